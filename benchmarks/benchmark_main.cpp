@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <QApplication>
+#include <vector>
+
+/**
+ * @brief Entry point of the microbenchmark suite.
+ *
+ * Creates the QApplication required by the widget-based benchmarks (on the offscreen platform unless
+ * QT_QPA_PLATFORM says otherwise) and, when no --benchmark_out is given, writes the results as JSON to
+ * wavelength_benchmarks.json next to the console report, so runs can be diffed across releases.
+ */
+int main(int argc, char *argv[]) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    std::vector<char *> arguments(argv, argv + argc);
+    bool has_output = false;
+    for (const char *argument: arguments) {
+        if (std::strncmp(argument, "--benchmark_out=", 16) == 0) {
+            has_output = true;
+        }
+    }
+
+    char default_output[] = "--benchmark_out=wavelength_benchmarks.json";
+    char default_format[] = "--benchmark_out_format=json";
+    if (!has_output) {
+        arguments.push_back(default_output);
+        arguments.push_back(default_format);
+    }
+
+    int benchmark_argc = static_cast<int>(arguments.size());
+    benchmark::Initialize(&benchmark_argc, arguments.data());
+    if (benchmark::ReportUnrecognizedArguments(benchmark_argc, arguments.data())) {
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,460 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <QLineF>
+#include <QPointF>
+#include <QRandomGenerator>
+#include <string>
+#include <vector>
+
+#include "../src/blob/blob_config.h"
+#include "../src/blob/core/blob_simulation.h"
+#include "../src/blob/physics/blob_physics.h"
+#include "../src/blob/physics/blob_physics_kernels.h"
+#include "../src/blob/states/idle_wave_synthesizer.h"
+#include "../src/blob/utils/blob_math.h"
+#include "../src/blob/utils/blob_path.h"
+#include "../src/blob/utils/path_arc_length_table.h"
+#include "../src/util/parallel_for_pool.h"
+
+namespace {
+    /**
+     * @brief Blob state shared by the physics and path benchmarks.
+     * Starts from the circular rest shape with every target point pushed outwards, so the
+     * spring forces are non-zero and every step does real work.
+     */
+    struct BlobFixture {
+        explicit BlobFixture(const int num_of_points) {
+            params.num_of_points = num_of_points;
+            params.blob_radius = 250.0;
+            BlobPhysics::InitializeBlob(points, blob_center, params, 1280, 720, random);
+
+            for (size_t i = 0; i < points.Size(); ++i) {
+                const float scale = i % 2 == 0 ? 1.1f : 0.9f;
+                points.target_x[i] = blob_center.x() + (points.target_x[i] - blob_center.x()) * scale;
+                points.target_y[i] = blob_center.y() + (points.target_y[i] - blob_center.y()) * scale;
+            }
+        }
+
+        BlobConfig::BlobParameters params;
+        BlobConfig::PhysicsParameters physics_params;
+        BlobPoints points;
+        QPointF blob_center;
+        BlobRandomGenerator random;
+    };
+
+    void BM_BlobPhysicsUpdateOptimized(benchmark::State &state) {
+        BlobFixture fixture(static_cast<int>(state.range(0)));
+
+        for (auto _: state) {
+            BlobPhysics::UpdatePhysicsOptimized(fixture.points, fixture.blob_center, fixture.params,
+                                                fixture.physics_params, fixture.random);
+            benchmark::DoNotOptimize(fixture.points.position_x.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_BlobPhysicsUpdateParallel(benchmark::State &state) {
+        BlobFixture fixture(static_cast<int>(state.range(0)));
+        state.SetLabel(BlobPhysics::SelectExecutionMode(fixture.points.Size()) ==
+                       BlobPhysics::ExecutionMode::kThreaded
+                           ? "threaded"
+                           : "single thread");
+
+        for (auto _: state) {
+            BlobPhysics::UpdatePhysicsParallel(fixture.points, fixture.blob_center, fixture.params,
+                                               fixture.physics_params, fixture.random);
+            benchmark::DoNotOptimize(fixture.points.position_x.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    /**
+     * @brief Round trip of an empty ParallelForPool job: the fixed cost a threaded physics step has to beat.
+     * Back-to-back jobs find the workers still spinning; the 120 Hz physics thread finds them parked.
+     */
+    void BM_ParallelForDispatch(benchmark::State &state) {
+        ParallelForPool *pool = ParallelForPool::GetInstance();
+        const auto count = static_cast<size_t>(pool->GetParticipantCount()) * 16;
+
+        for (auto _: state) {
+            pool->ParallelFor(count, 16, [](const size_t begin, const size_t end) {
+                benchmark::DoNotOptimize(begin + end);
+            });
+        }
+        state.SetLabel(std::to_string(pool->GetParticipantCount()) + " participants");
+    }
+
+    /**
+     * @brief SoA point data for the kernel benchmarks.
+     * Points are scattered around the center, partly inside the radius threshold, with velocities ranging
+     * from resting to above the speed limit, so every masked branch of the kernels is exercised. Two target
+     * sets are kept; alternating them between steps keeps the points from settling.
+     */
+    struct KernelFixture {
+        explicit KernelFixture(const size_t count)
+            : position_x(count), position_y(count), velocity_x(count), velocity_y(count) {
+            QRandomGenerator generator(7);
+            const auto random = [&generator](const double min, const double max) {
+                return static_cast<float>(min + (max - min) * generator.generateDouble());
+            };
+
+            for (auto &targets: target_x) targets.resize(count);
+            for (auto &targets: target_y) targets.resize(count);
+
+            for (size_t i = 0; i < count; ++i) {
+                position_x[i] = random(340.0, 940.0);
+                position_y[i] = random(60.0, 660.0);
+                velocity_x[i] = i % 4 == 0 ? 0.0f : random(-20.0, 20.0);
+                velocity_y[i] = i % 4 == 0 ? 0.0f : random(-20.0, 20.0);
+                for (int set = 0; set < 2; ++set) {
+                    target_x[set][i] = random(340.0, 940.0);
+                    target_y[set][i] = random(60.0, 660.0);
+                }
+            }
+
+            // same constants UpdatePhysicsOptimized derives from the default parameters
+            const BlobConfig::BlobParameters blob_params{};
+            const BlobConfig::PhysicsParameters physics_params{};
+            const auto radius_threshold = static_cast<float>(blob_params.blob_radius * 1.1);
+            const auto velocity_threshold = static_cast<float>(physics_params.velocity_threshold);
+            const auto max_speed = static_cast<float>(blob_params.blob_radius * physics_params.max_speed);
+            params.center_x = 640.0f;
+            params.center_y = 360.0f;
+            params.radius_threshold_squared = radius_threshold * radius_threshold;
+            params.viscosity = static_cast<float>(physics_params.viscosity);
+            params.damping = static_cast<float>(physics_params.damping);
+            params.velocity_threshold_squared = velocity_threshold * velocity_threshold;
+            params.max_speed = max_speed;
+            params.max_speed_squared = max_speed * max_speed;
+        }
+
+        BlobPhysicsKernels::PointArrays Arrays(const int target_set) {
+            return {
+                position_x.data(), position_y.data(), velocity_x.data(), velocity_y.data(),
+                target_x[target_set].data(), target_y[target_set].data(), position_x.size()
+            };
+        }
+
+        std::vector<float> position_x;
+        std::vector<float> position_y;
+        std::vector<float> velocity_x;
+        std::vector<float> velocity_y;
+        std::vector<float> target_x[2];
+        std::vector<float> target_y[2];
+        BlobPhysicsKernels::StepParameters params{};
+    };
+
+    void BM_BlobPhysicsKernel(benchmark::State &state) {
+        const auto instruction_set = static_cast<BlobPhysicsKernels::InstructionSet>(state.range(0));
+        const auto count = static_cast<size_t>(state.range(1));
+        state.SetLabel(BlobPhysicsKernels::GetInstructionSetName(instruction_set));
+
+        if (!BlobPhysicsKernels::IsSupported(instruction_set)) {
+            state.SkipWithError("instruction set not supported by this CPU");
+            return;
+        }
+
+        KernelFixture fixture(count);
+        int target_set = 0;
+        for (auto _: state) {
+            bool is_in_motion = BlobPhysicsKernels::Step(instruction_set, fixture.Arrays(target_set), fixture.params);
+            benchmark::DoNotOptimize(is_in_motion);
+            target_set ^= 1;
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(1));
+    }
+
+    /** @brief Length of the scripted session (5 s of simulated time at 120 Hz). */
+    constexpr int kScriptedSessionSteps = 600;
+
+    /**
+     * @brief Runs a scripted live session while recording it: the blob is dragged with the window, pushed by
+     * forces, resized, switched between states and reset at fixed ticks, the way the GUI thread feeds the physics
+     * thread.
+     * @param final_state Receives the simulation state at the end of the session.
+     * @return The recording of the session.
+     */
+    BlobRecording RecordScriptedSession(BlobSimulationState &final_state) {
+        BlobConfig::BlobParameters params{};
+        params.num_of_points = 32;
+        params.blob_radius = 250.0;
+        BlobSimulation simulation(params, BlobConfig::PhysicsParameters{});
+
+        BlobInputEvent viewport;
+        viewport.type = BlobInputEvent::Type::kViewportSize;
+        viewport.new_size = QSize(1280, 720);
+        simulation.QueueInput(viewport);
+
+        BlobInputEvent shape;
+        shape.type = BlobInputEvent::Type::kShapeReset;
+        shape.center = QPointF(1280 / 2.0, 720 / 2.0);
+        shape.shape = BlobMath::GenerateCircularPoints(shape.center, params.blob_radius, params.num_of_points);
+        simulation.QueueInput(shape);
+        simulation.ApplyPendingInputs();
+
+        simulation.StartRecording();
+        for (int step = 0; step < kScriptedSessionSteps; ++step) {
+            BlobInputEvent event;
+            if (step == 60 || step == 240) {
+                event.type = BlobInputEvent::Type::kStateChange;
+                event.state = step == 60 ? BlobConfig::kMoving : BlobConfig::kIdle;
+                simulation.QueueInput(event);
+            }
+            if (step >= 60 && step < 180 && step % 2 == 0) {
+                event.type = BlobInputEvent::Type::kWindowMove;
+                event.force = QVector2D(40.0f * std::sin(step * 0.1f), 25.0f * std::cos(step * 0.1f));
+                simulation.QueueInput(event);
+            }
+            if (step == 200) {
+                event.type = BlobInputEvent::Type::kResize;
+                event.old_size = QSize(1280, 720);
+                event.new_size = QSize(1400, 800);
+                simulation.QueueInput(event);
+                event.type = BlobInputEvent::Type::kViewportSize;
+                simulation.QueueInput(event);
+            }
+            if (step % 50 == 25) {
+                event.type = BlobInputEvent::Type::kForce;
+                event.force = QVector2D(15.0f, -10.0f);
+                simulation.QueueInput(event);
+            }
+            if (step == 400) {
+                // the new shape factors come from the simulation's generator, which the replay has to continue
+                simulation.QueueInput(shape);
+            }
+            simulation.Step();
+        }
+
+        final_state = simulation.GetState();
+        return simulation.StopRecording();
+    }
+
+    /**
+     * @brief Checks two simulation states for bitwise equal points, shape factors, center, tick and generator.
+     */
+    bool IsSameSimulationState(const BlobSimulationState &a, const BlobSimulationState &b) {
+        return a.tick == b.tick && a.animation_state == b.animation_state && a.blob_center == b.blob_center &&
+               a.points.position_x == b.points.position_x && a.points.position_y == b.points.position_y &&
+               a.points.velocity_x == b.points.velocity_x && a.points.velocity_y == b.points.velocity_y &&
+               a.points.shape_factors == b.points.shape_factors && a.random.state == b.random.state;
+    }
+
+    void BM_BlobSimulationReplay(benchmark::State &state) {
+        BlobSimulationState live_state;
+        const BlobRecording recording = RecordScriptedSession(live_state);
+        // the replay has to reproduce the live session exactly, otherwise the timings are meaningless
+        if (!IsSameSimulationState(BlobSimulation::Replay(recording), live_state)) {
+            state.SkipWithError("replay diverged from the recorded session");
+            return;
+        }
+
+        for (auto _: state) {
+            BlobSimulationState final_state = BlobSimulation::Replay(recording);
+            benchmark::DoNotOptimize(final_state.points.position_x.data());
+        }
+        state.SetItemsProcessed(state.iterations() * kScriptedSessionSteps);
+    }
+
+    void BM_BlobPathCreate(benchmark::State &state) {
+        const BlobFixture fixture(static_cast<int>(state.range(0)));
+
+        for (auto _: state) {
+            QPainterPath path = BlobPath::CreateBlobPath(fixture.points);
+            benchmark::DoNotOptimize(path);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    /** @brief Marker count and trail length of a busy PathMarkersManager frame (6 markers, head + 15 trail points). */
+    constexpr int kMarkerLookupsPerFrame = 6 * 16;
+
+    /**
+     * @brief The former marker placement: walks the path segments from the start for every query.
+     * @return The point at the given distance, or (0, 0) if the distance lies past the end of the path.
+     */
+    QPointF WalkPathToLength(const QPainterPath &path, const double distance) {
+        double current_length = 0;
+        for (int i = 0; i < path.elementCount() - 1; i++) {
+            const QPointF p1 = path.elementAt(i);
+            const QPointF p2 = path.elementAt(i + 1);
+            const double segment_length = QLineF(p1, p2).length();
+            if (current_length + segment_length >= distance) {
+                const double t = (distance - current_length) / segment_length;
+                return p1 * (1 - t) + p2 * t;
+            }
+            current_length += segment_length;
+        }
+        return {};
+    }
+
+    void BM_PathMarkerLookupWalk(benchmark::State &state) {
+        const BlobFixture fixture(static_cast<int>(state.range(0)));
+        const QPainterPath path = BlobPath::CreateBlobPath(fixture.points);
+        PathArcLengthTable table;
+        table.Build(path);
+        const double path_length = table.TotalLength();
+
+        for (auto _: state) {
+            for (int i = 0; i < kMarkerLookupsPerFrame; ++i) {
+                benchmark::DoNotOptimize(WalkPathToLength(path, path_length * i / kMarkerLookupsPerFrame));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * kMarkerLookupsPerFrame);
+    }
+
+    void BM_PathMarkerLookupTable(benchmark::State &state) {
+        const BlobFixture fixture(static_cast<int>(state.range(0)));
+        const QPainterPath path = BlobPath::CreateBlobPath(fixture.points);
+        PathArcLengthTable table;
+        table.Build(path);
+        const double path_length = table.TotalLength();
+
+        // the table has to place markers exactly where the segment walk did
+        for (int i = 0; i <= 1000; ++i) {
+            const double distance = path_length * i / 1000.0;
+            if (const QPointF expected = WalkPathToLength(path, distance), actual = table.PointAtLength(distance);
+                std::abs(expected.x() - actual.x()) > 1e-6 || std::abs(expected.y() - actual.y()) > 1e-6) {
+                state.SkipWithError(("table lookup differs from the segment walk at distance "
+                                     + std::to_string(distance)).c_str());
+                return;
+            }
+        }
+
+        // the table is rebuilt every frame, so its construction is part of the measured cost
+        for (auto _: state) {
+            table.Build(path);
+            for (int i = 0; i < kMarkerLookupsPerFrame; ++i) {
+                benchmark::DoNotOptimize(table.PointAtLength(path_length * i / kMarkerLookupsPerFrame));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * kMarkerLookupsPerFrame);
+    }
+
+    /**
+     * @brief Idle wave constants of a typical step (the application's frequency and amplitude, mid-cycle phases).
+     */
+    IdleWaveSynthesizer::WaveParameters IdleWaveFixtureParameters(const BlobFixture &fixture) {
+        IdleWaveSynthesizer::WaveParameters wave;
+        wave.center_x = fixture.blob_center.x();
+        wave.center_y = fixture.blob_center.y();
+        wave.primary_amplitude = 2.0 * 0.9;
+        wave.primary_phase = 1.3;
+        wave.secondary_amplitude = 2.0 * 0.5;
+        wave.secondary_phase = 2.1;
+        wave.frequency = 3.0;
+        wave.rotation_strength = 0.15 * std::sin(0.7);
+        wave.blob_radius = fixture.params.blob_radius;
+        return wave;
+    }
+
+    /**
+     * @brief The former IdleState wave loop: an atan2() and two sin() calls per point.
+     */
+    void ApplyIdleWaveReference(BlobPoints &points, const IdleWaveSynthesizer::WaveParameters &wave) {
+        const size_t num_of_points = points.Size();
+        double total_displacement_x = 0.0;
+        double total_displacement_y = 0.0;
+
+        for (size_t i = 0; i < num_of_points; ++i) {
+            const double vector_from_center_x = points.position_x[i] - wave.center_x;
+            const double vector_from_center_y = points.position_y[i] - wave.center_y;
+            const double angle = std::atan2(vector_from_center_y, vector_from_center_x);
+            const double distance_from_center = std::sqrt(vector_from_center_x * vector_from_center_x +
+                                                          vector_from_center_y * vector_from_center_y);
+
+            double wave_strength = wave.primary_amplitude * std::sin(wave.primary_phase + wave.frequency * angle);
+            wave_strength += wave.secondary_amplitude * std::sin(wave.secondary_phase + wave.frequency * 2.0 * angle);
+
+            double normalized_x = 0.0;
+            double normalized_y = 0.0;
+            if (distance_from_center > 0.0) {
+                normalized_x = vector_from_center_x / distance_from_center;
+                normalized_y = vector_from_center_y / distance_from_center;
+            }
+
+            const double rotation_factor = wave.rotation_strength * (distance_from_center / wave.blob_radius);
+            double force_scale = 0.2 + 0.8 * (distance_from_center / wave.blob_radius);
+            if (force_scale > 1.0) force_scale = 1.0;
+
+            const double delta_force_x = (normalized_x * wave_strength - normalized_y * rotation_factor) *
+                                         force_scale * 0.15;
+            const double delta_force_y = (normalized_y * wave_strength + normalized_x * rotation_factor) *
+                                         force_scale * 0.15;
+            points.velocity_x[i] += static_cast<float>(delta_force_x);
+            points.velocity_y[i] += static_cast<float>(delta_force_y);
+
+            total_displacement_x += delta_force_x;
+            total_displacement_y += delta_force_y;
+        }
+
+        const auto avg_displacement_x = static_cast<float>(total_displacement_x / num_of_points);
+        const auto avg_displacement_y = static_cast<float>(total_displacement_y / num_of_points);
+        for (size_t i = 0; i < num_of_points; ++i) {
+            points.velocity_x[i] -= avg_displacement_x;
+            points.velocity_y[i] -= avg_displacement_y;
+        }
+    }
+
+    void BM_IdleWaveReference(benchmark::State &state) {
+        BlobFixture fixture(static_cast<int>(state.range(0)));
+        const IdleWaveSynthesizer::WaveParameters wave = IdleWaveFixtureParameters(fixture);
+
+        for (auto _: state) {
+            ApplyIdleWaveReference(fixture.points, wave);
+            benchmark::DoNotOptimize(fixture.points.velocity_x.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_IdleWaveSynthesized(benchmark::State &state) {
+        BlobFixture fixture(static_cast<int>(state.range(0)));
+        IdleWaveSynthesizer::WaveParameters wave = IdleWaveFixtureParameters(fixture);
+        IdleWaveSynthesizer synthesizer;
+
+        // both the recurrence (integer frequency) and the atan2 fallback have to match the former loop
+        for (const double frequency: {wave.frequency, 2.5}) {
+            wave.frequency = frequency;
+            BlobPoints expected = fixture.points;
+            BlobPoints actual = fixture.points;
+            ApplyIdleWaveReference(expected, wave);
+            synthesizer.ApplyWave(actual, wave);
+            for (size_t i = 0; i < expected.Size(); ++i) {
+                if (std::abs(expected.velocity_x[i] - actual.velocity_x[i]) > 1e-5f ||
+                    std::abs(expected.velocity_y[i] - actual.velocity_y[i]) > 1e-5f) {
+                    state.SkipWithError(("synthesized wave differs from the reference at point " + std::to_string(i)
+                                         + ", frequency " + std::to_string(frequency)).c_str());
+                    return;
+                }
+            }
+        }
+        wave = IdleWaveFixtureParameters(fixture);
+
+        for (auto _: state) {
+            synthesizer.ApplyWave(fixture.points, wave);
+            benchmark::DoNotOptimize(fixture.points.velocity_x.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+// 24 and 32 are the point counts used by the application, the rest show how the kernels scale
+BENCHMARK(BM_BlobPhysicsUpdateOptimized)->Arg(24)->Arg(32)->Arg(64)->Arg(128)->Arg(256)->Arg(1024);
+BENCHMARK(BM_BlobPhysicsUpdateParallel)->Arg(24)->Arg(32)->Arg(64)->Arg(128)->Arg(256)->Arg(1024)->Arg(64 * 1024)
+    ->UseRealTime();
+BENCHMARK(BM_ParallelForDispatch)->UseRealTime();
+// every kernel variant (scalar, SSE2, AVX2, AVX-512) at 64, 1k and 64k points; blob_physics_kernels_test
+// checks that they match the scalar kernel
+BENCHMARK(BM_BlobPhysicsKernel)->ArgsProduct({{0, 1, 2, 3}, {64, 1024, 64 * 1024}});
+// replays a recorded 5 s session headlessly after checking it against the live run
+BENCHMARK(BM_BlobSimulationReplay);
+BENCHMARK(BM_BlobPathCreate)->Arg(24)->Arg(32)->Arg(64)->Arg(128)->Arg(256);
+// one frame of marker placement (6 markers with trails) on the blob outline: per-query segment walk vs. the
+// arc-length table built once per frame; the table run first checks its positions against the walk
+BENCHMARK(BM_PathMarkerLookupWalk)->Arg(24)->Arg(32)->Arg(64)->Arg(256);
+BENCHMARK(BM_PathMarkerLookupTable)->Arg(24)->Arg(32)->Arg(64)->Arg(256);
+// one idle wave step: per-point atan2/sin vs. the synthesizer's multiplication recurrence; the synthesized run
+// first checks its velocities against the reference loop
+BENCHMARK(BM_IdleWaveReference)->Arg(32)->Arg(256)->Arg(4 * 1024)->Arg(64 * 1024);
+BENCHMARK(BM_IdleWaveSynthesized)->Arg(32)->Arg(256)->Arg(4 * 1024)->Arg(64 * 1024);
@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+
+#include <QAudioFormat>
+#include <QRandomGenerator>
+
+#include "../src/ui/chat/effects/long_text_display_effect.h"
+#include "../src/util/audio_utilities.h"
+
+namespace {
+    void BM_AudioCalculateAmplitude(benchmark::State &state) {
+        QAudioFormat format;
+        format.setSampleRate(44100);
+        format.setChannelCount(1);
+        format.setSampleSize(16);
+        format.setCodec("audio/pcm");
+        format.setByteOrder(QAudioFormat::LittleEndian);
+        format.setSampleType(QAudioFormat::SignedInt);
+
+        QByteArray buffer(static_cast<int>(state.range(0)) * 2, Qt::Uninitialized);
+        auto samples = reinterpret_cast<qint16 *>(buffer.data());
+        QRandomGenerator generator(42);
+        for (int i = 0; i < state.range(0); ++i) {
+            samples[i] = static_cast<qint16>(generator.bounded(-32768, 32768));
+        }
+
+        for (auto _: state) {
+            qreal amplitude = AudioUtilities::CalculateRmsAmplitude(buffer, format);
+            benchmark::DoNotOptimize(amplitude);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_LongTextDisplayProcessText(benchmark::State &state) {
+        QString paragraph;
+        while (paragraph.size() < 400) {
+            paragraph += "the carrier wave folds over itself and the message arrives in pieces ";
+        }
+
+        QString text;
+        while (text.size() < state.range(0)) {
+            text += paragraph + "\n";
+        }
+        text.truncate(static_cast<int>(state.range(0)));
+
+        // SetText() reprocesses immediately, alternating two texts defeats the unchanged-text early return
+        const QString alternate = text + " ";
+        LongTextDisplayEffect effect(QString(), Qt::white);
+        effect.resize(600, 400);
+
+        bool flip = false;
+        for (auto _: state) {
+            effect.SetText(flip ? alternate : text);
+            flip = !flip;
+            benchmark::DoNotOptimize(effect.sizeHint());
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+}
+
+// 20 ms of mono audio at 44.1 kHz, one push-to-talk chunk, and one second
+BENCHMARK(BM_AudioCalculateAmplitude)->Arg(882)->Arg(4096)->Arg(44100);
+BENCHMARK(BM_LongTextDisplayProcessText)->Arg(1024)->Arg(16 * 1024)->Arg(128 * 1024);
@@ -0,0 +1,143 @@
+#include <benchmark/benchmark.h>
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QRegExp>
+
+#include "../src/chat/messages/formatter/message_content_parser.h"
+#include "../src/chat/messages/formatter/message_formatter.h"
+#include "../src/chat/messages/handler/message_handler.h"
+
+namespace {
+    /**
+     * @brief Builds a chat message of roughly the given content length, as sent by the relay server.
+     * @param content_length Number of characters in the message content.
+     * @return The message object.
+     */
+    QJsonObject MakeMessage(const int content_length) {
+        QString content;
+        content.reserve(content_length);
+        while (content.size() < content_length) {
+            content += "signal lost in the static, retrying on the next band ";
+        }
+        content.truncate(content_length);
+
+        QJsonObject message;
+        message["type"] = "message";
+        message["id"] = "msg-1234567890";
+        message["frequency"] = "130.0";
+        message["content"] = content;
+        message["senderId"] = "f3a1c0de-1234-4bcd-9aef-0123456789ab";
+        message["timestamp"] = static_cast<qint64>(1700000000000);
+        return message;
+    }
+
+    void BM_MessageHandlerParseMessage(benchmark::State &state) {
+        const QString raw = QString::fromUtf8(
+            QJsonDocument(MakeMessage(static_cast<int>(state.range(0)))).toJson(QJsonDocument::Compact));
+
+        for (auto _: state) {
+            bool ok = false;
+            QJsonObject parsed = MessageHandler::ParseMessage(raw, &ok);
+            benchmark::DoNotOptimize(parsed);
+        }
+        state.SetBytesProcessed(state.iterations() * raw.size() * static_cast<int64_t>(sizeof(QChar)));
+    }
+
+    void BM_MessageFormatterFormatMessage(benchmark::State &state) {
+        const QJsonObject message = MakeMessage(static_cast<int>(state.range(0)));
+
+        for (auto _: state) {
+            QString html = MessageFormatter::FormatMessage(message, "130.0");
+            benchmark::DoNotOptimize(html);
+        }
+    }
+
+    void BM_Base64RoundTrip(benchmark::State &state) {
+        // deterministic payload, so every run encodes the same bytes
+        QByteArray payload(static_cast<int>(state.range(0)), Qt::Uninitialized);
+        QRandomGenerator generator(42);
+        for (char &byte: payload) {
+            byte = static_cast<char>(generator.bounded(256));
+        }
+
+        for (auto _: state) {
+            const QByteArray encoded = payload.toBase64();
+            QByteArray decoded = QByteArray::fromBase64(encoded);
+            benchmark::DoNotOptimize(decoded);
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+
+    /**
+     * @brief The former StreamMessage::CleanupContent for content without placeholders: regex tag removal,
+     * one replace per entity, and replaces splitting long text into sentences.
+     */
+    QString CleanupContentReference(const QString &content) {
+        QString clean_content = content;
+        clean_content.remove(QRegExp("<[^>]*>"));
+
+        clean_content.replace("&nbsp;", " ");
+        clean_content.replace("&lt;", "<");
+        clean_content.replace("&gt;", ">");
+        clean_content.replace("&amp;", "&");
+
+        if (clean_content.length() > 300) {
+            clean_content.replace("\n\n", "||PARAGRAPH||");
+            clean_content = clean_content.simplified();
+            clean_content.replace("||PARAGRAPH||", "\n\n");
+
+            clean_content.replace(". ", ".\n");
+            clean_content.replace("? ", "?\n");
+            clean_content.replace("! ", "!\n");
+            clean_content.replace(":\n", ": ");
+        } else {
+            clean_content = clean_content.simplified();
+        }
+        return clean_content;
+    }
+
+    /**
+     * @brief Builds formatted message HTML of roughly the given length with paragraphs and inline markup.
+     */
+    QString MakeMessageHtml(const int content_length) {
+        QString html = "<span style=\"color:#85c4ff;\">[12:00:00] <b>Operator:</b></span> "
+                "<span style=\"color:#ffffff;\">";
+        while (html.size() < content_length) {
+            html += "Signal lost in the static &amp; retrying on the next band. Is anyone &lt;there&gt;?<br>"
+                    "<b>Status:</b>&nbsp;scanning\n\n";
+        }
+        html += "</span>";
+        return html;
+    }
+
+    void BM_CleanupContentReference(benchmark::State &state) {
+        const QString html = MakeMessageHtml(static_cast<int>(state.range(0)));
+
+        for (auto _: state) {
+            QString clean_content = CleanupContentReference(html);
+            benchmark::DoNotOptimize(clean_content);
+        }
+        state.SetBytesProcessed(state.iterations() * html.size() * static_cast<int64_t>(sizeof(QChar)));
+    }
+
+    void BM_MessageContentParser(benchmark::State &state) {
+        const QString html = MakeMessageHtml(static_cast<int>(state.range(0)));
+
+        for (auto _: state) {
+            QString clean_content = MessageContentParser::FormatForDisplay(MessageContentParser::Parse(html).text);
+            benchmark::DoNotOptimize(clean_content);
+        }
+        state.SetBytesProcessed(state.iterations() * html.size() * static_cast<int64_t>(sizeof(QChar)));
+    }
+}
+
+BENCHMARK(BM_MessageHandlerParseMessage)->Arg(64)->Arg(1024)->Arg(16 * 1024);
+BENCHMARK(BM_MessageFormatterFormatMessage)->Arg(64)->Arg(1024)->Arg(16 * 1024);
+// attachment-sized payloads: a small image, a voice note and a short video clip
+BENCHMARK(BM_Base64RoundTrip)->Arg(64 * 1024)->Arg(1024 * 1024)->Arg(8 * 1024 * 1024);
+// message content cleanup: regex and replace passes vs. the single-pass parser (checked against the passes by
+// message_content_parser_fuzz_test)
+BENCHMARK(BM_CleanupContentReference)->Arg(1024)->Arg(16 * 1024)->Arg(256 * 1024);
+BENCHMARK(BM_MessageContentParser)->Arg(1024)->Arg(16 * 1024)->Arg(256 * 1024);
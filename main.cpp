@@ -17,6 +17,7 @@
 #include <QTimer>
 #include <QStyleFactory>
 #include <QCommandLineParser>
+#include <QElapsedTimer>
 #include <QGraphicsDropShadowEffect>
 #include <QVBoxLayout>
 
@@ -27,6 +28,7 @@
 #include "src/ui/views/chat_view.h"
 #include "src/ui/dialogs/create_wavelength_dialog.h"
 
+#include "src/services/frequency_allocator.h"
 #include "src/session/session_coordinator.h"
 #include "src/app/style/cyberpunk_style.h"
 #include "src/ui/effects/cyberpunk_text_effect.h"
@@ -34,11 +36,17 @@
 #include "src/app/managers/shortcut_manager.h"
 #include "src/app/managers/translation_manager.h"
 #include "src/ui/views/settings_view.h"
+#include "src/util/frame_scheduler.h"
 #include "src/util/resize_event_filter.h"
 #include "src/util/wavelength_utilities.h"
+#include "src/util/profiling/startup_profiler.h"
+#include "src/util/profiling/trace_profiler.h"
 
 
 int main(int argc, char *argv[]) {
+    StartupProfiler *startup_profiler = StartupProfiler::GetInstance();
+    startup_profiler->Start();
+
     QCoreApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
     QCoreApplication::setAttribute(Qt::AA_UseHighDpiPixmaps);
     QCoreApplication::setAttribute(Qt::AA_ShareOpenGLContexts);
@@ -48,15 +56,15 @@ int main(int argc, char *argv[]) {
     QApplication app(argc, argv);
     QCoreApplication::setOrganizationName("Wavelength");
     QCoreApplication::setApplicationName("WavelengthApp");
+    startup_profiler->Mark("application");
 
     auto boot_sound = new QSoundEffect(&app);
     boot_sound->setSource(QUrl("qrc:/resources/sounds/interface/boot_up.wav"));
     boot_sound->setVolume(1.0);
 
-    auto shutdown_sound = new QSoundEffect(&app);
-    shutdown_sound->setSource(QUrl("qrc:/resources/sounds/interface/shutdown.wav"));
-    shutdown_sound->setVolume(1.0);
-
+    // the shutdown sound is only needed on exit, it gets loaded after the first frame
+    QSoundEffect *shutdown_sound = nullptr;
+    startup_profiler->Mark("boot sound");
 
     WavelengthConfig *config = WavelengthConfig::GetInstance();
 
@@ -64,6 +72,7 @@ int main(int argc, char *argv[]) {
     if (!translator->Initialize(config->GetLanguageCode())) {
         qCritical() << "[MAIN] Failed to initialize translation manager. Fallback to English.";
     }
+    startup_profiler->Mark("config & translations");
 
     QCommandLineParser parser;
     parser.setApplicationDescription("Wavelength Application");
@@ -72,8 +81,58 @@ int main(int argc, char *argv[]) {
     const QCommandLineOption override_option("run-override",
                                              "Internal flag to start the system override sequence immediately.");
     parser.addOption(override_option);
+    const QCommandLineOption startup_trace_option("startup-trace",
+                                                  "Writes the startup phase breakdown as JSON to <file>.",
+                                                  "file");
+    parser.addOption(startup_trace_option);
+    const QCommandLineOption trace_option("trace",
+                                          "Records hot-path trace zones and writes them as a Chrome trace to <file> on exit.",
+                                          "file");
+    parser.addOption(trace_option);
+    const QCommandLineOption record_blob_option("record-blob",
+                                                "Records the blob simulation inputs and writes them to <file> on exit.",
+                                                "file");
+    parser.addOption(record_blob_option);
+    const QCommandLineOption replay_blob_option("replay-blob",
+                                                "Replays a blob recording from <file> headlessly and exits.",
+                                                "file");
+    parser.addOption(replay_blob_option);
     parser.process(app);
 
+    if (parser.isSet(replay_blob_option)) {
+        BlobRecording recording;
+        if (!recording.Load(parser.value(replay_blob_option))) {
+            return 1;
+        }
+
+        QElapsedTimer replay_timer;
+        replay_timer.start();
+        const BlobSimulationState final_state = BlobSimulation::Replay(recording);
+        qDebug() << "[MAIN] Replayed" << recording.end_tick - recording.initial_state.tick << "blob steps with"
+                << recording.events.size() << "inputs in" << replay_timer.nsecsElapsed() / 1.0e6
+                << "ms. Final center:" << final_state.blob_center;
+        return 0;
+    }
+
+    if (parser.isSet(startup_trace_option)) {
+        startup_profiler->SetExportPath(parser.value(startup_trace_option));
+    }
+
+    const QString trace_path = parser.isSet(trace_option)
+                                   ? parser.value(trace_option)
+                                   : qEnvironmentVariable("WAVELENGTH_TRACE");
+    TRACE_THREAD_NAME("Main");
+    if (!trace_path.isEmpty()) {
+        TraceProfiler::SetExportPath(trace_path);
+        TraceProfiler::SetEnabled(true);
+    }
+    // a recording still running on exit (from --trace or Debug.ToggleTracing) is exported
+    QObject::connect(&app, &QApplication::aboutToQuit, [] {
+        if (TraceProfiler::IsEnabled()) {
+            TraceProfiler::ToggleRecording();
+        }
+    });
+
     if (parser.isSet(override_option)) {
         qDebug() << "--run-override flag detected.";
 #ifdef Q_OS_WIN
@@ -114,8 +173,8 @@ int main(int argc, char *argv[]) {
         QObject::disconnect(boot_sound, &QSoundEffect::statusChanged, nullptr, nullptr);
     }
 
-    QObject::connect(&app, &QApplication::aboutToQuit, [shutdown_sound] {
-        if (shutdown_sound->isLoaded()) {
+    QObject::connect(&app, &QApplication::aboutToQuit, [&shutdown_sound] {
+        if (shutdown_sound && shutdown_sound->isLoaded()) {
             shutdown_sound->play();
             QTimer::singleShot(2500, &QCoreApplication::quit);
         } else {
@@ -137,6 +196,7 @@ int main(int argc, char *argv[]) {
     QApplication::setStyle(QStyleFactory::create("Fusion"));
 
     CyberpunkStyle::ApplyStyle();
+    startup_profiler->Mark("fonts & style");
 
     QMainWindow window;
     window.setWindowTitle("Wavelength");
@@ -155,6 +215,7 @@ int main(int argc, char *argv[]) {
     stacked_widget->SetDuration(600);
     stacked_widget->SetAnimationType(AnimatedStackedWidget::Slide);
     main_layout->addWidget(stacked_widget);
+    startup_profiler->Mark("main window");
 
     auto animation_widget = new QWidget(stacked_widget);
     const auto animation_layout = new QVBoxLayout(animation_widget);
@@ -175,11 +236,19 @@ int main(int argc, char *argv[]) {
 
     stacked_widget->addWidget(animation_widget);
 
+    if (parser.isSet(record_blob_option)) {
+        animation->StartRecording();
+        QObject::connect(&app, &QApplication::aboutToQuit, [animation, path = parser.value(record_blob_option)] {
+            if (animation->StopRecording().Save(path)) {
+                qDebug() << "[MAIN] Blob recording written to" << path;
+            }
+        });
+    }
+    startup_profiler->Mark("blob animation");
+
     auto chat_view = new ChatView(stacked_widget);
     stacked_widget->addWidget(chat_view);
-
-    auto settings_view = new SettingsView(stacked_widget);
-    stacked_widget->addWidget(settings_view);
+    startup_profiler->Mark("chat view");
 
     stacked_widget->setCurrentWidget(animation_widget);
 
@@ -215,6 +284,7 @@ int main(int argc, char *argv[]) {
     auto event_filter = new ResizeEventFilter(title_label, animation);
 
     auto *text_effect = new CyberpunkTextEffect(title_label, animation);
+    startup_profiler->Mark("title label");
 
     window.setMinimumSize(1200, 900);
     window.setMaximumSize(1600, 900);
@@ -231,6 +301,7 @@ int main(int argc, char *argv[]) {
 
     SessionCoordinator *coordinator = SessionCoordinator::GetInstance();
     coordinator->Initialize();
+    startup_profiler->Mark("session coordinator");
 
     auto event_listening = [animation, event_filter](const bool enable) {
         if (enable) {
@@ -296,9 +367,18 @@ int main(int argc, char *argv[]) {
         animation->hideAnimation();
         navbar->SetChatMode(true);
         chat_view->SetWavelength(frequency, "");
+        // a snapshot prefetched before the wavelength changed would slide in the previous session
+        stacked_widget->InvalidateSnapshot(chat_view);
         stacked_widget->SlideToWidget(chat_view);
     };
 
+    // network traffic wakes the throttled animations before the chat view starts animating the message
+    FrameScheduler *frame_scheduler = FrameScheduler::GetInstance();
+    QObject::connect(coordinator, &SessionCoordinator::messageReceived,
+                     frame_scheduler, &FrameScheduler::NotifyActivity);
+    QObject::connect(coordinator, &SessionCoordinator::messageSent,
+                     frame_scheduler, &FrameScheduler::NotifyActivity);
+
     QObject::connect(coordinator, &SessionCoordinator::messageReceived,
                      chat_view, &ChatView::OnMessageReceived);
 
@@ -341,30 +421,46 @@ int main(int argc, char *argv[]) {
                          WavelengthUtilities::CenterLabel(title_label, animation);
                      });
 
-    QObject::connect(navbar, &Navbar::settingsClicked, [stacked_widget, settings_view, animation] {
-        animation->hideAnimation();
+    // settings view (with all its tabs and classified layers) is not needed for the first frame,
+    // so it is built the first time the user opens it
+    SettingsView *settings_view = nullptr;
+    auto ensure_settings_view = [&settings_view, stacked_widget, animation_widget, animation, title_label,
+                text_effect] {
+        if (settings_view) {
+            return settings_view;
+        }
 
-        animation->PauseAllEventTracking();
+        settings_view = new SettingsView(stacked_widget);
+        stacked_widget->addWidget(settings_view);
 
-        stacked_widget->SlideToWidget(settings_view);
-    });
+        QObject::connect(settings_view, &SettingsView::backToMainView,
+                         [stacked_widget, animation_widget, animation, title_label, text_effect] {
+                             animation->hideAnimation();
+                             animation->ResetLifeColor();
+                             stacked_widget->SlideToWidget(animation_widget);
 
-    QObject::connect(settings_view, &SettingsView::backToMainView,
-                     [stacked_widget, animation_widget, animation, title_label, text_effect] {
-                         animation->hideAnimation();
-                         animation->ResetLifeColor();
-                         stacked_widget->SlideToWidget(animation_widget);
-
-                         QTimer::singleShot(stacked_widget->GetDuration(), [animation, text_effect, title_label] {
-                             animation->showAnimation();
-                             animation->ResetVisualization();
-                             title_label->adjustSize();
-                             QTimer::singleShot(0, [title_label, animation] {
-                                 WavelengthUtilities::CenterLabel(title_label, animation);
+                             QTimer::singleShot(stacked_widget->GetDuration(), [animation, text_effect, title_label] {
+                                 animation->showAnimation();
+                                 animation->ResetVisualization();
+                                 title_label->adjustSize();
+                                 QTimer::singleShot(0, [title_label, animation] {
+                                     WavelengthUtilities::CenterLabel(title_label, animation);
+                                 });
+                                 text_effect->StartAnimation();
                              });
-                             text_effect->StartAnimation();
                          });
-                     });
+
+        ShortcutManager::GetInstance()->RegisterShortcuts(settings_view);
+        return settings_view;
+    };
+
+    QObject::connect(navbar, &Navbar::settingsClicked, [stacked_widget, ensure_settings_view, animation] {
+        animation->hideAnimation();
+
+        animation->PauseAllEventTracking();
+
+        stacked_widget->SlideToWidget(ensure_settings_view());
+    });
 
     QObject::connect(navbar, &Navbar::createWavelengthClicked, [&window, animation, coordinator, navbar] {
         navbar->PlayClickSound();
@@ -414,7 +510,7 @@ int main(int argc, char *argv[]) {
     ShortcutManager *shortcut_manager = ShortcutManager::GetInstance();
     shortcut_manager->RegisterShortcuts(&window);
     shortcut_manager->RegisterShortcuts(chat_view);
-    shortcut_manager->RegisterShortcuts(settings_view);
+    startup_profiler->Mark("signals & shortcuts");
 
 #ifdef Q_OS_WINDOWS
     if (QOperatingSystemVersion::current() >= QOperatingSystemVersion::Windows10) {
@@ -427,6 +523,17 @@ int main(int argc, char *argv[]) {
 #endif
 
     window.show();
+    startup_profiler->Mark("window shown");
+    startup_profiler->WatchFirstFrame(animation);
+
+    QObject::connect(startup_profiler, &StartupProfiler::firstFramePresented, &app, [&app, &shutdown_sound] {
+        shutdown_sound = new QSoundEffect(&app);
+        shutdown_sound->setSource(QUrl("qrc:/resources/sounds/interface/shutdown.wav"));
+        shutdown_sound->setVolume(1.0);
+
+        // candidates for the create dialog are fetched while the user is still looking at the intro
+        FrequencyAllocator::GetInstance()->Prefetch();
+    });
 
     QTimer::singleShot(500, [title_label, animation, text_effect] {
         title_label->setText("WAVELENGTH");
@@ -3,9 +3,11 @@
 #include <qcoreapplication.h>
 #include <QMainWindow>
 #include <QSequentialAnimationGroup>
+#include <QtEndian>
 #include <QUuid>
 
 #include "../../blob/core/blob_animation.h"
+#include "../../util/frame_scheduler.h"
 
 const QString AppInstanceManager::kServerName = "pk4-projekt-blob-animation";
 
@@ -13,16 +15,12 @@ AppInstanceManager::AppInstanceManager(QMainWindow *window, BlobAnimation *blob,
     : QObject(parent),
       main_window_(window),
       blob_(blob),
+      position_channel_(kServerName + "-positions"),
       instance_id_(QUuid::createUuid().toString()) {
-    position_timer_.setInterval(kUpdateIntervalMs);
-    connect(&position_timer_, &QTimer::timeout, this, &AppInstanceManager::sendPositionUpdate);
+    connect(&sync_timer_, &QTimer::timeout, this, &AppInstanceManager::synchronizePositions);
 }
 
 AppInstanceManager::~AppInstanceManager() {
-    if (attraction_thread_ && is_thread_running) {
-        is_thread_running = false;
-        attraction_thread_->join();
-    }
     if (server_) {
         server_->close();
     }
@@ -41,9 +39,8 @@ bool AppInstanceManager::Start() {
         is_creator_ = true;
         SetupServer();
     }
-    position_timer_.start();
+    FrameScheduler::GetInstance()->RegisterTimer(&sync_timer_, kSyncIntervalMs, kIdleSyncIntervalMs);
     absorption_check_timer_.start();
-    InitAttractionThread();
 
     if (!is_creator_) {
         main_window_->setWindowFlags(main_window_->windowFlags() | Qt::WindowStaysOnTopHint);
@@ -74,18 +71,22 @@ void AppInstanceManager::clientDisconnected() {
     auto *socket = qobject_cast<QLocalSocket *>(sender());
     if (!socket) return;
 
+    receive_buffers_.remove(socket);
+
     if (is_creator_) {
         if (const QString clientId = client_ids_.value(socket, QString()); !clientId.isNull()) {
-            {
-                QMutexLocker locker(&instances_mutex_);
-                connected_instances_.erase(
-                    std::ranges::remove_if(connected_instances_,
-                                           [&](const InstanceInfo &info) {
-                                               return info.instance_id == clientId;
-                                           }).begin(),
-                    connected_instances_.end()
-                );
+            for (const auto &instance: connected_instances_) {
+                if (instance.instance_id == clientId) {
+                    position_channel_.ClearSlot(instance.slot);
+                }
             }
+            connected_instances_.erase(
+                std::ranges::remove_if(connected_instances_,
+                                       [&](const InstanceInfo &info) {
+                                           return info.instance_id == clientId;
+                                       }).begin(),
+                connected_instances_.end()
+            );
 
             client_ids_.remove(socket);
             emit instanceDisconnected(clientId);
@@ -107,20 +108,11 @@ void AppInstanceManager::clientDisconnected() {
     } else {
         if (!IsAnotherInstanceRunning()) {
             is_creator_ = true;
-            if (attraction_thread_ && is_thread_running) {
-                is_thread_running = false;
-                if (attraction_thread_->joinable()) {
-                    attraction_thread_->join();
-                }
-                attraction_thread_.reset();
-            }
             if (socket_) {
                 socket_->deleteLater();
                 socket_ = nullptr;
-            } {
-                QMutexLocker locker(&instances_mutex_);
-                connected_instances_.clear();
             }
+            connected_instances_.clear();
             SetupServer();
         }
     }
@@ -132,23 +124,62 @@ void AppInstanceManager::readData() {
     const auto socket = qobject_cast<QLocalSocket *>(sender());
     if (!socket) return;
 
-    while (socket->bytesAvailable() > 0) {
-        QByteArray data = socket->readAll();
-        ProcessMessage(data, socket);
+    // reads may split or coalesce frames, so bytes are collected until a whole frame is available
+    QByteArray &buffer = receive_buffers_[socket];
+    buffer.append(socket->readAll());
+
+    while (buffer.size() >= kFrameHeaderSize) {
+        const auto length = qFromBigEndian<quint32>(buffer.constData());
+        if (length > kMaxMessageSize) {
+            qWarning() << "[INSTANCE MANAGER] INVALID MESSAGE LENGTH:" << length;
+            receive_buffers_.remove(socket);
+            socket->abort();
+            return;
+        }
+        if (static_cast<quint32>(buffer.size() - kFrameHeaderSize) < length) {
+            break;
+        }
+
+        const QByteArray message = buffer.mid(kFrameHeaderSize, static_cast<int>(length));
+        buffer.remove(0, kFrameHeaderSize + static_cast<int>(length));
+        ProcessMessage(message, socket);
     }
 }
 
-void AppInstanceManager::sendPositionUpdate() {
-    const QByteArray message = CreatePositionMessage();
+void AppInstanceManager::synchronizePositions() {
+    if (!position_channel_.IsAttached()) return;
+
+    position_channel_.Publish(own_slot_, CurrentPosition());
+
+    const InstanceInfo *creator = nullptr;
+    for (auto &instance: connected_instances_) {
+        InstancePositionChannel::Position position;
+        quint32 sequence;
+        if (position_channel_.Read(instance.slot, position, sequence) && sequence != instance.sequence) {
+            instance.sequence = sequence;
+            instance.blob_center = position.blob_center;
+            instance.window_position = position.window_position;
+            instance.window_size = position.window_size;
+            emit otherInstancePositionHasChanged(instance.instance_id, instance.blob_center,
+                                                 instance.window_position);
+        }
+        if (instance.is_creator && instance.sequence != 0) {
+            creator = &instance;
+        }
+    }
 
-    if (is_creator_) {
-        SendToAllClients(message);
-    } else if (socket_ && socket_->isOpen()) {
-        socket_->write(message);
+    if (!is_creator_ && creator && !is_being_absorbed_) {
+        UpdateAttraction(*creator);
     }
 }
 
 void AppInstanceManager::SetupServer() {
+    if (position_channel_.Create()) {
+        own_slot_ = InstancePositionChannel::kCreatorSlot;
+    } else {
+        own_slot_ = -1;
+    }
+
     server_ = new QLocalServer(this);
     QLocalServer::removeServer(kServerName);
 
@@ -172,7 +203,7 @@ void AppInstanceManager::ConnectToServer() {
         QByteArray message;
         QDataStream stream(&message, QIODevice::WriteOnly);
         stream << static_cast<quint8>(kIdentify) << instance_id_;
-        socket_->write(message);
+        WriteMessage(socket_, message);
     } else {
         qWarning() << "[INSTANCE MANAGER] CANNOT ESTABLISH CONNECTION" << socket_->errorString();
     }
@@ -184,56 +215,32 @@ bool AppInstanceManager::ProcessMessage(const QByteArray &message, QLocalSocket
     stream >> message_type;
 
     switch (message_type) {
-        case kPositionUpdate: {
+        case kIdentify: {
             QString id;
-            QPointF blob_center;
-            QPoint window_position;
-            QSize window_size;
-
-            stream >> id >> blob_center >> window_position >> window_size;
-
-            QMutexLocker locker(&instances_mutex_);
-            bool found = false;
-            for (auto &instance: connected_instances_) {
-                if (instance.instance_id == id) {
-                    instance.blob_center = blob_center;
-                    instance.window_position = window_position;
-                    instance.window_size = window_size;
-                    found = true;
-                    break;
-                }
+            stream >> id;
+            if (stream.status() != QDataStream::Ok) {
+                qWarning() << "[INSTANCE MANAGER] MALFORMED IDENTIFY MESSAGE";
+                return false;
             }
 
-            if (!found) {
+            if (is_creator_ && sender) {
+                const int slot = AllocateSlot();
+                if (slot < 0) {
+                    qWarning() << "[INSTANCE MANAGER] NO FREE POSITION SLOT FOR" << id;
+                }
+
+                client_ids_[sender] = id;
                 InstanceInfo info;
                 info.instance_id = id;
-                info.blob_center = blob_center;
-                info.window_position = window_position;
-                info.window_size = window_size;
-                info.is_creator = is_creator_ ? false : sender == nullptr;
+                info.is_creator = false;
+                info.slot = slot;
                 connected_instances_.append(info);
 
-                if (sender && is_creator_) {
-                    client_ids_[sender] = id;
-                    emit instanceConnected(id);
-                }
-            }
-
-            emit otherInstancePositionHasChanged(id, blob_center, window_position);
-            return true;
-        }
-
-        case kIdentify: {
-            QString id;
-            stream >> id;
-
-            if (is_creator_ && sender) {
-                client_ids_[sender] = id;
                 QByteArray response;
                 QDataStream response_stream(&response, QIODevice::WriteOnly);
-                response_stream << static_cast<quint8>(kIdentifyResponse) << instance_id_ << true;
-                sender->write(response);
-                sender->write(CreatePositionMessage());
+                response_stream << static_cast<quint8>(kIdentifyResponse) << instance_id_ << true
+                        << static_cast<qint32>(slot);
+                WriteMessage(sender, response);
 
                 emit instanceConnected(id);
             }
@@ -243,15 +250,21 @@ bool AppInstanceManager::ProcessMessage(const QByteArray &message, QLocalSocket
         case kIdentifyResponse: {
             QString id;
             bool is_creator;
-            stream >> id >> is_creator;
-
+            qint32 slot;
+            stream >> id >> is_creator >> slot;
+            if (stream.status() != QDataStream::Ok) {
+                qWarning() << "[INSTANCE MANAGER] MALFORMED IDENTIFY RESPONSE";
+                return false;
+            }
 
             if (!is_creator_) {
+                // the creator has created the segment before it started listening
+                own_slot_ = position_channel_.Attach() ? slot : -1;
+
                 InstanceInfo info;
                 info.instance_id = id;
                 info.is_creator = true;
-
-                QMutexLocker locker(&instances_mutex_);
+                info.slot = InstancePositionChannel::kCreatorSlot;
                 connected_instances_.append(info);
 
                 emit instanceConnected(id);
@@ -265,78 +278,52 @@ bool AppInstanceManager::ProcessMessage(const QByteArray &message, QLocalSocket
     }
 }
 
-void AppInstanceManager::SendToAllClients(const QByteArray &message) {
-    if (!is_creator_) return;
+void AppInstanceManager::WriteMessage(QLocalSocket *socket, const QByteArray &message) {
+    if (!socket || !socket->isOpen()) return;
+
+    QByteArray frame(kFrameHeaderSize, Qt::Uninitialized);
+    qToBigEndian<quint32>(static_cast<quint32>(message.size()), frame.data());
+    frame.append(message);
+    socket->write(frame);
+}
 
-    for (auto it = client_ids_.begin(); it != client_ids_.end(); ++it) {
-        if (QLocalSocket *socket = it.key(); socket && socket->isOpen()) {
-            socket->write(message);
+int AppInstanceManager::AllocateSlot() const {
+    for (int slot = InstancePositionChannel::kCreatorSlot + 1; slot < InstancePositionChannel::kMaxInstances; ++slot) {
+        if (std::ranges::none_of(connected_instances_, [slot](const InstanceInfo &info) {
+            return info.slot == slot;
+        })) {
+            return slot;
         }
     }
+    return -1;
 }
 
-QByteArray AppInstanceManager::CreatePositionMessage() const {
-    QByteArray message;
-    QDataStream stream(&message, QIODevice::WriteOnly);
-
-    const QPointF blobCenter = blob_->GetBlobCenter();
-    const QPoint windowPos = main_window_->pos();
-    const QSize windowSize = main_window_->size();
-
-    stream << static_cast<quint8>(kPositionUpdate) << instance_id_ << blobCenter << windowPos << windowSize;
-
-    return message;
+InstancePositionChannel::Position AppInstanceManager::CurrentPosition() const {
+    InstancePositionChannel::Position position;
+    position.blob_center = blob_->GetBlobCenter();
+    position.window_position = main_window_->pos();
+    position.window_size = main_window_->size();
+    return position;
 }
 
-void AppInstanceManager::InitAttractionThread() {
-    is_thread_running = true;
-    attraction_thread_ = std::make_unique<std::thread>([this] {
-        while (is_thread_running) {
-            constexpr int sleep_time_ms = 16;
-            if (is_being_absorbed_) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(sleep_time_ms));
-                continue;
-            }
+void AppInstanceManager::UpdateAttraction(const InstanceInfo &creator) {
+    const QPointF blob_center = blob_->GetBlobCenter();
+    const QPoint window_position = main_window_->pos();
+    const QPointF global_position(window_position.x() + blob_center.x(),
+                                  window_position.y() + blob_center.y());
 
-            QVector<InstanceInfo> instances_copy; {
-                QMutexLocker locker(&instances_mutex_);
-                instances_copy = connected_instances_;
-            }
+    const QPointF global_creator_position(creator.window_position.x() + creator.blob_center.x(),
+                                          creator.window_position.y() + creator.blob_center.y());
 
-            if (!is_creator_) {
-                for (const auto &instance: instances_copy) {
-                    if (instance.is_creator) {
-                        QPointF blob_center = blob_->GetBlobCenter();
-                        QPoint window_position = main_window_->pos();
-                        QPointF global_position(window_position.x() + blob_center.x(),
-                                                window_position.y() + blob_center.y());
-
-                        QPointF other_blob_center = instance.blob_center;
-                        QPoint other_window_position = instance.window_position;
-                        QPointF global_creator_position(other_window_position.x() + other_blob_center.x(),
-                                                        other_window_position.y() + other_blob_center.y());
-
-                        if (const double distance = QLineF(global_position, global_creator_position).length();
-                            distance < kAbsorptionDistance && !is_being_absorbed_) {
-                            QMetaObject::invokeMethod(this, [this] {
-                                is_being_absorbed_ = true;
-                                main_window_->setWindowFlags(main_window_->windowFlags() | Qt::WindowStaysOnTopHint);
-                                main_window_->show();
-                                StartAbsorptionAnimation();
-                            }, Qt::QueuedConnection);
-                        } else {
-                            QMetaObject::invokeMethod(this, [this, global_creator_position] {
-                                ApplyAttractionForce(global_creator_position);
-                            }, Qt::QueuedConnection);
-                        }
-                        break;
-                    }
-                }
-            }
-
-            std::this_thread::sleep_for(std::chrono::milliseconds(sleep_time_ms));
-        }
-    });
+    if (const double distance = QLineF(global_position, global_creator_position).length();
+        distance < kAbsorptionDistance) {
+        is_being_absorbed_ = true;
+        main_window_->setWindowFlags(main_window_->windowFlags() | Qt::WindowStaysOnTopHint);
+        main_window_->show();
+        StartAbsorptionAnimation();
+    } else {
+        ApplyAttractionForce(global_creator_position);
+    }
 }
 
 void AppInstanceManager::ApplyAttractionForce(const QPointF &target_position) {
@@ -378,13 +365,11 @@ void AppInstanceManager::StartAbsorptionAnimation() {
     position_animation->setDuration(500);
     position_animation->setEasingCurve(QEasingCurve::InOutQuad);
 
-    QPoint target_position; {
-        QMutexLocker locker(&instances_mutex_);
-        for (const auto &instance: connected_instances_) {
-            if (instance.is_creator) {
-                target_position = instance.window_position;
-                break;
-            }
+    QPoint target_position;
+    for (const auto &instance: connected_instances_) {
+        if (instance.is_creator) {
+            target_position = instance.window_position;
+            break;
         }
     }
 
@@ -7,10 +7,10 @@
 #include <QString>
 #include <QLocalSocket>
 #include <QLocalServer>
-#include <QMutex>
 #include <QPropertyAnimation>
 #include <QTimer>
-#include <thread>
+
+#include "instance_position_channel.h"
 
 class BlobAnimation;
 class QMainWindow;
@@ -24,13 +24,17 @@ struct InstanceInfo {
     QPoint window_position; ///< Global position of the instance's window.
     QSize window_size; ///< Size of the instance's window.
     bool is_creator; ///< Flag indicating if this instance is the creator (was opened first).
+    int slot = -1; ///< Slot of the instance in the shared position channel (-1 if it has none).
+    quint32 sequence = 0; ///< Sequence of the last position read from the slot (0 before the first read).
 };
 
 /**
  * @brief Manages communication and interaction between multiple instances of the application.
  *
- * This class handles the detection of existing instances, establishing a local server/client
- * connection and exchanging position data between instances.
+ * This class handles the detection of existing instances and establishing a local server/client
+ * connection. The socket only carries the join/leave control messages (length-prefixed frames); positions
+ * are exchanged through InstancePositionChannel, where every instance publishes into its own slot and
+ * reads the others without locking, on the GUI thread.
  * It also implements an attraction and absorption mechanism where client instances are drawn
  * towards the creator instance and eventually absorbed (closed).
  */
@@ -56,7 +60,7 @@ public:
      *
      * Determines if another instance is running. If so, connect as a client.
      * Otherwise, starts a local server and becomes the creator instance.
-     * Initializes timers and the attraction thread.
+     * Starts the position synchronization timer.
      * @return True if startup was successful, false otherwise (though currently always returns true).
      */
     bool Start();
@@ -93,7 +97,7 @@ signals:
     void instanceDisconnected(QString instance_id);
 
     /**
-     * @brief Emitted when position data from another instance is received.
+     * @brief Emitted when another instance publishes a new position.
      * @param instance_id The ID of the instance whose position changed.
      * @param blob_center The new center position of the blob in the other instance's window.
      * @param window_position The new global position of the other instance's window.
@@ -118,18 +122,18 @@ private slots:
     void readData();
 
     /**
-     * @brief Slot called periodically by position_timer_ to send the current instance's position data.
+     * @brief Slot called periodically by sync_timer_. Publishes the current instance's position, reads the
+     * positions of the other instances and, on a client, applies the attraction towards the creator.
      */
-    void sendPositionUpdate();
+    void synchronizePositions();
 
 private:
     /**
      * @brief Defines the types of messages exchanged between instances.
      */
     enum MessageType : quint8 {
-        kPositionUpdate = 1, ///< Message containing position and size data.
         kIdentify = 5, ///< Message sent by a client to identify itself to the server.
-        kIdentifyResponse = 6, ///< Message sent by the server in response to an Identify message.
+        kIdentifyResponse = 6, ///< Message sent by the server in response to an Identify message (assigns the slot).
     };
 
     /**
@@ -143,29 +147,37 @@ private:
     void ConnectToServer();
 
     /**
-     * @brief Processes an incoming message received from a socket.
-     * @param message The raw byte array containing the message data.
-     * @param sender Pointer to the socket that sent the message (used by the server to identify clients). Null for client processing.
+     * @brief Processes one complete message received from a socket.
+     * @param message The message data, without the length prefix.
+     * @param sender Pointer to the socket that sent the message (used by the server to identify clients).
      * @return True if the message was processed successfully, false otherwise.
      */
-    bool ProcessMessage(const QByteArray &message, QLocalSocket *sender = nullptr);
+    bool ProcessMessage(const QByteArray &message, QLocalSocket *sender);
 
     /**
-     * @brief Sends a message to all connected clients (only applicable for the creator instance).
+     * @brief Writes a message to a socket as one frame: a 32-bit big-endian length followed by the message.
+     * @param socket The socket to write to.
      * @param message The message to send.
      */
-    void SendToAllClients(const QByteArray &message);
+    static void WriteMessage(QLocalSocket *socket, const QByteArray &message);
+
+    /**
+     * @brief Finds a position slot not used by any connected client (only applicable for the creator instance).
+     * @return The slot index, or -1 if all slots are taken.
+     */
+    [[nodiscard]] int AllocateSlot() const;
 
     /**
-     * @brief Creates a QByteArray message containing the current instance's position data.
-     * @return A QByteArray ready to be sent over the socket.
+     * @brief Collects the current instance's position for publishing.
+     * @return The blob center, window position and window size.
      */
-    [[nodiscard]] QByteArray CreatePositionMessage() const;
+    [[nodiscard]] InstancePositionChannel::Position CurrentPosition() const;
 
     /**
-     * @brief Initializes and starts the background thread responsible for attraction logic.
+     * @brief Pulls the client window towards the creator, or starts the absorption once it is close enough.
+     * @param creator The creator instance with its latest position.
      */
-    void InitAttractionThread();
+    void UpdateAttraction(const InstanceInfo &creator);
 
     /**
      * @brief Applies a force to the client window, pulling it towards the target position (creator window).
@@ -188,21 +200,24 @@ private:
     BlobAnimation *blob_; ///< Pointer to the BlobAnimation object.
     QLocalServer *server_ = nullptr; ///< Local server instance (used only by the creator).
     QLocalSocket *socket_ = nullptr; ///< Local socket instance (used only by clients).
-    QTimer position_timer_; ///< Timer to periodically send position updates.
+    QTimer sync_timer_; ///< Timer publishing and reading positions (paced by FrameScheduler).
     QTimer absorption_check_timer_; ///< Timer potentially used for absorption checks (currently seems unused).
-    QMutex instances_mutex_; ///< Mutex to protect access to connected_instances_.
+    InstancePositionChannel position_channel_; ///< Shared memory slots with the positions of all instances.
+    int own_slot_ = -1; ///< Slot this instance publishes its position into (-1 if it has none).
 
     std::atomic<bool> is_creator_{false}; ///< Atomic flag indicating if this instance is the creator.
     QString instance_id_; ///< Unique identifier for this application instance.
 
-    QVector<InstanceInfo> connected_instances_;
-    ///< List of currently known connected instances. Protected by instances_mutex_.
+    QVector<InstanceInfo> connected_instances_; ///< List of currently known connected instances.
     QHash<QLocalSocket *, QString> client_ids_;
     ///< Maps client sockets to their instance IDs (used only by the creator).
-    std::unique_ptr<std::thread> attraction_thread_; ///< Background thread for attraction logic.
-    std::atomic<bool> is_thread_running{false}; ///< Atomic flag to control the attraction thread's loop.
+    QHash<QLocalSocket *, QByteArray> receive_buffers_;
+    ///< Bytes received from each socket that do not form a complete frame yet.
 
-    static constexpr int kUpdateIntervalMs = 50; ///< Interval (in ms) for sending position updates.
+    static constexpr int kSyncIntervalMs = 16; ///< Interval (in ms) of the position synchronization.
+    static constexpr int kIdleSyncIntervalMs = 100; ///< Synchronization interval while the application is idle.
+    static constexpr int kFrameHeaderSize = sizeof(quint32); ///< Size of the length prefix of a message.
+    static constexpr quint32 kMaxMessageSize = 64 * 1024; ///< Larger frames are treated as a corrupted stream.
     static const QString kServerName; ///< Name used for the local server discovery.
 
     static constexpr double kAttractionForce = 0.5;
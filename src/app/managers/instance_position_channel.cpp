@@ -0,0 +1,139 @@
+#include "instance_position_channel.h"
+
+#include <new>
+#include <QDebug>
+
+InstancePositionChannel::InstancePositionChannel(const QString &key) : memory_(key) {
+}
+
+InstancePositionChannel::~InstancePositionChannel() {
+    Detach();
+}
+
+bool InstancePositionChannel::Create() {
+    Detach();
+
+    if (!memory_.create(sizeof(Segment))) {
+        // a segment left behind by a crashed creator is reused
+        if (memory_.error() != QSharedMemory::AlreadyExists || !memory_.attach()) {
+            qWarning() << "[POSITION CHANNEL] CANNOT CREATE SHARED MEMORY:" << memory_.errorString();
+            return false;
+        }
+    }
+    if (memory_.size() < static_cast<int>(sizeof(Segment))) {
+        qWarning() << "[POSITION CHANNEL] SHARED MEMORY HAS AN UNEXPECTED SIZE:" << memory_.size();
+        memory_.detach();
+        return false;
+    }
+
+    memory_.lock();
+    InitializeSegment();
+    memory_.unlock();
+    return true;
+}
+
+bool InstancePositionChannel::Attach() {
+    Detach();
+
+    if (!memory_.attach()) {
+        qWarning() << "[POSITION CHANNEL] CANNOT ATTACH TO SHARED MEMORY:" << memory_.errorString();
+        return false;
+    }
+
+    const auto segment = static_cast<Segment *>(memory_.data());
+    if (memory_.size() < static_cast<int>(sizeof(Segment))
+        || segment->magic.load(std::memory_order_acquire) != kSegmentMagic) {
+        qWarning() << "[POSITION CHANNEL] SHARED MEMORY HAS AN INCOMPATIBLE LAYOUT";
+        memory_.detach();
+        return false;
+    }
+
+    segment_ = segment;
+    return true;
+}
+
+void InstancePositionChannel::Detach() {
+    segment_ = nullptr;
+    if (memory_.isAttached()) {
+        memory_.detach();
+    }
+}
+
+void InstancePositionChannel::Publish(const int slot, const Position &position) const {
+    if (!segment_ || slot < 0 || slot >= kMaxInstances) return;
+
+    Slot &target = segment_->slots[slot];
+    const quint32 sequence = target.sequence.load(std::memory_order_relaxed);
+    target.sequence.store(sequence + 1, std::memory_order_relaxed);
+    // the odd sequence must be visible before any of the new fields
+    std::atomic_thread_fence(std::memory_order_release);
+
+    target.blob_center_x.store(position.blob_center.x(), std::memory_order_relaxed);
+    target.blob_center_y.store(position.blob_center.y(), std::memory_order_relaxed);
+    target.window_x.store(position.window_position.x(), std::memory_order_relaxed);
+    target.window_y.store(position.window_position.y(), std::memory_order_relaxed);
+    target.window_width.store(position.window_size.width(), std::memory_order_relaxed);
+    target.window_height.store(position.window_size.height(), std::memory_order_relaxed);
+    target.active.store(1, std::memory_order_relaxed);
+
+    target.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void InstancePositionChannel::ClearSlot(const int slot) const {
+    if (!segment_ || slot < 0 || slot >= kMaxInstances) return;
+
+    Slot &target = segment_->slots[slot];
+    const quint32 sequence = target.sequence.load(std::memory_order_relaxed);
+    target.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    target.active.store(0, std::memory_order_relaxed);
+    target.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool InstancePositionChannel::Read(const int slot, Position &position, quint32 &sequence) const {
+    if (!segment_ || slot < 0 || slot >= kMaxInstances) return false;
+
+    // a writer holds the slot only for a few stores; the bound protects against one that died mid-write
+    constexpr int kMaxReadAttempts = 64;
+
+    const Slot &source = segment_->slots[slot];
+    for (int attempt = 0; attempt < kMaxReadAttempts; ++attempt) {
+        const quint32 begin = source.sequence.load(std::memory_order_acquire);
+        if (begin & 1u) {
+            continue;
+        }
+
+        const bool active = source.active.load(std::memory_order_relaxed) != 0;
+        const double blob_center_x = source.blob_center_x.load(std::memory_order_relaxed);
+        const double blob_center_y = source.blob_center_y.load(std::memory_order_relaxed);
+        const qint32 window_x = source.window_x.load(std::memory_order_relaxed);
+        const qint32 window_y = source.window_y.load(std::memory_order_relaxed);
+        const qint32 window_width = source.window_width.load(std::memory_order_relaxed);
+        const qint32 window_height = source.window_height.load(std::memory_order_relaxed);
+
+        // the copied fields must be read before the sequence is checked again
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (source.sequence.load(std::memory_order_relaxed) != begin) {
+            continue;
+        }
+
+        if (!active) {
+            return false;
+        }
+        position.blob_center = QPointF(blob_center_x, blob_center_y);
+        position.window_position = QPoint(window_x, window_y);
+        position.window_size = QSize(window_width, window_height);
+        sequence = begin;
+        return true;
+    }
+    return false;
+}
+
+void InstancePositionChannel::InitializeSegment() {
+    segment_ = new(memory_.data()) Segment();
+    for (Slot &slot: segment_->slots) {
+        slot.sequence.store(0, std::memory_order_relaxed);
+        slot.active.store(0, std::memory_order_relaxed);
+    }
+    segment_->magic.store(kSegmentMagic, std::memory_order_release);
+}
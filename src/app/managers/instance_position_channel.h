@@ -0,0 +1,138 @@
+#ifndef INSTANCE_POSITION_CHANNEL_H
+#define INSTANCE_POSITION_CHANNEL_H
+
+#include <atomic>
+#include <QPoint>
+#include <QPointF>
+#include <QSharedMemory>
+#include <QSize>
+
+/**
+ * @brief Shared memory segment through which application instances exchange their blob positions.
+ *
+ * The segment holds one fixed slot per instance. Every slot is guarded by a seqlock: the owner makes
+ * the sequence odd, writes the position and makes it even again, so a writer never waits for anyone.
+ * Readers copy the slot and retry if the sequence was odd or changed meanwhile, so they never lock either.
+ * Slots are assigned by the creator instance over the control socket (the creator always owns slot 0).
+ *
+ * All slot fields are lock-free (hence address-free) atomics, which makes them safe to share between processes.
+ */
+class InstancePositionChannel {
+public:
+    /** @brief Number of slots in the segment, i.e., the maximum number of instances exchanging positions. */
+    static constexpr int kMaxInstances = 16;
+    /** @brief Slot of the creator instance. */
+    static constexpr int kCreatorSlot = 0;
+
+    /**
+     * @brief Position of one instance as published in its slot.
+     */
+    struct Position {
+        QPointF blob_center; ///< Center position of the blob within its window.
+        QPoint window_position; ///< Global position of the instance's window.
+        QSize window_size; ///< Size of the instance's window.
+    };
+
+    /**
+     * @brief Constructs a channel that is not yet attached to any segment.
+     * @param key The key of the shared memory segment.
+     */
+    explicit InstancePositionChannel(const QString &key);
+
+    /**
+     * @brief Destructor. Detaches from the segment (the system removes it with its last user).
+     */
+    ~InstancePositionChannel();
+
+    /**
+     * @brief Creates the segment and clears all slots (used by the creator instance).
+     * A segment left behind by a crashed creator is attached to and cleared instead.
+     * @return True if the channel is usable.
+     */
+    bool Create();
+
+    /**
+     * @brief Attaches to the segment created by the creator instance.
+     * @return True if the channel is usable.
+     */
+    bool Attach();
+
+    /**
+     * @brief Detaches from the segment.
+     */
+    void Detach();
+
+    /**
+     * @brief Checks whether the channel is attached to a valid segment.
+     * @return True if positions can be published and read.
+     */
+    [[nodiscard]] bool IsAttached() const { return segment_ != nullptr; }
+
+    /**
+     * @brief Publishes a position in a slot. Only the slot's owner may call it.
+     * @param slot The slot index.
+     * @param position The position to publish.
+     */
+    void Publish(int slot, const Position &position) const;
+
+    /**
+     * @brief Marks a slot as unused (called by the creator when an instance leaves).
+     * @param slot The slot index.
+     */
+    void ClearSlot(int slot) const;
+
+    /**
+     * @brief Reads the latest position of a slot without locking.
+     * @param slot The slot index.
+     * @param position Receives the position.
+     * @param sequence Receives the seqlock sequence of the copy; it changes with every publication.
+     * @return True if the slot holds a published position.
+     */
+    bool Read(int slot, Position &position, quint32 &sequence) const;
+
+private:
+    /**
+     * @brief One seqlock guarded slot, aligned to a cache line so that writers of neighbouring slots
+     * do not invalidate each other's lines.
+     */
+    struct alignas(64) Slot {
+        /** @brief Seqlock sequence; odd while the owner is writing. */
+        std::atomic<quint32> sequence;
+        /** @brief Whether the slot holds a published position. */
+        std::atomic<quint32> active;
+        std::atomic<double> blob_center_x;
+        std::atomic<double> blob_center_y;
+        std::atomic<qint32> window_x;
+        std::atomic<qint32> window_y;
+        std::atomic<qint32> window_width;
+        std::atomic<qint32> window_height;
+    };
+
+    /**
+     * @brief Layout of the shared memory segment.
+     */
+    struct Segment {
+        /** @brief Layout identifier, guards against segments of incompatible builds. */
+        std::atomic<quint32> magic;
+        Slot slots[kMaxInstances];
+    };
+
+    static_assert(std::atomic<quint32>::is_always_lock_free && std::atomic<qint32>::is_always_lock_free &&
+                  std::atomic<double>::is_always_lock_free,
+                  "The position slots require lock-free atomics to be shared between processes");
+
+    /** @brief Value of Segment::magic of this layout. */
+    static constexpr quint32 kSegmentMagic = 0x424c4f42u + sizeof(Segment);
+
+    /**
+     * @brief Resets all slots to unused. The segment must be locked.
+     */
+    void InitializeSegment();
+
+    /** @brief The shared memory segment. */
+    QSharedMemory memory_;
+    /** @brief The attached segment, or null. */
+    Segment *segment_ = nullptr;
+};
+
+#endif // INSTANCE_POSITION_CHANNEL_H
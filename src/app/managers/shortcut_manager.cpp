@@ -10,6 +10,8 @@
 #include "../../ui/views/settings_view.h"
 #include "../../ui/views/chat_view.h"
 #include "../../ui/buttons/navbar_button.h"
+#include "../../ui/widgets/performance_overlay.h"
+#include "../../util/profiling/trace_profiler.h"
 
 class QPushButton;
 class QLineEdit;
@@ -91,6 +93,14 @@ void ShortcutManager::RegisterMainWindowShortcuts(QMainWindow *window, Navbar *n
     CreateAndConnectShortcut("MainWindow.OpenSettings", window, [navbar] {
         if (navbar) emit navbar->settingsClicked();
     });
+
+    CreateAndConnectShortcut("Debug.TogglePerformanceOverlay", window, [window] {
+        PerformanceOverlay::Toggle(window);
+    });
+
+    CreateAndConnectShortcut("Debug.ToggleTracing", window, [] {
+        TraceProfiler::ToggleRecording();
+    });
 }
 
 void ShortcutManager::RegisterChatViewShortcuts(ChatView *chat_view) {
@@ -10,15 +10,18 @@ bool TranslationManager::Initialize(const QString &language_code) {
     }
 
     qInfo() << "[TRANSLATION MANAGER] Initializing with language:" << language_code;
-    initialized_ = LoadTranslations(language_code);
-    if (!initialized_) {
-        qCritical() << "[TRANSLATION MANAGER] Failed to load translations for" << language_code <<
+    if (QFile::exists(TranslationFilePath(language_code))) {
+        current_language_code_ = language_code;
+    } else {
+        qCritical() << "[TRANSLATION MANAGER] Translation file not found for" << language_code <<
                 ". Falling back to English.";
-        initialized_ = LoadTranslations("en");
-        if (!initialized_) {
-            qCritical() <<
-                    "[TRANSLATION MANAGER] Failed to load English translations as fallback. Translation system unavailable.";
-        }
+        current_language_code_ = "en";
+    }
+
+    initialized_ = QFile::exists(TranslationFilePath(current_language_code_));
+    if (!initialized_) {
+        qCritical() <<
+                "[TRANSLATION MANAGER] English translation file not found. Translation system unavailable.";
     }
     return initialized_;
 }
@@ -32,7 +35,7 @@ TranslationManager *TranslationManager::GetInstance() {
 }
 
 QString TranslationManager::Translate(const QString &key, const QString &default_value) const {
-    if (!initialized_ || translations_.isEmpty()) {
+    if (!initialized_ || !EnsureTranslationsLoaded() || translations_.isEmpty()) {
         qWarning() << "[TRANSLATION MANAGER] Not initialized or no translations loaded. Key:" << key;
         return default_value.isEmpty() ? key : default_value;
     }
@@ -70,8 +73,39 @@ QString TranslationManager::GetCurrentLanguage() const {
     return current_language_code_;
 }
 
-bool TranslationManager::LoadTranslations(const QString &language_code) {
-    const QString file_path = QString(":/translations/%1.json").arg(language_code);
+bool TranslationManager::EnsureTranslationsLoaded() const {
+    // translations_ is written once, before load_attempted_ is set, so Translate() calls after the first one
+    // read it without taking the lock
+    if (load_attempted_.load(std::memory_order_acquire)) {
+        return !translations_.isEmpty();
+    }
+
+    QMutexLocker locker(&load_mutex_);
+    if (load_attempted_.load(std::memory_order_relaxed)) {
+        return !translations_.isEmpty();
+    }
+
+    bool loaded = LoadTranslations(current_language_code_);
+    if (!loaded && current_language_code_ != "en") {
+        qCritical() << "[TRANSLATION MANAGER] Failed to load translations for" << current_language_code_ <<
+                ". Falling back to English.";
+        loaded = LoadTranslations("en");
+    }
+    if (!loaded) {
+        qCritical() <<
+                "[TRANSLATION MANAGER] Failed to load English translations as fallback. Translation system unavailable.";
+    }
+
+    load_attempted_.store(true, std::memory_order_release);
+    return loaded;
+}
+
+QString TranslationManager::TranslationFilePath(const QString &language_code) {
+    return QString(":/translations/%1.json").arg(language_code);
+}
+
+bool TranslationManager::LoadTranslations(const QString &language_code) const {
+    const QString file_path = TranslationFilePath(language_code);
     QFile file(file_path);
 
     if (!file.exists()) {
@@ -1,6 +1,7 @@
 #ifndef TRANSLATION_MANAGER_H
 #define TRANSLATION_MANAGER_H
 
+#include <atomic>
 #include <QJsonObject>
 #include <QMutex>
 #include <QObject>
@@ -17,9 +18,11 @@ class TranslationManager final : public QObject {
 
 public:
     /**
-     * @brief Initializes the translation manager by loading the appropriate language file.
+     * @brief Initializes the translation manager by selecting the appropriate language file.
+     * The file itself is parsed lazily on the first call to Translate(), so startup only pays
+     * for a file existence check here.
      * @param language_code Language code (e.g., "en", "pl").
-     * @return True if the initialization and loading of translations was successful, false otherwise.
+     * @return True if a translation file for the language (or the English fallback) exists, false otherwise.
      */
     bool Initialize(const QString &language_code);
 
@@ -66,18 +69,39 @@ private:
      * @param language_code Language code to be loaded.
      * @return True if loading is successful, false otherwise.
      */
-    bool LoadTranslations(const QString &language_code);
+    bool LoadTranslations(const QString &language_code) const;
+
+    /**
+     * @brief Parses the selected translation file on first use.
+     * Falls back to English if the selected language cannot be parsed.
+     * @return True if translations are available, false otherwise.
+     */
+    bool EnsureTranslationsLoaded() const;
+
+    /**
+     * @brief Builds the resource path of the translation file for the given language code.
+     * @param language_code Language code.
+     * @return The resource path of the JSON file.
+     */
+    static QString TranslationFilePath(const QString &language_code);
 
     /** @brief Static singleton instance. */
     static TranslationManager *instance_;
     /** @brief Mutex to protect instance creation in a multithreaded environment. */
     static QMutex mutex_;
-    /** @brief It stores the loaded translations as a JSON object. */
-    QJsonObject translations_;
-    /** @brief Currently loaded language code. */
-    QString current_language_code_;
+    /** @brief Mutex serializing the first loading of translations_. */
+    mutable QMutex load_mutex_;
+    /** @brief It stores the loaded translations as a JSON object. Populated lazily by EnsureTranslationsLoaded(). */
+    mutable QJsonObject translations_;
+    /** @brief Currently selected language code. */
+    mutable QString current_language_code_;
     /** @brief A flag indicating whether the manager has been initialized. */
     bool initialized_ = false;
+    /**
+     * @brief A flag indicating whether loading translations has already been attempted.
+     * Set with release order after translations_ is written, so it is the lock-free fast path of Translate().
+     */
+    mutable std::atomic<bool> load_attempted_ = false;
 };
 
 #endif // TRANSLATION_MANAGER_H
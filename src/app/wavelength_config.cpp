@@ -63,6 +63,9 @@ void WavelengthConfig::LoadDefaultShortcuts() {
     default_shortcuts_["SettingsView.Save"] = QKeySequence("Ctrl+S");
     default_shortcuts_["SettingsView.Defaults"] = QKeySequence("Ctrl+D");
     default_shortcuts_["SettingsView.Back"] = QKeySequence(Qt::Key_Escape);
+    // hidden debug actions, not listed in the shortcuts tab
+    default_shortcuts_["Debug.TogglePerformanceOverlay"] = QKeySequence("Ctrl+Shift+F12");
+    default_shortcuts_["Debug.ToggleTracing"] = QKeySequence("Ctrl+Shift+F11");
 }
 
 void WavelengthConfig::LoadSettings() {
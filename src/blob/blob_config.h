@@ -39,6 +39,8 @@ namespace BlobConfig {
         QColor grid_color;
         /** @brief The spacing between grid lines in pixels. */
         int grid_spacing;
+        /** @brief Number of curve samples per control point span when the OpenGL path evaluates the outline spline. */
+        int spline_subdivisions = 8;
         /** @brief The current width of the screen/widget area (used for border collisions, etc.). */
         int screen_width = 0;
         /** @brief The current height of the screen/widget area (used for border collisions, etc.). */
@@ -1,15 +1,37 @@
 #include "blob_animation.h"
 
+#include <algorithm>
+#include <chrono>
 #include <QDateTime>
-#include <QOpenGLShaderProgram>
-#include <QPainter>
-#include <QPaintEvent>
+#include <QResizeEvent>
 #include <QRandomGenerator>
 
 #include "../../app/wavelength_config.h"
-#include "../states/idle_state.h"
-#include "../states/moving_state.h"
-#include "../states/resizing_state.h"
+#include "../../util/frame_scheduler.h"
+#include "../../util/profiling/trace_profiler.h"
+
+namespace {
+    /** @brief Simulated time of one physics step. */
+    constexpr std::chrono::nanoseconds kPhysicsStepInterval(BlobSimulation::kStepDurationNs);
+    /**
+     * @brief Most steps the physics thread runs to catch up in one go. After a longer stall (debugger,
+     * suspended process) the rest of the backlog is dropped instead of freezing the thread in catch-up.
+     */
+    constexpr int kMaxCatchUpSteps = 5;
+    /**
+     * @brief Steps simulated per wake-up while the application is idle (~30 Hz publishing instead of 120 Hz).
+     * The simulation keeps its fixed step, so the motion stays identical; only the batching changes.
+     */
+    constexpr int kIdleStepsPerWake = 4;
+
+    /**
+     * @brief Current steady clock time in nanoseconds, the time base of the render snapshots.
+     */
+    qint64 SteadyNowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
 
 BlobAnimation::BlobAnimation(QWidget *parent)
     : QOpenGLWidget(parent),
@@ -24,27 +46,34 @@ BlobAnimation::BlobAnimation(QWidget *parent)
 
     params_.blob_radius = 250.0f;
     params_.num_of_points = 32;
+    Q_ASSERT(params_.num_of_points <= BlobRenderer::kMaxControlPoints);
     params_.glow_radius = 10;
     params_.border_width = 3;
 
     idle_params_.wave_amplitude = 2.0;
     idle_params_.wave_frequency = 2.0;
 
-    idle_state_ = std::make_unique<IdleState>();
-    moving_state_ = std::make_unique<MovingState>();
-    resizing_state_ = std::make_unique<ResizingState>();
-    current_blob_state_ = idle_state_.get();
-
-    control_points_.reserve(params_.num_of_points);
-    target_points_.reserve(params_.num_of_points);
-    velocity_.reserve(params_.num_of_points);
+    simulation_ = std::make_unique<BlobSimulation>(params_, physics_params_);
 
     setAttribute(Qt::WA_OpaquePaintEvent, false);
     setAttribute(Qt::WA_TranslucentBackground);
     setAttribute(Qt::WA_NoSystemBackground, true);
 
+    BlobInputEvent viewport;
+    viewport.type = BlobInputEvent::Type::kViewportSize;
+    viewport.new_size = size();
+    simulation_->QueueInput(std::move(viewport));
     InitializeBlob();
+    {
+        // the physics thread (the only other writer) is not running yet
+        std::lock_guard lock(points_mutex_);
+        simulation_->ApplyPendingInputs();
+        CaptureRenderSnapshot(SteadyNowNs());
+    }
+    render_snapshots_.Publish();
 
+    frame_channel_ = PerformanceMonitor::GetInstance()->RegisterChannel("Blob frame");
+    physics_channel_ = PerformanceMonitor::GetInstance()->RegisterChannel("Blob physics step", 1000.0 / 120.0);
     physics_thread_ = std::thread(&BlobAnimation::PhysicsThreadFunction, this);
 
     QSurfaceFormat format;
@@ -63,15 +92,21 @@ BlobAnimation::BlobAnimation(QWidget *parent)
         last_window_position_timer_ = last_window_position_;
     }
 
+    // both timers only track window movement, which is user activity: they stop while the application is idle
+    FrameScheduler *scheduler = FrameScheduler::GetInstance();
     animation_timer_.setTimerType(Qt::PreciseTimer);
-    animation_timer_.setInterval(16); // ~60 FPS
     connect(&animation_timer_, &QTimer::timeout, this, &BlobAnimation::updateAnimation);
-    animation_timer_.start();
+    scheduler->RegisterTimer(&animation_timer_, 16, 0); // ~60 FPS
 
-    window_position_timer_.setInterval(16);
     window_position_timer_.setTimerType(Qt::PreciseTimer);
     connect(&window_position_timer_, &QTimer::timeout, this, &BlobAnimation::CheckWindowPosition);
-    window_position_timer_.start();
+    scheduler->RegisterTimer(&window_position_timer_, 16, 0);
+
+    connect(scheduler, &FrameScheduler::idleChanged, this, [this](const bool idle) {
+        if (!idle) {
+            WakePhysicsThread();
+        }
+    });
 
     connect(&state_reset_timer_, &QTimer::timeout, this, &BlobAnimation::onStateResetTimeout);
 
@@ -90,12 +125,11 @@ BlobAnimation::BlobAnimation(QWidget *parent)
     });
     connect(&event_handler_, &BlobEventHandler::significantResizeDetected, this,
             [this](const QSize &oldSize, const QSize &newSize) {
-                resizing_state_->HandleResize(control_points_, target_points_, velocity_,
-                                              blob_center_, oldSize, newSize);
-                if (abs(newSize.width() - last_size_.width()) > 20 ||
-                    abs(newSize.height() - last_size_.height()) > 20) {
-                    renderer_.ResetGridBuffer();
-                }
+                BlobInputEvent resize;
+                resize.type = BlobInputEvent::Type::kResize;
+                resize.old_size = oldSize;
+                resize.new_size = newSize;
+                QueueSimulationInput(std::move(resize));
                 last_size_ = newSize;
             });
 
@@ -130,7 +164,6 @@ BlobAnimation::BlobAnimation(QWidget *parent)
 
 void BlobAnimation::HandleResizeTimeout() {
     ResetBlobToCenter();
-    renderer_.ResetGridBuffer();
     last_size_ = size();
     update();
 }
@@ -161,152 +194,135 @@ void BlobAnimation::CheckWindowPosition() {
 }
 
 void BlobAnimation::PhysicsThreadFunction() {
+    TRACE_THREAD_NAME("Blob Physics");
+    const FrameScheduler *scheduler = FrameScheduler::GetInstance();
+    auto previous_time = std::chrono::steady_clock::now();
+    std::chrono::nanoseconds accumulator(0);
+    bool is_settled = false;
+
     while (physics_active_) {
-        auto start_time = std::chrono::high_resolution_clock::now(); {
-            std::lock_guard lock(points_mutex_);
-            updatePhysics();
+        if (is_settled || physics_paused_) {
+            // nothing visible changes until the next input (or until the widget is shown again)
+            {
+                std::unique_lock lock(physics_wait_mutex_);
+                physics_condition_.wait(lock, [this] { return physics_wake_requested_ || !physics_active_; });
+                physics_wake_requested_ = false;
+            }
+            previous_time = std::chrono::steady_clock::now();
+            // step right away, so the input shows up without waiting for a whole interval
+            accumulator = kPhysicsStepInterval;
+            is_settled = false;
+            continue;
         }
 
-        QMetaObject::invokeMethod(this, "update", Qt::QueuedConnection);
+        const auto start_time = std::chrono::steady_clock::now();
+        accumulator = std::min(accumulator + std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   start_time - previous_time), kPhysicsStepInterval * kMaxCatchUpSteps);
+        previous_time = start_time;
+
+        if (accumulator >= kPhysicsStepInterval) {
+            {
+                std::lock_guard lock(points_mutex_);
+                while (accumulator >= kPhysicsStepInterval) {
+                    simulation_->Step();
+                    accumulator -= kPhysicsStepInterval;
+                }
+                is_settled = simulation_->IsSettled();
+                // the simulation is behind the wall clock by the time not yet simulated
+                CaptureRenderSnapshot(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    start_time.time_since_epoch() - accumulator).count());
+            }
+            render_snapshots_.Publish();
 
-        auto end_time = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+            QMetaObject::invokeMethod(this, "update", Qt::QueuedConnection);
 
-        if (auto target_frame_time = std::chrono::microseconds(8333); duration < target_frame_time) {
-            std::unique_lock lock(points_mutex_);
-            physics_condition_.wait_for(lock, target_frame_time - duration);
+            PerformanceMonitor::GetInstance()->RecordDuration(
+                physics_channel_, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start_time).count());
         }
+
+        const int steps_per_wake = scheduler->IsIdle() ? kIdleStepsPerWake : 1;
+        std::unique_lock lock(physics_wait_mutex_);
+        physics_condition_.wait_for(lock, kPhysicsStepInterval * steps_per_wake - accumulator, [this] {
+            return physics_wake_requested_ || !physics_active_;
+        });
+        physics_wake_requested_ = false;
+    }
+}
+
+void BlobAnimation::QueueSimulationInput(BlobInputEvent event) {
+    simulation_->QueueInput(std::move(event));
+    WakePhysicsThread();
+}
+
+void BlobAnimation::WakePhysicsThread() {
+    {
+        std::lock_guard lock(physics_wait_mutex_);
+        physics_wake_requested_ = true;
     }
+    physics_condition_.notify_one();
+}
+
+void BlobAnimation::CaptureRenderSnapshot(const qint64 time_ns) {
+    const BlobSimulationState &state = simulation_->GetState();
+    render_snapshots_.GetWriteBuffer().Capture(render_snapshots_.GetLastPublished(), state.points, state.blob_center,
+                                               time_ns);
+}
+
+void BlobAnimation::UpdateRenderState() {
+    render_snapshots_.Update();
+
+    // drawing one publish interval behind the simulation keeps the frame time between the two published states
+    const int steps_per_publish = FrameScheduler::GetInstance()->IsIdle() ? kIdleStepsPerWake : 1;
+    const qint64 render_time_ns = SteadyNowNs() - kPhysicsStepInterval.count() * steps_per_publish;
+    render_snapshots_.GetReadBuffer().Interpolate(render_time_ns, render_points_, render_center_);
 }
 
 BlobAnimation::~BlobAnimation() {
-    physics_active_ = false;
+    {
+        std::lock_guard lock(physics_wait_mutex_);
+        physics_active_ = false;
+    }
     physics_condition_.notify_all();
     if (physics_thread_.joinable()) {
         physics_thread_.join();
     }
+    PerformanceMonitor::GetInstance()->ReleaseChannel(physics_channel_);
+    PerformanceMonitor::GetInstance()->ReleaseChannel(frame_channel_);
 
     makeCurrent();
-    vbo_.destroy();
-    vao_.destroy();
-    delete shader_program_;
+    renderer_.ReleaseGL();
     doneCurrent();
 
     animation_timer_.stop();
     state_reset_timer_.stop();
-
-    idle_state_.reset();
-    moving_state_.reset();
-    resizing_state_.reset();
 }
 
 void BlobAnimation::InitializeBlob() {
-    std::lock_guard lock(points_mutex_);
-    control_points_.clear();
-    target_points_.clear();
-    velocity_.clear();
-
-    blob_center_ = QPointF(width() / 2.0, height() / 2.0);
-    control_points_ = GenerateOrganicShape(blob_center_, params_.blob_radius, params_.num_of_points);
-    target_points_ = control_points_;
-    velocity_.resize(params_.num_of_points, QPointF(0, 0));
-
-    precalc_min_distance_ = params_.blob_radius * physics_params_.min_neighbor_distance;
-    precalc_max_distance_ = params_.blob_radius * physics_params_.max_neighbor_distance;
-}
-
-void BlobAnimation::paintEvent(QPaintEvent *event) {
-    std::lock_guard lock(points_mutex_);
-
-    if (const QRectF blob_rect = CalculateBlobBoundingRect(); !event->rect().intersects(blob_rect.toRect())) {
-        return;
-    }
-
-    static QPixmap background_cache;
-    static QSize last_background_size;
-    static QColor last_background_color;
-    static QColor last_grid_color;
-    static int last_grid_spacing;
-
-    QPainter painter(this);
-
-    BlobRenderState blob_render_state;
-    blob_render_state.animation_state = current_state_;
-
-    renderer_.RenderScene(
-        painter,
-        control_points_,
-        blob_center_,
-        params_,
-        blob_render_state,
-        width(),
-        height(),
-        background_cache,
-        last_background_size,
-        last_background_color,
-        last_grid_color,
-        last_grid_spacing
-    );
+    BlobInputEvent reset;
+    reset.type = BlobInputEvent::Type::kShapeReset;
+    reset.center = QPointF(width() / 2.0, height() / 2.0);
+    reset.shape = GenerateOrganicShape(reset.center, params_.blob_radius, params_.num_of_points);
+    QueueSimulationInput(std::move(reset));
 }
 
-QRectF BlobAnimation::CalculateBlobBoundingRect() {
-    if (control_points_.empty()) {
-        return {0, 0, static_cast<qreal>(width()), static_cast<qreal>(height())};
-    }
-
-    auto x_comp = [](const QPointF &a, const QPointF &b) { return a.x() < b.x(); };
-    auto y_comp = [](const QPointF &a, const QPointF &b) { return a.y() < b.y(); };
-
-    auto [minXIt, maxXIt] = std::minmax_element(control_points_.begin(), control_points_.end(), x_comp);
-    auto [minYIt, maxYIt] = std::minmax_element(control_points_.begin(), control_points_.end(), y_comp);
-
-    const qreal min_x = minXIt->x();
-    const qreal max_x = maxXIt->x();
-    const qreal min_y = minYIt->y();
-    const qreal max_y = maxYIt->y();
-
-    const int margin = params_.border_width + params_.glow_radius + 5;
-    return {
-        min_x - margin, min_y - margin,
-        max_x - min_x + 2 * margin, max_y - min_y + 2 * margin
-    };
-}
-
-
 void BlobAnimation::updateAnimation() {
-    needs_redraw_ = false; {
-        std::lock_guard lock(points_mutex_);
-
-        processMovementBuffer();
+    needs_redraw_ = current_state_ == BlobConfig::kMoving || current_state_ == BlobConfig::kResizing;
 
-        if (current_state_ == BlobConfig::kIdle) {
-            if (current_blob_state_) {
-                current_blob_state_->Apply(control_points_, velocity_, blob_center_, params_);
-            }
-        } else if (current_state_ == BlobConfig::kMoving || current_state_ == BlobConfig::kResizing) {
-            if (current_blob_state_) {
-                current_blob_state_->Apply(control_points_, velocity_, blob_center_, params_);
-                needs_redraw_ = true;
-            }
-        }
-    }
+    processMovementBuffer();
 
     if (needs_redraw_) {
         update();
-        params_.screen_width = width();
-        params_.screen_height = height();
     }
 }
 
 void BlobAnimation::processMovementBuffer() {
     transition_manager_.ProcessMovementBuffer(
-        velocity_,
-        blob_center_,
-        control_points_,
-        params_.blob_radius,
-        [this](std::vector<QPointF> &vel, QPointF &center, const std::vector<QPointF> &points, const float radius,
-               const QVector2D force) {
-            MovingState::ApplyInertiaForce(vel, center, points, radius, force);
+        [this](const QVector2D &force) {
+            BlobInputEvent move;
+            move.type = BlobInputEvent::Type::kWindowMove;
+            move.force = force;
+            QueueSimulationInput(std::move(move));
         },
         [this](const QPointF &pos) {
             physics_.SetLastWindowPos(pos);
@@ -314,23 +330,12 @@ void BlobAnimation::processMovementBuffer() {
     );
 }
 
-void BlobAnimation::updatePhysics() {
-    physics_.UpdatePhysicsParallel(control_points_, target_points_, velocity_,
-                                   blob_center_, params_, physics_params_);
-
-    const int padding = params_.border_width + params_.glow_radius;
-    BlobPhysics::HandleBorderCollisions(control_points_, velocity_, blob_center_,
-                                        width(), height(), physics_params_.restitution, padding);
-
-    BlobPhysics::SmoothBlobShape(control_points_);
-
-    const double min_distance = params_.blob_radius * physics_params_.min_neighbor_distance;
-    const double max_distance = params_.blob_radius * physics_params_.max_neighbor_distance;
-    BlobPhysics::ConstrainNeighborDistances(control_points_, velocity_, min_distance, max_distance);
-}
-
-
 void BlobAnimation::resizeEvent(QResizeEvent *event) {
+    BlobInputEvent viewport;
+    viewport.type = BlobInputEvent::Type::kViewportSize;
+    viewport.new_size = event->size();
+    QueueSimulationInput(std::move(viewport));
+
     if (event_handler_.ProcessResizeEvent(event)) {
         update();
     }
@@ -360,54 +365,30 @@ void BlobAnimation::SwitchToState(const BlobConfig::AnimationState new_state) {
         return;
     }
 
-    if (new_state == BlobConfig::kIdle &&
-        (current_state_ == BlobConfig::kMoving || current_state_ == BlobConfig::kResizing)) {
-        current_state_ = BlobConfig::kIdle;
-        current_blob_state_ = idle_state_.get();
-
-        dynamic_cast<IdleState *>(current_blob_state_)->ResetInitialization();
-
-        for (auto &vel: velocity_) {
-            vel *= 0.5;
-        }
-
-        return;
-    }
-
     current_state_ = new_state;
 
-    switch (current_state_) {
-        case BlobConfig::kIdle:
-            current_blob_state_ = idle_state_.get();
-            dynamic_cast<IdleState *>(current_blob_state_)->ResetInitialization();
-            break;
-        case BlobConfig::kMoving:
-            current_blob_state_ = moving_state_.get();
-            state_reset_timer_.stop();
-            state_reset_timer_.start(2000);
-            break;
-        case BlobConfig::kResizing:
-            current_blob_state_ = resizing_state_.get();
-            state_reset_timer_.stop();
-            state_reset_timer_.start(2000);
-            break;
+    if (current_state_ == BlobConfig::kMoving || current_state_ == BlobConfig::kResizing) {
+        state_reset_timer_.stop();
+        state_reset_timer_.start(2000);
     }
-}
 
-void BlobAnimation::ApplyForces(const QVector2D &force) {
-    current_blob_state_->ApplyForce(force, velocity_, blob_center_,
-                                    control_points_, params_.blob_radius);
+    // the simulation resets the idle heartbeat and calms the blob down when returning to idle
+    BlobInputEvent state_change;
+    state_change.type = BlobInputEvent::Type::kStateChange;
+    state_change.state = new_state;
+    QueueSimulationInput(std::move(state_change));
 }
 
-void BlobAnimation::ApplyIdleEffect() {
-    idle_state_->Apply(control_points_, velocity_, blob_center_, params_);
+void BlobAnimation::ApplyForces(const QVector2D &force) {
+    BlobInputEvent external_force;
+    external_force.type = BlobInputEvent::Type::kForce;
+    external_force.force = force;
+    QueueSimulationInput(std::move(external_force));
 }
 
 void BlobAnimation::setBackgroundColor(const QColor &color) {
     if (params_.background_color != color) {
         params_.background_color = color;
-        renderer_.UpdateGridBuffer(params_.background_color, params_.grid_color, params_.grid_spacing, width(),
-                                   height());
         update();
     }
 }
@@ -415,8 +396,6 @@ void BlobAnimation::setBackgroundColor(const QColor &color) {
 void BlobAnimation::setGridColor(const QColor &color) {
     if (params_.grid_color != color) {
         params_.grid_color = color;
-        renderer_.UpdateGridBuffer(params_.background_color, params_.grid_color, params_.grid_spacing, width(),
-                                   height());
         update();
     }
 }
@@ -424,8 +403,6 @@ void BlobAnimation::setGridColor(const QColor &color) {
 void BlobAnimation::setGridSpacing(const int spacing) {
     if (params_.grid_spacing != spacing && spacing > 0) {
         params_.grid_spacing = spacing;
-        renderer_.UpdateGridBuffer(params_.background_color, params_.grid_color, params_.grid_spacing, width(),
-                                   height());
         update();
     }
 }
@@ -455,196 +432,35 @@ void BlobAnimation::ResetLifeColor() {
 }
 
 void BlobAnimation::initializeGL() {
-    initializeOpenGLFunctions();
-
-    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-
-    shader_program_ = new QOpenGLShaderProgram();
-
-    const auto vertex_shader_source = R"(
-        #version 330 core
-        layout (location = 0) in vec2 position;
-        uniform mat4 projection;
-        void main() {
-            gl_Position = projection * vec4(position, 0.0, 1.0);
-        }
-    )";
-
-    const auto fragment_shader_source = R"(
-        #version 330 core
-        out vec4 FragColor;
-        uniform vec4 blobColor;
-        uniform vec2 blobCenter;
-        uniform float blobRadius;
-
-        void main() {
-            // calculate the distance from the center of the blob
-            vec2 fragCoord = gl_FragCoord.xy;
-            float distance = length(fragCoord - blobCenter);
-
-            // glow effect
-            float glow = 1.0 - smoothstep(blobRadius * 0.8, blobRadius, distance);
-            FragColor = blobColor * glow;
-        }
-    )";
-
-    shader_program_->addShaderFromSourceCode(QOpenGLShader::Vertex, vertex_shader_source);
-    shader_program_->addShaderFromSourceCode(QOpenGLShader::Fragment, fragment_shader_source);
-    shader_program_->link();
-
-    vao_.create();
-    vao_.bind();
-
-    vbo_ = QOpenGLBuffer(QOpenGLBuffer::VertexBuffer);
-    vbo_.create();
-    vbo_.bind();
-
-    shader_program_->enableAttributeArray(0);
-    shader_program_->setAttributeBuffer(0, GL_FLOAT, 0, 2, 2 * sizeof(GLfloat));
-
-    vbo_.release();
-    vao_.release();
-}
-
-void BlobAnimation::paintGL() {
-    glClear(GL_COLOR_BUFFER_BIT);
-
-    std::lock_guard lock(points_mutex_);
-
-    UpdateBlobGeometry();
-
-    shader_program_->bind();
-
-    QMatrix4x4 projection;
-    projection.ortho(0, width(), height(), 0, -1, 1);
-    shader_program_->setUniformValue("projection", projection);
-
-    const QColor blob_color = params_.border_color;
-
-    shader_program_->setUniformValue("blobColor", QVector4D(
-                                         blob_color.redF(), blob_color.greenF(), blob_color.blueF(),
-                                         blob_color.alphaF()));
-    shader_program_->setUniformValue("blobCenter", QVector2D(blob_center_));
-    shader_program_->setUniformValue("blobRadius",
-                                     static_cast<float>(params_.blob_radius));
-
-    vao_.bind();
-    vbo_.bind();
-    vbo_.allocate(gl_vertices_.data(), gl_vertices_.size() * sizeof(GLfloat));
-
-    glDrawArrays(GL_TRIANGLE_FAN, 0, gl_vertices_.size() / 2);
-
-    vbo_.release();
-    vao_.release();
-    shader_program_->release();
-}
-
-void BlobAnimation::resizeGL(const int w, const int h) {
-    glViewport(0, 0, w, h);
-}
-
-void BlobAnimation::UpdateBlobGeometry() {
-    gl_vertices_.clear();
-
-    gl_vertices_.push_back(blob_center_.x());
-    gl_vertices_.push_back(blob_center_.y());
-
-    for (const auto &point: control_points_) {
-        gl_vertices_.push_back(point.x());
-        gl_vertices_.push_back(point.y());
-    }
-
-    if (!control_points_.empty()) {
-        gl_vertices_.push_back(control_points_[0].x());
-        gl_vertices_.push_back(control_points_[0].y());
+    if (!renderer_.InitializeGL()) {
+        qCritical() << "[BLOB ANIMATION] Failed to initialize the renderer!";
     }
 }
 
-void BlobAnimation::DrawGrid() {
-    static QOpenGLShaderProgram *grid_shader = nullptr;
-
-    if (!grid_shader) {
-        grid_shader = new QOpenGLShaderProgram(this);
-
-        const auto grid_vertex_shader = R"(
-            #version 330 core
-            layout (location = 0) in vec2 position;
-            uniform mat4 projection;
-            void main() {
-                gl_Position = projection * vec4(position, 0.0, 1.0);
-            }
-        )";
-
-        const auto grid_fragment_shader = R"(
-            #version 330 core
-            out vec4 FragColor;
-            uniform vec4 gridColor;
-            void main() {
-                FragColor = gridColor;
-            }
-        )";
-
-        grid_shader->addShaderFromSourceCode(QOpenGLShader::Vertex, grid_vertex_shader);
-        grid_shader->addShaderFromSourceCode(QOpenGLShader::Fragment, grid_fragment_shader);
-        grid_shader->link();
-    }
-
-    grid_shader->bind();
-
-    QMatrix4x4 projection;
-    projection.ortho(0, width(), height(), 0, -1, 1);
-    grid_shader->setUniformValue("projection", projection);
-
-    const QColor grid_color = params_.grid_color;
-    grid_shader->setUniformValue("gridColor", QVector4D(
-                                     grid_color.redF(), grid_color.greenF(), grid_color.blueF(),
-                                     grid_color.alphaF()));
-
-    QOpenGLBuffer grid_vbo(QOpenGLBuffer::VertexBuffer);
-    grid_vbo.create();
-    grid_vbo.bind();
-
-    std::vector<GLfloat> grid_vertices;
-    const int grid_spacing = params_.grid_spacing;
-
-    // horizontal lines
-    for (int y = 0; y < height(); y += grid_spacing) {
-        grid_vertices.push_back(0);
-        grid_vertices.push_back(y);
-
-        grid_vertices.push_back(width());
-        grid_vertices.push_back(y);
-    }
-
-    // vertical lines
-    for (int x = 0; x < width(); x += grid_spacing) {
-        grid_vertices.push_back(x);
-        grid_vertices.push_back(0);
-
-        grid_vertices.push_back(x);
-        grid_vertices.push_back(height());
-    }
-
-    grid_vbo.allocate(grid_vertices.data(), grid_vertices.size() * sizeof(GLfloat));
-
-    // line drawing
-    grid_shader->enableAttributeArray(0);
-    grid_shader->setAttributeBuffer(0, GL_FLOAT, 0, 2, 2 * sizeof(GLfloat));
+void BlobAnimation::paintGL() {
+    TRACE_ZONE("BlobAnimation::paintGL");
+    PerformanceMonitor::GetInstance()->RecordFrame(frame_channel_);
+    UpdateRenderState();
 
-    glLineWidth(1.0f);
-    glDrawArrays(GL_LINES, 0, grid_vertices.size() / 2);
+    BlobRenderState blob_render_state;
+    blob_render_state.animation_state = current_state_;
 
-    // free resources
-    grid_shader->disableAttributeArray(0);
-    grid_vbo.release();
-    grid_shader->release();
-    grid_vbo.destroy();
+    renderer_.RenderScene(
+        render_points_,
+        render_center_,
+        params_,
+        blob_render_state,
+        width(),
+        height(),
+        devicePixelRatioF(),
+        defaultFramebufferObject()
+    );
 }
 
 void BlobAnimation::PauseAllEventTracking() {
     qDebug() << "[BLOB ANIMATION] Pausing all event tracking mechanisms.";
     events_enabled_ = false;
-    window_position_timer_.stop();
+    FrameScheduler::GetInstance()->SetTimerEnabled(&window_position_timer_, false);
     state_reset_timer_.stop();
     transition_manager_.ClearAllMovementBuffers();
     event_handler_.DisableEvents();
@@ -656,7 +472,7 @@ void BlobAnimation::ResumeAllEventTracking() {
 
     InitializeBlob();
     events_enabled_ = true;
-    window_position_timer_.start();
+    FrameScheduler::GetInstance()->SetTimerEnabled(&window_position_timer_, true);
     event_handler_.EnableEvents();
     renderer_.ResetHUD();
     SwitchToState(BlobConfig::kIdle);
@@ -729,20 +545,8 @@ std::vector<QPointF> BlobAnimation::GenerateOrganicShape(const QPointF &center,
 }
 
 void BlobAnimation::ResetBlobToCenter() {
-    std::lock_guard lock(points_mutex_);
-    const double original_radius = params_.blob_radius;
-
-    control_points_.clear();
-    target_points_.clear();
-    velocity_.clear();
-    blob_center_ = QPointF(width() / 2.0, height() / 2.0);
-    control_points_ = GenerateOrganicShape(blob_center_, original_radius, params_.num_of_points);
-    target_points_ = control_points_;
-    velocity_.resize(params_.num_of_points, QPointF(0, 0));
-
-    if (idle_state_) {
-        idle_state_->ResetInitialization();
-    }
+    // the shape reset also restarts the idle heartbeat
+    InitializeBlob();
     SwitchToState(BlobConfig::kIdle);
 }
 
@@ -750,17 +554,34 @@ void BlobAnimation::ResetVisualization() {
     ResetBlobToCenter();
 
     renderer_.ResetHUD();
-    renderer_.ForceHUDInitialization(blob_center_, params_.blob_radius,
-                                     params_.border_color, width(), height());
+    renderer_.ForceHUDInitialization(QPointF(width() / 2.0, height() / 2.0), params_.blob_radius,
+                                     params_.border_color);
 
     emit visualizationReset();
     update();
 }
 
+void BlobAnimation::StartRecording() {
+    std::lock_guard lock(points_mutex_);
+    simulation_->StartRecording();
+    qDebug() << "[BLOB ANIMATION] Recording simulation inputs.";
+}
+
+BlobRecording BlobAnimation::StopRecording() {
+    std::lock_guard lock(points_mutex_);
+    BlobRecording recording = simulation_->StopRecording();
+    qDebug() << "[BLOB ANIMATION] Recorded" << recording.end_tick - recording.initial_state.tick << "steps,"
+            << recording.events.size() << "inputs.";
+    return recording;
+}
+
 void BlobAnimation::showAnimation() {
     if (!isVisible()) {
         setVisible(true);
+        FrameScheduler::GetInstance()->SetTimerEnabled(&animation_timer_, true);
+        physics_paused_ = false;
         ResumeAllEventTracking();
+        WakePhysicsThread();
     }
 }
 
@@ -768,5 +589,7 @@ void BlobAnimation::hideAnimation() {
     if (isVisible()) {
         setVisible(false);
         PauseAllEventTracking();
+        FrameScheduler::GetInstance()->SetTimerEnabled(&animation_timer_, false);
+        physics_paused_ = true;
     }
 }
@@ -1,33 +1,27 @@
 #ifndef BLOBANIMATION_H
 #define BLOBANIMATION_H
 
-#include <QOpenGLBuffer>
-#include <QOpenGLFunctions>
-#include <QOpenGLVertexArrayObject>
 #include <QOpenGLWidget>
 
 #include "../blob_config.h"
 #include "../physics/blob_physics.h"
 #include "../rendering/blob_renderer.h"
+#include "../../util/triple_buffer.h"
+#include "../../util/profiling/performance_monitor.h"
+#include "blob_render_snapshot.h"
+#include "blob_simulation.h"
 #include "dynamics/blob_event_handler.h"
 #include "dynamics/blob_transition_manager.h"
 
-class QOpenGLShaderProgram;
-class BlobState;
-class ResizingState;
-class MovingState;
-class IdleState;
-
 /**
  * @brief Main widget responsible for rendering and animating the dynamic blob.
  *
- * This class integrates physics simulation (BlobPhysics), rendering (BlobRenderer),
- * state management (IdleState, MovingState, ResizingState), event handling (BlobEventHandler),
- * and transition logic (BlobTransitionManager) to create a fluid, interactive blob animation.
- * It uses QOpenGLWidget for hardware-accelerated rendering and runs physics calculations
- * in a separate thread for performance.
+ * This class integrates the fixed-timestep simulation (BlobSimulation), rendering (BlobRenderer),
+ * event handling (BlobEventHandler) and transition logic (BlobTransitionManager) to create a fluid,
+ * interactive blob animation. It uses QOpenGLWidget for hardware-accelerated rendering and steps the
+ * simulation in a separate thread; window events only queue inputs for the simulation.
  */
-class BlobAnimation final : public QOpenGLWidget, protected QOpenGLFunctions {
+class BlobAnimation final : public QOpenGLWidget {
     Q_OBJECT
 
 public:
@@ -41,7 +35,7 @@ public:
 
     /**
      * @brief Destructor.
-     * Stops timers, cleans up OpenGL resources, joins the physics thread, and deletes state objects.
+     * Stops timers, releases the renderer's OpenGL resources and joins the physics thread.
      */
     ~BlobAnimation() override;
 
@@ -52,10 +46,11 @@ public:
      */
     QPointF GetBlobCenter() const {
         std::lock_guard lock(points_mutex_);
-        if (control_points_.empty()) {
+        const BlobSimulationState &state = simulation_->GetState();
+        if (state.points.Empty()) {
             return {width() / 2.0, height() / 2.0};
         }
-        return blob_center_;
+        return state.blob_center;
     }
 
     /**
@@ -89,6 +84,17 @@ public:
      */
     void ResetVisualization();
 
+    /**
+     * @brief Starts recording the simulation inputs (see BlobSimulation::StartRecording()).
+     */
+    void StartRecording();
+
+    /**
+     * @brief Stops recording the simulation inputs.
+     * @return The recorded session, replayable headlessly with BlobSimulation::Replay().
+     */
+    BlobRecording StopRecording();
+
 public slots:
     /**
      * @brief Makes the animation widget visible and resumes event tracking.
@@ -102,7 +108,7 @@ public slots:
 
     /**
      * @brief Sets the background color used for rendering.
-     * Updates the grid buffer and triggers a repaint.
+     * Triggers a repaint; the background is procedural, so nothing is rebuilt.
      * @param color The new background color.
      */
     void setBackgroundColor(const QColor &color);
@@ -116,14 +122,14 @@ public slots:
 
     /**
      * @brief Sets the color of the background grid lines.
-     * Updates the grid buffer and triggers a repaint.
+     * Triggers a repaint; the background is procedural, so nothing is rebuilt.
      * @param color The new grid color.
      */
     void setGridColor(const QColor &color);
 
     /**
      * @brief Sets the spacing between background grid lines.
-     * Updates the grid buffer and triggers a repaint.
+     * Triggers a repaint; the background is procedural, so nothing is rebuilt.
      * @param spacing The new grid spacing in pixels.
      */
     void setGridSpacing(int spacing);
@@ -136,21 +142,6 @@ signals:
     void visualizationReset();
 
 protected:
-    /**
-     * @brief Overridden paint event handler.
-     * Delegates rendering to BlobRenderer after checking if the paint area intersects the blob's bounding box.
-     * Uses a cached background pixmap for efficiency.
-     * @param event The paint event.
-     */
-    void paintEvent(QPaintEvent *event) override;
-
-    /**
-     * @brief Calculates the bounding rectangle encompassing the blob's control points, including margins for border and glow.
-     * Used for optimizing paint events.
-     * @return The calculated bounding rectangle.
-     */
-    QRectF CalculateBlobBoundingRect();
-
     /**
      * @brief Overridden resize event handler.
      * Delegates processing to BlobEventHandler.
@@ -175,54 +166,30 @@ protected:
     bool eventFilter(QObject *watched, QEvent *event) override;
 
     /**
-     * @brief Initializes OpenGL functions, shaders, VAO, and VBO. Called once before the first paintGL call.
+     * @brief Creates the renderer's GL resources (shaders, control point buffer, glow pipeline).
+     * Called once before the first paintGL call.
      */
     void initializeGL() override;
 
     /**
-     * @brief Renders the blob and grid using OpenGL. Called whenever the widget needs to be painted.
-     * Binds shaders, sets uniforms (projection matrix, colors, etc.), updates VBO data, and draws the blob geometry.
+     * @brief Renders the whole scene (background, glow, blob, HUD) in one OpenGL pass through BlobRenderer.
+     * Draws the interpolated render state, never locks the simulation state.
      */
     void paintGL() override;
 
-    /**
-     * @brief Handles OpenGL viewport updates when the widget is resized.
-     * @param w New width.
-     * @param h New height.
-     */
-    void resizeGL(int w, int h) override;
-
-    /**
-     * @brief Updates the internal vertex buffer (gl_vertices_) based on the current blob_center_ and control_points_.
-     * Prepares the geometry data for rendering with GL_TRIANGLE_FAN.
-     */
-    void UpdateBlobGeometry();
-
-    /**
-     * @brief Draws the background grid using a separate shader program and line primitives.
-     * Generates vertex data for horizontal and vertical lines based on grid spacing.
-     */
-    void DrawGrid();
-
 private slots:
     /**
-     * @brief Slot connected to animation_timer_. Called periodically (~60 FPS) to update the animation state.
-     * Processes movement buffer, applies current state logic, and triggers a repaint if needed.
+     * @brief Slot connected to animation_timer_. Called periodically (~60 FPS).
+     * Processes the movement buffer and triggers a repaint while the window is moving or resizing.
      */
     void updateAnimation();
 
     /**
      * @brief Slot (or helper called by updateAnimation) to process the window movement buffer via BlobTransitionManager.
-     * Provides callbacks to apply inertia forces and update the last known window position.
+     * Provides callbacks that queue inertia forces for the simulation and update the last known window position.
      */
     void processMovementBuffer();
 
-    /**
-     * @brief Slot (or helper called by physics thread) to update the blob's physics simulation.
-     * Calls BlobPhysics methods for internal forces, collisions, smoothing, and constraints.
-     */
-    void updatePhysics();
-
     /**
      * @brief Slot connected to state_reset_timer_. Called after a period of inactivity in Moving or Resizing state.
      * Automatically switches the state back to Idle.
@@ -231,7 +198,7 @@ private slots:
 
     /**
      * @brief Slot connected to resize_debounce_timer_. Called after a short delay following resize events.
-     * Resets the blob to the center, resets the grid buffer, and updates the widget.
+     * Resets the blob to the center and updates the widget.
      */
     void HandleResizeTimeout();
 
@@ -243,32 +210,26 @@ private slots:
 
 private:
     /**
-     * @brief Initializes the blob's state (control points, target points, velocity, center)
-     * based on current parameters. Generates the initial organic shape.
+     * @brief Generates a new organic shape centered in the widget and queues it as the simulation's
+     * point state (positions, targets, velocities) and center.
      */
     void InitializeBlob();
 
     /**
      * @brief Switches the blob's current animation state (Idle, Moving, Resizing).
-     * Updates the current_blob_state_ pointer and handles state-specific logic like timer management
-     * and resetting state properties.
+     * Manages the state reset timer and queues the state change for the simulation,
+     * which applies the state-specific logic at its next step.
      * @param new_state The target state to switch to.
      */
     void SwitchToState(BlobConfig::AnimationState new_state);
 
     /**
-     * @brief Applies an external force vector to the blob.
-     * Delegates force application to the current state object.
+     * @brief Queues an external force vector for the simulation.
+     * The simulation delegates force application to the active state.
      * @param force The force vector to apply.
      */
     void ApplyForces(const QVector2D &force);
 
-    /**
-     * @brief Explicitly applies the idle state effect (e.g., heartbeat).
-     * Calls the Apply method of the idle_state_ object.
-     */
-    void ApplyIdleEffect();
-
     /**
      * @brief Resets the blob's position to the center of the widget and regenerates its shape.
      * Clears velocities and switches the state to Idle.
@@ -287,11 +248,39 @@ private:
 
     /**
      * @brief The main function executed by the physics simulation thread.
-     * Enters a loop that repeatedly calls updatePhysics(), notifies the UI thread to update,
-     * and waits for the next frame time, controlled by physics_active_ flag and physics_condition_.
+     * Accumulates elapsed time and runs as many fixed BlobSimulation steps as it covers (bounded after stalls),
+     * publishes the result to the renderer, notifies the UI thread to update, and waits for the next step,
+     * controlled by physics_active_ flag and physics_condition_. While the application is idle it wakes up
+     * once per kIdleStepsPerWake steps; while the blob is settled or the widget hidden it sleeps until
+     * WakePhysicsThread().
      */
     void PhysicsThreadFunction();
 
+    /**
+     * @brief Queues an input for the simulation and wakes the physics thread, which may be sleeping on a settled blob.
+     * @param event The input to queue.
+     */
+    void QueueSimulationInput(BlobInputEvent event);
+
+    /**
+     * @brief Interrupts the physics thread's wait (settled blob, idle batching or paused widget).
+     */
+    void WakePhysicsThread();
+
+    /**
+     * @brief Copies the current simulation state into the write buffer of render_snapshots_.
+     * Must be called with points_mutex_ held, by the physics thread (or before it starts).
+     * The snapshot becomes visible to the renderer with render_snapshots_.Publish().
+     * @param time_ns Steady clock time (ns) the simulation state corresponds to.
+     */
+    void CaptureRenderSnapshot(qint64 time_ns);
+
+    /**
+     * @brief Picks up the latest published snapshot and interpolates render_points_ and render_center_
+     * to the current frame time. Called on the GUI thread before drawing.
+     */
+    void UpdateRenderState();
+
     /** @brief Handles window move/resize event filtering and processing. */
     BlobEventHandler event_handler_;
     /** @brief Manages movement analysis, velocity calculation, and state transitions based on movement. */
@@ -317,17 +306,10 @@ private:
     /** @brief Structure holding parameters specific to the idle state animation (wave amplitude/frequency). */
     BlobConfig::IdleParameters idle_params_;
 
-    /** @brief Vector storing the current positions of the blob's control points. Modified by physics and states. Protected by points_mutex_. */
-    std::vector<QPointF> control_points_;
-    /** @brief Vector storing the target positions for control points (used by physics). Protected by points_mutex_. */
-    std::vector<QPointF> target_points_;
-    /** @brief Vector storing the current velocities of the blob's control points. Protected by points_mutex_. */
-    std::vector<QPointF> velocity_;
-
-    /** @brief The calculated center position of the blob. Protected by points_mutex_. */
-    QPointF blob_center_;
+    /** @brief Fixed-timestep simulation owning the point state, blob center and state logic. Stepped under points_mutex_. */
+    std::unique_ptr<BlobSimulation> simulation_;
 
-    /** @brief The current animation state (Idle, Moving, Resizing). */
+    /** @brief The current animation state (Idle, Moving, Resizing) as seen by the GUI; the simulation follows it via queued inputs. */
     BlobConfig::AnimationState current_state_ = BlobConfig::kIdle;
 
     /** @brief Main timer driving the animation updates (~60 FPS). */
@@ -340,29 +322,27 @@ private:
     /** @brief Object responsible for rendering the blob, grid, and HUD. */
     BlobRenderer renderer_;
 
-    /** @brief Unique pointer to the Idle state logic object. */
-    std::unique_ptr<IdleState> idle_state_;
-    /** @brief Unique pointer to the Moving state logic object. */
-    std::unique_ptr<MovingState> moving_state_;
-    /** @brief Unique pointer to the Resizing state logic object. */
-    std::unique_ptr<ResizingState> resizing_state_;
-    /** @brief Pointer to the currently active state object (points to one of the above). */
-    BlobState *current_blob_state_;
-
     /** @brief Stores the last known window position. */
     QPointF last_window_position_;
 
-    /** @brief Precalculated minimum distance constraint for physics. */
-    double precalc_min_distance_ = 0.0;
-    /** @brief Precalculated maximum distance constraint for physics. */
-    double precalc_max_distance_ = 0.0;
-
-    /** @brief Mutex protecting access to shared data between UI and physics threads (control_points_, velocity_, etc.). */
+    /** @brief Mutex protecting simulation_ between the physics steps and GUI-thread reads. Rendering does not use it. */
     mutable std::mutex points_mutex_;
+    /** @brief Physics states handed to the renderer (written by the physics thread, read by the GUI thread). */
+    TripleBuffer<BlobRenderSnapshot> render_snapshots_;
+    /** @brief Interpolated positions drawn by the current frame (only the position arrays are used). GUI thread only. */
+    BlobPoints render_points_;
+    /** @brief Interpolated blob center drawn by the current frame. GUI thread only. */
+    QPointF render_center_;
     /** @brief Atomic flag controlling the physics thread loop. */
     std::atomic<bool> physics_active_{true};
-    /** @brief Condition variable used by the physics thread to wait for the next frame time. */
+    /** @brief Mutex used only for the physics thread's timed wait, so sleeping never blocks the simulation state. */
+    std::mutex physics_wait_mutex_;
+    /** @brief Condition variable used by the physics thread to wait for the next step time. */
     std::condition_variable physics_condition_;
+    /** @brief Set by WakePhysicsThread() to end the physics thread's current wait. Protected by physics_wait_mutex_. */
+    bool physics_wake_requested_ = false;
+    /** @brief Flag suspending the simulation while the widget is hidden. */
+    std::atomic<bool> physics_paused_{false};
 
     /** @brief Flag indicating if event processing is currently enabled. */
     bool events_enabled_ = true;
@@ -373,15 +353,10 @@ private:
 
     /** @brief The separate thread object running the physics simulation (PhysicsThreadFunction). */
     std::thread physics_thread_;
-
-    /** @brief Pointer to the shader program used for rendering the blob. */
-    QOpenGLShaderProgram *shader_program_ = nullptr;
-    /** @brief Vertex Buffer Object storing blob geometry data. */
-    QOpenGLBuffer vbo_;
-    /** @brief Vertex Array Object encapsulating vertex buffer state. */
-    QOpenGLVertexArrayObject vao_;
-    /** @brief Vector storing vertex data (x, y pairs) to be uploaded to the VBO. */
-    std::vector<GLfloat> gl_vertices_;
+    /** @brief Performance overlay channel receiving frame-to-frame times. */
+    PerformanceMonitor::Channel *frame_channel_ = nullptr;
+    /** @brief Performance overlay channel receiving physics step durations. */
+    PerformanceMonitor::Channel *physics_channel_ = nullptr;
 };
 
 #endif // BLOBANIMATION_H
@@ -0,0 +1,213 @@
+#include "blob_recording.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QFile>
+
+namespace {
+    /** @brief File signature ("WBRC"). */
+    constexpr quint32 kRecordingMagic = 0x57425243;
+    /** @brief Format version; bump on every layout change. */
+    constexpr quint16 kRecordingVersion = 2;
+
+    template<typename Vector>
+    void WriteFloats(QDataStream &stream, const Vector &values) {
+        stream << static_cast<quint32>(values.size());
+        for (const float value: values) {
+            stream << value;
+        }
+    }
+
+    template<typename Vector>
+    void ReadFloats(QDataStream &stream, Vector &values) {
+        quint32 count = 0;
+        stream >> count;
+        if (stream.status() != QDataStream::Ok) {
+            return;
+        }
+        values.resize(count);
+        for (float &value: values) {
+            stream >> value;
+        }
+    }
+
+    void WritePoints(QDataStream &stream, const BlobPoints &points) {
+        WriteFloats(stream, points.position_x);
+        WriteFloats(stream, points.position_y);
+        WriteFloats(stream, points.target_x);
+        WriteFloats(stream, points.target_y);
+        WriteFloats(stream, points.velocity_x);
+        WriteFloats(stream, points.velocity_y);
+        WriteFloats(stream, points.shape_factors);
+    }
+
+    void ReadPoints(QDataStream &stream, BlobPoints &points) {
+        ReadFloats(stream, points.position_x);
+        ReadFloats(stream, points.position_y);
+        ReadFloats(stream, points.target_x);
+        ReadFloats(stream, points.target_y);
+        ReadFloats(stream, points.velocity_x);
+        ReadFloats(stream, points.velocity_y);
+        ReadFloats(stream, points.shape_factors);
+    }
+
+    void WriteShape(QDataStream &stream, const std::vector<QPointF> &shape) {
+        stream << static_cast<quint32>(shape.size());
+        for (const QPointF &point: shape) {
+            stream << point;
+        }
+    }
+
+    void ReadShape(QDataStream &stream, std::vector<QPointF> &shape) {
+        quint32 count = 0;
+        stream >> count;
+        if (stream.status() != QDataStream::Ok) {
+            return;
+        }
+        shape.resize(count);
+        for (QPointF &point: shape) {
+            stream >> point;
+        }
+    }
+
+    void WriteState(QDataStream &stream, const BlobSimulationState &state) {
+        WritePoints(stream, state.points);
+        stream << state.blob_center << state.viewport_size << static_cast<quint8>(state.animation_state)
+                << state.idle_state << state.tick << state.random.seed << state.random.state;
+    }
+
+    void ReadState(QDataStream &stream, BlobSimulationState &state) {
+        quint8 animation_state = 0;
+        ReadPoints(stream, state.points);
+        stream >> state.blob_center >> state.viewport_size >> animation_state >> state.idle_state >> state.tick
+                >> state.random.seed >> state.random.state;
+        state.animation_state = static_cast<BlobConfig::AnimationState>(animation_state);
+    }
+}
+
+bool BlobRecording::Save(const QString &path) const {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[BLOB RECORDING] Cannot write" << path << ":" << file.errorString();
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_15);
+    // double precision keeps every float and double field bit-exact, which the replay relies on
+    stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+    stream << kRecordingMagic << kRecordingVersion;
+    stream << params.blob_radius << static_cast<qint32>(params.num_of_points)
+            << static_cast<qint32>(params.glow_radius) << static_cast<qint32>(params.border_width);
+    stream << physics_params.viscosity << physics_params.damping << physics_params.velocity_threshold
+            << physics_params.max_speed << physics_params.restitution << physics_params.stabilization_rate
+            << physics_params.min_neighbor_distance << physics_params.max_neighbor_distance;
+
+    WriteState(stream, initial_state);
+
+    stream << static_cast<quint32>(events.size());
+    for (const BlobInputEvent &event: events) {
+        stream << static_cast<quint8>(event.type) << event.tick;
+        switch (event.type) {
+            case BlobInputEvent::Type::kViewportSize:
+                stream << event.new_size;
+                break;
+            case BlobInputEvent::Type::kResize:
+                stream << event.old_size << event.new_size;
+                break;
+            case BlobInputEvent::Type::kWindowMove:
+            case BlobInputEvent::Type::kForce:
+                stream << event.force;
+                break;
+            case BlobInputEvent::Type::kStateChange:
+                stream << static_cast<quint8>(event.state);
+                break;
+            case BlobInputEvent::Type::kShapeReset:
+                WriteShape(stream, event.shape);
+                stream << event.center;
+                break;
+        }
+    }
+    stream << end_tick;
+
+    return stream.status() == QDataStream::Ok;
+}
+
+bool BlobRecording::Load(const QString &path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "[BLOB RECORDING] Cannot read" << path << ":" << file.errorString();
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_15);
+    stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    stream >> magic >> version;
+    if (magic != kRecordingMagic || version != kRecordingVersion) {
+        qWarning() << "[BLOB RECORDING]" << path << "is not a blob recording of version" << kRecordingVersion;
+        return false;
+    }
+
+    qint32 num_of_points = 0;
+    qint32 glow_radius = 0;
+    qint32 border_width = 0;
+    stream >> params.blob_radius >> num_of_points >> glow_radius >> border_width;
+    params.num_of_points = num_of_points;
+    params.glow_radius = glow_radius;
+    params.border_width = border_width;
+
+    stream >> physics_params.viscosity >> physics_params.damping >> physics_params.velocity_threshold
+            >> physics_params.max_speed >> physics_params.restitution >> physics_params.stabilization_rate
+            >> physics_params.min_neighbor_distance >> physics_params.max_neighbor_distance;
+
+    ReadState(stream, initial_state);
+
+    quint32 event_count = 0;
+    stream >> event_count;
+    events.clear();
+    for (quint32 i = 0; i < event_count && stream.status() == QDataStream::Ok; ++i) {
+        BlobInputEvent event;
+        quint8 type = 0;
+        stream >> type >> event.tick;
+        event.type = static_cast<BlobInputEvent::Type>(type);
+
+        switch (event.type) {
+            case BlobInputEvent::Type::kViewportSize:
+                stream >> event.new_size;
+                break;
+            case BlobInputEvent::Type::kResize:
+                stream >> event.old_size >> event.new_size;
+                break;
+            case BlobInputEvent::Type::kWindowMove:
+            case BlobInputEvent::Type::kForce:
+                stream >> event.force;
+                break;
+            case BlobInputEvent::Type::kStateChange: {
+                quint8 state = 0;
+                stream >> state;
+                event.state = static_cast<BlobConfig::AnimationState>(state);
+                break;
+            }
+            case BlobInputEvent::Type::kShapeReset:
+                ReadShape(stream, event.shape);
+                stream >> event.center;
+                break;
+            default:
+                stream.setStatus(QDataStream::ReadCorruptData);
+                break;
+        }
+        events.push_back(std::move(event));
+    }
+    stream >> end_tick;
+
+    if (stream.status() != QDataStream::Ok) {
+        qWarning() << "[BLOB RECORDING]" << path << "is truncated or corrupt.";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,105 @@
+#ifndef BLOB_RECORDING_H
+#define BLOB_RECORDING_H
+
+#include <QSize>
+#include <QString>
+#include <QVector2D>
+#include <vector>
+
+#include "../blob_config.h"
+#include "../physics/blob_points.h"
+#include "../states/idle_state.h"
+
+/**
+ * @brief A single input to the blob simulation (window movement, resize, force, state switch or shape reset).
+ *
+ * Inputs are queued by the GUI thread and applied by BlobSimulation at the start of the next fixed step,
+ * which stamps them with that step's tick. Replaying the same inputs at the same ticks from the same
+ * initial state reproduces the simulation exactly.
+ */
+struct BlobInputEvent {
+    /**
+     * @brief Kind of input; selects which of the payload fields are used.
+     */
+    enum class Type : quint8 {
+        kViewportSize, ///< The simulation area changed to new_size.
+        kResize, ///< Significant window resize from old_size to new_size (ResizingState::HandleResize).
+        kWindowMove, ///< Inertia from window movement; force holds the smoothed window velocity.
+        kForce, ///< External force applied through the active state.
+        kStateChange, ///< Switch of the animation state to state.
+        kShapeReset ///< The blob was re-initialized with shape and center.
+    };
+
+    /** @brief Kind of input. */
+    Type type = Type::kForce;
+    /** @brief Tick of the step the input was applied before. Assigned by the simulation. */
+    quint64 tick = 0;
+    /** @brief Force or window velocity (kWindowMove, kForce). */
+    QVector2D force;
+    /** @brief Size before a resize (kResize). */
+    QSize old_size;
+    /** @brief Size after a resize, or the new simulation area (kResize, kViewportSize). */
+    QSize new_size;
+    /** @brief Target animation state (kStateChange). */
+    BlobConfig::AnimationState state = BlobConfig::kIdle;
+    /**
+     * @brief New control point positions (kShapeReset).
+     * The simulation draws the shape factors of a new shape from its own generator when applying the reset.
+     */
+    std::vector<QPointF> shape;
+    /** @brief New blob center (kShapeReset). */
+    QPointF center;
+};
+
+/**
+ * @brief Everything that evolves during the blob simulation. Copying it captures the simulation exactly.
+ */
+struct BlobSimulationState {
+    /** @brief Positions, targets, velocities and shape factors of the control points. */
+    BlobPoints points;
+    /** @brief Blob center. */
+    QPointF blob_center;
+    /** @brief Simulation area (widget size) used for border collisions and idle centering. */
+    QSize viewport_size;
+    /** @brief Active animation state. */
+    BlobConfig::AnimationState animation_state = BlobConfig::kIdle;
+    /** @brief Idle state including its wave and heartbeat phases. */
+    IdleState idle_state;
+    /** @brief Number of fixed steps simulated so far. */
+    quint64 tick = 0;
+    /** @brief Generator of everything random in the simulation (shape factors, repairs of invalid points). */
+    BlobRandomGenerator random;
+};
+
+/**
+ * @brief Recorded blob session: the initial simulation state and every input, stamped with its tick.
+ * Can be saved to and loaded from a binary file to reproduce a session (e.g. a jank report) headlessly.
+ */
+struct BlobRecording {
+    /** @brief Blob parameters of the session (only the geometry-related fields are saved). */
+    BlobConfig::BlobParameters params{};
+    /** @brief Physics parameters of the session. */
+    BlobConfig::PhysicsParameters physics_params{};
+    /** @brief Simulation state when the recording started. */
+    BlobSimulationState initial_state;
+    /** @brief Inputs in the order they were applied (ticks are non-decreasing). */
+    std::vector<BlobInputEvent> events;
+    /** @brief Tick at which the recording stopped. */
+    quint64 end_tick = 0;
+
+    /**
+     * @brief Writes the recording to a binary file.
+     * @param path Destination file path.
+     * @return True on success.
+     */
+    [[nodiscard]] bool Save(const QString &path) const;
+
+    /**
+     * @brief Replaces this recording with the contents of a file written by Save().
+     * @param path Source file path.
+     * @return True on success; false if the file cannot be read or has an unknown format.
+     */
+    bool Load(const QString &path);
+};
+
+#endif // BLOB_RECORDING_H
@@ -0,0 +1,40 @@
+#include "blob_render_snapshot.h"
+
+#include <algorithm>
+#include <QtGlobal>
+
+void BlobRenderSnapshot::Capture(const BlobRenderSnapshot &previous, const BlobPoints &points,
+                                 const QPointF &center, const qint64 time_ns) {
+    previous_x = previous.current_x;
+    previous_y = previous.current_y;
+    previous_center = previous.current_center;
+    previous_time_ns = previous.current_time_ns;
+
+    current_x.assign(points.position_x.begin(), points.position_x.end());
+    current_y.assign(points.position_y.begin(), points.position_y.end());
+    current_center = center;
+    current_time_ns = time_ns;
+}
+
+void BlobRenderSnapshot::Interpolate(const qint64 render_time_ns, BlobPoints &points, QPointF &center) const {
+    const size_t count = current_x.size();
+    points.position_x.resize(count);
+    points.position_y.resize(count);
+
+    // the first snapshot and a changed point count (blob re-initialized) have nothing to blend with
+    if (previous_x.size() != count || current_time_ns <= previous_time_ns) {
+        std::copy(current_x.begin(), current_x.end(), points.position_x.begin());
+        std::copy(current_y.begin(), current_y.end(), points.position_y.begin());
+        center = current_center;
+        return;
+    }
+
+    const auto alpha = static_cast<float>(qBound(0.0, static_cast<double>(render_time_ns - previous_time_ns) /
+                                                      static_cast<double>(current_time_ns - previous_time_ns), 1.0));
+
+    for (size_t i = 0; i < count; ++i) {
+        points.position_x[i] = previous_x[i] + (current_x[i] - previous_x[i]) * alpha;
+        points.position_y[i] = previous_y[i] + (current_y[i] - previous_y[i]) * alpha;
+    }
+    center = previous_center + (current_center - previous_center) * alpha;
+}
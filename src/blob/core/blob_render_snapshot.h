@@ -0,0 +1,54 @@
+#ifndef BLOB_RENDER_SNAPSHOT_H
+#define BLOB_RENDER_SNAPSHOT_H
+
+#include <QPointF>
+#include <vector>
+
+#include "../physics/blob_points.h"
+
+/**
+ * @brief Blob geometry handed from the physics thread to the renderer.
+ *
+ * Holds the two most recent completed physics states with their timestamps, so the renderer can
+ * interpolate to its own frame time instead of showing whichever step happened to be last.
+ * Exchanged through a TripleBuffer; the renderer never touches the live simulation state.
+ */
+struct BlobRenderSnapshot {
+    /** @brief X coordinates of the control points after the previous step. */
+    std::vector<float> previous_x;
+    /** @brief Y coordinates of the control points after the previous step. */
+    std::vector<float> previous_y;
+    /** @brief X coordinates of the control points after the latest step. */
+    std::vector<float> current_x;
+    /** @brief Y coordinates of the control points after the latest step. */
+    std::vector<float> current_y;
+    /** @brief Blob center after the previous step. */
+    QPointF previous_center;
+    /** @brief Blob center after the latest step. */
+    QPointF current_center;
+    /** @brief Completion time of the previous step (steady clock, nanoseconds). */
+    qint64 previous_time_ns = 0;
+    /** @brief Completion time of the latest step (steady clock, nanoseconds). */
+    qint64 current_time_ns = 0;
+
+    /**
+     * @brief Fills the snapshot: the given previous state and the current positions of the blob.
+     * @param previous Snapshot published before this one (its current state becomes the previous state here).
+     * @param points The live point state (only the positions are copied).
+     * @param center The live blob center.
+     * @param time_ns Completion time of the step.
+     */
+    void Capture(const BlobRenderSnapshot &previous, const BlobPoints &points, const QPointF &center,
+                 qint64 time_ns);
+
+    /**
+     * @brief Computes the blob geometry at the given time, linearly interpolated between the two states.
+     * Times outside [previous_time_ns, current_time_ns] are clamped (no extrapolation).
+     * @param render_time_ns The time to render (steady clock, nanoseconds).
+     * @param points Receives the interpolated positions; the other arrays are left untouched.
+     * @param center Receives the interpolated center.
+     */
+    void Interpolate(qint64 render_time_ns, BlobPoints &points, QPointF &center) const;
+};
+
+#endif // BLOB_RENDER_SNAPSHOT_H
@@ -0,0 +1,189 @@
+#include "blob_simulation.h"
+
+#include <algorithm>
+#include <limits>
+#include <QRandomGenerator>
+
+#include "../physics/blob_physics.h"
+#include "../../util/profiling/trace_profiler.h"
+
+BlobSimulation::BlobSimulation(const BlobConfig::BlobParameters &params,
+                               const BlobConfig::PhysicsParameters &physics_params)
+    : params_(params),
+      physics_params_(physics_params) {
+    // every live session gets its own sequence; recordings carry the generator, so a replay continues it
+    state_.random.Seed(QRandomGenerator::global()->generate64());
+}
+
+void BlobSimulation::QueueInput(BlobInputEvent event) {
+    std::lock_guard lock(input_mutex_);
+    pending_inputs_.push_back(std::move(event));
+}
+
+void BlobSimulation::ApplyPendingInputs() {
+    {
+        std::lock_guard lock(input_mutex_);
+        if (pending_inputs_.empty()) {
+            return;
+        }
+        applying_inputs_.swap(pending_inputs_);
+    }
+
+    // any input may disturb a resting blob
+    resting_steps_ = 0;
+
+    for (BlobInputEvent &event: applying_inputs_) {
+        event.tick = state_.tick;
+        ApplyInput(event);
+        if (recording_active_) {
+            recording_.events.push_back(std::move(event));
+        }
+    }
+    applying_inputs_.clear();
+}
+
+void BlobSimulation::Step() {
+    TRACE_ZONE("BlobSimulation::Step");
+    ApplyPendingInputs();
+
+    BlobPoints &points = state_.points;
+    if (!points.Empty()) {
+        if (state_.tick % kStateUpdateInterval == 0) {
+            params_.screen_width = state_.viewport_size.width();
+            params_.screen_height = state_.viewport_size.height();
+            ActiveState()->Apply(points, state_.blob_center, params_);
+        }
+
+        BlobPhysics::UpdatePhysicsParallel(points, state_.blob_center, params_, physics_params_, state_.random);
+
+        if (state_.viewport_size.isValid() && !state_.viewport_size.isEmpty()) {
+            const int padding = params_.border_width + params_.glow_radius;
+            BlobPhysics::HandleBorderCollisions(points, state_.blob_center,
+                                                state_.viewport_size.width(), state_.viewport_size.height(),
+                                                physics_params_.restitution, padding);
+        }
+
+        BlobPhysics::SmoothBlobShape(points);
+
+        const double min_distance = params_.blob_radius * physics_params_.min_neighbor_distance;
+        const double max_distance = params_.blob_radius * physics_params_.max_neighbor_distance;
+        BlobPhysics::ConstrainNeighborDistances(points, min_distance, max_distance);
+
+        if (UpdateMaxDisplacementSquared() < kSettleDistance * kSettleDistance) {
+            ++resting_steps_;
+        } else {
+            resting_steps_ = 0;
+        }
+    }
+
+    ++state_.tick;
+}
+
+void BlobSimulation::StartRecording() {
+    recording_ = BlobRecording{};
+    recording_.params = params_;
+    recording_.physics_params = physics_params_;
+    recording_.initial_state = state_;
+    recording_active_ = true;
+}
+
+BlobRecording BlobSimulation::StopRecording() {
+    if (!recording_active_) {
+        return {};
+    }
+    recording_active_ = false;
+    recording_.end_tick = state_.tick;
+    return std::move(recording_);
+}
+
+BlobSimulationState BlobSimulation::Replay(const BlobRecording &recording,
+                                           const std::function<void(const BlobSimulationState &)> &on_step) {
+    BlobSimulation simulation(recording.params, recording.physics_params);
+    simulation.state_ = recording.initial_state;
+
+    auto next_event = recording.events.begin();
+    const auto queue_inputs_up_to = [&](const quint64 tick) {
+        for (; next_event != recording.events.end() && next_event->tick <= tick; ++next_event) {
+            simulation.pending_inputs_.push_back(*next_event);
+        }
+    };
+
+    while (simulation.state_.tick < recording.end_tick) {
+        queue_inputs_up_to(simulation.state_.tick);
+        simulation.Step();
+        if (on_step) {
+            on_step(simulation.state_);
+        }
+    }
+
+    // inputs applied after the last step, right before the recording stopped
+    queue_inputs_up_to(recording.end_tick);
+    simulation.ApplyPendingInputs();
+
+    return simulation.state_;
+}
+
+void BlobSimulation::ApplyInput(const BlobInputEvent &event) {
+    switch (event.type) {
+        case BlobInputEvent::Type::kViewportSize:
+            state_.viewport_size = event.new_size;
+            break;
+        case BlobInputEvent::Type::kResize:
+            resizing_state_.HandleResize(state_.points, state_.blob_center, event.old_size, event.new_size);
+            break;
+        case BlobInputEvent::Type::kWindowMove:
+            MovingState::ApplyInertiaForce(state_.points, state_.blob_center, params_.blob_radius, event.force);
+            break;
+        case BlobInputEvent::Type::kForce:
+            ActiveState()->ApplyForce(event.force, state_.points, state_.blob_center, params_.blob_radius);
+            break;
+        case BlobInputEvent::Type::kStateChange:
+            if (event.state == state_.animation_state) {
+                break;
+            }
+            if (event.state == BlobConfig::kIdle) {
+                state_.idle_state.ResetInitialization();
+                state_.points.ScaleVelocities(0.5f);
+            }
+            state_.animation_state = event.state;
+            break;
+        case BlobInputEvent::Type::kShapeReset:
+            // a reset always starts from fresh shape factors, even if the point count is unchanged
+            state_.points.shape_factors.clear();
+            state_.points.AssignShape(event.shape, state_.random);
+            state_.blob_center = event.center;
+            state_.idle_state.ResetInitialization();
+            break;
+    }
+}
+
+float BlobSimulation::UpdateMaxDisplacementSquared() {
+    const BlobPoints &points = state_.points;
+    if (settle_reference_x_.size() != points.Size()) {
+        settle_reference_x_.assign(points.position_x.begin(), points.position_x.end());
+        settle_reference_y_.assign(points.position_y.begin(), points.position_y.end());
+        return std::numeric_limits<float>::infinity();
+    }
+
+    float max_displacement_squared = 0.0f;
+    for (size_t i = 0; i < points.Size(); ++i) {
+        const float dx = points.position_x[i] - settle_reference_x_[i];
+        const float dy = points.position_y[i] - settle_reference_y_[i];
+        max_displacement_squared = std::max(max_displacement_squared, dx * dx + dy * dy);
+        settle_reference_x_[i] = points.position_x[i];
+        settle_reference_y_[i] = points.position_y[i];
+    }
+    return max_displacement_squared;
+}
+
+BlobState *BlobSimulation::ActiveState() {
+    switch (state_.animation_state) {
+        case BlobConfig::kMoving:
+            return &moving_state_;
+        case BlobConfig::kResizing:
+            return &resizing_state_;
+        case BlobConfig::kIdle:
+        default:
+            return &state_.idle_state;
+    }
+}
@@ -0,0 +1,164 @@
+#ifndef BLOB_SIMULATION_H
+#define BLOB_SIMULATION_H
+
+#include <functional>
+#include <mutex>
+
+#include "blob_recording.h"
+#include "../states/moving_state.h"
+#include "../states/resizing_state.h"
+
+/**
+ * @brief Headless, fixed-timestep simulation of the blob (physics and animation states, no widget or GL context).
+ *
+ * Each Step() advances the simulation by exactly kStepDurationNs, independent of how late the caller runs it,
+ * so the motion no longer depends on scheduling jitter or machine load. All external influences (window moves,
+ * resizes, forces, state switches, shape resets) enter through QueueInput() and are applied at the start of the
+ * next step. With recording enabled the inputs are stored together with the tick they were applied at,
+ * so Replay() reproduces a live session exactly. Everything random in the simulation is drawn from the seeded
+ * generator in the state, which the recording's initial state carries along.
+ *
+ * Step() and GetState() must not run concurrently (BlobAnimation serializes them with its points mutex);
+ * QueueInput() may be called from any thread.
+ */
+class BlobSimulation {
+public:
+    /** @brief Simulated time covered by one Step() (120 Hz). */
+    static constexpr qint64 kStepDurationNs = 8'333'333;
+
+    /**
+     * @brief Constructs an empty simulation (no points, invalid viewport, idle state).
+     * @param params Blob appearance parameters (radius, point count, border and glow size are used).
+     * @param physics_params Blob physics parameters.
+     */
+    BlobSimulation(const BlobConfig::BlobParameters &params, const BlobConfig::PhysicsParameters &physics_params);
+
+    /**
+     * @brief Queues an input to be applied before the next step. Thread-safe.
+     * @param event The input. Its tick is assigned when it is applied.
+     */
+    void QueueInput(BlobInputEvent event);
+
+    /**
+     * @brief Applies all queued inputs now, stamping them with the current tick.
+     * Step() does this itself; calling it directly makes inputs visible before the first step.
+     */
+    void ApplyPendingInputs();
+
+    /**
+     * @brief Advances the simulation by one fixed step.
+     * Applies the queued inputs, the active state's effect (every kStateUpdateInterval steps), the physics step,
+     * border collisions, smoothing and neighbor distance constraints.
+     */
+    void Step();
+
+    /**
+     * @brief Gets the complete simulation state.
+     * @return Reference to the state, valid until the next Step() or ApplyPendingInputs().
+     */
+    [[nodiscard]] const BlobSimulationState &GetState() const { return state_; }
+
+    /**
+     * @brief Checks whether the blob has come to rest.
+     * A settled simulation changes nothing visible per step, so the caller may stop stepping until the next input.
+     * @return True if no control point moved more than kSettleDistance per step for kSettleSteps consecutive steps
+     * and no input arrived since.
+     */
+    [[nodiscard]] bool IsSettled() const { return resting_steps_ >= kSettleSteps; }
+
+    /**
+     * @brief Starts recording: snapshots the current state and stores every input applied from now on.
+     * Restarts a recording in progress.
+     */
+    void StartRecording();
+
+    /**
+     * @brief Stops recording.
+     * @return The recording since StartRecording() (empty if none was started).
+     */
+    BlobRecording StopRecording();
+
+    /**
+     * @brief Checks whether a recording is in progress.
+     * @return True between StartRecording() and StopRecording().
+     */
+    [[nodiscard]] bool IsRecording() const { return recording_active_; }
+
+    /**
+     * @brief Re-runs a recording headlessly, feeding every input at the tick it was originally applied.
+     * @param recording The recording to replay.
+     * @param on_step Optional callback invoked with the state after every step.
+     * @return The state at the recording's end tick.
+     */
+    static BlobSimulationState Replay(const BlobRecording &recording,
+                                      const std::function<void(const BlobSimulationState &)> &on_step = {});
+
+private:
+    /**
+     * @brief Number of steps between two applications of the active state's effect.
+     * The state effects advance their phases per call and were tuned for the former ~60 Hz animation timer.
+     */
+    static constexpr quint64 kStateUpdateInterval = 2;
+
+    /**
+     * @brief Number of consecutive resting steps after which the blob counts as settled.
+     * The shape stabilization keeps nudging points for a moment after their velocities dropped to zero.
+     */
+    static constexpr quint64 kSettleSteps = 60;
+    /**
+     * @brief Largest per-step movement (in pixels) of any control point that still counts as resting.
+     * Measured on the final positions: the physics step's own is_in_motion flag also reports velocities
+     * that the neighbor constraints cancel out again, so it stays set for a blob that is visibly still.
+     */
+    static constexpr float kSettleDistance = 0.01f;
+
+    /**
+     * @brief Measures how far the control points moved since the previous call and remembers the new positions.
+     * @return The largest squared displacement, or infinity if the point count changed.
+     */
+    float UpdateMaxDisplacementSquared();
+
+    /**
+     * @brief Applies a single input to the state.
+     * @param event The input to apply.
+     */
+    void ApplyInput(const BlobInputEvent &event);
+
+    /**
+     * @brief Gets the state object matching state_.animation_state.
+     * @return Pointer to the idle, moving or resizing state.
+     */
+    BlobState *ActiveState();
+
+    /** @brief Blob appearance parameters; screen_width/height follow the viewport. */
+    BlobConfig::BlobParameters params_;
+    /** @brief Physics simulation parameters. */
+    BlobConfig::PhysicsParameters physics_params_;
+    /** @brief The evolving simulation state (includes the idle state, which carries animation phases). */
+    BlobSimulationState state_;
+    /** @brief Moving state logic (stateless). */
+    MovingState moving_state_;
+    /** @brief Resizing state logic (stateless). */
+    ResizingState resizing_state_;
+
+    /** @brief Consecutive steps in which no control point moved more than kSettleDistance. */
+    quint64 resting_steps_ = 0;
+    /** @brief Control point positions after the previous step, x coordinates. */
+    std::vector<float> settle_reference_x_;
+    /** @brief Control point positions after the previous step, y coordinates. */
+    std::vector<float> settle_reference_y_;
+
+    /** @brief Protects pending_inputs_. */
+    std::mutex input_mutex_;
+    /** @brief Inputs queued since the last step. Protected by input_mutex_. */
+    std::vector<BlobInputEvent> pending_inputs_;
+    /** @brief Inputs being applied; swapped with pending_inputs_ to keep the lock short and reuse capacity. */
+    std::vector<BlobInputEvent> applying_inputs_;
+
+    /** @brief Flag indicating if applied inputs are recorded. */
+    bool recording_active_ = false;
+    /** @brief Recording in progress. */
+    BlobRecording recording_;
+};
+
+#endif // BLOB_SIMULATION_H
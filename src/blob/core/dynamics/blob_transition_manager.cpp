@@ -7,12 +7,7 @@ BlobTransitionManager::BlobTransitionManager(QObject *parent)
 }
 
 void BlobTransitionManager::ProcessMovementBuffer(
-    std::vector<QPointF> &velocity,
-    QPointF &blob_center,
-    std::vector<QPointF> &control_points,
-    const float blob_radius,
-    const std::function<void(std::vector<QPointF> &, QPointF &, std::vector<QPointF> &, float, QVector2D)> &
-    ApplyInertiaForce,
+    const std::function<void(const QVector2D &)> &ApplyInertiaForce,
     const std::function<void(const QPointF &)> &SetLastWindowPos) {
     if (is_resizing_) {
         return;
@@ -57,13 +52,7 @@ void BlobTransitionManager::ProcessMovementBuffer(
         significant_movement || current_time - last_movement_time_ < 200) {
         if (significant_movement) {
             const QVector2D scaled_velocity = m_smoothed_velocity_ * 0.6;
-            ApplyInertiaForce(
-                velocity,
-                blob_center,
-                control_points,
-                blob_radius,
-                scaled_velocity
-            );
+            ApplyInertiaForce(scaled_velocity);
 
             SetLastWindowPos(movement_buffer_.back().position);
 
@@ -2,6 +2,7 @@
 #define BLOB_TRANSITION_MANAGER_H
 
 #include <deque>
+#include <functional>
 #include <QObject>
 #include <QVector2D>
 
@@ -39,20 +40,11 @@ public:
      * significantMovementDetected(). If movement stops, it increments the inactivity counter
      * and emits movementStopped() after a period of inactivity.
      *
-     * @param velocity Reference to the vector storing velocities of blob control points (modified by ApplyInertiaForce).
-     * @param blob_center Reference to the blob's center position (modified by ApplyInertiaForce).
-     * @param control_points Reference to the vector storing blob control points (modified by ApplyInertiaForce).
-     * @param blob_radius The current radius of the blob.
-     * @param ApplyInertiaForce A function callback to apply the calculated inertia force to the blob's state.
+     * @param ApplyInertiaForce A function callback applying the calculated inertia force (scaled window velocity) to the blob.
      * @param SetLastWindowPos A function callback to update the last known window position used by dynamics.
      */
     void ProcessMovementBuffer(
-        std::vector<QPointF> &velocity,
-        QPointF &blob_center,
-        std::vector<QPointF> &control_points,
-        float blob_radius,
-        const std::function<void(std::vector<QPointF> &, QPointF &, std::vector<QPointF> &, float, QVector2D)> &
-        ApplyInertiaForce,
+        const std::function<void(const QVector2D &)> &ApplyInertiaForce,
         const std::function<void(const QPointF &)> &SetLastWindowPos
     );
 
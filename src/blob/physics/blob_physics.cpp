@@ -1,493 +1,457 @@
 #include "blob_physics.h"
 
-#include <qfuture.h>
+#include <algorithm>
+#include <chrono>
+#include <limits>
 #include <qmath.h>
-#include <QRandomGenerator>
-#include <qtconcurrentrun.h>
+#include <thread>
 
+#include "blob_physics_kernels.h"
 #include "../utils/blob_math.h"
 #include "../blob_config.h"
+#include "../../util/parallel_for_pool.h"
+#include "../../util/profiling/trace_profiler.h"
 
 
 BlobPhysics::BlobPhysics() {
     physics_timer_.start();
-    thread_pool_.setMaxThreadCount(QThread::idealThreadCount());
 }
 
-void BlobPhysics::InitializeBlob(std::vector<QPointF> &control_points,
-                                 std::vector<QPointF> &target_points,
-                                 std::vector<QPointF> &velocity,
+void BlobPhysics::InitializeBlob(BlobPoints &points,
                                  QPointF &blob_center,
                                  const BlobConfig::BlobParameters &params,
-                                 const int width, const int height) {
+                                 const int width, const int height,
+                                 BlobRandomGenerator &random) {
     blob_center = QPointF(width / 2.0, height / 2.0);
-
-    control_points = BlobMath::GenerateCircularPoints(blob_center, params.blob_radius, params.num_of_points);
-    target_points = control_points;
-
-    velocity.resize(params.num_of_points);
-    for (auto &vel: velocity) {
-        vel = QPointF(0, 0);
-    }
+    points.AssignShape(BlobMath::GenerateCircularPoints(blob_center, params.blob_radius, params.num_of_points),
+                       random);
 }
 
-void BlobPhysics::UpdatePhysicsOptimized(std::vector<QPointF> &control_points,
-                                         const std::vector<QPointF> &target_points,
-                                         std::vector<QPointF> &velocity,
-                                         const QPointF &blob_center,
-                                         const BlobConfig::BlobParameters &params,
-                                         const BlobConfig::PhysicsParameters &physics_params) {
-    const auto expected_size = static_cast<size_t>(params.num_of_points);
-    if (control_points.size() != expected_size ||
-        target_points.size() != expected_size ||
-        velocity.size() != expected_size) {
-        qCritical() << "[BLOB PHYSICS]::updatePhysicsOptimized - Inconsistent vector sizes!";
-        qCritical() << "[BLOB PHYSICS] controlPoints:" << control_points.size()
-                << "targetPoints:" << target_points.size()
-                << "velocity:" << velocity.size()
-                << "expected:" << expected_size;
-        return;
-    }
-
-    const size_t num_of_points = control_points.size();
-
-    static std::vector<float> pos_x, pos_y, target_x, target_y, velocity_x, vel_y, force_x, force_y;
-
-    // memory allocation
-    if (pos_x.size() != num_of_points) {
-        pos_x.resize(num_of_points);
-        pos_y.resize(num_of_points);
-        target_x.resize(num_of_points);
-        target_y.resize(num_of_points);
-        velocity_x.resize(num_of_points);
-        vel_y.resize(num_of_points);
-        force_x.resize(num_of_points);
-        force_y.resize(num_of_points);
-    }
-
-    // conversion to optimized structures (SoA)
-    const auto center_x = static_cast<float>(blob_center.x());
-    const auto center_y = static_cast<float>(blob_center.y());
-    const auto radius_threshold = static_cast<float>(params.blob_radius * 1.1f);
-    const float radius_threshold_squared = radius_threshold * radius_threshold;
-    const auto damping_factor = static_cast<float>(physics_params.damping);
-    const auto viscosity = static_cast<float>(physics_params.viscosity);
-    const auto velocity_threshold = static_cast<float>(physics_params.velocity_threshold);
-    const float velocity_threshold_squared = velocity_threshold * velocity_threshold;
-    const auto max_speed = static_cast<float>(params.blob_radius * physics_params.max_speed);
-    const float max_speed_squared = max_speed * max_speed;
-
-#pragma omp parallel for
-    for (int i = 0; i < num_of_points; ++i) {
-        pos_x[i] = static_cast<float>(control_points[i].x());
-        pos_y[i] = static_cast<float>(control_points[i].y());
-        target_x[i] = static_cast<float>(target_points[i].x());
-        target_y[i] = static_cast<float>(target_points[i].y());
-        velocity_x[i] = static_cast<float>(velocity[i].x());
-        vel_y[i] = static_cast<float>(velocity[i].y());
-        force_x[i] = 0.0f;
-        force_y[i] = 0.0f;
-    }
-
-    bool is_in_motion = false;
-
-    constexpr int block_size = 64; // cache line-based block size
-
-#pragma omp parallel for reduction(|:isInMotion)
-    for (int block_start = 0; block_start < num_of_points; block_start += block_size) {
-        const int block_end = std::min(block_start + block_size, static_cast<int>(num_of_points));
-
-        for (int i = block_start; i < block_end; ++i) {
-            force_x[i] = (target_x[i] - pos_x[i]) * viscosity;
-            force_y[i] = (target_y[i] - pos_y[i]) * viscosity;
-
-            const float vector_to_center_x = center_x - pos_x[i];
-            const float vector_to_center_y = center_y - pos_y[i];
-
-            if (const float distance_squared = vector_to_center_x * vector_to_center_x + vector_to_center_y *
-                                               vector_to_center_y; distance_squared > radius_threshold_squared) {
-                const float inversed_distance = 1.0f / sqrtf(distance_squared);
-                const float factor = 0.03f * inversed_distance;
-                force_x[i] += vector_to_center_x * factor;
-                force_y[i] += vector_to_center_y * factor;
+namespace {
+    /** @brief Largest blob that keeps the blended step; bigger ones use the SIMD kernel. */
+    constexpr size_t kBlendedStepPointLimit = 64;
+
+    /** @brief Chunk sizes are multiples of the widest kernel (16 floats), so every chunk starts aligned. */
+    constexpr size_t kChunkAlignment = 16;
+
+    /**
+     * @brief Exposes the range [begin, end) of the SoA arrays of the blob to the SIMD kernels.
+     */
+    BlobPhysicsKernels::PointArrays KernelArrays(BlobPoints &points, const size_t begin, const size_t end) {
+        return {
+            points.position_x.data() + begin, points.position_y.data() + begin,
+            points.velocity_x.data() + begin, points.velocity_y.data() + begin,
+            points.target_x.data() + begin, points.target_y.data() + begin,
+            end - begin
+        };
+    }
+
+    BlobPhysicsKernels::StepParameters MakeKernelStepParameters(const QPointF &blob_center,
+                                                                const BlobConfig::BlobParameters &params,
+                                                                const BlobConfig::PhysicsParameters &physics_params) {
+        const auto radius_threshold = static_cast<float>(params.blob_radius * 1.1f);
+        const auto velocity_threshold = static_cast<float>(physics_params.velocity_threshold);
+        const auto max_speed = static_cast<float>(params.blob_radius * physics_params.max_speed);
+
+        BlobPhysicsKernels::StepParameters step_params{};
+        step_params.center_x = static_cast<float>(blob_center.x());
+        step_params.center_y = static_cast<float>(blob_center.y());
+        step_params.radius_threshold_squared = radius_threshold * radius_threshold;
+        step_params.viscosity = static_cast<float>(physics_params.viscosity);
+        step_params.damping = static_cast<float>(physics_params.damping);
+        step_params.velocity_threshold_squared = velocity_threshold * velocity_threshold;
+        step_params.max_speed = max_speed;
+        step_params.max_speed_squared = max_speed * max_speed;
+        return step_params;
+    }
+
+    /**
+     * @brief Precomputed constants of the blended physics step (UpdatePhysics / UpdatePhysicsParallel).
+     */
+    struct BlendedStepParameters {
+        double center_x;
+        double center_y;
+        double viscosity;
+        double radius_threshold_squared;
+        double damping_factor;
+        double velocity_threshold_squared;
+        double max_speed;
+        double max_speed_squared;
+    };
+
+    /**
+     * @brief Physics step with the 0.8 / 0.2 blend between the new and the previous velocity.
+     * Every point only reads and writes its own elements, so disjoint ranges can run concurrently.
+     * @return True if any point in [begin, end) is still moving.
+     */
+    bool StepBlendedRange(BlobPoints &points, const BlendedStepParameters &step, const size_t begin,
+                          const size_t end) {
+        constexpr double prev_velocity_blend = 0.2;
+        constexpr double velocity_blend = 0.8;
+        bool is_in_motion = false;
+
+        for (size_t i = begin; i < end; ++i) {
+            const double position_x = points.position_x[i];
+            const double position_y = points.position_y[i];
+            const double previous_velocity_x = points.velocity_x[i];
+            const double previous_velocity_y = points.velocity_y[i];
+
+            double force_x = (points.target_x[i] - position_x) * step.viscosity;
+            double force_y = (points.target_y[i] - position_y) * step.viscosity;
+
+            const double vector_to_center_x = step.center_x - position_x;
+            const double vector_to_center_y = step.center_y - position_y;
+
+            if (const double dist_from_center_squared =
+                        vector_to_center_x * vector_to_center_x + vector_to_center_y * vector_to_center_y;
+                dist_from_center_squared > step.radius_threshold_squared) {
+                const double factor = 0.03 / qSqrt(dist_from_center_squared);
+                force_x += vector_to_center_x * factor;
+                force_y += vector_to_center_y * factor;
             }
 
-            velocity_x[i] += force_x[i];
-            vel_y[i] += force_y[i];
-
-            // applying velocity blending (damping)
-            velocity_x[i] *= damping_factor;
-            vel_y[i] *= damping_factor;
+            // velocity blend
+            double velocity_x = (previous_velocity_x + force_x) * velocity_blend + previous_velocity_x *
+                                prev_velocity_blend;
+            double velocity_y = (previous_velocity_y + force_y) * velocity_blend + previous_velocity_y *
+                                prev_velocity_blend;
+            velocity_x *= step.damping_factor;
+            velocity_y *= step.damping_factor;
 
-            const float speed_squared = velocity_x[i] * velocity_x[i] + vel_y[i] * vel_y[i];
+            const double speed_squared = velocity_x * velocity_x + velocity_y * velocity_y;
 
-            if (speed_squared < velocity_threshold_squared) {
-                velocity_x[i] = 0.0f;
-                vel_y[i] = 0.0f;
+            if (speed_squared < step.velocity_threshold_squared) {
+                velocity_x = 0.0;
+                velocity_y = 0.0;
             } else {
                 is_in_motion = true;
 
-                if (speed_squared > max_speed_squared) {
-                    const float scaleFactor = max_speed / sqrtf(speed_squared);
-                    velocity_x[i] *= scaleFactor;
-                    vel_y[i] *= scaleFactor;
+                if (speed_squared > step.max_speed_squared) {
+                    const double scale_factor = step.max_speed / qSqrt(speed_squared);
+                    velocity_x *= scale_factor;
+                    velocity_y *= scale_factor;
                 }
             }
 
-            pos_x[i] += velocity_x[i];
-            pos_y[i] += vel_y[i];
+            points.velocity_x[i] = static_cast<float>(velocity_x);
+            points.velocity_y[i] = static_cast<float>(velocity_y);
+            points.position_x[i] = static_cast<float>(position_x + velocity_x);
+            points.position_y[i] = static_cast<float>(position_y + velocity_y);
         }
-    }
 
-#pragma omp parallel for
-    for (int i = 0; i < num_of_points; ++i) {
-        control_points[i].rx() = pos_x[i];
-        control_points[i].ry() = pos_y[i];
-        velocity[i].rx() = velocity_x[i];
-        velocity[i].ry() = vel_y[i];
+        return is_in_motion;
+    }
+
+    BlendedStepParameters MakeBlendedStepParameters(const QPointF &blob_center,
+                                                    const BlobConfig::BlobParameters &params,
+                                                    const BlobConfig::PhysicsParameters &physics_params) {
+        const double radius_threshold = params.blob_radius * 1.1;
+        const double max_speed = params.blob_radius * physics_params.max_speed;
+
+        return {
+            blob_center.x(),
+            blob_center.y(),
+            physics_params.viscosity,
+            radius_threshold * radius_threshold,
+            physics_params.damping,
+            physics_params.velocity_threshold * physics_params.velocity_threshold,
+            max_speed,
+            max_speed * max_speed
+        };
+    }
+
+    /**
+     * @brief Checks the point count against the configured one, logging a mismatch.
+     */
+    bool HasExpectedSize(const BlobPoints &points, const BlobConfig::BlobParameters &params, const char *caller) {
+        if (points.Size() == static_cast<size_t>(params.num_of_points)) {
+            return true;
+        }
+        qCritical() << "[BLOB PHYSICS]::" << caller << "- Inconsistent point count! points:" << points.Size()
+                << "expected:" << params.num_of_points;
+        return false;
+    }
+
+    /**
+     * @brief Calibrated per-point costs of the single-threaded physics steps.
+     */
+    struct StepCostModel {
+        /** @brief Cost of the scalar blended step per point. */
+        double blended_ns_per_point;
+        /** @brief Cost of the SIMD kernel step per point. */
+        double kernel_ns_per_point;
+    };
+
+    /**
+     * @brief Calibrated fixed cost of a threaded physics step.
+     */
+    struct DispatchCostModel {
+        /** @brief Round trip of an empty ParallelForPool job with parked workers. */
+        double dispatch_ns;
+        /** @brief Number of threads taking part in a pool job. */
+        int participants;
+    };
+
+    /**
+     * @brief Waking parked workers takes at least this long (a futex round trip); a threaded step saving less
+     * than this over the single-threaded one cannot win, so the pool is not even started for it.
+     */
+    constexpr double kMinimumDispatchNs = 2000.0;
+
+    /**
+     * @brief Splits a threaded step into about four chunks per participant (for stealing), rounded up to
+     * whole kernel widths.
+     */
+    size_t ThreadedChunkSize(const size_t num_of_points, const int participants) {
+        const size_t target = num_of_points / (static_cast<size_t>(participants) * 4);
+        return std::max(kChunkAlignment, (target + kChunkAlignment - 1) / kChunkAlignment * kChunkAlignment);
+    }
+
+    /**
+     * @brief Runs the function repeat times and returns the fastest run in nanoseconds.
+     */
+    template<typename Function>
+    double MinimumDurationNs(const int repeat, Function &&function) {
+        double best = std::numeric_limits<double>::max();
+        for (int i = 0; i < repeat; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            function();
+            const auto end = std::chrono::steady_clock::now();
+            best = std::min(best, static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                      end - start).count()));
+        }
+        return best;
+    }
+
+    /**
+     * @brief Measures both single-threaded physics steps on a synthetic blob. Takes about a millisecond.
+     */
+    StepCostModel CalibrateStepCosts() {
+        constexpr size_t kCalibrationPoints = 4096;
+        constexpr int kRepeat = 5;
+
+        const BlobConfig::BlobParameters params{};
+        const BlobConfig::PhysicsParameters physics_params{};
+        const QPointF center(0.0, 0.0);
+
+        BlobPoints points;
+        BlobRandomGenerator random;
+        points.AssignShape(BlobMath::GenerateCircularPoints(center, params.blob_radius, kCalibrationPoints), random);
+        for (size_t i = 0; i < points.Size(); ++i) {
+            points.target_x[i] *= 1.1f;
+            points.target_y[i] *= 1.1f;
+        }
+
+        const BlendedStepParameters blended_step = MakeBlendedStepParameters(center, params, physics_params);
+        const BlobPhysicsKernels::StepParameters kernel_step =
+                MakeKernelStepParameters(center, params, physics_params);
+
+        StepCostModel model{};
+        model.blended_ns_per_point = MinimumDurationNs(kRepeat, [&] {
+            StepBlendedRange(points, blended_step, 0, points.Size());
+        }) / kCalibrationPoints;
+        model.kernel_ns_per_point = MinimumDurationNs(kRepeat, [&] {
+            BlobPhysicsKernels::Step(KernelArrays(points, 0, points.Size()), kernel_step);
+        }) / kCalibrationPoints;
+
+        qDebug() << "[BLOB PHYSICS] Calibrated step costs: blended" << model.blended_ns_per_point
+                << "ns/point, SIMD" << model.kernel_ns_per_point << "ns/point";
+        return model;
+    }
+
+    /**
+     * @brief Starts the pool and measures the wake-up latency of its parked workers. Takes a few milliseconds.
+     */
+    DispatchCostModel CalibrateDispatchCost() {
+        constexpr int kDispatchSamples = 7;
+
+        ParallelForPool *pool = ParallelForPool::GetInstance();
+        DispatchCostModel model{};
+        model.participants = pool->GetParticipantCount();
+        model.dispatch_ns = std::numeric_limits<double>::max();
+
+        if (model.participants > 1) {
+            // physics steps are ~8 ms apart, so the workers are parked by then: sleep past the spin phase
+            // before every sample and take the median
+            std::vector<double> samples;
+            for (int i = 0; i < kDispatchSamples; ++i) {
+                std::this_thread::sleep_for(std::chrono::microseconds(500));
+                samples.push_back(MinimumDurationNs(1, [pool, &model] {
+                    pool->ParallelFor(model.participants * kChunkAlignment, kChunkAlignment,
+                                      [](size_t, size_t) {
+                                      });
+                }));
+            }
+            std::nth_element(samples.begin(), samples.begin() + kDispatchSamples / 2, samples.end());
+            model.dispatch_ns = samples[kDispatchSamples / 2];
+        }
+
+        qDebug() << "[BLOB PHYSICS] Calibrated pool wake-up:" << model.dispatch_ns / 1000.0 << "us with"
+                << model.participants << "participants";
+        return model;
     }
 
-    if (!is_in_motion) {
-        StabilizeBlob(control_points, blob_center, params.blob_radius, physics_params.stabilization_rate);
+    const StepCostModel &GetStepCostModel() {
+        static const StepCostModel model = CalibrateStepCosts();
+        return model;
     }
 
-    ValidateAndRepairControlPoints(control_points, velocity, blob_center, params.blob_radius);
+    const DispatchCostModel &GetDispatchCostModel() {
+        static const DispatchCostModel model = CalibrateDispatchCost();
+        return model;
+    }
 }
 
-void BlobPhysics::UpdatePhysicsParallel(std::vector<QPointF> &control_points,
-                                        std::vector<QPointF> &target_points,
-                                        std::vector<QPointF> &velocity,
-                                        const QPointF &blob_center,
-                                        const BlobConfig::BlobParameters &params,
-                                        const BlobConfig::PhysicsParameters &physics_params) {
-    const auto expected_size = static_cast<size_t>(params.num_of_points);
-    if (control_points.size() != expected_size ||
-        target_points.size() != expected_size ||
-        velocity.size() != expected_size) {
-        qCritical() << "[BLOB PHYSICS]::updatePhysicsParallel - Inconsistent vector sizes!";
-        qCritical() << "[BLOB PHYSICS] controlPoints:" << control_points.size()
-                << "targetPoints:" << target_points.size()
-                << "velocity:" << velocity.size()
-                << "expected:" << expected_size;
+void BlobPhysics::UpdatePhysicsOptimized(BlobPoints &points,
+                                         const QPointF &blob_center,
+                                         const BlobConfig::BlobParameters &params,
+                                         const BlobConfig::PhysicsParameters &physics_params,
+                                         BlobRandomGenerator &random) {
+    TRACE_ZONE("BlobPhysics::UpdatePhysicsOptimized");
+    if (!HasExpectedSize(points, params, "updatePhysicsOptimized")) {
         return;
     }
 
-    const size_t initial_control_points_size = control_points.size();
-    const size_t num_of_points = initial_control_points_size;
+    const BlobPhysicsKernels::StepParameters step_params =
+            MakeKernelStepParameters(blob_center, params, physics_params);
 
-    // 24 points is the minimum number for parallel processing (keep in mind that 24 is a stiff lower limit)
-    if (num_of_points < 24) {
-        UpdatePhysics(control_points, target_points, velocity, blob_center, params, physics_params);
-        return;
+    if (const bool is_in_motion = BlobPhysicsKernels::Step(KernelArrays(points, 0, points.Size()), step_params);
+        !is_in_motion) {
+        StabilizeBlob(points, blob_center, params.blob_radius, physics_params.stabilization_rate);
     }
 
-    if (num_of_points > 64) {
-        UpdatePhysicsOptimized(control_points, target_points, velocity, blob_center, params, physics_params);
-        return;
-    }
+    ValidateAndRepairControlPoints(points, blob_center, params.blob_radius, random);
+}
 
-    const int num_of_threads = qMin(thread_pool_.maxThreadCount(), static_cast<int>(num_of_points / 8 + 1));
-    const int batch_size = std::max(1, static_cast<int>(num_of_points) / thread_pool_.maxThreadCount());
-    std::vector<std::pair<int, int> > ranges;
+BlobPhysics::ExecutionMode BlobPhysics::SelectExecutionMode(const size_t num_of_points) {
+    const StepCostModel &costs = GetStepCostModel();
+    const bool is_blended = num_of_points <= kBlendedStepPointLimit;
+    const ExecutionMode single_thread_mode = is_blended ? ExecutionMode::kSerial : ExecutionMode::kSimd;
+    const double ns_per_point = is_blended ? costs.blended_ns_per_point : costs.kernel_ns_per_point;
+    const double single_thread_ns = ns_per_point * static_cast<double>(num_of_points);
 
-    for (int i = 0; i < static_cast<int>(num_of_points); i += batch_size) {
-        ranges.emplace_back(i, std::min(i + batch_size, static_cast<int>(num_of_points)));
-    }
+    // chunks smaller than the participant count leave some threads without work
+    const size_t chunk_count = (num_of_points + kChunkAlignment - 1) / kChunkAlignment;
+    const auto busy_threads = [chunk_count](const int participants) {
+        return static_cast<double>(std::min<size_t>(chunk_count, participants));
+    };
 
-    const double radius_threshold = params.blob_radius * 1.1;
-    const double radius_threshold_squared = radius_threshold * radius_threshold;
-    const double damping_factor = physics_params.damping;
-    const double max_speed = params.blob_radius * physics_params.max_speed;
-    const double velocity_threshold_squared = physics_params.velocity_threshold * physics_params.velocity_threshold;
-    const double max_speed_squared = max_speed * max_speed;
-
-    if (velocity.size() != num_of_points) {
-        qCritical() << "[BLOB PHYSICS]::updatePhysicsParallel - Size of 'velocity' (" << velocity.size() <<
-                ") changed before copying! Expected:" << num_of_points;
-        assert(false && "[BLOB PHYSICS]::updatePhysicsParallel - Size of 'velocity' changed before copying!");
+    // the pool is only started (and its wake-up measured) once a step is big enough to pay for a wake-up
+    if (const double best_case_threads = busy_threads(ParallelForPool::GetDefaultParticipantCount());
+        best_case_threads <= 1 || single_thread_ns - single_thread_ns / best_case_threads <= kMinimumDispatchNs) {
+        return single_thread_mode;
     }
 
-    static std::vector<QPointF> previous_velocity;
-    if (previous_velocity.size() != num_of_points) {
-        previous_velocity.resize(num_of_points);
-    }
-    if (velocity.size() != previous_velocity.size()) {
-        qCritical() << "[BLOB PHYSICS]::updatePhysicsParallel - Inconsistent sizes of 'velocity' (" << velocity.size()
-                << ") and 'previousVelocity' (" << previous_velocity.size() << ") before std::copy!";
-        assert(
-            false &&
-            "[BLOB PHYSICS]::updatePhysicsParallel Inconsistent sizes of velocity and previousVelocity before std::copy!");
+    const DispatchCostModel &dispatch = GetDispatchCostModel();
+    if (const double threaded_threads = busy_threads(dispatch.participants);
+        threaded_threads > 1 && single_thread_ns / threaded_threads + dispatch.dispatch_ns < single_thread_ns) {
+        return ExecutionMode::kThreaded;
     }
+    return single_thread_mode;
+}
 
-    std::ranges::copy(velocity, previous_velocity.begin());
-    std::atomic is_in_motion(false);
-    QVector<QFuture<void> > futures;
-    futures.reserve(num_of_threads);
+void BlobPhysics::UpdatePhysicsParallel(BlobPoints &points,
+                                        const QPointF &blob_center,
+                                        const BlobConfig::BlobParameters &params,
+                                        const BlobConfig::PhysicsParameters &physics_params,
+                                        BlobRandomGenerator &random) {
+    TRACE_ZONE("BlobPhysics::UpdatePhysicsParallel");
+    if (!HasExpectedSize(points, params, "updatePhysicsParallel")) {
+        return;
+    }
 
-    for (int t = 0; t < num_of_threads; ++t) {
-        constexpr double prev_velocity_blend = 0.2;
-        constexpr double velocity_blend = 0.8;
-        const size_t start_idx = t * (num_of_points / num_of_threads);
-        const size_t end_idx = t == num_of_threads - 1 ? num_of_points : (t + 1) * (num_of_points / num_of_threads);
-
-        if (start_idx >= num_of_points || end_idx > num_of_points || start_idx > end_idx) {
-            qCritical() << "[BLOB PHYSICS]::updatePhysicsParallel - Invalid scope for the thread" << t <<
-                    "! startIdx:"
-                    << start_idx << "endIdx:" << end_idx << "numPoints:" << num_of_points;
-            assert(false && "[BLOB PHYSICS]::updatePhysicsParallel - Invalid scope for the thread!");
-        }
+    const size_t num_of_points = points.Size();
 
-        futures.append(QtConcurrent::run(&thread_pool_, [&, start_idx, end_idx, radius_threshold_squared,
-                                             damping_factor, velocity_blend, prev_velocity_blend,
-                                             velocity_threshold_squared, max_speed_squared] {
-                                             const double center_x = blob_center.x();
-                                             const double center_y = blob_center.y();
-
-                                             for (size_t batch_start = start_idx; batch_start < end_idx;
-                                                  batch_start += batch_size) {
-                                                 const size_t batch_end = qMin(batch_start + batch_size, end_idx);
-
-                                                 if (batch_start >= num_of_points || batch_end > num_of_points ||
-                                                     batch_start > batch_end) {
-                                                     qCritical() <<
-                                                             "[BLOB PHYSICS]::updatePhysicsParallel - Incorrect batch range! batchStart:"
-                                                             << batch_start << "batchEnd:" << batch_end << "numPoints:"
-                                                             << num_of_points << "Thread:" <<
-                                                             QThread::currentThreadId();
-                                                     assert(
-                                                         false &&
-                                                         "[BLOB PHYSICS]::updatePhysicsParallel - Incorrect batch range!");
-                                                 }
-
-                                                 for (size_t i = batch_start; i < batch_end; ++i) {
-                                                     const size_t current_control_points_size = control_points.size();
-
-                                                     if (i >= current_control_points_size) {
-                                                         qCritical() <<
-                                                                 "[BLOB PHYSICS]::updatePhysicsParallel - DISCOVERED ACCESS OVER THE SCOPE of controlPoints! Index 'i':"
-                                                                 << i
-                                                                 << "Current size:" << current_control_points_size
-                                                                 << "Expected size (numPoints):" << num_of_points
-                                                                 << "Thread scope:" << start_idx << "-" << end_idx
-                                                                 << "Batch scope:" << batch_start << "-" << batch_end
-                                                                 << "Thread ID:" << QThread::currentThreadId();
-                                                         assert(
-                                                             false &&
-                                                             "[BLOB PHYSICS]::updatePhysicsParallel - Access outside the range of controlPoints in a parallel loop!");
-                                                     }
-
-                                                     QPointF &current_point = control_points[i];
-
-                                                     const size_t current_target_points_size = target_points.size();
-                                                     if (i >= current_target_points_size) {
-                                                         qCritical() <<
-                                                                 "BlobPhysics::updatePhysicsParallel - Access beyond the scope of targetPoints! Index 'i':"
-                                                                 << i << "Current size:" <<
-                                                                 current_target_points_size << "Thread ID:" <<
-                                                                 QThread::currentThreadId();
-                                                         assert(
-                                                             false &&
-                                                             "[BLOB PHYSICS]::updatePhysicsParallel - Access beyond the scope of targetPoints!!");
-                                                     }
-                                                     const size_t current_velocity_size = velocity.size();
-
-                                                     if (i >= current_velocity_size) {
-                                                         qCritical() <<
-                                                                 "[BLOB PHYSICS]::updatePhysicsParallel - Access beyond the scope of velocity! Index 'i':"
-                                                                 << i << "Current size:" << current_velocity_size <<
-                                                                 "Thread ID:" << QThread::currentThreadId();
-                                                         assert(
-                                                             false &&
-                                                             "[BLOB PHYSICS]::updatePhysicsParallel - Access beyond the scope of velocity!");
-                                                     }
-
-                                                     const size_t previous_velocity_size = previous_velocity.size();
-
-                                                     if (i >= previous_velocity_size) {
-                                                         qCritical() <<
-                                                                 "[BLOB PHYSICS]::updatePhysicsParallel - Access beyond the scope of previousVelocity! Index 'i':"
-                                                                 << i << "Current size:" << previous_velocity_size
-                                                                 << "Thread ID:" << QThread::currentThreadId();
-                                                         assert(
-                                                             false &&
-                                                             "[BLOB PHYSICS]::updatePhysicsParallel - Access beyond the scope of previousVelocity!");
-                                                     }
-
-                                                     QPointF &current_target = target_points[i];
-                                                     QPointF &current_velocity = velocity[i];
-                                                     const QPointF &prev_velocity = previous_velocity[i];
-
-                                                     double force_x =
-                                                             (current_target.x() - current_point.x()) * physics_params.
-                                                             viscosity;
-                                                     double force_y =
-                                                             (current_target.y() - current_point.y()) * physics_params.
-                                                             viscosity;
-
-                                                     const double vector_to_center_x = center_x - current_point.x();
-                                                     const double vector_to_center_y = center_y - current_point.y();
-                                                     const double dist_from_center_squared =
-                                                             vector_to_center_x * vector_to_center_x +
-                                                             vector_to_center_y * vector_to_center_y;
-
-                                                     if (dist_from_center_squared > radius_threshold_squared) {
-                                                         const double factor = 0.03 / qSqrt(dist_from_center_squared);
-                                                         force_x += vector_to_center_x * factor;
-                                                         force_y += vector_to_center_y * factor;
-                                                     }
-
-                                                     current_velocity.rx() += force_x;
-                                                     current_velocity.ry() += force_y;
-
-                                                     // velocity blend
-                                                     current_velocity.rx() =
-                                                             current_velocity.x() * velocity_blend + prev_velocity.x() *
-                                                             prev_velocity_blend;
-                                                     current_velocity.ry() =
-                                                             current_velocity.y() * velocity_blend + prev_velocity.y() *
-                                                             prev_velocity_blend;
-                                                     current_velocity *= damping_factor;
-
-                                                     const double speed_squared =
-                                                             current_velocity.x() * current_velocity.x() +
-                                                             current_velocity.y() * current_velocity.y();
-
-                                                     if (speed_squared < velocity_threshold_squared) {
-                                                         current_velocity = QPointF(0, 0);
-                                                     } else {
-                                                         is_in_motion = true;
-
-                                                         if (speed_squared > max_speed_squared) {
-                                                             const double scale_factor =
-                                                                     max_speed / qSqrt(speed_squared);
-                                                             current_velocity *= scale_factor;
-                                                         }
-                                                     }
-
-                                                     current_point.rx() += current_velocity.x();
-                                                     current_point.ry() += current_velocity.y();
-                                                 }
-                                             }
-                                         }));
+    switch (SelectExecutionMode(num_of_points)) {
+        case ExecutionMode::kSerial:
+            UpdatePhysics(points, blob_center, params, physics_params, random);
+            return;
+        case ExecutionMode::kSimd:
+            UpdatePhysicsOptimized(points, blob_center, params, physics_params, random);
+            return;
+        case ExecutionMode::kThreaded:
+            break;
     }
 
-    for (auto &future: futures) {
-        future.waitForFinished();
+    ParallelForPool *pool = ParallelForPool::GetInstance();
+    const size_t chunk_size = ThreadedChunkSize(num_of_points, pool->GetParticipantCount());
+    std::atomic is_in_motion(false);
+
+    if (num_of_points <= kBlendedStepPointLimit) {
+        const BlendedStepParameters step = MakeBlendedStepParameters(blob_center, params, physics_params);
+        pool->ParallelFor(num_of_points, chunk_size, [&points, &step, &is_in_motion](const size_t begin,
+                                                                                    const size_t end) {
+            if (StepBlendedRange(points, step, begin, end)) {
+                is_in_motion.store(true, std::memory_order_relaxed);
+            }
+        });
+    } else {
+        const BlobPhysicsKernels::StepParameters step =
+                MakeKernelStepParameters(blob_center, params, physics_params);
+        pool->ParallelFor(num_of_points, chunk_size, [&points, &step, &is_in_motion](const size_t begin,
+                                                                                    const size_t end) {
+            if (BlobPhysicsKernels::Step(KernelArrays(points, begin, end), step)) {
+                is_in_motion.store(true, std::memory_order_relaxed);
+            }
+        });
     }
 
     if (!is_in_motion) {
-        StabilizeBlob(control_points, blob_center, params.blob_radius, physics_params.stabilization_rate);
+        StabilizeBlob(points, blob_center, params.blob_radius, physics_params.stabilization_rate);
     }
 
-    ValidateAndRepairControlPoints(control_points, velocity, blob_center, params.blob_radius);
+    ValidateAndRepairControlPoints(points, blob_center, params.blob_radius, random);
 }
 
-void BlobPhysics::UpdatePhysics(std::vector<QPointF> &control_points,
-                                const std::vector<QPointF> &target_points,
-                                std::vector<QPointF> &velocity,
+void BlobPhysics::UpdatePhysics(BlobPoints &points,
                                 const QPointF &blob_center,
                                 const BlobConfig::BlobParameters &params,
-                                const BlobConfig::PhysicsParameters &physics_params) {
-    const auto expected_size = static_cast<size_t>(params.num_of_points);
-
-    if (
-        control_points.size() != expected_size ||
-        target_points.size() != expected_size ||
-        velocity.size() != expected_size) {
-        qCritical() << "[BLOB PHYSICS]::updatePhysics - Inconsistent vector sizes!";
-        assert(false && "[BLOB PHYSICS]::updatePhysics - Inconsistent vector sizes!");
-    }
-
-    static std::vector<QPointF> previous_velocity;
-    if (previous_velocity.size() != velocity.size()) {
-        previous_velocity.resize(velocity.size());
+                                const BlobConfig::PhysicsParameters &physics_params,
+                                BlobRandomGenerator &random) {
+    if (!HasExpectedSize(points, params, "updatePhysics")) {
+        return;
     }
 
-    const double radius_threshold = params.blob_radius * 1.1;
-    const double damping_factor = physics_params.damping;
-    const double max_speed = params.blob_radius * physics_params.max_speed;
-
-    bool is_in_motion = false;
-
-    for (size_t i = 0; i < control_points.size(); ++i) {
-        constexpr double prev_velocity_blend = 0.2;
-        constexpr double velocity_blend = 0.8;
-        previous_velocity[i] = velocity[i];
-
-        QPointF force = (target_points[i] - control_points[i]) * physics_params.viscosity;
-
-        QPointF vector_to_center = blob_center - control_points[i];
-
-        if (const double dist_from_center_squared =
-                    vector_to_center.x() * vector_to_center.x() + vector_to_center.y() * vector_to_center.y();
-            dist_from_center_squared > radius_threshold * radius_threshold) {
-            const double factor = 0.03 / qSqrt(dist_from_center_squared);
-            force.rx() += vector_to_center.x() * factor;
-            force.ry() += vector_to_center.y() * factor;
-        }
-
-        velocity[i] += force;
-
-        // velocity blend
-        velocity[i].rx() = velocity[i].x() * velocity_blend + previous_velocity[i].x() * prev_velocity_blend;
-        velocity[i].ry() = velocity[i].y() * velocity_blend + previous_velocity[i].y() * prev_velocity_blend;
-        velocity[i] *= damping_factor;
-
-        const double speed_squared = velocity[i].x() * velocity[i].x() + velocity[i].y() * velocity[i].y();
-
-        if (const double threshold_squared = physics_params.velocity_threshold * physics_params.velocity_threshold;
-            speed_squared < threshold_squared) {
-            velocity[i] = QPointF(0, 0);
-        } else {
-            is_in_motion = true;
-
-            if (speed_squared > max_speed * max_speed) {
-                const double scaleFactor = max_speed / qSqrt(speed_squared);
-                velocity[i] *= scaleFactor;
-            }
-        }
-
-        control_points[i] += velocity[i];
-    }
+    const BlendedStepParameters step = MakeBlendedStepParameters(blob_center, params, physics_params);
 
-    if (!is_in_motion) {
-        StabilizeBlob(control_points, blob_center, params.blob_radius, physics_params.stabilization_rate);
+    if (const bool is_in_motion = StepBlendedRange(points, step, 0, points.Size()); !is_in_motion) {
+        StabilizeBlob(points, blob_center, params.blob_radius, physics_params.stabilization_rate);
     }
 
-    if (Q_UNLIKELY(ValidateAndRepairControlPoints(control_points, velocity, blob_center, params.blob_radius))) {
+    if (Q_UNLIKELY(ValidateAndRepairControlPoints(points, blob_center, params.blob_radius, random))) {
         qDebug() << "[BLOB PHYSICS] Invalid control points were detected. The blob shape was reset.";
     }
 }
 
 
-void BlobPhysics::HandleBorderCollisions(std::vector<QPointF> &control_points,
-                                         std::vector<QPointF> &velocity,
+void BlobPhysics::HandleBorderCollisions(BlobPoints &points,
                                          QPointF &blob_center,
                                          const int width, const int height,
                                          const double restitution,
                                          const int padding) {
-    const int min_x = padding;
-    const int min_y = padding;
-    const int max_x = width - padding;
-    const int max_y = height - padding;
+    const auto min_x = static_cast<float>(padding);
+    const auto min_y = static_cast<float>(padding);
+    const auto max_x = static_cast<float>(width - padding);
+    const auto max_y = static_cast<float>(height - padding);
+    const auto bounce = static_cast<float>(-restitution);
 
-    for (size_t i = 0; i < control_points.size(); ++i) {
+    for (size_t i = 0; i < points.Size(); ++i) {
         // x axis
-        if (control_points[i].x() < min_x) {
-            control_points[i].setX(min_x);
-            velocity[i].setX(-velocity[i].x() * restitution);
-        } else if (control_points[i].x() > max_x) {
-            control_points[i].setX(max_x);
-            velocity[i].setX(-velocity[i].x() * restitution);
+        if (points.position_x[i] < min_x) {
+            points.position_x[i] = min_x;
+            points.velocity_x[i] *= bounce;
+        } else if (points.position_x[i] > max_x) {
+            points.position_x[i] = max_x;
+            points.velocity_x[i] *= bounce;
         }
 
         // y axis
-        if (control_points[i].y() < min_y) {
-            control_points[i].setY(min_y);
-            velocity[i].setY(-velocity[i].y() * restitution);
-        } else if (control_points[i].y() > max_y) {
-            control_points[i].setY(max_y);
-            velocity[i].setY(-velocity[i].y() * restitution);
+        if (points.position_y[i] < min_y) {
+            points.position_y[i] = min_y;
+            points.velocity_y[i] *= bounce;
+        } else if (points.position_y[i] > max_y) {
+            points.position_y[i] = max_y;
+            points.velocity_y[i] *= bounce;
         }
     }
 
@@ -497,130 +461,131 @@ void BlobPhysics::HandleBorderCollisions(std::vector<QPointF> &control_points,
     if (blob_center.y() > max_y) blob_center.setY(max_y);
 }
 
-void BlobPhysics::ConstrainNeighborDistances(std::vector<QPointF> &control_points,
-                                             std::vector<QPointF> &velocity,
+void BlobPhysics::ConstrainNeighborDistances(BlobPoints &points,
                                              const double min_distance,
                                              const double max_distance) {
-    if (control_points.empty()) return;
+    if (points.Empty()) return;
 
-    const int num_of_points = control_points.size();
+    const int num_of_points = static_cast<int>(points.Size());
 
     for (int i = 0; i < num_of_points; ++i) {
         const int next = (i + 1) % num_of_points;
 
-        QPointF difference = control_points[next] - control_points[i];
-        const double distance = QVector2D(difference).length();
+        const double difference_x = points.position_x[next] - points.position_x[i];
+        const double difference_y = points.position_y[next] - points.position_y[i];
+        const double distance = qSqrt(difference_x * difference_x + difference_y * difference_y);
 
         if (distance < min_distance || distance > max_distance) {
-            QPointF direction = difference / distance;
+            const double direction_x = difference_x / distance;
+            const double direction_y = difference_y / distance;
             const double target_distance = BlobMath::Clamp(distance, min_distance, max_distance);
 
-            const QPointF correction = direction * (distance - target_distance) * 0.5;
-            control_points[i] += correction;
-            control_points[next] -= correction;
-
-            if (distance < min_distance) {
-                velocity[i] -= direction * 0.3;
-                velocity[next] += direction * 0.3;
-            } else if (distance > max_distance) {
-                velocity[i] += direction * 0.3;
-                velocity[next] -= direction * 0.3;
-            }
+            const double correction = (distance - target_distance) * 0.5;
+            points.position_x[i] += static_cast<float>(direction_x * correction);
+            points.position_y[i] += static_cast<float>(direction_y * correction);
+            points.position_x[next] -= static_cast<float>(direction_x * correction);
+            points.position_y[next] -= static_cast<float>(direction_y * correction);
+
+            // pushes the pair apart when too close and pulls it together when too far
+            const double push = distance < min_distance ? -0.3 : 0.3;
+            points.velocity_x[i] += static_cast<float>(direction_x * push);
+            points.velocity_y[i] += static_cast<float>(direction_y * push);
+            points.velocity_x[next] -= static_cast<float>(direction_x * push);
+            points.velocity_y[next] -= static_cast<float>(direction_y * push);
         }
     }
 }
 
-void BlobPhysics::SmoothBlobShape(std::vector<QPointF> &control_points) {
-    if (control_points.empty()) return;
+void BlobPhysics::SmoothBlobShape(BlobPoints &points) {
+    if (points.Empty()) return;
 
-    const int num_of_points = control_points.size();
-    std::vector<QPointF> smoothed_points = control_points;
+    const size_t num_of_points = points.Size();
 
-    for (int i = 0; i < num_of_points; ++i) {
-        const int prev = (i + num_of_points - 1) % num_of_points;
-        const int next = (i + 1) % num_of_points;
-
-        QPointF neighbor_average = (control_points[prev] + control_points[next]) * 0.5;
+    for (AlignedFloatVector *coordinates: {&points.position_x, &points.position_y}) {
+        float *values = coordinates->data();
+        // every point is smoothed against the original values of its neighbors
+        float previous = values[num_of_points - 1];
+        const float first = values[0];
 
-        smoothed_points[i] += (neighbor_average - control_points[i]) * 0.15;
+        for (size_t i = 0; i < num_of_points; ++i) {
+            const float current = values[i];
+            const float next = i + 1 < num_of_points ? values[i + 1] : first;
+            values[i] = current + ((previous + next) * 0.5f - current) * 0.15f;
+            previous = current;
+        }
     }
-
-    control_points = smoothed_points;
 }
 
-void BlobPhysics::StabilizeBlob(std::vector<QPointF> &control_points,
+void BlobPhysics::StabilizeBlob(BlobPoints &points,
                                 const QPointF &blob_center,
                                 const double blob_radius,
                                 const double stabilization_rate) {
-    const int num_of_points = control_points.size();
+    const int num_of_points = static_cast<int>(points.Size());
+    if (num_of_points == 0 || points.shape_factors.size() != points.Size()) return;
+
+    const double center_x = blob_center.x();
+    const double center_y = blob_center.y();
 
     double avg_distance = 0.0;
     for (int i = 0; i < num_of_points; ++i) {
-        QPointF vector_from_center = control_points[i] - blob_center;
-        avg_distance += QVector2D(vector_from_center).length();
+        const double dx = points.position_x[i] - center_x;
+        const double dy = points.position_y[i] - center_y;
+        avg_distance += qSqrt(dx * dx + dy * dy);
     }
     avg_distance /= num_of_points;
 
     const double radius_ratio = blob_radius / avg_distance;
 
-    static std::vector<double> random_offsets;
-    if (random_offsets.size() != num_of_points) {
-        random_offsets.resize(num_of_points);
-        for (int i = 0; i < num_of_points; ++i) {
-            random_offsets[i] = 0.95f + 0.1f * static_cast<float>(QRandomGenerator::global()->generateDouble());
-        }
-    }
-
     for (int i = 0; i < num_of_points; ++i) {
         const double angle = 2 * M_PI * i / num_of_points;
 
-        QPointF ideal_point(
-            blob_center.x() + blob_radius * random_offsets[i] * qCos(angle),
-            blob_center.y() + blob_radius * random_offsets[i] * qSin(angle)
-        );
+        const double ideal_x = center_x + blob_radius * points.shape_factors[i] * qCos(angle);
+        const double ideal_y = center_y + blob_radius * points.shape_factors[i] * qSin(angle);
 
-        QPointF vector_from_center = control_points[i] - blob_center;
-        const double current_distance = QVector2D(vector_from_center).length();
+        double x = points.position_x[i];
+        double y = points.position_y[i];
 
         if (radius_ratio < 0.9 || radius_ratio > 1.1) {
-            const double corrected_distance = current_distance * radius_ratio;
+            const double dx = x - center_x;
+            const double dy = y - center_y;
 
-            if (current_distance > 0.001) {
-                QPointF normalized_vector = vector_from_center * (1.0 / current_distance);
-                control_points[i] = blob_center + normalized_vector * corrected_distance;
+            if (const double current_distance = qSqrt(dx * dx + dy * dy); current_distance > 0.001) {
+                // rescaling the vector from the center by the ratio keeps its direction
+                x = center_x + dx * radius_ratio;
+                y = center_y + dy * radius_ratio;
             }
         }
 
-        control_points[i] += (ideal_point - control_points[i]) * stabilization_rate;
+        points.position_x[i] = static_cast<float>(x + (ideal_x - x) * stabilization_rate);
+        points.position_y[i] = static_cast<float>(y + (ideal_y - y) * stabilization_rate);
     }
 }
 
-bool BlobPhysics::ValidateAndRepairControlPoints(std::vector<QPointF> &control_points,
-                                                 std::vector<QPointF> &velocity,
+bool BlobPhysics::ValidateAndRepairControlPoints(BlobPoints &points,
                                                  const QPointF &blob_center,
-                                                 const double blob_radius) {
+                                                 const double blob_radius,
+                                                 BlobRandomGenerator &random) {
     bool has_invalid_points = false;
 
-    for (size_t i = 0; i < control_points.size(); ++i) {
-        if (!BlobMath::IsValidPoint(control_points[i]) || !BlobMath::IsValidPoint(velocity[i])) {
+    for (size_t i = 0; i < points.Size(); ++i) {
+        if (!BlobMath::IsValidPoint(points.Position(i)) ||
+            !BlobMath::IsValidPoint(QPointF(points.velocity_x[i], points.velocity_y[i]))) {
             has_invalid_points = true;
             break;
         }
     }
 
     if (has_invalid_points) {
-        const int num_of_points = control_points.size();
+        const int num_of_points = static_cast<int>(points.Size());
 
         for (int i = 0; i < num_of_points; ++i) {
             const double angle = 2 * M_PI * i / num_of_points;
-            const double random_radius = blob_radius * (0.9 + 0.2 * QRandomGenerator::global()->generateDouble());
-
-            control_points[i] = QPointF(
-                blob_center.x() + random_radius * qCos(angle),
-                blob_center.y() + random_radius * qSin(angle)
-            );
+            const double random_radius = blob_radius * (0.9 + 0.2 * random.GenerateDouble());
 
-            velocity[i] = QPointF(0, 0);
+            points.position_x[i] = static_cast<float>(blob_center.x() + random_radius * qCos(angle));
+            points.position_y[i] = static_cast<float>(blob_center.y() + random_radius * qSin(angle));
+            points.velocity_x[i] = 0.0f;
+            points.velocity_y[i] = 0.0f;
         }
         return true;
     }
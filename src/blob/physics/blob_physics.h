@@ -1,11 +1,10 @@
 #ifndef BLOBPHYSICS_H
 #define BLOBPHYSICS_H
 
-#include <QThreadPool>
+#include <QElapsedTimer>
 #include <QVector2D>
-#include <vector>
 
-class QPointF;
+#include "blob_points.h"
 
 namespace BlobConfig {
     struct PhysicsParameters;
@@ -23,94 +22,106 @@ namespace BlobConfig {
  */
 class BlobPhysics {
 public:
+    /**
+     * @brief Ways UpdatePhysicsParallel() can execute a physics step.
+     */
+    enum class ExecutionMode {
+        kSerial, ///< Scalar blended step on the calling thread.
+        kSimd, ///< Vectorized kernel on the calling thread.
+        kThreaded ///< Step split into chunks on the shared ParallelForPool.
+    };
+
     /**
      * @brief Constructs a BlobPhysics object.
-     * Initializes the internal thread pool and starts the physics timer.
+     * Starts the physics timer.
      */
     BlobPhysics();
 
     /**
-    * @brief Initializes the blob's state vectors (control points, target points, velocity) and center position.
+    * @brief Initializes the blob's point state (positions, targets, velocities) and center position.
     * Generates initial circular points.
-    * @param control_points Reference to the vector of control point positions (modified).
-    * @param target_points Reference to the vector of target control point positions (modified).
-    * @param velocity Reference to the vector of control point velocities (modified).
+    * @param points Reference to the blob point state (modified).
     * @param blob_center Reference to the blob's center position (modified).
     * @param params Blob appearance parameters (read-only).
     * @param width The width of the widget area.
     * @param height The height of the widget area.
+    * @param random Generator of the shape factors.
     */
-    static void InitializeBlob(std::vector<QPointF> &control_points,
-                               std::vector<QPointF> &target_points,
-                               std::vector<QPointF> &velocity,
+    static void InitializeBlob(BlobPoints &points,
                                QPointF &blob_center,
                                const BlobConfig::BlobParameters &params,
-                               int width, int height);
+                               int width, int height,
+                               BlobRandomGenerator &random);
 
     /**
-     * @brief Updates the blob physics using an optimized Structure-of-Arrays (SoA) approach with OpenMP parallelization.
-     * Suitable for a large number of control points. Converts data to separate float arrays for better cache performance and vectorization.
-     * Includes safety checks for vector sizes.
-     * @param control_points Reference to the vector of current control point positions (modified).
-     * @param target_points Reference to the vector of target control point positions (read-only).
-     * @param velocity Reference to the vector of current control point velocities (modified).
+     * @brief Updates the blob physics with the SIMD kernels, working on the SoA arrays in place.
+     * Suitable for a large number of control points. Runs the BlobPhysicsKernels variant selected
+     * for the CPU (SSE2/AVX2/AVX-512, scalar fallback). Includes a safety check of the point count.
+     * @param points Reference to the blob point state (positions and velocities are modified).
      * @param blob_center The current center position of the blob (read-only).
      * @param params Blob appearance parameters (read-only).
      * @param physics_params Blob physics parameters (read-only).
+     * @param random Generator of the simulation, used if invalid points have to be repaired.
      */
-    static void UpdatePhysicsOptimized(std::vector<QPointF> &control_points, const std::vector<QPointF> &target_points,
-                                       std::vector<QPointF> &velocity, const QPointF &blob_center,
+    static void UpdatePhysicsOptimized(BlobPoints &points, const QPointF &blob_center,
                                        const BlobConfig::BlobParameters &params,
-                                       const BlobConfig::PhysicsParameters &physics_params);
+                                       const BlobConfig::PhysicsParameters &physics_params,
+                                       BlobRandomGenerator &random);
 
     /**
-     * @brief Updates the blob physics using QtConcurrent for parallel processing across multiple threads.
-     * Divides the work into batches and processes them using the internal thread pool.
-     * Falls back to UpdatePhysicsOptimized or UpdatePhysics for different point counts.
-     * Includes safety checks for vector sizes and thread ranges.
-     * @param control_points Reference to the vector of current control point positions (modified).
-     * @param target_points Reference to the vector of target control point positions (read-only).
-     * @param velocity Reference to the vector of current control point velocities (modified).
+     * @brief Updates the blob physics, choosing the cheapest execution for the point count.
+     * Blobs of up to 64 points use the blended step of UpdatePhysics(), larger ones the SIMD kernel of
+     * UpdatePhysicsOptimized(). Either step runs on the calling thread or is split over the persistent
+     * ParallelForPool, whichever SelectExecutionMode() predicts to be faster.
+     * @param points Reference to the blob point state (positions and velocities are modified).
      * @param blob_center The current center position of the blob (read-only).
      * @param params Blob appearance parameters (read-only).
      * @param physics_params Blob physics parameters (read-only).
+     * @param random Generator of the simulation, used if invalid points have to be repaired.
      */
-    void UpdatePhysicsParallel(std::vector<QPointF> &control_points, std::vector<QPointF> &target_points,
-                               std::vector<QPointF> &velocity, const QPointF &blob_center,
-                               const BlobConfig::BlobParameters &params,
-                               const BlobConfig::PhysicsParameters &physics_params);
+    static void UpdatePhysicsParallel(BlobPoints &points, const QPointF &blob_center,
+                                      const BlobConfig::BlobParameters &params,
+                                      const BlobConfig::PhysicsParameters &physics_params,
+                                      BlobRandomGenerator &random);
+
+    /**
+     * @brief Predicts the fastest execution of a physics step for the given point count.
+     * Compares the per-point cost of the scalar step and the SIMD kernel, divided over the pool participants,
+     * plus the measured cost of waking the pool. The step costs are calibrated once per process, on the first
+     * call. The pool is only started, and its wake-up measured, for the first point count large enough that a
+     * threaded step could pay for waking it.
+     * @param num_of_points The number of control points.
+     * @return kSerial or kThreaded for blended steps (up to 64 points), kSimd or kThreaded above that.
+     */
+    static ExecutionMode SelectExecutionMode(size_t num_of_points);
 
     /**
      * @brief Updates the blob physics using a standard sequential approach.
-     * Iterates through each control point, calculates forces, applies damping, updates velocity and position.
-     * Includes safety checks for vector sizes.
-     * @param control_points Reference to the vector of current control point positions (modified).
-     * @param target_points Reference to the vector of target control point positions (read-only).
-     * @param velocity Reference to the vector of current control point velocities (modified).
+     * Iterates through each control point, calculates forces, blends with the previous velocity, applies damping
+     * and updates velocity and position. Includes a safety check of the point count.
+     * @param points Reference to the blob point state (positions and velocities are modified).
      * @param blob_center The current center position of the blob (read-only).
      * @param params Blob appearance parameters (read-only).
      * @param physics_params Blob physics parameters (read-only).
+     * @param random Generator of the simulation, used if invalid points have to be repaired.
      */
-    static void UpdatePhysics(std::vector<QPointF> &control_points,
-                              const std::vector<QPointF> &target_points,
-                              std::vector<QPointF> &velocity,
+    static void UpdatePhysics(BlobPoints &points,
                               const QPointF &blob_center,
                               const BlobConfig::BlobParameters &params,
-                              const BlobConfig::PhysicsParameters &physics_params);
+                              const BlobConfig::PhysicsParameters &physics_params,
+                              BlobRandomGenerator &random);
 
     /**
      * @brief Handles collisions between blob control points and the widget borders.
      * Adjusts positions and reverses velocity components based on the restitution factor.
-     * @param control_points Reference to the vector of control point positions (modified).
-     * @param velocity Reference to the vector of control point velocities (modified).
+     * @param points Reference to the blob point state (positions and velocities are modified).
      * @param blob_center Reference to the blob's center position (modified).
      * @param width The width of the widget area.
      * @param height The height of the widget area.
      * @param restitution The bounciness factor (0.0 to 1.0).
      * @param padding The distance from the edge where collisions occur.
      */
-    static void HandleBorderCollisions(std::vector<QPointF> &control_points,
-                                       std::vector<QPointF> &velocity,
+    static void HandleBorderCollisions(BlobPoints &points,
                                        QPointF &blob_center,
                                        int width, int height,
                                        double restitution,
@@ -119,32 +130,32 @@ public:
     /**
      * @brief Enforces minimum and maximum distance constraints between neighboring control points.
      * Adjusts positions and applies small velocity changes to maintain shape integrity.
-     * @param control_points Reference to the vector of control point positions (modified).
-     * @param velocity Reference to the vector of control point velocities (modified).
+     * @param points Reference to the blob point state (positions and velocities are modified).
      * @param min_distance The minimum allowed distance between neighbors.
      * @param max_distance The maximum allowed distance between neighbors.
      */
-    static void ConstrainNeighborDistances(std::vector<QPointF> &control_points,
-                                           std::vector<QPointF> &velocity,
+    static void ConstrainNeighborDistances(BlobPoints &points,
                                            double min_distance,
                                            double max_distance);
 
     /**
      * @brief Applies a smoothing filter to the blob's shape.
-     * Moves each control point slightly towards the average position of its neighbors.
-     * @param control_points Reference to the vector of control point positions (modified).
+     * Moves each control point slightly towards the average position of its neighbors. Works in place,
+     * keeping only the original values of the previous and the first point.
+     * @param points Reference to the blob point state (positions are modified).
      */
-    static void SmoothBlobShape(std::vector<QPointF> &control_points);
+    static void SmoothBlobShape(BlobPoints &points);
 
     /**
      * @brief Gradually moves control points towards an ideal circular/organic shape when the blob is idle.
      * Helps prevent the blob from collapsing or drifting excessively when not moving.
-     * @param control_points Reference to the vector of control point positions (modified).
+     * The ideal shape uses the per-instance BlobPoints::shape_factors.
+     * @param points Reference to the blob point state (positions are modified).
      * @param blob_center The current center position of the blob (read-only).
      * @param blob_radius The target average radius of the blob.
      * @param stabilization_rate The rate at which points move towards the ideal shape (0.0 to 1.0).
      */
-    static void StabilizeBlob(std::vector<QPointF> &control_points,
+    static void StabilizeBlob(BlobPoints &points,
                               const QPointF &blob_center,
                               double blob_radius,
                               double stabilization_rate);
@@ -152,16 +163,17 @@ public:
     /**
      * @brief Checks if any control points or velocities contain invalid values (NaN, infinity).
      * If invalid points are found, reset the entire blob shape to a default organic form around the center.
-     * @param control_points Reference to the vector of control point positions (modified).
-     * @param velocity Reference to the vector of control point velocities (modified).
+     * @param points Reference to the blob point state (modified on repair).
      * @param blob_center The current center position of the blob (read-only).
      * @param blob_radius The target average radius of the blob.
+     * @param random Generator of the simulation, which draws the radii of the repaired points so a replay
+     * repairs them identically.
      * @return True if invalid points were found and repaired, false otherwise.
      */
-    static bool ValidateAndRepairControlPoints(std::vector<QPointF> &control_points,
-                                               std::vector<QPointF> &velocity,
+    static bool ValidateAndRepairControlPoints(BlobPoints &points,
                                                const QPointF &blob_center,
-                                               double blob_radius);
+                                               double blob_radius,
+                                               BlobRandomGenerator &random);
 
     /**
      * @brief Calculates the approximate velocity of the window based on position changes over time.
@@ -196,8 +208,6 @@ private:
     QPointF last_window_position_;
     /** @brief Stores the last calculated window velocity. */
     QVector2D last_window_velocity_;
-    /** @brief Thread pool used for parallel physics updates (UpdatePhysicsParallel). */
-    QThreadPool thread_pool_;
 };
 
 #endif // BLOBPHYSICS_H
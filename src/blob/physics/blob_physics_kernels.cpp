@@ -0,0 +1,368 @@
+#include "blob_physics_kernels.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <QDebug>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define BLOB_KERNELS_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#else
+#define BLOB_KERNELS_X86 0
+#endif
+
+// MSVC allows any intrinsic in any function, GCC and Clang need the target enabled per function
+#if defined(__GNUC__) || defined(__clang__)
+#define BLOB_KERNEL_TARGET(isa) __attribute__((target(isa)))
+#else
+#define BLOB_KERNEL_TARGET(isa)
+#endif
+
+// this file is compiled with -ffp-contract=off (see CMakeLists.txt): the compiler would otherwise fuse the
+// multiply-adds in the AVX-512 kernel and its results would no longer match the scalar kernel exactly
+
+namespace {
+    /** @brief Strength of the pull towards the center for points outside the radius threshold. */
+    constexpr float kCenterPull = 0.03f;
+
+    /**
+     * @brief Reference implementation, also used for the tails of the SSE2 and AVX2 kernels.
+     * @return True if any point in [begin, end) is still moving.
+     */
+    bool StepScalar(const BlobPhysicsKernels::PointArrays &points, const BlobPhysicsKernels::StepParameters &params,
+                    const size_t begin, const size_t end) {
+        bool is_in_motion = false;
+
+        for (size_t i = begin; i < end; ++i) {
+            float force_x = (points.target_x[i] - points.position_x[i]) * params.viscosity;
+            float force_y = (points.target_y[i] - points.position_y[i]) * params.viscosity;
+
+            const float vector_to_center_x = params.center_x - points.position_x[i];
+            const float vector_to_center_y = params.center_y - points.position_y[i];
+
+            if (const float distance_squared = vector_to_center_x * vector_to_center_x + vector_to_center_y *
+                                               vector_to_center_y; distance_squared > params.radius_threshold_squared) {
+                const float factor = kCenterPull * (1.0f / std::sqrt(distance_squared));
+                force_x += vector_to_center_x * factor;
+                force_y += vector_to_center_y * factor;
+            }
+
+            float velocity_x = (points.velocity_x[i] + force_x) * params.damping;
+            float velocity_y = (points.velocity_y[i] + force_y) * params.damping;
+
+            const float speed_squared = velocity_x * velocity_x + velocity_y * velocity_y;
+
+            if (speed_squared < params.velocity_threshold_squared) {
+                velocity_x = 0.0f;
+                velocity_y = 0.0f;
+            } else {
+                is_in_motion = true;
+
+                if (speed_squared > params.max_speed_squared) {
+                    const float scale_factor = params.max_speed / std::sqrt(speed_squared);
+                    velocity_x *= scale_factor;
+                    velocity_y *= scale_factor;
+                }
+            }
+
+            points.velocity_x[i] = velocity_x;
+            points.velocity_y[i] = velocity_y;
+            points.position_x[i] += velocity_x;
+            points.position_y[i] += velocity_y;
+        }
+
+        return is_in_motion;
+    }
+
+#if BLOB_KERNELS_X86
+    /**
+     * @brief Selects b where the mask is set and a elsewhere (SSE2 has no blendv).
+     */
+    BLOB_KERNEL_TARGET("sse2")
+    __m128 Select(const __m128 mask, const __m128 a, const __m128 b) {
+        return _mm_or_ps(_mm_and_ps(mask, b), _mm_andnot_ps(mask, a));
+    }
+
+    BLOB_KERNEL_TARGET("sse2")
+    bool StepSse2(const BlobPhysicsKernels::PointArrays &points, const BlobPhysicsKernels::StepParameters &params) {
+        const __m128 center_x = _mm_set1_ps(params.center_x);
+        const __m128 center_y = _mm_set1_ps(params.center_y);
+        const __m128 radius_threshold_squared = _mm_set1_ps(params.radius_threshold_squared);
+        const __m128 viscosity = _mm_set1_ps(params.viscosity);
+        const __m128 damping = _mm_set1_ps(params.damping);
+        const __m128 velocity_threshold_squared = _mm_set1_ps(params.velocity_threshold_squared);
+        const __m128 max_speed = _mm_set1_ps(params.max_speed);
+        const __m128 max_speed_squared = _mm_set1_ps(params.max_speed_squared);
+        const __m128 center_pull = _mm_set1_ps(kCenterPull);
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        int resting_lanes = 0xF;
+        const size_t vector_end = points.count & ~static_cast<size_t>(3);
+
+        for (size_t i = 0; i < vector_end; i += 4) {
+            const __m128 position_x = _mm_loadu_ps(points.position_x + i);
+            const __m128 position_y = _mm_loadu_ps(points.position_y + i);
+
+            __m128 force_x = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(points.target_x + i), position_x), viscosity);
+            __m128 force_y = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(points.target_y + i), position_y), viscosity);
+
+            const __m128 to_center_x = _mm_sub_ps(center_x, position_x);
+            const __m128 to_center_y = _mm_sub_ps(center_y, position_y);
+            const __m128 distance_squared = _mm_add_ps(_mm_mul_ps(to_center_x, to_center_x),
+                                                       _mm_mul_ps(to_center_y, to_center_y));
+            const __m128 outside = _mm_cmpgt_ps(distance_squared, radius_threshold_squared);
+            // lanes inside the threshold may divide by zero here, they are discarded by the select
+            const __m128 factor = _mm_mul_ps(center_pull, _mm_div_ps(one, _mm_sqrt_ps(distance_squared)));
+            force_x = Select(outside, force_x, _mm_add_ps(force_x, _mm_mul_ps(to_center_x, factor)));
+            force_y = Select(outside, force_y, _mm_add_ps(force_y, _mm_mul_ps(to_center_y, factor)));
+
+            __m128 velocity_x = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(points.velocity_x + i), force_x), damping);
+            __m128 velocity_y = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(points.velocity_y + i), force_y), damping);
+
+            const __m128 speed_squared = _mm_add_ps(_mm_mul_ps(velocity_x, velocity_x),
+                                                    _mm_mul_ps(velocity_y, velocity_y));
+            const __m128 too_fast = _mm_cmpgt_ps(speed_squared, max_speed_squared);
+            const __m128 scale_factor = _mm_div_ps(max_speed, _mm_sqrt_ps(speed_squared));
+            velocity_x = Select(too_fast, velocity_x, _mm_mul_ps(velocity_x, scale_factor));
+            velocity_y = Select(too_fast, velocity_y, _mm_mul_ps(velocity_y, scale_factor));
+
+            const __m128 resting = _mm_cmplt_ps(speed_squared, velocity_threshold_squared);
+            velocity_x = _mm_andnot_ps(resting, velocity_x);
+            velocity_y = _mm_andnot_ps(resting, velocity_y);
+            resting_lanes &= _mm_movemask_ps(resting);
+
+            _mm_storeu_ps(points.velocity_x + i, velocity_x);
+            _mm_storeu_ps(points.velocity_y + i, velocity_y);
+            _mm_storeu_ps(points.position_x + i, _mm_add_ps(position_x, velocity_x));
+            _mm_storeu_ps(points.position_y + i, _mm_add_ps(position_y, velocity_y));
+        }
+
+        const bool tail_in_motion = StepScalar(points, params, vector_end, points.count);
+        return resting_lanes != 0xF || tail_in_motion;
+    }
+
+    BLOB_KERNEL_TARGET("avx2")
+    bool StepAvx2(const BlobPhysicsKernels::PointArrays &points, const BlobPhysicsKernels::StepParameters &params) {
+        const __m256 center_x = _mm256_set1_ps(params.center_x);
+        const __m256 center_y = _mm256_set1_ps(params.center_y);
+        const __m256 radius_threshold_squared = _mm256_set1_ps(params.radius_threshold_squared);
+        const __m256 viscosity = _mm256_set1_ps(params.viscosity);
+        const __m256 damping = _mm256_set1_ps(params.damping);
+        const __m256 velocity_threshold_squared = _mm256_set1_ps(params.velocity_threshold_squared);
+        const __m256 max_speed = _mm256_set1_ps(params.max_speed);
+        const __m256 max_speed_squared = _mm256_set1_ps(params.max_speed_squared);
+        const __m256 center_pull = _mm256_set1_ps(kCenterPull);
+        const __m256 one = _mm256_set1_ps(1.0f);
+
+        int resting_lanes = 0xFF;
+        const size_t vector_end = points.count & ~static_cast<size_t>(7);
+
+        for (size_t i = 0; i < vector_end; i += 8) {
+            const __m256 position_x = _mm256_loadu_ps(points.position_x + i);
+            const __m256 position_y = _mm256_loadu_ps(points.position_y + i);
+
+            __m256 force_x = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(points.target_x + i), position_x), viscosity);
+            __m256 force_y = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(points.target_y + i), position_y), viscosity);
+
+            const __m256 to_center_x = _mm256_sub_ps(center_x, position_x);
+            const __m256 to_center_y = _mm256_sub_ps(center_y, position_y);
+            const __m256 distance_squared = _mm256_add_ps(_mm256_mul_ps(to_center_x, to_center_x),
+                                                          _mm256_mul_ps(to_center_y, to_center_y));
+            const __m256 outside = _mm256_cmp_ps(distance_squared, radius_threshold_squared, _CMP_GT_OQ);
+            const __m256 factor = _mm256_mul_ps(center_pull, _mm256_div_ps(one, _mm256_sqrt_ps(distance_squared)));
+            force_x = _mm256_blendv_ps(force_x, _mm256_add_ps(force_x, _mm256_mul_ps(to_center_x, factor)), outside);
+            force_y = _mm256_blendv_ps(force_y, _mm256_add_ps(force_y, _mm256_mul_ps(to_center_y, factor)), outside);
+
+            __m256 velocity_x = _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(points.velocity_x + i), force_x), damping);
+            __m256 velocity_y = _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(points.velocity_y + i), force_y), damping);
+
+            const __m256 speed_squared = _mm256_add_ps(_mm256_mul_ps(velocity_x, velocity_x),
+                                                       _mm256_mul_ps(velocity_y, velocity_y));
+            const __m256 too_fast = _mm256_cmp_ps(speed_squared, max_speed_squared, _CMP_GT_OQ);
+            const __m256 scale_factor = _mm256_div_ps(max_speed, _mm256_sqrt_ps(speed_squared));
+            velocity_x = _mm256_blendv_ps(velocity_x, _mm256_mul_ps(velocity_x, scale_factor), too_fast);
+            velocity_y = _mm256_blendv_ps(velocity_y, _mm256_mul_ps(velocity_y, scale_factor), too_fast);
+
+            const __m256 resting = _mm256_cmp_ps(speed_squared, velocity_threshold_squared, _CMP_LT_OQ);
+            velocity_x = _mm256_andnot_ps(resting, velocity_x);
+            velocity_y = _mm256_andnot_ps(resting, velocity_y);
+            resting_lanes &= _mm256_movemask_ps(resting);
+
+            _mm256_storeu_ps(points.velocity_x + i, velocity_x);
+            _mm256_storeu_ps(points.velocity_y + i, velocity_y);
+            _mm256_storeu_ps(points.position_x + i, _mm256_add_ps(position_x, velocity_x));
+            _mm256_storeu_ps(points.position_y + i, _mm256_add_ps(position_y, velocity_y));
+        }
+
+        const bool tail_in_motion = StepScalar(points, params, vector_end, points.count);
+        return resting_lanes != 0xFF || tail_in_motion;
+    }
+
+    BLOB_KERNEL_TARGET("avx512f")
+    bool StepAvx512(const BlobPhysicsKernels::PointArrays &points, const BlobPhysicsKernels::StepParameters &params) {
+        const __m512 center_x = _mm512_set1_ps(params.center_x);
+        const __m512 center_y = _mm512_set1_ps(params.center_y);
+        const __m512 radius_threshold_squared = _mm512_set1_ps(params.radius_threshold_squared);
+        const __m512 viscosity = _mm512_set1_ps(params.viscosity);
+        const __m512 damping = _mm512_set1_ps(params.damping);
+        const __m512 velocity_threshold_squared = _mm512_set1_ps(params.velocity_threshold_squared);
+        const __m512 max_speed = _mm512_set1_ps(params.max_speed);
+        const __m512 max_speed_squared = _mm512_set1_ps(params.max_speed_squared);
+        const __m512 center_pull = _mm512_set1_ps(kCenterPull);
+        const __m512 one = _mm512_set1_ps(1.0f);
+
+        bool is_in_motion = false;
+
+        for (size_t i = 0; i < points.count; i += 16) {
+            const size_t remaining = points.count - i;
+            const __mmask16 active = remaining >= 16
+                                         ? static_cast<__mmask16>(0xFFFF)
+                                         : static_cast<__mmask16>((1u << remaining) - 1u);
+
+            const __m512 position_x = _mm512_maskz_loadu_ps(active, points.position_x + i);
+            const __m512 position_y = _mm512_maskz_loadu_ps(active, points.position_y + i);
+
+            __m512 force_x = _mm512_mul_ps(_mm512_sub_ps(_mm512_maskz_loadu_ps(active, points.target_x + i),
+                                                         position_x), viscosity);
+            __m512 force_y = _mm512_mul_ps(_mm512_sub_ps(_mm512_maskz_loadu_ps(active, points.target_y + i),
+                                                         position_y), viscosity);
+
+            const __m512 to_center_x = _mm512_sub_ps(center_x, position_x);
+            const __m512 to_center_y = _mm512_sub_ps(center_y, position_y);
+            const __m512 distance_squared = _mm512_add_ps(_mm512_mul_ps(to_center_x, to_center_x),
+                                                          _mm512_mul_ps(to_center_y, to_center_y));
+            const __mmask16 outside = _mm512_cmp_ps_mask(distance_squared, radius_threshold_squared, _CMP_GT_OQ);
+            const __m512 factor = _mm512_mul_ps(center_pull, _mm512_div_ps(one, _mm512_sqrt_ps(distance_squared)));
+            force_x = _mm512_mask_add_ps(force_x, outside, force_x, _mm512_mul_ps(to_center_x, factor));
+            force_y = _mm512_mask_add_ps(force_y, outside, force_y, _mm512_mul_ps(to_center_y, factor));
+
+            __m512 velocity_x = _mm512_mul_ps(_mm512_add_ps(_mm512_maskz_loadu_ps(active, points.velocity_x + i),
+                                                            force_x), damping);
+            __m512 velocity_y = _mm512_mul_ps(_mm512_add_ps(_mm512_maskz_loadu_ps(active, points.velocity_y + i),
+                                                            force_y), damping);
+
+            const __m512 speed_squared = _mm512_add_ps(_mm512_mul_ps(velocity_x, velocity_x),
+                                                       _mm512_mul_ps(velocity_y, velocity_y));
+            const __mmask16 too_fast = _mm512_cmp_ps_mask(speed_squared, max_speed_squared, _CMP_GT_OQ);
+            const __m512 scale_factor = _mm512_div_ps(max_speed, _mm512_sqrt_ps(speed_squared));
+            velocity_x = _mm512_mask_mul_ps(velocity_x, too_fast, velocity_x, scale_factor);
+            velocity_y = _mm512_mask_mul_ps(velocity_y, too_fast, velocity_y, scale_factor);
+
+            const __mmask16 moving = _mm512_cmp_ps_mask(speed_squared, velocity_threshold_squared, _CMP_NLT_UQ);
+            velocity_x = _mm512_maskz_mov_ps(moving, velocity_x);
+            velocity_y = _mm512_maskz_mov_ps(moving, velocity_y);
+            is_in_motion |= (moving & active) != 0;
+
+            _mm512_mask_storeu_ps(points.velocity_x + i, active, velocity_x);
+            _mm512_mask_storeu_ps(points.velocity_y + i, active, velocity_y);
+            _mm512_mask_storeu_ps(points.position_x + i, active, _mm512_add_ps(position_x, velocity_x));
+            _mm512_mask_storeu_ps(points.position_y + i, active, _mm512_add_ps(position_y, velocity_y));
+        }
+
+        return is_in_motion;
+    }
+#endif
+
+    /**
+     * @brief Queries the CPU and OS for the widest usable instruction set.
+     */
+    BlobPhysicsKernels::InstructionSet DetectInstructionSet() {
+#if BLOB_KERNELS_X86
+#if defined(__GNUC__) || defined(__clang__)
+        // libgcc's checks include the OS support for saving the wide registers (XGETBV)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return BlobPhysicsKernels::InstructionSet::kAvx512;
+        if (__builtin_cpu_supports("avx2")) return BlobPhysicsKernels::InstructionSet::kAvx2;
+        if (__builtin_cpu_supports("sse2")) return BlobPhysicsKernels::InstructionSet::kSse2;
+#elif defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        const int max_leaf = info[0];
+
+        __cpuid(info, 1);
+        const bool has_sse2 = (info[3] & (1 << 26)) != 0;
+        const bool has_os_xsave = (info[2] & (1 << 27)) != 0;
+        const unsigned long long enabled_state = has_os_xsave ? _xgetbv(0) : 0;
+        const bool os_saves_ymm = (enabled_state & 0x6) == 0x6;
+        const bool os_saves_zmm = (enabled_state & 0xE6) == 0xE6;
+
+        if (max_leaf >= 7) {
+            __cpuidex(info, 7, 0);
+            if ((info[1] & (1 << 16)) != 0 && os_saves_zmm) return BlobPhysicsKernels::InstructionSet::kAvx512;
+            if ((info[1] & (1 << 5)) != 0 && os_saves_ymm) return BlobPhysicsKernels::InstructionSet::kAvx2;
+        }
+        if (has_sse2) return BlobPhysicsKernels::InstructionSet::kSse2;
+#endif
+#endif
+        return BlobPhysicsKernels::InstructionSet::kScalar;
+    }
+
+    /**
+     * @brief Detects the instruction set once and applies the WAVELENGTH_BLOB_SIMD limit.
+     */
+    BlobPhysicsKernels::InstructionSet SelectInstructionSet() {
+        const BlobPhysicsKernels::InstructionSet detected = DetectInstructionSet();
+        BlobPhysicsKernels::InstructionSet selected = detected;
+
+        if (const char *requested = std::getenv("WAVELENGTH_BLOB_SIMD")) {
+            for (int i = 0; i <= static_cast<int>(BlobPhysicsKernels::InstructionSet::kAvx512); ++i) {
+                const auto candidate = static_cast<BlobPhysicsKernels::InstructionSet>(i);
+                if (std::strcmp(requested, BlobPhysicsKernels::GetInstructionSetName(candidate)) == 0
+                    && candidate < detected) {
+                    selected = candidate;
+                }
+            }
+        }
+
+        qDebug() << "[BLOB PHYSICS] Using" << BlobPhysicsKernels::GetInstructionSetName(selected)
+                << "kernels (CPU supports" << BlobPhysicsKernels::GetInstructionSetName(detected) << ")";
+        return selected;
+    }
+}
+
+bool BlobPhysicsKernels::Step(const PointArrays &points, const StepParameters &params) {
+    return Step(GetActiveInstructionSet(), points, params);
+}
+
+bool BlobPhysicsKernels::Step(const InstructionSet instruction_set, const PointArrays &points,
+                              const StepParameters &params) {
+    switch (instruction_set) {
+#if BLOB_KERNELS_X86
+        case InstructionSet::kAvx512:
+            return StepAvx512(points, params);
+        case InstructionSet::kAvx2:
+            return StepAvx2(points, params);
+        case InstructionSet::kSse2:
+            return StepSse2(points, params);
+#endif
+        default:
+            return StepScalar(points, params, 0, points.count);
+    }
+}
+
+bool BlobPhysicsKernels::IsSupported(const InstructionSet instruction_set) {
+    static const InstructionSet detected = DetectInstructionSet();
+    return instruction_set <= detected;
+}
+
+BlobPhysicsKernels::InstructionSet BlobPhysicsKernels::GetActiveInstructionSet() {
+    static const InstructionSet selected = SelectInstructionSet();
+    return selected;
+}
+
+const char *BlobPhysicsKernels::GetInstructionSetName(const InstructionSet instruction_set) {
+    switch (instruction_set) {
+        case InstructionSet::kSse2:
+            return "sse2";
+        case InstructionSet::kAvx2:
+            return "avx2";
+        case InstructionSet::kAvx512:
+            return "avx512";
+        default:
+            return "scalar";
+    }
+}
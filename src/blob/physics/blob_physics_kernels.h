@@ -0,0 +1,101 @@
+#ifndef BLOB_PHYSICS_KERNELS_H
+#define BLOB_PHYSICS_KERNELS_H
+
+#include <cstddef>
+
+/**
+ * @brief Vectorized spring/damping/clamping kernels for the blob control points.
+ *
+ * The kernels work on Structure-of-Arrays float data and implement a single physics step:
+ * spring force towards the target point, pull towards the center for points outside the radius
+ * threshold, velocity damping, resting-point snapping and max speed clamping. The per-point
+ * branches of the scalar code are evaluated as lane masks, so every variant produces the same
+ * results as the scalar kernel (up to the sign of zero).
+ *
+ * Variants for SSE2, AVX2 and AVX-512 are compiled into the same binary using per-function target
+ * attributes, and the best one supported by the CPU is selected once at runtime. Setting the
+ * WAVELENGTH_BLOB_SIMD environment variable to "scalar", "sse2", "avx2" or "avx512" restricts the
+ * selection (useful when comparing results or hunting a suspected kernel bug).
+ */
+class BlobPhysicsKernels {
+public:
+    /**
+     * @brief Instruction sets a kernel can be compiled for, ordered from the narrowest one.
+     */
+    enum class InstructionSet {
+        kScalar, ///< Plain C++, always available.
+        kSse2, ///< 4 lanes (x86 / x86-64).
+        kAvx2, ///< 8 lanes.
+        kAvx512 ///< 16 lanes, tail handled with masked loads and stores.
+    };
+
+    /**
+     * @brief Per-step constants, precomputed once from the blob and physics parameters.
+     */
+    struct StepParameters {
+        float center_x;
+        float center_y;
+        /** @brief Points further from the center than the square root of this are pulled back. */
+        float radius_threshold_squared;
+        float viscosity;
+        float damping;
+        /** @brief Velocities with a squared magnitude below this are snapped to zero. */
+        float velocity_threshold_squared;
+        float max_speed;
+        float max_speed_squared;
+    };
+
+    /**
+     * @brief Pointers to the SoA point data. All arrays must hold at least count elements; no
+     * alignment is required.
+     */
+    struct PointArrays {
+        float *position_x;
+        float *position_y;
+        float *velocity_x;
+        float *velocity_y;
+        const float *target_x;
+        const float *target_y;
+        size_t count;
+    };
+
+    /**
+     * @brief Runs one physics step with the kernel selected for this CPU.
+     * @param points The point data (positions and velocities are modified).
+     * @param params The step constants.
+     * @return True if any point is still moving (its velocity was not snapped to zero).
+     */
+    static bool Step(const PointArrays &points, const StepParameters &params);
+
+    /**
+     * @brief Runs one physics step with an explicitly chosen kernel.
+     * Used by the benchmarks to compare the variants. The instruction set must be supported.
+     * @param instruction_set The kernel variant to use.
+     * @param points The point data (positions and velocities are modified).
+     * @param params The step constants.
+     * @return True if any point is still moving.
+     */
+    static bool Step(InstructionSet instruction_set, const PointArrays &points, const StepParameters &params);
+
+    /**
+     * @brief Checks whether the CPU (and the OS) support the given kernel variant.
+     * @param instruction_set The kernel variant.
+     * @return True if the variant can be used on this machine.
+     */
+    static bool IsSupported(InstructionSet instruction_set);
+
+    /**
+     * @brief Gets the kernel variant used by Step(points, params).
+     * @return The selected instruction set.
+     */
+    static InstructionSet GetActiveInstructionSet();
+
+    /**
+     * @brief Gets a short, lowercase name of the instruction set (the same as accepted by WAVELENGTH_BLOB_SIMD).
+     * @param instruction_set The instruction set.
+     * @return The name, e.g. "avx2".
+     */
+    static const char *GetInstructionSetName(InstructionSet instruction_set);
+};
+
+#endif // BLOB_PHYSICS_KERNELS_H
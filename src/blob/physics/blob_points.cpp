@@ -0,0 +1,43 @@
+#include "blob_points.h"
+
+void BlobPoints::AssignShape(const std::vector<QPointF> &points, BlobRandomGenerator &random) {
+    const size_t count = points.size();
+
+    position_x.resize(count);
+    position_y.resize(count);
+    target_x.resize(count);
+    target_y.resize(count);
+    velocity_x.assign(count, 0.0f);
+    velocity_y.assign(count, 0.0f);
+
+    for (size_t i = 0; i < count; ++i) {
+        position_x[i] = target_x[i] = static_cast<float>(points[i].x());
+        position_y[i] = target_y[i] = static_cast<float>(points[i].y());
+    }
+
+    if (shape_factors.size() != count) {
+        shape_factors.resize(count);
+        for (float &factor: shape_factors) {
+            factor = 0.95f + 0.1f * static_cast<float>(random.GenerateDouble());
+        }
+    }
+}
+
+void BlobPoints::ScaleVelocities(const float factor) {
+    for (size_t i = 0; i < Size(); ++i) {
+        velocity_x[i] *= factor;
+        velocity_y[i] *= factor;
+    }
+}
+
+void BlobPoints::Translate(const QPointF &delta) {
+    const auto delta_x = static_cast<float>(delta.x());
+    const auto delta_y = static_cast<float>(delta.y());
+
+    for (size_t i = 0; i < Size(); ++i) {
+        position_x[i] += delta_x;
+        position_y[i] += delta_y;
+        target_x[i] += delta_x;
+        target_y[i] += delta_y;
+    }
+}
@@ -0,0 +1,147 @@
+#ifndef BLOB_POINTS_H
+#define BLOB_POINTS_H
+
+#include <cstddef>
+#include <new>
+#include <QPointF>
+#include <vector>
+
+/**
+ * @brief Minimal allocator returning memory aligned to a fixed boundary.
+ * Lets std::vector hold data that SIMD kernels can load with aligned loads and that never
+ * shares a cache line with another array.
+ * @tparam T The element type.
+ * @tparam Alignment The alignment in bytes (a power of two).
+ */
+template<typename T, std::size_t Alignment>
+class AlignedAllocator {
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept {
+    }
+
+    T *allocate(const std::size_t count) {
+        return static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T *pointer, std::size_t) noexcept {
+        ::operator delete(pointer, std::align_val_t(Alignment));
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment> &) const noexcept { return true; }
+};
+
+/** @brief Float vector aligned to a 64-byte boundary (cache line and AVX-512 register width). */
+using AlignedFloatVector = std::vector<float, AlignedAllocator<float, 64> >;
+
+/**
+ * @brief Seedable random generator of one blob simulation (SplitMix64).
+ * Its whole state is a single integer, so it is copied with the simulation state and saved in recordings:
+ * a replay draws the same shape factors and repair radii as the recorded session.
+ */
+struct BlobRandomGenerator {
+    /** @brief Seed the generator was started from. */
+    quint64 seed = 0;
+    /** @brief Current state; advances with every draw. */
+    quint64 state = 0;
+
+    /**
+     * @brief Restarts the sequence from a seed.
+     * @param value The seed.
+     */
+    void Seed(const quint64 value) {
+        seed = value;
+        state = value;
+    }
+
+    /**
+     * @brief Draws the next value of the sequence.
+     * @return A uniformly distributed double in [0, 1).
+     */
+    double GenerateDouble() {
+        quint64 z = state += 0x9E3779B97F4A7C15ull;
+        z = (z ^ z >> 30) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ z >> 27) * 0x94D049BB133111EBull;
+        z ^= z >> 31;
+        // the top 53 bits fill the mantissa of a double
+        return static_cast<double>(z >> 11) * (1.0 / 9007199254740992.0);
+    }
+};
+
+/**
+ * @brief Per-instance state of the blob's control points in Structure-of-Arrays float layout.
+ *
+ * Physics, the animation states and the renderer all operate on these arrays directly, so no
+ * per-frame conversion between QPointF vectors and SIMD-friendly arrays is needed. QPointF values
+ * are only produced where Qt requires them (building the QPainterPath).
+ * Each BlobAnimation owns its own instance; access is guarded by the owner's points mutex.
+ */
+struct BlobPoints {
+    /** @brief Current x coordinates of the control points. */
+    AlignedFloatVector position_x;
+    /** @brief Current y coordinates of the control points. */
+    AlignedFloatVector position_y;
+    /** @brief Target x coordinates the springs pull the points towards. */
+    AlignedFloatVector target_x;
+    /** @brief Target y coordinates the springs pull the points towards. */
+    AlignedFloatVector target_y;
+    /** @brief X components of the point velocities. */
+    AlignedFloatVector velocity_x;
+    /** @brief Y components of the point velocities. */
+    AlignedFloatVector velocity_y;
+    /** @brief Per-point radius factors of the ideal shape BlobPhysics::StabilizeBlob() relaxes towards. */
+    std::vector<float> shape_factors;
+
+    /**
+     * @brief Gets the number of control points.
+     * @return The number of points.
+     */
+    [[nodiscard]] size_t Size() const { return position_x.size(); }
+
+    /**
+     * @brief Checks whether the blob has any control points.
+     * @return True if there are no points.
+     */
+    [[nodiscard]] bool Empty() const { return position_x.empty(); }
+
+    /**
+     * @brief Gets the position of a single point.
+     * @param index The point index.
+     * @return The position as a QPointF.
+     */
+    [[nodiscard]] QPointF Position(const size_t index) const {
+        return {position_x[index], position_y[index]};
+    }
+
+    /**
+     * @brief Replaces the shape: positions and targets are set to the given points, velocities are cleared.
+     * Regenerates the stabilization shape factors when the number of points changes.
+     * @param points The new control point positions.
+     * @param random Generator of the new shape factors.
+     */
+    void AssignShape(const std::vector<QPointF> &points, BlobRandomGenerator &random);
+
+    /**
+     * @brief Multiplies all velocities by a factor.
+     * @param factor The scale factor.
+     */
+    void ScaleVelocities(float factor);
+
+    /**
+     * @brief Moves both positions and targets by the same offset.
+     * @param delta The offset.
+     */
+    void Translate(const QPointF &delta);
+};
+
+#endif // BLOB_POINTS_H
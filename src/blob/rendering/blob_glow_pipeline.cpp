@@ -0,0 +1,113 @@
+#include "blob_glow_pipeline.h"
+
+#include <QDebug>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLShaderProgram>
+#include <QVector2D>
+
+namespace {
+    // 9-tap Gaussian (sigma ~ 2 texels) folded into 5 bilinear fetches: each off-center fetch lands between two
+    // texels at the weighted position, so the hardware filter does half of the taps
+    const auto kBlurFragmentShader = R"(
+        #version 330 core
+        out vec4 FragColor;
+        uniform sampler2D sourceTexture;
+        uniform vec2 viewportSize;
+        uniform vec2 texelStep;
+
+        const float kOffsets[3] = float[](0.0, 1.3846153846, 3.2307692308);
+        const float kWeights[3] = float[](0.2270270270, 0.3162162162, 0.0702702703);
+
+        void main() {
+            vec2 uv = gl_FragCoord.xy / viewportSize;
+            vec4 sum = texture(sourceTexture, uv) * kWeights[0];
+            for (int i = 1; i < 3; ++i) {
+                sum += texture(sourceTexture, uv + texelStep * kOffsets[i]) * kWeights[i];
+                sum += texture(sourceTexture, uv - texelStep * kOffsets[i]) * kWeights[i];
+            }
+            FragColor = sum;
+        }
+    )";
+}
+
+BlobGlowPipeline::BlobGlowPipeline() = default;
+
+BlobGlowPipeline::~BlobGlowPipeline() = default;
+
+bool BlobGlowPipeline::Initialize() {
+    functions_initialized_ = initializeOpenGLFunctions();
+    if (!functions_initialized_) {
+        qCritical() << "[BLOB GLOW] Failed to initialize OpenGL 3.3 functions!";
+        return false;
+    }
+
+    blur_program_ = std::make_unique<QOpenGLShaderProgram>();
+    blur_program_->addShaderFromSourceCode(QOpenGLShader::Vertex, kFullScreenVertexShader);
+    blur_program_->addShaderFromSourceCode(QOpenGLShader::Fragment, kBlurFragmentShader);
+    if (!blur_program_->link()) {
+        qCritical() << "[BLOB GLOW] Blur Shader Log:" << blur_program_->log();
+        blur_program_.reset();
+        return false;
+    }
+    return true;
+}
+
+void BlobGlowPipeline::Release() {
+    framebuffers_[0].reset();
+    framebuffers_[1].reset();
+    blur_program_.reset();
+    glow_size_ = QSize();
+}
+
+bool BlobGlowPipeline::IsReady() const {
+    return functions_initialized_ && blur_program_ && blur_program_->isLinked();
+}
+
+void BlobGlowPipeline::BeginGlowPass(const QSize &target_size) {
+    const QSize glow_size(qMax(1, (target_size.width() + kDownsample - 1) / kDownsample),
+                          qMax(1, (target_size.height() + kDownsample - 1) / kDownsample));
+
+    if (glow_size != glow_size_ || !framebuffers_[0]) {
+        for (auto &framebuffer: framebuffers_) {
+            framebuffer = std::make_unique<QOpenGLFramebufferObject>(glow_size);
+            // linear filtering is what makes both the 5-fetch blur and the upscaling composite work
+            glBindTexture(GL_TEXTURE_2D, framebuffer->texture());
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glow_size_ = glow_size;
+    }
+
+    framebuffers_[0]->bind();
+    glViewport(0, 0, glow_size_.width(), glow_size_.height());
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+}
+
+GLuint BlobGlowPipeline::BlurGlow() {
+    glDisable(GL_BLEND);
+
+    blur_program_->bind();
+    blur_program_->setUniformValue("sourceTexture", 0);
+    blur_program_->setUniformValue("viewportSize", QVector2D(glow_size_.width(), glow_size_.height()));
+    glActiveTexture(GL_TEXTURE0);
+
+    RunBlurPass(framebuffers_[0]->texture(), 1, 1.0f / static_cast<float>(glow_size_.width()), 0.0f);
+    RunBlurPass(framebuffers_[1]->texture(), 0, 0.0f, 1.0f / static_cast<float>(glow_size_.height()));
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    blur_program_->release();
+
+    return framebuffers_[0]->texture();
+}
+
+void BlobGlowPipeline::RunBlurPass(const GLuint source_texture, const int target_index,
+                                   const float texel_step_x, const float texel_step_y) {
+    framebuffers_[target_index]->bind();
+    glBindTexture(GL_TEXTURE_2D, source_texture);
+    blur_program_->setUniformValue("texelStep", QVector2D(texel_step_x, texel_step_y));
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+}
@@ -0,0 +1,97 @@
+#ifndef BLOB_GLOW_PIPELINE_H
+#define BLOB_GLOW_PIPELINE_H
+
+#include <memory>
+#include <QOpenGLFunctions_3_3_Core>
+#include <QSize>
+
+class QOpenGLFramebufferObject;
+class QOpenGLShaderProgram;
+
+/**
+ * @brief Render-to-texture glow: the glow sources are drawn into a downsampled framebuffer, blurred with a
+ * two-pass separable Gaussian (horizontal, then vertical, ping-ponging between two framebuffers) and handed
+ * back as a texture for an additive composite.
+ *
+ * Replaces the stacked wide QPainter strokes that were re-rendered into a full-size QPixmap. The blur runs on
+ * a quarter of the pixels (kDownsample in both directions), which also widens the effective kernel for free.
+ * The framebuffers are only reallocated when the target size changes.
+ * All methods must be called with the owning GL context current, with a vertex array object bound.
+ */
+class BlobGlowPipeline : protected QOpenGLFunctions_3_3_Core {
+public:
+    /** @brief Downsampling factor of the glow framebuffers relative to the target, in each direction. */
+    static constexpr int kDownsample = 2;
+
+    /**
+     * @brief Vertex shader drawing one triangle that covers the whole viewport (three vertices, no attributes).
+     * Shared by every full-screen pass of the blob renderer.
+     */
+    static constexpr auto kFullScreenVertexShader = R"(
+        #version 330 core
+        void main() {
+            vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+            gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+        }
+    )";
+
+    BlobGlowPipeline();
+
+    /**
+     * @brief Destructor. GL resources must have been released with Release() while the context was current.
+     */
+    ~BlobGlowPipeline();
+
+    /**
+     * @brief Resolves the GL functions and compiles the blur shader. Framebuffers are created lazily.
+     * @return True if the pipeline is usable.
+     */
+    bool Initialize();
+
+    /**
+     * @brief Destroys the framebuffers and the blur shader.
+     */
+    void Release();
+
+    /**
+     * @brief Checks whether Initialize() succeeded.
+     * @return True if the blur shader is linked.
+     */
+    [[nodiscard]] bool IsReady() const;
+
+    /**
+     * @brief Binds the glow source framebuffer (cleared to transparent) and sets the viewport to its size.
+     * (Re)allocates both framebuffers if the target size changed.
+     * @param target_size Size of the final render target in device pixels.
+     */
+    void BeginGlowPass(const QSize &target_size);
+
+    /**
+     * @brief Blurs the glow sources drawn since BeginGlowPass(): horizontal pass into the second framebuffer,
+     * vertical pass back into the first one. Leaves blending disabled and a glow framebuffer bound;
+     * the caller rebinds its own target.
+     * @return The texture holding the blurred glow (premultiplied alpha, bottom-up like any GL render target).
+     */
+    GLuint BlurGlow();
+
+private:
+    /**
+     * @brief Runs one blur pass.
+     * @param source_texture The texture to blur.
+     * @param target_index Index of the framebuffer to render into.
+     * @param texel_step_x Horizontal offset of one texel along the blur direction, in texture coordinates.
+     * @param texel_step_y Vertical offset of one texel along the blur direction, in texture coordinates.
+     */
+    void RunBlurPass(GLuint source_texture, int target_index, float texel_step_x, float texel_step_y);
+
+    /** @brief Whether initializeOpenGLFunctions() succeeded. */
+    bool functions_initialized_ = false;
+    /** @brief Separable Gaussian blur shader (direction set per pass). */
+    std::unique_ptr<QOpenGLShaderProgram> blur_program_;
+    /** @brief Ping-pong framebuffers at the downsampled size; [0] holds the sources and the final result. */
+    std::unique_ptr<QOpenGLFramebufferObject> framebuffers_[2];
+    /** @brief Current size of the framebuffers. */
+    QSize glow_size_;
+};
+
+#endif // BLOB_GLOW_PIPELINE_H
@@ -1,353 +1,566 @@
 #include "blob_renderer.h"
 
+#include <algorithm>
 #include <QDateTime>
+#include <QImage>
+#include <QMatrix4x4>
+#include <QOpenGLShaderProgram>
 #include <QPainter>
 #include <QRandomGenerator>
+#include <QVector2D>
+#include <QVector3D>
+#include <QVector4D>
+
+namespace {
+    /** @brief Size of the control point uniform buffer: x, y per point, i.e. two points per std140 vec4. */
+    constexpr GLsizeiptr kControlPointBufferSize = BlobRenderer::kMaxControlPoints * 2 * sizeof(GLfloat);
+    /** @brief Uniform buffer binding point of the control points. */
+    constexpr GLuint kControlPointBinding = 0;
+
+    /**
+     * @brief Closed outline spline shared by the fill and stroke vertex shaders: the same Catmull-Rom segments
+     * (tension 0.25) as BlobPath::CreateBlobPath, evaluated per vertex from the control point uniform buffer.
+     */
+    const auto kSplineShaderSource = R"(
+        #version 330 core
+        #define BLOB_MAX_CONTROL_POINTS 256
+
+        layout (std140) uniform BlobControlPoints {
+            vec4 controlPoints[BLOB_MAX_CONTROL_POINTS / 2];
+        };
+        uniform mat4 projection;
+        uniform int pointCount;
+        uniform int subdivisions;
+
+        vec2 ControlPoint(int index) {
+            int wrapped = index % pointCount;
+            vec4 pair = controlPoints[wrapped / 2];
+            return (wrapped % 2 == 0) ? pair.xy : pair.zw;
+        }
 
-#include "../utils/blob_path.h"
-
-void BlobRenderer::RenderBlob(QPainter &painter,
-                              const std::vector<QPointF> &control_points,
-                              const QPointF &blob_center,
-                              const BlobConfig::BlobParameters &params) {
-    painter.setRenderHint(QPainter::Antialiasing, true);
-
-    const QPainterPath blob_path = BlobPath::CreateBlobPath(control_points, control_points.size());
+        // sample k of the outline (wrapping around), with the curve derivative there
+        vec2 SplinePoint(int spline_sample, out vec2 tangent) {
+            int wrapped_sample = spline_sample % (pointCount * subdivisions);
+            int segment = wrapped_sample / subdivisions;
+            float t = float(wrapped_sample % subdivisions) / float(subdivisions);
+
+            vec2 p0 = ControlPoint(segment + pointCount - 1);
+            vec2 p1 = ControlPoint(segment);
+            vec2 p2 = ControlPoint(segment + 1);
+            vec2 p3 = ControlPoint(segment + 2);
+            vec2 c1 = p1 + (p2 - p0) * 0.25;
+            vec2 c2 = p2 + (p1 - p3) * 0.25;
+
+            float u = 1.0 - t;
+            tangent = 3.0 * u * u * (c1 - p1) + 6.0 * u * t * (c2 - c1) + 3.0 * t * t * (p2 - c2);
+            return u * u * u * p1 + 3.0 * u * u * t * c1 + 3.0 * u * t * t * c2 + t * t * t * p2;
+        }
+    )";
+
+    // vertex 0 is the fan center, vertex 1 + k is sample k of the outline
+    const auto kFillVertexShaderMain = R"(
+        uniform vec2 blobCenter;
+        out vec2 scenePosition;
+
+        void main() {
+            vec2 position = blobCenter;
+            if (gl_VertexID > 0) {
+                vec2 tangent;
+                position = SplinePoint(gl_VertexID - 1, tangent);
+            }
+            scenePosition = position;
+            gl_Position = projection * vec4(position, 0.0, 1.0);
+        }
+    )";
+
+    // the radial gradient of the former QPainter filling: stops at 0, 0.7, 0.9 and 1 (premultiplied colors)
+    const auto kFillFragmentShader = R"(
+        #version 330 core
+        in vec2 scenePosition;
+        out vec4 FragColor;
+        uniform vec2 blobCenter;
+        uniform float blobRadius;
+        uniform vec4 centerColor;
+        uniform vec4 midColor;
+        uniform vec4 edgeColor;
+
+        void main() {
+            float gradient_position = length(scenePosition - blobCenter) / blobRadius;
+            if (gradient_position < 0.7) {
+                FragColor = mix(centerColor, midColor, gradient_position / 0.7);
+            } else if (gradient_position < 0.9) {
+                FragColor = mix(midColor, edgeColor, (gradient_position - 0.7) / 0.2);
+            } else {
+                FragColor = mix(edgeColor, vec4(0.0), clamp((gradient_position - 0.9) / 0.1, 0.0, 1.0));
+            }
+        }
+    )";
+
+    // vertices 2k and 2k + 1 are sample k pushed out to both sides along the normal, one pixel further than
+    // the stroke width for the antialiased edge; the last pair wraps around to the first sample
+    const auto kStrokeVertexShaderMain = R"(
+        uniform float halfWidth;
+        out float edgeDistance;
+
+        void main() {
+            vec2 tangent;
+            vec2 position = SplinePoint(gl_VertexID / 2, tangent);
+            float tangent_length = length(tangent);
+            vec2 normal = tangent_length > 0.0 ? vec2(-tangent.y, tangent.x) / tangent_length : vec2(0.0);
+
+            edgeDistance = ((gl_VertexID % 2 == 0) ? 1.0 : -1.0) * (halfWidth + 1.0);
+            gl_Position = projection * vec4(position + normal * edgeDistance, 0.0, 1.0);
+        }
+    )";
+
+    const auto kStrokeFragmentShader = R"(
+        #version 330 core
+        in float edgeDistance;
+        out vec4 FragColor;
+        uniform float halfWidth;
+        uniform vec4 strokeColor;
+
+        void main() {
+            // coverage of the pixel by the stroke, measured in pixels across the edge
+            float coverage = clamp((halfWidth - abs(edgeDistance)) / max(fwidth(edgeDistance), 0.0001) + 0.5,
+                                   0.0, 1.0);
+            FragColor = strokeColor * coverage;
+        }
+    )";
+
+    // diagonal gradient, 1 px grid lines every gridSpacing pixels and dotted subgrid lines halfway between them
+    const auto kBackgroundFragmentShader = R"(
+        #version 330 core
+        out vec4 FragColor;
+        uniform vec3 gradientStart;
+        uniform vec3 gradientEnd;
+        uniform vec4 gridColor;
+        uniform vec4 subgridColor;
+        uniform float gridSpacing;
+        uniform float subgridOffset;
+        uniform float lineWidth;
+        uniform vec2 viewportSize;
+
+        void main() {
+            // pixel coordinates from the top left, matching the QPainter grid
+            vec2 pixel = floor(vec2(gl_FragCoord.x, viewportSize.y - gl_FragCoord.y));
+            vec2 uv = pixel / viewportSize;
+            vec3 color = mix(gradientStart, gradientEnd, (uv.x + uv.y) * 0.5);
+
+            vec2 offset = mod(pixel, gridSpacing);
+            if (offset.x < lineWidth || offset.y < lineWidth) {
+                color = mix(color, gridColor.rgb, gridColor.a);
+            } else {
+                vec2 subgrid = offset - subgridOffset;
+                vec2 dots = mod(pixel, 3.0 * lineWidth);
+                if ((subgrid.y >= 0.0 && subgrid.y < lineWidth && dots.x < lineWidth) ||
+                    (subgrid.x >= 0.0 && subgrid.x < lineWidth && dots.y < lineWidth)) {
+                    color = mix(color, subgridColor.rgb, subgridColor.a);
+                }
+            }
+            FragColor = vec4(color, 1.0);
+        }
+    )";
+
+    const auto kTextureFragmentShader = R"(
+        #version 330 core
+        out vec4 FragColor;
+        uniform sampler2D sourceTexture;
+        uniform vec2 viewportSize;
+        uniform bool flipVertically;
+
+        void main() {
+            vec2 uv = gl_FragCoord.xy / viewportSize;
+            if (flipVertically) {
+                uv.y = 1.0 - uv.y;
+            }
+            FragColor = texture(sourceTexture, uv);
+        }
+    )";
+
+    /**
+     * @brief Converts a color into the premultiplied RGBA vector the shaders blend with.
+     */
+    QVector4D PremultipliedColor(const QColor &color) {
+        const auto alpha = static_cast<float>(color.alphaF());
+        return {
+            static_cast<float>(color.redF()) * alpha, static_cast<float>(color.greenF()) * alpha,
+            static_cast<float>(color.blueF()) * alpha, alpha
+        };
+    }
 
-    DrawGlowEffect(painter, blob_path, params.border_color, params.glow_radius);
-    DrawBorder(painter, blob_path, params.border_color, params.border_width);
-    DrawFilling(painter, blob_path, blob_center, params.blob_radius, params.border_color);
+    /**
+     * @brief Compiles and links a shader program, logging failures.
+     * @return The linked program, or nullptr.
+     */
+    std::unique_ptr<QOpenGLShaderProgram> CreateProgram(const QByteArray &vertex_source,
+                                                        const char *fragment_source, const char *name) {
+        auto program = std::make_unique<QOpenGLShaderProgram>();
+        program->addShaderFromSourceCode(QOpenGLShader::Vertex, vertex_source);
+        program->addShaderFromSourceCode(QOpenGLShader::Fragment, fragment_source);
+        if (!program->link()) {
+            qCritical() << "[BLOB RENDERER]" << name << "Shader Log:" << program->log();
+            return nullptr;
+        }
+        return program;
+    }
 }
 
-void BlobRenderer::UpdateGridBuffer(const QColor &background_color,
-                                    const QColor &grid_color,
-                                    const int grid_spacing,
-                                    const int width, const int height) {
-    grid_buffer_ = QPixmap(width, height);
+BlobRenderer::BlobRenderer() : markers_manager_(nullptr),
+                               idle_amplitude_(0),
+                               idle_hud_initialized_(false),
+                               is_rendering_active_(true),
+                               last_animation_state_(BlobConfig::kMoving),
+                               hud_radius_(0),
+                               hud_texture_dirty_(false),
+                               gl_initialized_(false),
+                               control_point_buffer_(0),
+                               hud_texture_(0) {
+    // markers_manager_ = new PathMarkersManager();
+}
 
-    QPainter buffer_painter(&grid_buffer_);
-    buffer_painter.setRenderHint(QPainter::Antialiasing, false);
+BlobRenderer::~BlobRenderer() {
+    delete markers_manager_;
+    markers_manager_ = nullptr;
+}
 
-    buffer_painter.fillRect(QRect(0, 0, width, height), background_color);
-    buffer_painter.setPen(QPen(grid_color, 1, Qt::SolidLine));
+bool BlobRenderer::InitializeGL() {
+    if (!initializeOpenGLFunctions()) {
+        qCritical() << "[BLOB RENDERER] Failed to initialize OpenGL 3.3 functions!";
+        return false;
+    }
 
-    for (int y = 0; y < height; y += grid_spacing) {
-        buffer_painter.drawLine(0, y, width, y);
+    fill_program_ = CreateProgram(QByteArray(kSplineShaderSource) + kFillVertexShaderMain, kFillFragmentShader,
+                                  "Fill");
+    stroke_program_ = CreateProgram(QByteArray(kSplineShaderSource) + kStrokeVertexShaderMain,
+                                    kStrokeFragmentShader, "Stroke");
+    background_program_ = CreateProgram(BlobGlowPipeline::kFullScreenVertexShader, kBackgroundFragmentShader,
+                                        "Background");
+    texture_program_ = CreateProgram(BlobGlowPipeline::kFullScreenVertexShader, kTextureFragmentShader, "Texture");
+    if (!fill_program_ || !stroke_program_ || !background_program_ || !texture_program_) {
+        return false;
     }
 
-    for (int x = 0; x < width; x += grid_spacing) {
-        buffer_painter.drawLine(x, 0, x, height);
+    for (const QOpenGLShaderProgram *program: {fill_program_.get(), stroke_program_.get()}) {
+        const GLuint program_id = program->programId();
+        glUniformBlockBinding(program_id, glGetUniformBlockIndex(program_id, "BlobControlPoints"),
+                              kControlPointBinding);
     }
 
-    last_background_color_ = background_color;
-    last_grid_color_ = grid_color;
-    last_grid_spacing_ = grid_spacing;
-    last_size_ = QSize(width, height);
-}
+    vao_.create();
 
-void BlobRenderer::DrawBackground(QPainter &painter,
-                                  const QColor &background_color,
-                                  const QColor &grid_color,
-                                  const int grid_spacing,
-                                  const int width, const int height) {
-    const bool needs_grid_update = grid_buffer_.isNull() ||
-                                   background_color != last_background_color_ ||
-                                   grid_color != last_grid_color_ ||
-                                   grid_spacing != last_grid_spacing_ ||
-                                   QSize(width, height) != last_size_;
+    glGenBuffers(1, &control_point_buffer_);
+    glBindBuffer(GL_UNIFORM_BUFFER, control_point_buffer_);
+    glBufferData(GL_UNIFORM_BUFFER, kControlPointBufferSize, nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
+    // without the glow the rest of the scene still renders
+    if (!glow_pipeline_.Initialize()) {
+        qWarning() << "[BLOB RENDERER] Glow pipeline unavailable, rendering without glow.";
+    }
 
-    if (!static_background_initialized_) {
-        constexpr int texture_size = 800;
-        static_background_texture_ = QPixmap(texture_size, texture_size);
-        static_background_texture_.fill(Qt::transparent);
+    gl_initialized_ = true;
+    return true;
+}
 
-        QPainter texture_painter(&static_background_texture_);
-        texture_painter.setRenderHint(QPainter::Antialiasing, true);
+void BlobRenderer::ReleaseGL() {
+    if (control_point_buffer_ != 0) {
+        glDeleteBuffers(1, &control_point_buffer_);
+        control_point_buffer_ = 0;
+    }
+    if (hud_texture_ != 0) {
+        glDeleteTextures(1, &hud_texture_);
+        hud_texture_ = 0;
+        hud_texture_size_ = QSize();
+    }
+    vao_.destroy();
+    fill_program_.reset();
+    stroke_program_.reset();
+    background_program_.reset();
+    texture_program_.reset();
+    glow_pipeline_.Release();
+    gl_initialized_ = false;
+}
 
-        QLinearGradient background_gradient(0, 0, texture_size, texture_size);
-        background_gradient.setColorAt(0, QColor(0, 15, 30));
-        background_gradient.setColorAt(1, QColor(10, 25, 40));
-        texture_painter.fillRect(QRect(0, 0, texture_size, texture_size), background_gradient);
+void BlobRenderer::RenderScene(const BlobPoints &points,
+                               const QPointF &blob_center,
+                               const BlobConfig::BlobParameters &params,
+                               const BlobRenderState &render_state,
+                               const int width, const int height,
+                               const double device_pixel_ratio,
+                               const GLuint target_framebuffer) {
+    const bool state_changing_to_idle = render_state.animation_state == BlobConfig::kIdle && last_animation_state_ !=
+                                        BlobConfig::kIdle;
 
-        static_background_initialized_ = true;
+    if (state_changing_to_idle) {
+        ForceHUDInitialization(blob_center, params.blob_radius, params.border_color);
+        is_rendering_active_ = false;
+    } else if (render_state.animation_state != BlobConfig::kIdle) {
+        is_rendering_active_ = true;
     }
 
-    // static background with points
-    painter.drawPixmap(QRect(0, 0, width, height), static_background_texture_);
+    last_animation_state_ = render_state.animation_state;
 
-    // only grid without points (if needed)
-    if (needs_grid_update) {
-        grid_buffer_ = QPixmap(width, height);
-        grid_buffer_.fill(Qt::transparent);
+    if (!gl_initialized_) {
+        return;
+    }
 
-        QPainter buffer_painter(&grid_buffer_);
+    const QSize device_size(qRound(width * device_pixel_ratio), qRound(height * device_pixel_ratio));
 
-        const QColor &main_grid_color = grid_color;
-        buffer_painter.setPen(QPen(main_grid_color, 1, Qt::SolidLine));
+    glBindFramebuffer(GL_FRAMEBUFFER, target_framebuffer);
+    glViewport(0, 0, device_size.width(), device_size.height());
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
 
-        for (int y = 0; y < height; y += grid_spacing) {
-            buffer_painter.drawLine(0, y, width, y);
-        }
+    vao_.bind();
 
-        for (int x = 0; x < width; x += grid_spacing) {
-            buffer_painter.drawLine(x, 0, x, height);
-        }
+    DrawBackground(params, device_size, device_pixel_ratio);
 
-        auto subgrid_color = QColor(grid_color.redF(), grid_color.greenF(), grid_color.blueF(), 0.35);
-        subgrid_color.setAlphaF(0.3);
-        buffer_painter.setPen(QPen(subgrid_color, 0.5, Qt::DotLine));
+    if (const int point_count = UploadControlPoints(points); point_count >= 3) {
+        QMatrix4x4 projection;
+        projection.ortho(0, static_cast<float>(width), static_cast<float>(height), 0, -1, 1);
 
-        const int sub_grid_spacing = grid_spacing / 2;
-        for (int y = sub_grid_spacing; y < height; y += grid_spacing) {
-            buffer_painter.drawLine(0, y, width, y);
-        }
+        glBindBufferBase(GL_UNIFORM_BUFFER, kControlPointBinding, control_point_buffer_);
 
-        for (int x = sub_grid_spacing; x < width; x += grid_spacing) {
-            buffer_painter.drawLine(x, 0, x, height);
+        if (params.glow_radius > 0 && glow_pipeline_.IsReady()) {
+            DrawGlowEffect(point_count, params, projection, device_size, target_framebuffer);
         }
 
-        last_background_color_ = background_color;
-        last_grid_color_ = grid_color;
-        last_grid_spacing_ = grid_spacing;
-        last_size_ = QSize(width, height);
-    }
+        // all colors are premultiplied
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 
-    painter.drawPixmap(0, 0, grid_buffer_);
-}
+        // border with a thinner, lighter inner line for a neon effect
+        DrawStroke(point_count, params.spline_subdivisions, projection, params.border_color, params.border_width);
+        DrawStroke(point_count, params.spline_subdivisions, projection, params.border_color.lighter(150), 1.0);
+        DrawFilling(point_count, params, projection, blob_center);
 
-void BlobRenderer::DrawGlowEffect(QPainter &painter,
-                                  const QPainterPath &blob_path,
-                                  const QColor &border_color,
-                                  const int glow_radius) {
-    const auto viewport_size = QSize(painter.device()->width(), painter.device()->height());
+        glBindBufferBase(GL_UNIFORM_BUFFER, kControlPointBinding, 0);
+    }
 
-    const bool buffer_needs_update = glow_buffer_.isNull() ||
-                                     blob_path != last_glow_path_ ||
-                                     border_color != last_glow_color_ ||
-                                     glow_radius != last_glow_radius_ ||
-                                     viewport_size != last_glow_size_;
+    if (render_state.animation_state == BlobConfig::kIdle && idle_hud_initialized_) {
+        if (params.border_color != hud_color_) {
+            hud_color_ = params.border_color;
+            hud_texture_dirty_ = true;
+        }
+        if (hud_texture_dirty_ || hud_texture_size_ != device_size) {
+            UpdateHUDTexture(width, height, device_pixel_ratio);
+        }
 
-    if (last_animation_state_ == BlobConfig::kIdle && !buffer_needs_update && !glow_buffer_.isNull()) {
-        painter.drawPixmap(0, 0, glow_buffer_);
-        return;
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        DrawFullScreenTexture(hud_texture_, device_size, true);
     }
 
-    static int frame_counter = 0;
-    const bool should_update_buffer = buffer_needs_update ||
-                                      (last_animation_state_ != BlobConfig::kIdle &&
-                                       frame_counter++ % 5 == 0);
-
-    if (should_update_buffer) {
-        QPixmap new_glow_buffer(viewport_size);
-        new_glow_buffer.fill(Qt::transparent);
+    glDisable(GL_BLEND);
+    vao_.release();
+}
 
-        QPainter buffer_painter(&new_glow_buffer);
-        buffer_painter.setRenderHint(QPainter::Antialiasing, true);
+int BlobRenderer::UploadControlPoints(const BlobPoints &points) {
+    if (points.Size() > static_cast<size_t>(kMaxControlPoints)) {
+        if (!reported_point_overflow_) {
+            qWarning() << "[BLOB RENDERER]" << points.Size() << "control points exceed the GL capacity of"
+                    << kMaxControlPoints << "- the blob is not drawn.";
+            reported_point_overflow_ = true;
+        }
+        return 0;
+    }
+    const int point_count = static_cast<int>(points.Size());
 
-        RenderGlowEffect(buffer_painter, blob_path, border_color, glow_radius);
-        buffer_painter.end();
+    gl_control_points_.resize(point_count * 2);
+    for (int i = 0; i < point_count; ++i) {
+        gl_control_points_[i * 2] = static_cast<GLfloat>(points.position_x[i]);
+        gl_control_points_[i * 2 + 1] = static_cast<GLfloat>(points.position_y[i]);
+    }
 
-        glow_buffer_ = new_glow_buffer;
+    glBindBuffer(GL_UNIFORM_BUFFER, control_point_buffer_);
+    // orphaning hands the driver fresh storage while the GPU may still read the previous frame's points
+    glBufferData(GL_UNIFORM_BUFFER, kControlPointBufferSize, nullptr, GL_DYNAMIC_DRAW);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, static_cast<GLsizeiptr>(gl_control_points_.size() * sizeof(GLfloat)),
+                    gl_control_points_.data());
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
-        last_glow_path_ = blob_path;
-        last_glow_color_ = border_color;
-        last_glow_radius_ = glow_radius;
-        last_glow_size_ = viewport_size;
-    }
+    return point_count;
+}
 
-    painter.drawPixmap(0, 0, glow_buffer_);
+void BlobRenderer::DrawBackground(const BlobConfig::BlobParameters &params, const QSize &device_size,
+                                  const double device_pixel_ratio) {
+    background_program_->bind();
+
+    // the gradient of the former static background texture, derived from the configured background color
+    const QColor gradient_start = params.background_color.darker(125);
+    const QColor gradient_end = params.background_color.lighter(125);
+    background_program_->setUniformValue("gradientStart", QVector3D(
+                                             gradient_start.redF(), gradient_start.greenF(), gradient_start.blueF()));
+    background_program_->setUniformValue("gradientEnd", QVector3D(
+                                             gradient_end.redF(), gradient_end.greenF(), gradient_end.blueF()));
+
+    const QColor &grid_color = params.grid_color;
+    background_program_->setUniformValue("gridColor", QVector4D(
+                                             grid_color.redF(), grid_color.greenF(), grid_color.blueF(),
+                                             grid_color.alphaF()));
+    background_program_->setUniformValue("subgridColor", QVector4D(
+                                             grid_color.redF(), grid_color.greenF(), grid_color.blueF(), 0.3f));
+
+    // gl_FragCoord is in device pixels; a grid spacing of 0 would turn every pixel into a line
+    const auto pixel_ratio = static_cast<float>(device_pixel_ratio);
+    const int grid_spacing = qMax(2, params.grid_spacing);
+    background_program_->setUniformValue("gridSpacing", grid_spacing * pixel_ratio);
+    background_program_->setUniformValue("subgridOffset", static_cast<float>(grid_spacing / 2) * pixel_ratio);
+    background_program_->setUniformValue("lineWidth", qMax(1.0f, pixel_ratio));
+    background_program_->setUniformValue("viewportSize", QVector2D(device_size.width(), device_size.height()));
+
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+
+    background_program_->release();
 }
 
-void BlobRenderer::RenderGlowEffect(QPainter &painter,
-                                    const QPainterPath &blob_path,
-                                    const QColor &border_color,
-                                    int glow_radius) {
-    painter.save();
+void BlobRenderer::DrawGlowEffect(const int point_count,
+                                  const BlobConfig::BlobParameters &params,
+                                  const QMatrix4x4 &projection,
+                                  const QSize &device_size,
+                                  const GLuint target_framebuffer) {
+    const QColor &border_color = params.border_color;
 
-    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    glow_pipeline_.BeginGlowPass(device_size);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 
     // 1. base layer (mild glow) - the outermost layer
-    {
-        QColor outer_color = border_color;
-        outer_color = QColor::fromHslF(
-            outer_color.hslHueF(),
-            qMin(0.9, outer_color.hslSaturationF() * 0.7),
-            outer_color.lightnessF(),
-            0.2
-        );
-
-        QPen outer_pen(outer_color);
-        outer_pen.setWidth(glow_radius);
-        outer_pen.setCapStyle(Qt::RoundCap);
-        outer_pen.setJoinStyle(Qt::RoundJoin);
-        painter.setPen(outer_pen);
-        painter.drawPath(blob_path);
-    }
+    const QColor outer_color = QColor::fromHslF(
+        border_color.hslHueF(),
+        qMin(0.9, border_color.hslSaturationF() * 0.7),
+        border_color.lightnessF(),
+        0.2
+    );
+    DrawStroke(point_count, params.spline_subdivisions, projection, outer_color, params.glow_radius);
 
     // 2. middle layer (intense glow) - typical of neon signs
-    {
-        QColor mid_color = border_color.lighter(115);
-        mid_color = QColor::fromHslF(
-            mid_color.hslHueF(),
-            qMin(1.0, mid_color.hslSaturationF() * 1.1),
-            qMin(0.9, mid_color.lightnessF() * 1.2),
-            0.6
-        );
-
-        QPen mid_pen(mid_color);
-        mid_pen.setWidth(glow_radius / 2);
-        mid_pen.setCapStyle(Qt::RoundCap);
-        mid_pen.setJoinStyle(Qt::RoundJoin);
-        painter.setPen(mid_pen);
-        painter.drawPath(blob_path);
-    }
+    const QColor lighter_color = border_color.lighter(115);
+    const QColor mid_color = QColor::fromHslF(
+        lighter_color.hslHueF(),
+        qMin(1.0, lighter_color.hslSaturationF() * 1.1),
+        qMin(0.9, lighter_color.lightnessF() * 1.2),
+        0.6
+    );
+    DrawStroke(point_count, params.spline_subdivisions, projection, mid_color, params.glow_radius / 2);
 
     // 3. inner layer (bright nucleus) - characteristic of neon-ish effects
-    {
-        QColor core_color = border_color.lighter(160);
-        core_color = QColor::fromHslF(
-            core_color.hslHueF(),
-            qMin(0.3, core_color.hslSaturationF() * 0.5),
-            0.9,
-            0.95
-        );
-
-        QPen core_pen(core_color);
-        core_pen.setWidth(3);
-        core_pen.setCapStyle(Qt::RoundCap);
-        core_pen.setJoinStyle(Qt::RoundJoin);
-        painter.setPen(core_pen);
-        painter.drawPath(blob_path);
-    }
-
-    painter.restore();
+    const QColor nucleus_color = border_color.lighter(160);
+    const QColor core_color = QColor::fromHslF(
+        nucleus_color.hslHueF(),
+        qMin(0.3, nucleus_color.hslSaturationF() * 0.5),
+        0.9,
+        0.95
+    );
+    DrawStroke(point_count, params.spline_subdivisions, projection, core_color, 3.0);
+
+    const GLuint glow_texture = glow_pipeline_.BlurGlow();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, target_framebuffer);
+    glViewport(0, 0, device_size.width(), device_size.height());
+
+    // additive composite: light only ever brightens the background
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+    DrawFullScreenTexture(glow_texture, device_size, false);
 }
 
-void BlobRenderer::DrawBorder(QPainter &painter,
-                              const QPainterPath &blob_path,
-                              const QColor &border_color,
-                              const int border_width) {
-    QPen border_pen(border_color);
-    border_pen.setWidth(border_width);
-    painter.setPen(border_pen);
-    painter.drawPath(blob_path);
-
-    QPen inner_pen(border_color.lighter(150));
-    inner_pen.setWidth(1);
-    painter.setPen(inner_pen);
-    painter.drawPath(blob_path);
-
-    // if (markers_manager_) {
-    //     const qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
-    //     markers_manager_->drawMarkers(painter, blob_path, currentTime);
-    // }
+void BlobRenderer::DrawStroke(const int point_count,
+                              const int subdivisions,
+                              const QMatrix4x4 &projection,
+                              const QColor &color,
+                              const double stroke_width) {
+    stroke_program_->bind();
+    stroke_program_->setUniformValue("projection", projection);
+    stroke_program_->setUniformValue("pointCount", point_count);
+    stroke_program_->setUniformValue("subdivisions", subdivisions);
+    stroke_program_->setUniformValue("halfWidth", static_cast<float>(stroke_width * 0.5));
+    stroke_program_->setUniformValue("strokeColor", PremultipliedColor(color));
+
+    // two vertices per spline sample and the first pair again to close the outline
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, (point_count * subdivisions + 1) * 2);
+
+    stroke_program_->release();
 }
 
-
-void BlobRenderer::DrawFilling(QPainter &painter,
-                               const QPainterPath &blob_path,
-                               const QPointF &blob_center,
-                               double blob_radius,
-                               const QColor &border_color) {
-    QRadialGradient gradient(blob_center, blob_radius);
+void BlobRenderer::DrawFilling(const int point_count,
+                               const BlobConfig::BlobParameters &params,
+                               const QMatrix4x4 &projection,
+                               const QPointF &blob_center) {
+    const QColor &border_color = params.border_color;
 
     // brighter middle
     QColor center_color = border_color.lighter(130);
     center_color.setAlpha(30);
-    gradient.setColorAt(0, center_color);
 
     QColor mid_color = border_color;
     mid_color.setAlpha(15);
-    gradient.setColorAt(0.7, mid_color);
 
     QColor edge_color = border_color.darker(120);
     edge_color.setAlpha(5);
-    gradient.setColorAt(0.9, edge_color);
-    gradient.setColorAt(1, QColor(0, 0, 0, 0));
 
-    painter.setBrush(gradient);
-    painter.setPen(Qt::NoPen);
-    painter.drawPath(blob_path);
-}
+    fill_program_->bind();
+    fill_program_->setUniformValue("projection", projection);
+    fill_program_->setUniformValue("pointCount", point_count);
+    fill_program_->setUniformValue("subdivisions", params.spline_subdivisions);
+    fill_program_->setUniformValue("blobCenter", QVector2D(blob_center));
+    fill_program_->setUniformValue("blobRadius", static_cast<float>(params.blob_radius));
+    fill_program_->setUniformValue("centerColor", PremultipliedColor(center_color));
+    fill_program_->setUniformValue("midColor", PremultipliedColor(mid_color));
+    fill_program_->setUniformValue("edgeColor", PremultipliedColor(edge_color));
 
-void BlobRenderer::RenderScene(QPainter &painter,
-                               const std::vector<QPointF> &control_points,
-                               const QPointF &blob_center,
-                               const BlobConfig::BlobParameters &params,
-                               const BlobRenderState &render_state,
-                               const int width, const int height,
-                               QPixmap &background_cache,
-                               QSize &last_background_size,
-                               QColor &last_background_color,
-                               QColor &last_grid_color,
-                               int &last_grid_spacing) {
-    const bool state_changing_to_idle = render_state.animation_state == BlobConfig::kIdle && last_animation_state_ !=
-                                        BlobConfig::kIdle;
+    // center, every spline sample and the first sample again to close the outline
+    glDrawArrays(GL_TRIANGLE_FAN, 0, point_count * params.spline_subdivisions + 2);
 
-    if (state_changing_to_idle) {
-        InitializeIdleState();
+    fill_program_->release();
+}
 
-        static_hud_buffer_ = QPixmap(width, height);
-        static_hud_buffer_.fill(Qt::transparent);
+void BlobRenderer::UpdateHUDTexture(const int width, const int height, const double device_pixel_ratio) {
+    QImage hud_image(qRound(width * device_pixel_ratio), qRound(height * device_pixel_ratio),
+                     QImage::Format_RGBA8888_Premultiplied);
+    hud_image.setDevicePixelRatio(device_pixel_ratio);
+    hud_image.fill(Qt::transparent);
 
-        QPainter hud_painter(&static_hud_buffer_);
-        hud_painter.setRenderHint(QPainter::Antialiasing, true);
-        DrawCompleteHUD(hud_painter, blob_center, params.blob_radius, params.border_color, width, height);
-        hud_painter.end();
+    QPainter hud_painter(&hud_image);
+    hud_painter.setRenderHint(QPainter::Antialiasing, true);
+    DrawCompleteHUD(hud_painter, hud_center_, hud_radius_, hud_color_, width, height);
+    hud_painter.end();
 
-        idle_hud_initialized_ = true;
+    if (hud_texture_ == 0) {
+        glGenTextures(1, &hud_texture_);
     }
-
-    if (state_changing_to_idle) {
-        is_rendering_active_ = false;
-    } else if (render_state.animation_state != BlobConfig::kIdle) {
-        is_rendering_active_ = true;
+    glBindTexture(GL_TEXTURE_2D, hud_texture_);
+    if (hud_image.size() == hud_texture_size_) {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, hud_image.width(), hud_image.height(), GL_RGBA, GL_UNSIGNED_BYTE,
+                        hud_image.constBits());
+    } else {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, hud_image.width(), hud_image.height(), 0, GL_RGBA,
+                     GL_UNSIGNED_BYTE, hud_image.constBits());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        hud_texture_size_ = hud_image.size();
     }
+    glBindTexture(GL_TEXTURE_2D, 0);
 
-    last_animation_state_ = render_state.animation_state;
-
-    const bool should_update_background_cache =
-            background_cache.isNull() ||
-            last_background_size != QSize(width, height) ||
-            last_background_color != params.background_color ||
-            last_grid_color != params.grid_color ||
-            last_grid_spacing != params.grid_spacing;
-
-    if (render_state.animation_state == BlobConfig::kIdle) {
-        if (should_update_background_cache) {
-            background_cache = QPixmap(width, height);
-            background_cache.fill(Qt::transparent);
-
-            QPainter cache_painter(&background_cache);
-            cache_painter.setRenderHint(QPainter::Antialiasing, true);
-            DrawBackground(cache_painter, params.background_color,
-                           params.grid_color, params.grid_spacing,
-                           width, height);
-
-            last_background_size = QSize(width, height);
-            last_background_color = params.background_color;
-            last_grid_color = params.grid_color;
-            last_grid_spacing = params.grid_spacing;
-        }
-
-        painter.drawPixmap(0, 0, background_cache);
-
-        RenderBlob(painter, control_points, blob_center, params);
+    hud_texture_dirty_ = false;
+}
 
-        if (idle_hud_initialized_ && !static_hud_buffer_.isNull()) {
-            painter.drawPixmap(0, 0, static_hud_buffer_);
-        }
-    } else {
-        painter.setRenderHint(QPainter::Antialiasing, true);
-        painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+void BlobRenderer::DrawFullScreenTexture(const GLuint texture, const QSize &device_size,
+                                         const bool flip_vertically) {
+    texture_program_->bind();
+    texture_program_->setUniformValue("sourceTexture", 0);
+    texture_program_->setUniformValue("viewportSize", QVector2D(device_size.width(), device_size.height()));
+    texture_program_->setUniformValue("flipVertically", flip_vertically ? 1 : 0);
 
-        DrawBackground(painter, params.background_color,
-                       params.grid_color, params.grid_spacing,
-                       width, height);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindTexture(GL_TEXTURE_2D, 0);
 
-        RenderBlob(painter, control_points, blob_center, params);
-    }
+    texture_program_->release();
 }
 
 void BlobRenderer::InitializeIdleState() {
@@ -355,7 +568,6 @@ void BlobRenderer::InitializeIdleState() {
     idle_amplitude_ = 1.5 + sin(QDateTime::currentMSecsSinceEpoch() * 0.001) * 0.5;
     idle_timestamp_ = QDateTime::currentDateTime().toString("HH:mm:ss");
 
-    static_hud_buffer_ = QPixmap();
     idle_hud_initialized_ = false;
 }
 
@@ -400,17 +612,14 @@ void BlobRenderer::DrawCompleteHUD(QPainter &painter, const QPointF &blob_center
     painter.drawText(blob_center.x() - text_width / 2, blob_center.y() + blob_radius + 30, idle_blob_id_);
 }
 
-void BlobRenderer::ForceHUDInitialization(const QPointF &blob_center, const double blob_radius, const QColor &hud_color,
-                                          const int width, const int height) {
+void BlobRenderer::ForceHUDInitialization(const QPointF &blob_center, const double blob_radius,
+                                          const QColor &hud_color) {
     InitializeIdleState();
 
-    static_hud_buffer_ = QPixmap(width, height);
-    static_hud_buffer_.fill(Qt::transparent);
-
-    QPainter hud_painter(&static_hud_buffer_);
-    hud_painter.setRenderHint(QPainter::Antialiasing, true);
-    DrawCompleteHUD(hud_painter, blob_center, blob_radius, hud_color, width, height);
-    hud_painter.end();
-
+    hud_center_ = blob_center;
+    hud_radius_ = blob_radius;
+    hud_color_ = hud_color;
+    // painted and uploaded by the next frame, which knows the size and has the GL context current
+    hud_texture_dirty_ = true;
     idle_hud_initialized_ = true;
 }
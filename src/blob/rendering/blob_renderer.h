@@ -1,11 +1,18 @@
 #ifndef BLOB_RENDERER_H
 #define BLOB_RENDERER_H
 
-#include <QPainterPath>
-#include <QPixmap>
+#include <memory>
+#include <QOpenGLFunctions_3_3_Core>
+#include <QOpenGLVertexArrayObject>
+#include <vector>
 
+#include "blob_glow_pipeline.h"
 #include "path_markers_manager.h"
 #include "../blob_config.h"
+#include "../physics/blob_points.h"
+
+class QMatrix4x4;
+class QOpenGLShaderProgram;
 
 /**
  * @brief Structure holding state information relevant for rendering decisions.
@@ -24,111 +31,72 @@ struct BlobRenderState {
 /**
  * @brief Handles the rendering of the blob, background grid, and HUD elements.
  *
- * This class encapsulates all drawing logic for the Blob animation. It uses QPainter
- * to draw the blob shape (filling, border, glow), the background grid, and informational
- * Heads-Up Display (HUD) elements. It employs caching mechanisms (QPixmap buffers)
- * for the background, grid, glow effect, and HUD to optimize performance, especially
- * when the blob is in the Idle state.
+ * This class encapsulates all drawing logic for the Blob animation and renders the whole scene in one
+ * OpenGL pass into the widget's framebuffer:
+ * - the background gradient and grid are procedural (a full-screen fragment shader, nothing cached),
+ * - the glow is rendered to texture by BlobGlowPipeline (downsampled, separable blur) and added on top,
+ * - border and inner line are triangle strips and the filling a triangle fan, all evaluated on the outline
+ *   spline by the vertex shader from a uniform buffer of control points,
+ * - the idle state HUD is painted once with QPainter and kept as a texture, re-uploaded only when its
+ *   contents (new idle state, size or color) change.
+ * GL methods must be called with the widget's context current.
  */
-class BlobRenderer {
+class BlobRenderer : protected QOpenGLFunctions_3_3_Core {
 public:
     /**
-     * @brief Constructs a BlobRenderer object.
-     * Initializes member variables to default states.
+     * @brief Control point capacity of the GL uniform buffer (BLOB_MAX_CONTROL_POINTS in the shaders).
+     * Blobs with more points are not drawn: a truncated outline would close through the last uploaded point.
      */
-    BlobRenderer() : static_background_initialized_(false), last_grid_spacing_(0), markers_manager_(nullptr),
-                     idle_amplitude_(0),
-                     idle_hud_initialized_(false),
-                     is_rendering_active_(true),
-                     last_animation_state_(BlobConfig::kMoving), last_glow_radius_(0) {
-        // markers_manager_ = new PathMarkersManager();
-    }
+    static constexpr int kMaxControlPoints = 256;
 
     /**
-     * @brief Destructor for BlobRenderer.
-     * Cleans up allocated resources.
+     * @brief Constructs a BlobRenderer object.
+     * Initializes member variables to default states. GL resources are created by InitializeGL().
      */
-    ~BlobRenderer() {
-        delete markers_manager_;
-        markers_manager_ = nullptr;
-    }
+    BlobRenderer();
 
     /**
-     * @brief Renders the blob shape itself (filling, border, glow).
-     * @param painter The QPainter to use for drawing.
-     * @param control_points The current positions of the blob's control points.
-     * @param blob_center The calculated center of the blob.
-     * @param params Blob appearance parameters (colors, radius, etc.).
+     * @brief Destructor for BlobRenderer.
+     * Cleans up allocated resources. GL resources must have been released with ReleaseGL().
      */
-    void RenderBlob(QPainter &painter,
-                    const std::vector<QPointF> &control_points,
-                    const QPointF &blob_center,
-                    const BlobConfig::BlobParameters &params);
+    ~BlobRenderer();
 
     /**
-     * @brief Updates the internal buffer containing the rendered background grid.
-     * Called when grid parameters (colors, spacing) or widget size change.
-     * @param background_color The background color to fill behind the grid.
-     * @param grid_color The color of the grid lines.
-     * @param grid_spacing The spacing between grid lines in pixels.
-     * @param width The current width of the rendering area.
-     * @param height The current height of the rendering area.
+     * @brief Compiles the shaders and creates the VAO, the control point uniform buffer (allocated once at its
+     * maximum size) and the glow pipeline.
+     * @return True if the renderer is usable.
      */
-    void UpdateGridBuffer(const QColor &background_color,
-                          const QColor &grid_color,
-                          int grid_spacing,
-                          int width, int height);
+    bool InitializeGL();
 
     /**
-     * @brief Draws the background, including a static texture and the dynamic grid.
-     * Uses internal caching (grid_buffer_) to avoid redrawing the grid every frame if parameters haven't changed.
-     * It also draws a static background texture underneath the grid.
-     * @param painter The QPainter to use for drawing.
-     * @param background_color The desired background color (used for grid buffer update check).
-     * @param grid_color The desired color for the grid lines.
-     * @param grid_spacing The desired spacing between grid lines.
-     * @param width The current width of the rendering area.
-     * @param height The current height of the rendering area.
+     * @brief Destroys all GL resources (shaders, buffers, textures, glow framebuffers).
      */
-    void DrawBackground(QPainter &painter,
-                        const QColor &background_color,
-                        const QColor &grid_color,
-                        int grid_spacing,
-                        int width, int height);
+    void ReleaseGL();
 
     /**
-     * @brief Renders the entire scene, including a background, blob, and potentially HUD.
-     * Orchestrates the drawing process, using cached background and HUD elements when in the Idle state.
-     * Handles the logic for preparing HUD buffers when transitioning to the Idle state.
-     * @param painter The QPainter to use for drawing.
-     * @param control_points The current positions of the blob's control points.
+     * @brief Renders the entire scene: background, glow, blob and, in the Idle state, the HUD.
+     * Handles the logic for preparing the HUD when transitioning to the Idle state.
+     * @param points The blob point state (positions are used).
      * @param blob_center The calculated center of the blob.
      * @param params Blob appearance parameters.
-     * @param render_state Current rendering state information (opacity, scale, animation state, etc.).
-     * @param width The current width of the rendering area.
-     * @param height The current height of the rendering area.
-     * @param background_cache Reference to the QPixmap used for caching the background (managed externally, typically by BlobAnimation).
-     * @param last_background_size Reference to the size used for the last background cache update.
-     * @param last_background_color Reference to the background color used for the last cache update.
-     * @param last_grid_color Reference to the grid color used for the last cache update.
-     * @param last_grid_spacing Reference to the grid spacing used for the last cache update.
+     * @param render_state Current rendering state information (animation state, etc.).
+     * @param width The current width of the rendering area (logical pixels).
+     * @param height The current height of the rendering area (logical pixels).
+     * @param device_pixel_ratio Ratio between device and logical pixels.
+     * @param target_framebuffer The framebuffer to render into (the widget's default framebuffer object).
      */
-    void RenderScene(QPainter &painter,
-                     const std::vector<QPointF> &control_points,
+    void RenderScene(const BlobPoints &points,
                      const QPointF &blob_center,
                      const BlobConfig::BlobParameters &params,
                      const BlobRenderState &render_state,
                      int width, int height,
-                     QPixmap &background_cache,
-                     QSize &last_background_size,
-                     QColor &last_background_color,
-                     QColor &last_grid_color,
-                     int &last_grid_spacing);
+                     double device_pixel_ratio,
+                     GLuint target_framebuffer);
 
     /**
      * @brief Initializes parameters specific to the Idle state HUD display.
      * Generates random ID, calculates amplitude based on time, gets current timestamp.
-     * Reset the HUD buffer flags.
+     * Reset the HUD flags.
      */
     void InitializeIdleState();
 
@@ -147,47 +115,22 @@ public:
                          int height) const;
 
     /**
-     * @brief Resets the internal grid buffer pixmap, forcing it to be redrawn on the next frame.
-     */
-    void ResetGridBuffer() {
-        grid_buffer_ = QPixmap();
-    }
-
-    /**
-     * @brief Resets the HUD buffers and flags, forcing reinitialization on the next transition to Idle state.
+     * @brief Resets the HUD flags, forcing reinitialization on the next transition to Idle state.
      */
     void ResetHUD() {
         idle_hud_initialized_ = false;
-        static_hud_buffer_ = QPixmap();
     }
 
     /**
-     * @brief Forces the immediate initialization and buffering of the static HUD elements for the Idle state.
-     * Calls InitializeIdleState and then renders the HUD into the static_hud_buffer_.
+     * @brief Forces the immediate initialization of the static HUD elements for the Idle state.
+     * Calls InitializeIdleState and marks the HUD texture for re-rendering with the next frame.
      * @param blob_center The current center of the blob.
      * @param blob_radius The current radius of the blob.
      * @param hud_color The color to use for HUD elements.
-     * @param width The current width of the rendering area.
-     * @param height The current height of the rendering area.
      */
-    void ForceHUDInitialization(const QPointF &blob_center, double blob_radius,
-                                const QColor &hud_color, int width, int height);
+    void ForceHUDInitialization(const QPointF &blob_center, double blob_radius, const QColor &hud_color);
 
 private:
-    /** @brief Cached pixmap containing a static background texture (e.g., gradient, noise). Initialized once. */
-    QPixmap static_background_texture_;
-    /** @brief Flag indicating if static_background_texture_ has been initialized. */
-    bool static_background_initialized_;
-    /** @brief Cached pixmap containing the rendered grid lines. Updated when grid parameters or size change. */
-    QPixmap grid_buffer_;
-    /** @brief Stores the background color used for the last grid_buffer_ update. */
-    QColor last_background_color_;
-    /** @brief Stores the grid color used for the last grid_buffer_ update. */
-    QColor last_grid_color_;
-    /** @brief Stores the grid spacing used for the last grid_buffer_ update. */
-    int last_grid_spacing_;
-    /** @brief Stores the size used for the last grid_buffer_ update. */
-    QSize last_size_;
     /** @brief Markers Manager for drawing animated markers alongside blob border (currently unused). */
     PathMarkersManager *markers_manager_;
     /** @brief Randomly generated ID string displayed in the Idle state HUD. */
@@ -196,7 +139,7 @@ private:
     double idle_amplitude_;
     /** @brief Timestamp string displayed in the Idle state HUD (potentially dynamic, currently static after init). */
     QString idle_timestamp_;
-    /** @brief Flag indicating if the static HUD elements for the Idle state have been initialized and buffered. */
+    /** @brief Flag indicating if the static HUD elements for the Idle state have been initialized. */
     bool idle_hud_initialized_;
 
     /** @brief Flag indicating if rendering is currently active (used for state transition logic). */
@@ -204,72 +147,108 @@ private:
     /** @brief Stores the animation state from the previous frame, used for detecting state changes. */
     BlobConfig::AnimationState last_animation_state_;
 
-    /** @brief Cached pixmap containing the static elements of the HUD rendered during Idle state initialization. */
-    QPixmap static_hud_buffer_;
+    /** @brief Blob center the HUD target circle is drawn around. */
+    QPointF hud_center_;
+    /** @brief Blob radius shown by the HUD. */
+    double hud_radius_;
+    /** @brief Color the HUD is drawn with. */
+    QColor hud_color_;
+    /** @brief Flag indicating that hud_texture_ no longer matches the HUD parameters. */
+    bool hud_texture_dirty_;
+
+    /** @brief Whether InitializeGL() succeeded. */
+    bool gl_initialized_;
+    /** @brief Spline fan shader of the blob filling (radial gradient). */
+    std::unique_ptr<QOpenGLShaderProgram> fill_program_;
+    /** @brief Spline strip shader of the border, the inner line and the glow sources. */
+    std::unique_ptr<QOpenGLShaderProgram> stroke_program_;
+    /** @brief Procedural background shader (gradient, grid and dotted subgrid). */
+    std::unique_ptr<QOpenGLShaderProgram> background_program_;
+    /** @brief Full-screen textured triangle used for the glow composite and the HUD. */
+    std::unique_ptr<QOpenGLShaderProgram> texture_program_;
+    /** @brief Uniform buffer holding the control points (x, y pairs, std140 vec4 array) read by the spline shaders. */
+    GLuint control_point_buffer_;
+    /** @brief Staging copy of the control points (x, y pairs) uploaded to control_point_buffer_. Capacity is reused. */
+    std::vector<GLfloat> gl_control_points_;
+    /** @brief Empty Vertex Array Object (required by the core profile; nothing has vertex attributes). */
+    QOpenGLVertexArrayObject vao_;
+    /** @brief Texture holding the rendered HUD (premultiplied alpha, top-down rows). */
+    GLuint hud_texture_;
+    /** @brief Size of hud_texture_ in device pixels. */
+    QSize hud_texture_size_;
+    /** @brief Downsampled render-to-texture blur of the glow. */
+    BlobGlowPipeline glow_pipeline_;
+    /** @brief Whether a blob above kMaxControlPoints was already reported (it is skipped every frame). */
+    bool reported_point_overflow_ = false;
 
-    /** @brief Cached pixmap containing the rendered glow effect. Updated based on blob shape, color, and state. */
-    QPixmap glow_buffer_;
-    /** @brief Stores the blob path used for the last glow_buffer_ update. */
-    QPainterPath last_glow_path_;
-    /** @brief Stores the border color used for the last glow_buffer_ update. */
-    QColor last_glow_color_;
-    /** @brief Stores the glow radius used for the last glow_buffer_ update. */
-    int last_glow_radius_;
-    /** @brief Stores the viewport size used for the last glow_buffer_ update. */
-    QSize last_glow_size_;
+    /**
+     * @brief Uploads the control points into control_point_buffer_ in place. The buffer is orphaned first, so the
+     * upload never waits for the GPU to finish the previous frame, and its storage is never reallocated.
+     * @param points The blob point state (positions are used).
+     * @return The number of uploaded control points, or 0 if the blob has more than kMaxControlPoints.
+     */
+    int UploadControlPoints(const BlobPoints &points);
 
     /**
-     * @brief Draws the glow effect around the blob path.
-     * Uses internal caching (glow_buffer_) to optimize rendering, especially in the Idle state.
-     * Delegates the actual drawing to RenderGlowEffect when the buffer needs updating.
-     * @param painter The QPainter to use for drawing.
-     * @param blob_path The QPainterPath representing the blob's outline.
-     * @param border_color The base color for the glow.
-     * @param glow_radius The radius/spread of the glow effect.
+     * @brief Draws the background gradient, grid lines and dotted subgrid with a single full-screen triangle.
+     * Spacing and colors are uniforms, so parameter changes and resizes need no rebuild.
+     * @param params Blob appearance parameters (background and grid colors, grid spacing).
+     * @param device_size Size of the viewport in device pixels.
+     * @param device_pixel_ratio Ratio between device and logical pixels.
      */
-    void DrawGlowEffect(QPainter &painter,
-                        const QPainterPath &blob_path,
-                        const QColor &border_color,
-                        int glow_radius);
+    void DrawBackground(const BlobConfig::BlobParameters &params, const QSize &device_size,
+                        double device_pixel_ratio);
 
     /**
-     * @brief Renders the multi-layered glow effect using QPainter drawPath operations with varying pen widths and colors.
-     * This static method performs the actual drawing logic used by DrawGlowEffect when updating the cache.
-     * @param painter The QPainter to draw onto (typically the glow buffer painter).
-     * @param blob_path The QPainterPath representing the blob's outline.
-     * @param border_color The base color for the glow.
-     * @param glow_radius The radius/spread of the glow effect.
+     * @brief Draws the glow sources into the glow pipeline, blurs them and adds the result to the target.
+     * Three strokes, as the neon layers of the former QPainter glow: a wide, desaturated outer layer, an
+     * intense middle layer and a bright core.
+     * @param point_count Number of uploaded control points.
+     * @param params Blob appearance parameters (border color, glow radius, spline subdivisions).
+     * @param projection Logical-to-clip-space projection.
+     * @param device_size Size of the target in device pixels.
+     * @param target_framebuffer The framebuffer to composite into.
      */
-    static void RenderGlowEffect(QPainter &painter, const QPainterPath &blob_path, const QColor &border_color,
-                                 int glow_radius);
+    void DrawGlowEffect(int point_count, const BlobConfig::BlobParameters &params, const QMatrix4x4 &projection,
+                        const QSize &device_size, GLuint target_framebuffer);
 
     /**
-     * @brief Draws the border outline of the blob.
-     * Includes a main border and a thinner, lighter inner line for a neon effect.
-     * @param painter The QPainter to use for drawing.
-     * @param blob_path The QPainterPath representing the blob's outline.
-     * @param border_color The color of the main border.
-     * @param border_width The width of the main border.
+     * @brief Draws an antialiased stroke along the outline spline as a triangle strip extruded along the normals.
+     * @param point_count Number of uploaded control points.
+     * @param subdivisions Curve samples per control point span.
+     * @param projection Logical-to-clip-space projection.
+     * @param color Stroke color.
+     * @param stroke_width Stroke width in logical pixels.
      */
-    static void DrawBorder(QPainter &painter,
-                           const QPainterPath &blob_path,
-                           const QColor &border_color,
-                           int border_width);
+    void DrawStroke(int point_count, int subdivisions, const QMatrix4x4 &projection, const QColor &color,
+                    double stroke_width);
 
     /**
-     * @brief Draws the filling inside the blob path using a radial gradient.
+     * @brief Draws the filling inside the outline using a radial gradient.
      * The gradient fades from a lighter, semi-transparent center towards a darker, transparent edge.
-     * @param painter The QPainter to use for drawing.
-     * @param blob_path The QPainterPath representing the blob's outline.
+     * @param point_count Number of uploaded control points.
+     * @param params Blob appearance parameters (border color, radius, spline subdivisions).
+     * @param projection Logical-to-clip-space projection.
      * @param blob_center The center point for the radial gradient.
-     * @param blob_radius The radius for the radial gradient.
-     * @param border_color The base color used to derive gradient colors.
      */
-    static void DrawFilling(QPainter &painter,
-                            const QPainterPath &blob_path,
-                            const QPointF &blob_center,
-                            double blob_radius,
-                            const QColor &border_color);
+    void DrawFilling(int point_count, const BlobConfig::BlobParameters &params, const QMatrix4x4 &projection,
+                     const QPointF &blob_center);
+
+    /**
+     * @brief Paints the HUD with QPainter and uploads it into hud_texture_ (reusing its storage if the size matches).
+     * @param width The width of the rendering area (logical pixels).
+     * @param height The height of the rendering area (logical pixels).
+     * @param device_pixel_ratio Ratio between device and logical pixels.
+     */
+    void UpdateHUDTexture(int width, int height, double device_pixel_ratio);
+
+    /**
+     * @brief Draws a texture over the whole viewport with the current blend function.
+     * @param texture The texture to draw.
+     * @param device_size Size of the viewport in device pixels.
+     * @param flip_vertically True for textures uploaded from a QImage (top-down rows).
+     */
+    void DrawFullScreenTexture(GLuint texture, const QSize &device_size, bool flip_vertically);
 };
 
 #endif // BLOB_RENDERER_H
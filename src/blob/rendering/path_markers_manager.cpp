@@ -69,54 +69,58 @@ void PathMarkersManager::UpdateMarkers(const double delta_time) {
     QRandomGenerator *rng = QRandomGenerator::global();
 
     for (auto &marker: markers_) {
-        marker.position += marker.direction * marker.speed * delta_time;
-        if (marker.position > 1.0) {
-            marker.position -= 1.0; // looping after reaching the end
-        } else if (marker.position < 0.0) {
-            marker.position += 1.0; // looping after reaching the start
-        }
+        UpdateMarker(marker, delta_time, rng);
+    }
+}
 
-        marker.color_phase += marker.color_speed * delta_time;
-        if (marker.color_phase > 1.0) {
-            marker.color_phase -= 1.0;
-        }
+void PathMarkersManager::UpdateMarker(PathMarker &marker, const double delta_time, QRandomGenerator *rng) {
+    marker.position += marker.direction * marker.speed * delta_time;
+    if (marker.position > 1.0) {
+        marker.position -= 1.0; // looping after reaching the end
+    } else if (marker.position < 0.0) {
+        marker.position += 1.0; // looping after reaching the start
+    }
 
-        if (marker.marker_type == 1) {
-            marker.wave_phase += 1.5 * delta_time;
-            if (marker.wave_phase > 5.0) {
-                marker.wave_phase = 0.0;
-            }
+    marker.color_phase += marker.color_speed * delta_time;
+    if (marker.color_phase > 1.0) {
+        marker.color_phase -= 1.0;
+    }
+
+    if (marker.marker_type == 1) {
+        marker.wave_phase += 1.5 * delta_time;
+        if (marker.wave_phase > 5.0) {
+            marker.wave_phase = 0.0;
         }
+    }
 
-        if (marker.marker_type == 2) {
-            marker.quantum_state_time += delta_time;
-
-            if (marker.quantum_state_time >= marker.quantum_state_duration) {
-                marker.quantum_state = (marker.quantum_state + 1) % 4;
-                marker.quantum_state_time = 0.0;
-
-                switch (marker.quantum_state) {
-                    case 0: // Single point
-                        marker.quantum_state_duration = 2.0 + rng->bounded(2.0);
-                        break;
-                    case 1: // Expanding
-                        marker.quantum_state_duration = 0.8 + rng->bounded(0.6);
-                        break;
-                    case 2: // Disjointed
-                        marker.quantum_state_duration = 1.5 + rng->bounded(1.5);
-                        break;
-                    case 3: // Retraction
-                        marker.quantum_state_duration = 0.8 + rng->bounded(0.6);
-                        break;
-                    default:
-                        break;
-                }
+    if (marker.marker_type == 2) {
+        marker.quantum_state_time += delta_time;
+
+        if (marker.quantum_state_time >= marker.quantum_state_duration) {
+            marker.quantum_state = (marker.quantum_state + 1) % 4;
+            marker.quantum_state_time = 0.0;
+
+            switch (marker.quantum_state) {
+                case 0: // Single point
+                    marker.quantum_state_duration = 2.0 + rng->bounded(2.0);
+                    break;
+                case 1: // Expanding
+                    marker.quantum_state_duration = 0.8 + rng->bounded(0.6);
+                    break;
+                case 2: // Disjointed
+                    marker.quantum_state_duration = 1.5 + rng->bounded(1.5);
+                    break;
+                case 3: // Retraction
+                    marker.quantum_state_duration = 0.8 + rng->bounded(0.6);
+                    break;
+                default:
+                    break;
             }
         }
+    }
 
-        if (marker.marker_type == 0) {
-            marker.trail_points.clear();
-        }
+    if (marker.marker_type == 0) {
+        marker.trail_points.clear();
     }
 }
 
@@ -128,36 +132,22 @@ void PathMarkersManager::DrawMarkers(QPainter &painter, const QPainterPath &blob
     const double delta_time = (current_time - last_update_time_) / 1000.0;
     last_update_time_ = current_time;
 
-    UpdateMarkers(delta_time);
-
-    double path_length = 0;
-    for (int i = 0; i < blob_path.elementCount() - 1; i++) {
-        QPointF p1 = blob_path.elementAt(i);
-        QPointF p2 = blob_path.elementAt(i + 1);
-        path_length += QLineF(p1, p2).length();
-    }
+    arc_length_table_.Build(blob_path);
+    const bool has_path = !arc_length_table_.Empty();
+    const double path_length = arc_length_table_.TotalLength();
+    QRandomGenerator *rng = QRandomGenerator::global();
 
+    // one pass: every marker is advanced, placed on the path and drawn before moving on to the next one
     for (auto &marker: markers_) {
-        const double position = marker.position * path_length;
-        double current_length = 0;
-        QPointF marker_position;
-
-        for (int j = 0; j < blob_path.elementCount() - 1; j++) {
-            QPointF p1 = blob_path.elementAt(j);
-            QPointF p2 = blob_path.elementAt(j + 1);
-            const double segment_length = QLineF(p1, p2).length();
-
-            if (current_length + segment_length >= position) {
-                const double t = (position - current_length) / segment_length;
-                marker_position = p1 * (1 - t) + p2 * t;
-
-                if (marker.marker_type == 0) {
-                    CalculateTrailPoints(marker, blob_path, position, path_length);
-                }
+        UpdateMarker(marker, delta_time, rng);
+        if (!has_path) {
+            continue;
+        }
 
-                break;
-            }
-            current_length += segment_length;
+        const double position = marker.position * path_length;
+        const QPointF marker_position = arc_length_table_.PointAtLength(position);
+        if (marker.marker_type == 0) {
+            CalculateTrailPoints(marker, arc_length_table_, position);
         }
 
         QColor marker_color = GetMarkerColor(marker.marker_type, marker.color_phase);
@@ -178,34 +168,17 @@ void PathMarkersManager::DrawMarkers(QPainter &painter, const QPainterPath &blob
     }
 }
 
-void PathMarkersManager::CalculateTrailPoints(PathMarker &marker, const QPainterPath &blob_path, const double position,
-                                              const double path_length) {
+void PathMarkersManager::CalculateTrailPoints(PathMarker &marker, const PathArcLengthTable &arc_length_table,
+                                              const double position) {
     marker.trail_points.clear();
     constexpr int trail_points = 15;
+    const double path_length = arc_length_table.TotalLength();
 
     for (int k = 0; k < trail_points; k++) {
         const double trailT = static_cast<double>(k) / trail_points;
-
-        double trail_pos_on_path = position - marker.direction * trailT * marker.tail_length * path_length;
-
-        // wrapping
-        if (trail_pos_on_path < 0) trail_pos_on_path += path_length;
-        if (trail_pos_on_path > path_length) trail_pos_on_path -= path_length;
-
-        double trail_length = 0;
-        for (int l = 0; l < blob_path.elementCount() - 1; l++) {
-            QPointF tp1 = blob_path.elementAt(l);
-            QPointF tp2 = blob_path.elementAt(l + 1);
-            const double trail_segment_length = QLineF(tp1, tp2).length();
-
-            if (trail_length + trail_segment_length >= trail_pos_on_path) {
-                const double trail_point_t = (trail_pos_on_path - trail_length) / trail_segment_length;
-                QPointF trail_point = tp1 * (1 - trail_point_t) + tp2 * trail_point_t;
-                marker.trail_points.push_back(trail_point);
-                break;
-            }
-            trail_length += trail_segment_length;
-        }
+        // PointAtLength() wraps positions behind the start or past the end of the path
+        const double trail_pos_on_path = position - marker.direction * trailT * marker.tail_length * path_length;
+        marker.trail_points.push_back(arc_length_table.PointAtLength(trail_pos_on_path));
     }
 }
 
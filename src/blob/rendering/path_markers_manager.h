@@ -4,10 +4,12 @@
 #include <qglobal.h>
 #include <vector>
 
+#include "../utils/path_arc_length_table.h"
+
 class QColor;
 class QPainterPath;
 class QPainter;
-class QPointF;
+class QRandomGenerator;
 
 /**
  * @brief Manages the creation, update, and rendering of animated markers along a QPainterPath.
@@ -16,6 +18,8 @@ class QPointF;
  * that move along a given path (typically the blob's outline). Each marker type has unique
  * visual characteristics and animation behavior. The manager handles marker initialization,
  * position updates based on time, and drawing logic using QPainter.
+ * Each frame measures the path once into a PathArcLengthTable; marker heads and impulse trails are then
+ * placed with O(log n) lookups, and every marker is updated and drawn in a single pass.
  */
 class PathMarkersManager {
 public:
@@ -64,9 +68,8 @@ public:
 
     /**
      * @brief Draws all managed markers onto the provided QPainter.
-     * Calculates the time delta since the last draw call, updates marker states,
-     * determines marker positions on the given path, and calls the appropriate
-     * drawing function for each marker type. Initializes markers if the list is empty.
+     * Calculates the time delta since the last draw call and builds the arc-length table of the path,
+     * then updates, positions and draws each marker in one pass. Initializes markers if the list is empty.
      * @param painter The QPainter to use for drawing.
      * @param blob_path The QPainterPath along which the markers should be drawn.
      * @param current_time The current timestamp in milliseconds (e.g., from QDateTime::currentMSecsSinceEpoch()).
@@ -97,17 +100,25 @@ private:
     std::vector<PathMarker> markers_;
     /** @brief Timestamp (milliseconds since epoch) of the last call to drawMarkers, used for calculating deltaTime. */
     qint64 last_update_time_;
+    /** @brief Arc-length parameterization of the path drawn in the current frame. Rebuilt per frame, capacity reused. */
+    PathArcLengthTable arc_length_table_;
+
+    /**
+     * @brief Advances a single marker by the elapsed time (position, color phase, wave phase, quantum state).
+     * @param marker The marker to update (modified).
+     * @param delta_time Time elapsed since the last update in seconds.
+     * @param rng Random generator used for the durations of new quantum states.
+     */
+    static void UpdateMarker(PathMarker &marker, double delta_time, QRandomGenerator *rng);
 
     /**
      * @brief Calculates the points needed to draw the trailing effect for an impulse marker.
      * Populates the marker's trailPoints vector.
      * @param marker Reference to the PathMarker (type 0) whose trail points are being calculated (modified).
-     * @param blob_path The path along which the marker moves.
+     * @param arc_length_table Arc-length table of the path along which the marker moves.
      * @param position The current absolute position (distance along the path) of the marker head.
-     * @param path_length The total length of the blobPath.
      */
-    static void CalculateTrailPoints(PathMarker &marker, const QPainterPath &blob_path, double position,
-                                     double path_length);
+    static void CalculateTrailPoints(PathMarker &marker, const PathArcLengthTable &arc_length_table, double position);
 
     /**
      * @brief Draws a marker of type 0 (Impulse).
@@ -1,6 +1,7 @@
 #include "idle_state.h"
 
 #include <math.h>
+#include <QDataStream>
 
 IdleState::IdleState() {
 }
@@ -28,12 +29,11 @@ void IdleState::ResetInitialization() {
     heartbeat_phase_ = 0.0;
 }
 
-void IdleState::Apply(std::vector<QPointF> &control_points,
-                      std::vector<QPointF> &velocity,
+void IdleState::Apply(BlobPoints &points,
                       QPointF &blob_center,
                       const BlobConfig::BlobParameters &params) {
     if (is_initializing_) {
-        ApplyHeartbeatEffect(control_points, velocity, blob_center, params);
+        ApplyHeartbeatEffect(points, blob_center, params);
         return;
     }
 
@@ -47,42 +47,19 @@ void IdleState::Apply(std::vector<QPointF> &control_points,
     const QPointF centering_force = (screen_center - blob_center) * 0.01;
     blob_center += centering_force;
 
-    QPointF total_displacement(0, 0);
+    // wave 1: the main peripheral wave, wave 2: an additional wave with a different frequency for added depth
+    IdleWaveSynthesizer::WaveParameters wave;
+    wave.center_x = blob_center.x();
+    wave.center_y = blob_center.y();
+    wave.primary_amplitude = idle_params_.wave_amplitude * 0.9;
+    wave.primary_phase = idle_params_.wave_phase;
+    wave.secondary_amplitude = idle_params_.wave_amplitude * 0.5;
+    wave.secondary_phase = second_phase_;
+    wave.frequency = idle_params_.wave_frequency;
+    wave.rotation_strength = rotation_strength;
+    wave.blob_radius = params.blob_radius;
+    wave_synthesizer_.ApplyWave(points, wave);
 
-    for (size_t i = 0; i < control_points.size(); ++i) {
-        QPointF vector_from_center = control_points[i] - blob_center;
-        const double angle = std::atan2(vector_from_center.y(), vector_from_center.x());
-        const double distance_from_center = QVector2D(vector_from_center).length();
-
-        // wave 1: the main peripheral wave
-        double wave_strength = idle_params_.wave_amplitude * 0.9 *
-                               std::sin(idle_params_.wave_phase + idle_params_.wave_frequency * angle);
-
-        // wave 2: an additional wave with a different frequency for added depth
-        wave_strength += idle_params_.wave_amplitude * 0.5 *
-                std::sin(second_phase_ + idle_params_.wave_frequency * 2.0 * angle);
-
-        QVector2D normalized_vector = QVector2D(vector_from_center).normalized();
-        QPointF perp_vector(-normalized_vector.y(), normalized_vector.x());
-
-        const double rotation_factor = rotation_strength * (distance_from_center / params.blob_radius);
-        QPointF rotation_force = rotation_factor * perp_vector;
-
-        QPointF force_vector = QPointF(normalized_vector.x(), normalized_vector.y()) * wave_strength + rotation_force;
-
-        double force_scale = 0.2 + 0.8 * (distance_from_center / params.blob_radius);
-        if (force_scale > 1.0) force_scale = 1.0;
-
-        const QPointF delta_force = force_vector * force_scale * 0.15;
-        velocity[i] += delta_force;
-
-        total_displacement += delta_force;
-    }
-
-    const QPointF avg_displacement = total_displacement / control_points.size();
-    for (auto &vel: velocity) {
-        vel -= avg_displacement;
-    }
     if (QVector2D(blob_center - screen_center).length() > params.blob_radius * 0.1) {
         blob_center = blob_center * 0.95 + screen_center * 0.05;
     } else {
@@ -91,28 +68,26 @@ void IdleState::Apply(std::vector<QPointF> &control_points,
 }
 
 void IdleState::ApplyForce(const QVector2D &force,
-                           std::vector<QPointF> &velocity,
+                           BlobPoints &points,
                            QPointF &blob_center,
-                           const std::vector<QPointF> &control_points,
                            const double blob_radius) {
-    for (size_t i = 0; i < control_points.size(); ++i) {
-        QPointF vector_from_center = control_points[i] - blob_center;
-        const double distance_from_center = QVector2D(vector_from_center).length();
+    for (size_t i = 0; i < points.Size(); ++i) {
+        const double vector_from_center_x = points.position_x[i] - blob_center.x();
+        const double vector_from_center_y = points.position_y[i] - blob_center.y();
+        const double distance_from_center = std::sqrt(vector_from_center_x * vector_from_center_x +
+                                                      vector_from_center_y * vector_from_center_y);
 
         double force_scale = distance_from_center / blob_radius;
         if (force_scale > 1.0) force_scale = 1.0;
 
-        velocity[i] += QPointF(
-            force.x() * force_scale * 0.8,
-            force.y() * force_scale * 0.8
-        );
+        points.velocity_x[i] += static_cast<float>(force.x() * force_scale * 0.8);
+        points.velocity_y[i] += static_cast<float>(force.y() * force_scale * 0.8);
     }
 
     blob_center += QPointF(force.x() * 0.2, force.y() * 0.2);
 }
 
-void IdleState::ApplyHeartbeatEffect(const std::vector<QPointF> &control_points,
-                                     std::vector<QPointF> &velocity,
+void IdleState::ApplyHeartbeatEffect(BlobPoints &points,
                                      const QPointF &blob_center,
                                      const BlobConfig::BlobParameters &params) {
     heartbeat_phase_ += 0.02;
@@ -143,15 +118,21 @@ void IdleState::ApplyHeartbeatEffect(const std::vector<QPointF> &control_points,
         pulse_strength = 0.5 * std::sin(heartbeat_phase_ * 1.2);
     }
 
-    for (size_t i = 0; i < control_points.size(); ++i) {
-        QPointF vector_from_center = control_points[i] - blob_center;
-        QVector2D normalized_vector = QVector2D(vector_from_center).normalized();
+    // pulse power - expansion and contraction, growing with the distance from the center
+    IdleWaveSynthesizer::ApplyPulse(points, blob_center.x(), blob_center.y(),
+                                    pulse_strength * 0.5 / params.blob_radius);
+}
 
-        // pulse power - expansion and contraction
-        const double distance_ratio = QVector2D(vector_from_center).length() / params.blob_radius;
-        const double scaled_pulse = pulse_strength * distance_ratio * 0.5;
+QDataStream &operator<<(QDataStream &stream, const IdleState &state) {
+    stream << state.idle_params_.wave_amplitude << state.idle_params_.wave_frequency << state.idle_params_.wave_phase
+            << state.second_phase_ << state.rotation_phase_ << state.is_initializing_ << state.heartbeat_count_
+            << state.heartbeat_phase_;
+    return stream;
+}
 
-        const QPointF pulse_force = QPointF(normalized_vector.x(), normalized_vector.y()) * scaled_pulse;
-        velocity[i] += pulse_force;
-    }
+QDataStream &operator>>(QDataStream &stream, IdleState &state) {
+    stream >> state.idle_params_.wave_amplitude >> state.idle_params_.wave_frequency >> state.idle_params_.wave_phase
+            >> state.second_phase_ >> state.rotation_phase_ >> state.is_initializing_ >> state.heartbeat_count_
+            >> state.heartbeat_phase_;
+    return stream;
 }
@@ -2,6 +2,9 @@
 #define IDLESTATE_H
 
 #include "blob_state.h"
+#include "idle_wave_synthesizer.h"
+
+class QDataStream;
 
 /**
  * @brief Implements the Idle state behavior for the Blob animation.
@@ -22,13 +25,11 @@ public:
      * @brief Applies the idle animation effects (waves, rotation, centering) or the initial heartbeat effect.
      * Called periodically by the animation loop when this state is active.
      * If is_initializing_ is true, applies the heartbeat effect. Otherwise, applies the standard idle wave and rotation.
-     * @param control_points Reference to the vector of current control point positions (modified).
-     * @param velocity Reference to the vector of current control point velocities (modified).
+     * @param points Reference to the blob point state (velocities are modified, positions are read).
      * @param blob_center Reference to the blob's center position (modified).
      * @param params Blob appearance parameters (read-only).
      */
-    void Apply(std::vector<QPointF> &control_points,
-               std::vector<QPointF> &velocity,
+    void Apply(BlobPoints &points,
                QPointF &blob_center,
                const BlobConfig::BlobParameters &params) override;
 
@@ -37,15 +38,13 @@ public:
      * The force is scaled based on the distance of each control point from the center and applied primarily to velocity.
      * A small portion of the force is also applied directly to the blob's center position.
      * @param force The external force vector to apply.
-     * @param velocity Reference to the vector of current control point velocities (modified).
+     * @param points Reference to the blob point state (velocities are modified, positions are read).
      * @param blob_center Reference to the blob's center position (modified).
-     * @param control_points Reference to the vector of current control point positions (read-only).
      * @param blob_radius The current average radius of the blob (read-only).
      */
     void ApplyForce(const QVector2D &force,
-                    std::vector<QPointF> &velocity,
+                    BlobPoints &points,
                     QPointF &blob_center,
-                    const std::vector<QPointF> &control_points,
                     double blob_radius) override;
 
     /**
@@ -64,16 +63,30 @@ public:
      * @brief Applies a pulsating "heartbeat" effect to the blob.
      * Used during the initial phase after entering the Idle state. The effect runs for a defined number of beats (kRequiredHeartbeats).
      * Modifies control point velocities to create expansion and contraction.
-     * @param control_points Reference to the vector of current control point positions (read-only).
-     * @param velocity Reference to the vector of current control point velocities (modified).
+     * @param points Reference to the blob point state (velocities are modified, positions are read).
      * @param blob_center The current center position of the blob (read-only).
      * @param params Blob appearance parameters (read-only).
      */
-    void ApplyHeartbeatEffect(const std::vector<QPointF> &control_points,
-                              std::vector<QPointF> &velocity,
+    void ApplyHeartbeatEffect(BlobPoints &points,
                               const QPointF &blob_center,
                               const BlobConfig::BlobParameters &params);
 
+    /**
+     * @brief Writes the animation progress (phases, heartbeat counters) to a stream (used by blob recordings).
+     * @param stream The destination stream.
+     * @param state The state to write.
+     * @return The stream.
+     */
+    friend QDataStream &operator<<(QDataStream &stream, const IdleState &state);
+
+    /**
+     * @brief Reads the animation progress written by operator<<.
+     * @param stream The source stream.
+     * @param state The state to restore.
+     * @return The stream.
+     */
+    friend QDataStream &operator>>(QDataStream &stream, IdleState &state);
+
 private:
     /** @brief Parameters specific to the idle animation (wave amplitude, frequency, phase). */
     BlobConfig::IdleParameters idle_params_;
@@ -87,6 +100,8 @@ private:
     int heartbeat_count_ = 0;
     /** @brief Current phase of the heartbeat animation cycle (0 to 2*PI). */
     double heartbeat_phase_ = 0.0;
+    /** @brief Evaluates the wave and heartbeat impulses for all points (keeps its scratch tables between steps). */
+    IdleWaveSynthesizer wave_synthesizer_;
     /** @brief The number of heartbeat cycles to perform during initialization. */
     static constexpr int kRequiredHeartbeats = 1;
 };
@@ -0,0 +1,112 @@
+#include "idle_wave_synthesizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+void IdleWaveSynthesizer::BuildBasis(const BlobPoints &points, const WaveParameters &params) {
+    const size_t count = points.Size();
+    if (distance_.size() != count) {
+        for (std::vector<double> *table: {
+                 &distance_, &unit_x_, &unit_y_, &harmonic_cos_, &harmonic_sin_, &impulse_x_, &impulse_y_
+             }) {
+            table->resize(count);
+        }
+    }
+
+    const float *position_x = points.position_x.data();
+    const float *position_y = points.position_y.data();
+    for (size_t i = 0; i < count; ++i) {
+        const double offset_x = position_x[i] - params.center_x;
+        const double offset_y = position_y[i] - params.center_y;
+        const double distance = std::sqrt(offset_x * offset_x + offset_y * offset_y);
+        const double inverse_distance = distance > 0.0 ? 1.0 / distance : 0.0;
+
+        distance_[i] = distance;
+        unit_x_[i] = offset_x * inverse_distance;
+        unit_y_[i] = offset_y * inverse_distance;
+    }
+
+    const double frequency = params.frequency;
+    if (const int integer_frequency = static_cast<int>(frequency);
+        integer_frequency == frequency && integer_frequency >= 1 && integer_frequency <= kMaxRecurrenceFrequency) {
+        // (cos + i sin)^n = cos(n angle) + i sin(n angle), one complex multiplication per pass
+        std::copy(unit_x_.begin(), unit_x_.end(), harmonic_cos_.begin());
+        std::copy(unit_y_.begin(), unit_y_.end(), harmonic_sin_.begin());
+        for (int power = 1; power < integer_frequency; ++power) {
+            for (size_t i = 0; i < count; ++i) {
+                const double c = harmonic_cos_[i];
+                const double s = harmonic_sin_[i];
+                harmonic_cos_[i] = c * unit_x_[i] - s * unit_y_[i];
+                harmonic_sin_[i] = c * unit_y_[i] + s * unit_x_[i];
+            }
+        }
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            const double angle = frequency * std::atan2(unit_y_[i], unit_x_[i]);
+            harmonic_cos_[i] = std::cos(angle);
+            harmonic_sin_[i] = std::sin(angle);
+        }
+    }
+}
+
+void IdleWaveSynthesizer::ApplyWave(BlobPoints &points, const WaveParameters &params) {
+    const size_t count = points.Size();
+    if (count == 0) {
+        return;
+    }
+
+    BuildBasis(points, params);
+
+    // sin(phase + x) = sin(phase) cos(x) + cos(phase) sin(x): the only transcendental calls of the step
+    const double primary_sin = params.primary_amplitude * std::sin(params.primary_phase);
+    const double primary_cos = params.primary_amplitude * std::cos(params.primary_phase);
+    const double secondary_sin = params.secondary_amplitude * std::sin(params.secondary_phase);
+    const double secondary_cos = params.secondary_amplitude * std::cos(params.secondary_phase);
+    const double inverse_radius = 1.0 / params.blob_radius;
+
+    for (size_t i = 0; i < count; ++i) {
+        const double c1 = harmonic_cos_[i];
+        const double s1 = harmonic_sin_[i];
+        // second harmonic by the double angle formulas
+        const double c2 = c1 * c1 - s1 * s1;
+        const double s2 = 2.0 * c1 * s1;
+        const double wave_strength = primary_sin * c1 + primary_cos * s1 + secondary_sin * c2 + secondary_cos * s2;
+
+        const double distance_ratio = distance_[i] * inverse_radius;
+        const double rotation_factor = params.rotation_strength * distance_ratio;
+        const double force_scale = std::min(0.2 + 0.8 * distance_ratio, 1.0) * 0.15;
+
+        // radial wave plus a tangential rotation (the perpendicular of the unit offset)
+        impulse_x_[i] = (unit_x_[i] * wave_strength - unit_y_[i] * rotation_factor) * force_scale;
+        impulse_y_[i] = (unit_y_[i] * wave_strength + unit_x_[i] * rotation_factor) * force_scale;
+    }
+
+    double total_x = 0.0;
+    double total_y = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        total_x += impulse_x_[i];
+        total_y += impulse_y_[i];
+    }
+    const auto mean_x = static_cast<float>(total_x / static_cast<double>(count));
+    const auto mean_y = static_cast<float>(total_y / static_cast<double>(count));
+
+    float *velocity_x = points.velocity_x.data();
+    float *velocity_y = points.velocity_y.data();
+    for (size_t i = 0; i < count; ++i) {
+        velocity_x[i] = velocity_x[i] + static_cast<float>(impulse_x_[i]) - mean_x;
+        velocity_y[i] = velocity_y[i] + static_cast<float>(impulse_y_[i]) - mean_y;
+    }
+}
+
+void IdleWaveSynthesizer::ApplyPulse(BlobPoints &points, const double center_x, const double center_y,
+                                     const double pulse_scale) {
+    const float *position_x = points.position_x.data();
+    const float *position_y = points.position_y.data();
+    float *velocity_x = points.velocity_x.data();
+    float *velocity_y = points.velocity_y.data();
+
+    for (size_t i = 0, count = points.Size(); i < count; ++i) {
+        velocity_x[i] += static_cast<float>((position_x[i] - center_x) * pulse_scale);
+        velocity_y[i] += static_cast<float>((position_y[i] - center_y) * pulse_scale);
+    }
+}
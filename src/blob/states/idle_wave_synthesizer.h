@@ -0,0 +1,84 @@
+#ifndef IDLE_WAVE_SYNTHESIZER_H
+#define IDLE_WAVE_SYNTHESIZER_H
+
+#include <vector>
+
+#include "../physics/blob_points.h"
+
+/**
+ * @brief Generates the velocity impulses of the Idle state: the two-harmonic peripheral wave with a slow
+ * rotation, and the radial heartbeat pulse.
+ *
+ * The wave of a point depends on the angle of its offset from the center, sin(phase + frequency * angle).
+ * Instead of an atan2() and two sin() calls per point, the synthesizer expands the sum of angles once per
+ * step: the phases are evaluated as scalars, and the per-point basis cos/sin(frequency * angle) is raised
+ * from the unit offset (cos(angle), sin(angle)) by repeated complex multiplication (the second harmonic is
+ * its square). For the integer frequencies used by the application this needs only multiply-adds and one
+ * square root per point; other frequencies fall back to atan2() for the basis only.
+ *
+ * The work runs as a few passes over Structure-of-Arrays scratch tables (no calls, no branches inside),
+ * which the compiler vectorizes. The tables are resized only when the point count changes.
+ */
+class IdleWaveSynthesizer {
+public:
+    /** @brief Highest integer frequency evaluated with the multiplication recurrence (more would lose precision). */
+    static constexpr int kMaxRecurrenceFrequency = 16;
+
+    /**
+     * @brief Per-step constants of the idle wave.
+     */
+    struct WaveParameters {
+        double center_x = 0.0;
+        double center_y = 0.0;
+        /** @brief Amplitude of the main wave, sin(primary_phase + frequency * angle). */
+        double primary_amplitude = 0.0;
+        double primary_phase = 0.0;
+        /** @brief Amplitude of the second harmonic, sin(secondary_phase + 2 * frequency * angle). */
+        double secondary_amplitude = 0.0;
+        double secondary_phase = 0.0;
+        /** @brief Number of wave periods around the outline. */
+        double frequency = 1.0;
+        /** @brief Tangential push at the blob radius (scaled linearly with the distance from the center). */
+        double rotation_strength = 0.0;
+        double blob_radius = 1.0;
+    };
+
+    /**
+     * @brief Adds the idle wave and rotation to the point velocities. The mean impulse is removed
+     * afterwards, so the wave never moves the blob as a whole.
+     * @param points The blob point state (velocities are modified, positions are read).
+     * @param params The wave constants of this step.
+     */
+    void ApplyWave(BlobPoints &points, const WaveParameters &params);
+
+    /**
+     * @brief Adds a radial pulse proportional to each point's distance from the center.
+     * @param points The blob point state (velocities are modified, positions are read).
+     * @param center_x The x coordinate of the blob center.
+     * @param center_y The y coordinate of the blob center.
+     * @param pulse_scale Velocity added per pixel of distance from the center (negative contracts).
+     */
+    static void ApplyPulse(BlobPoints &points, double center_x, double center_y, double pulse_scale);
+
+private:
+    /**
+     * @brief Fills distance_, unit_x_/unit_y_ and the first harmonic basis for the current positions.
+     * @param points The blob point state (positions are read).
+     * @param params The wave constants (center and frequency).
+     */
+    void BuildBasis(const BlobPoints &points, const WaveParameters &params);
+
+    /** @brief Distance of each point from the center. */
+    std::vector<double> distance_;
+    /** @brief Unit offset from the center, i.e. (cos(angle), sin(angle)); zero for a point at the center. */
+    std::vector<double> unit_x_;
+    std::vector<double> unit_y_;
+    /** @brief cos(frequency * angle) and sin(frequency * angle) of each point. */
+    std::vector<double> harmonic_cos_;
+    std::vector<double> harmonic_sin_;
+    /** @brief Velocity impulse of each point before the mean is removed. */
+    std::vector<double> impulse_x_;
+    std::vector<double> impulse_y_;
+};
+
+#endif // IDLE_WAVE_SYNTHESIZER_H
@@ -1,41 +1,41 @@
 #include "moving_state.h"
 
+#include <cmath>
+
 MovingState::MovingState() = default;
 
-void MovingState::Apply(std::vector<QPointF> &control_points,
-                        std::vector<QPointF> &velocity,
+void MovingState::Apply(BlobPoints &points,
                         QPointF &blob_center,
                         const BlobConfig::BlobParameters &params) {
+    const size_t num_of_points = points.Size();
     double avg_velocity_x = 0.0;
     double avg_velocity_y = 0.0;
 
-    for (const auto &vel: velocity) {
-        avg_velocity_x += vel.x();
-        avg_velocity_y += vel.y();
+    for (size_t i = 0; i < num_of_points; ++i) {
+        avg_velocity_x += points.velocity_x[i];
+        avg_velocity_y += points.velocity_y[i];
     }
-    avg_velocity_x /= velocity.size();
-    avg_velocity_y /= velocity.size();
+    avg_velocity_x /= num_of_points;
+    avg_velocity_y /= num_of_points;
 
     if (std::abs(avg_velocity_x) > 0.1 || std::abs(avg_velocity_y) > 0.1) {
-        QVector2D avg_direction(avg_velocity_x, avg_velocity_y);
-        avg_direction.normalize();
-
-        for (size_t i = 0; i < control_points.size(); ++i) {
-            QPointF vector_from_center = control_points[i] - blob_center;
-            const double distance_from_center = QVector2D(vector_from_center).length();
+        for (size_t i = 0; i < num_of_points; ++i) {
+            const double vector_from_center_x = points.position_x[i] - blob_center.x();
+            const double vector_from_center_y = points.position_y[i] - blob_center.y();
+            const double distance_from_center = std::sqrt(vector_from_center_x * vector_from_center_x +
+                                                          vector_from_center_y * vector_from_center_y);
 
             double factor = distance_from_center / params.blob_radius;
             factor = factor * factor * 0.05;
 
-            auto stretch_force = QPointF(avg_velocity_x * factor, avg_velocity_y * factor);
-            velocity[i] += stretch_force * 0.015;
+            points.velocity_x[i] += static_cast<float>(avg_velocity_x * factor * 0.015);
+            points.velocity_y[i] += static_cast<float>(avg_velocity_y * factor * 0.015);
         }
     }
 }
 
-void MovingState::ApplyInertiaForce(std::vector<QPointF> &velocity,
+void MovingState::ApplyInertiaForce(BlobPoints &points,
                                     QPointF &blob_center,
-                                    const std::vector<QPointF> &control_points,
                                     const double blob_radius,
                                     const QVector2D &window_velocity) {
     const double window_speed = window_velocity.length();
@@ -52,16 +52,17 @@ void MovingState::ApplyInertiaForce(std::vector<QPointF> &velocity,
     const double center_y = blob_center.y();
 
     const double inverted_radius = 1.0 / blob_radius;
+    const size_t num_of_points = points.Size();
 
-    for (size_t i = 0; i < control_points.size(); ++i) {
-        double distance_x = control_points[i].x() - center_x;
-        double distance_y = control_points[i].y() - center_y;
+    for (size_t i = 0; i < num_of_points; ++i) {
+        const double distance_x = points.position_x[i] - center_x;
+        const double distance_y = points.position_y[i] - center_y;
 
         const double distance_approx = qAbs(distance_x) + qAbs(distance_y);
         const double force_scale = qMin(distance_approx * inverted_radius * 0.2, 0.3);
 
-        velocity[i].rx() += force_x * force_scale;
-        velocity[i].ry() += force_y * force_scale;
+        points.velocity_x[i] += static_cast<float>(force_x * force_scale);
+        points.velocity_y[i] += static_cast<float>(force_y * force_scale);
     }
 
     const double center_factor = 0.0003 * qMin(1.0, window_speed / 5.0);
@@ -69,43 +70,40 @@ void MovingState::ApplyInertiaForce(std::vector<QPointF> &velocity,
     blob_center.ry() += -window_velocity.y() * center_factor;
 
     if (window_speed > 5.0) {
-        for (size_t i = 0; i < control_points.size(); ++i) {
-            const double distance_x = control_points[i].x() - center_x;
-            const double distance_y = control_points[i].y() - center_y;
+        for (size_t i = 0; i < num_of_points; ++i) {
+            const double distance_x = points.position_x[i] - center_x;
+            const double distance_y = points.position_y[i] - center_y;
 
             const double perp_x = -force_y;
             const double perp_y = force_x;
 
             const double dot_product = distance_x * perp_x + distance_y * perp_y;
-            velocity[i].rx() += dot_product * 0.00002;
-            velocity[i].ry() += dot_product * 0.00002;
+            points.velocity_x[i] += static_cast<float>(dot_product * 0.00002);
+            points.velocity_y[i] += static_cast<float>(dot_product * 0.00002);
         }
     }
 }
 
 void MovingState::ApplyForce(const QVector2D &force,
-                             std::vector<QPointF> &velocity,
+                             BlobPoints &points,
                              QPointF &blob_center,
-                             const std::vector<QPointF> &control_points,
                              const double blob_radius) {
-    const size_t num_of_points = control_points.size();
-    static std::vector<double> distance_cache;
-
-    if (distance_cache.size() != num_of_points) {
-        distance_cache.resize(num_of_points);
-    }
-
-    for (size_t i = 0; i < num_of_points; ++i) {
-        QPointF vector_from_center = control_points[i] - blob_center;
-        distance_cache[i] = QVector2D(vector_from_center).length();
-    }
+    // distances are measured from the center before it is moved by the force
+    const double center_x = blob_center.x();
+    const double center_y = blob_center.y();
 
     const QPointF force_xy(force.x(), force.y());
     const QPointF center_force = force_xy * 0.2;
     blob_center += center_force;
 
-    for (size_t i = 0; i < num_of_points; ++i) {
-        const double force_scale = qMin(distance_cache[i] / blob_radius, 1.0);
-        velocity[i] += force_xy * (force_scale * 0.8);
+    for (size_t i = 0; i < points.Size(); ++i) {
+        const double vector_from_center_x = points.position_x[i] - center_x;
+        const double vector_from_center_y = points.position_y[i] - center_y;
+        const double distance = std::sqrt(vector_from_center_x * vector_from_center_x +
+                                          vector_from_center_y * vector_from_center_y);
+
+        const double force_scale = qMin(distance / blob_radius, 1.0);
+        points.velocity_x[i] += static_cast<float>(force_xy.x() * (force_scale * 0.8));
+        points.velocity_y[i] += static_cast<float>(force_xy.y() * (force_scale * 0.8));
     }
 }
@@ -22,13 +22,11 @@ public:
     /**
      * @brief Applies state-specific logic. Currently empty for ResizingState.
      * The primary logic for this state is handled in HandleResize().
-     * @param control_points Reference to the vector of current control point positions.
-     * @param velocity Reference to the vector of current control point velocities.
+     * @param points Reference to the blob point state (velocities are modified, positions are read).
      * @param blob_center Reference to the blob's center position.
      * @param params Blob appearance parameters (read-only).
      */
-    void Apply(std::vector<QPointF> &control_points,
-               std::vector<QPointF> &velocity,
+    void Apply(BlobPoints &points,
                QPointF &blob_center,
                const BlobConfig::BlobParameters &params) override;
 
@@ -38,15 +36,13 @@ public:
      * A portion of the force is also applied directly to the blob's center position.
      * This is used by HandleResize to apply a force based on the size change.
      * @param force The external force vector to apply.
-     * @param velocity Reference to the vector of current control point velocities (modified).
+     * @param points Reference to the blob point state (velocities are modified, positions are read).
      * @param blob_center Reference to the blob's center position (modified).
-     * @param control_points Reference to the vector of current control point positions (read-only).
      * @param blob_radius The current average radius of the blob (read-only).
      */
     void ApplyForce(const QVector2D &force,
-                    std::vector<QPointF> &velocity,
+                    BlobPoints &points,
                     QPointF &blob_center,
-                    const std::vector<QPointF> &control_points,
                     double blob_radius) override;
 
     /**
@@ -54,16 +50,12 @@ public:
      * Recalculates the blob's center based on the new size, shifts control points
      * and target points accordingly, and applies a force based on the magnitude
      * and direction of the size change.
-     * @param control_points Reference to the vector of current control point positions (modified).
-     * @param target_points Reference to the vector of target control point positions (modified).
-     * @param velocity Reference to the vector of current control point velocities (modified).
+     * @param points Reference to the blob point state (positions, targets and velocities are modified).
      * @param blob_center Reference to the blob's center position (modified).
      * @param old_size The size of the widget before the resize.
      * @param new_size The size of the widget after the resize.
      */
-    void HandleResize(std::vector<QPointF> &control_points,
-                      std::vector<QPointF> &target_points,
-                      std::vector<QPointF> &velocity,
+    void HandleResize(BlobPoints &points,
                       QPointF &blob_center,
                       const QSize &old_size,
                       const QSize &new_size);
@@ -1,13 +1,14 @@
 #include "blob_path.h"
 #include "blob_math.h"
+#include "../physics/blob_points.h"
 
-QPainterPath BlobPath::CreateBlobPath(const std::vector<QPointF> &control_points, const int num_of_points) {
+QPainterPath BlobPath::CreateBlobPath(const BlobPoints &points) {
     QPainterPath path;
 
-    if (control_points.empty()) return path;
+    if (points.Empty()) return path;
 
-
-    path.moveTo(control_points[0]);
+    const int num_of_points = static_cast<int>(points.Size());
+    path.moveTo(points.Position(0));
 
     for (int i = 0; i < num_of_points; ++i) {
         constexpr float tension = 0.25f;
@@ -16,10 +17,10 @@ QPainterPath BlobPath::CreateBlobPath(const std::vector<QPointF> &control_points
         const int next = (i + 1) % num_of_points;
         const int next_next = (i + 2) % num_of_points;
 
-        QPointF p0 = control_points[prev];
-        QPointF p1 = control_points[curr];
-        QPointF p2 = control_points[next];
-        QPointF p3 = control_points[next_next];
+        QPointF p0 = points.Position(prev);
+        QPointF p1 = points.Position(curr);
+        QPointF p2 = points.Position(next);
+        QPointF p3 = points.Position(next_next);
 
         if (!BlobMath::IsValidPoint(p0) || !BlobMath::IsValidPoint(p1) ||
             !BlobMath::IsValidPoint(p2) || !BlobMath::IsValidPoint(p3)) {
@@ -3,6 +3,8 @@
 
 #include <QPainterPath>
 
+struct BlobPoints;
+
 /**
  * @brief Provides a static utility function to create a smooth QPainterPath from blob control points.
  *
@@ -18,13 +20,12 @@ public:
      * to create a smooth, closed curve passing through them. Uses neighboring points
      * to calculate control handles for the Bézier curves, effectively creating a
      * Catmull-Rom spline effect with a specified tension. Includes validation to skip
-     * invalid points.
+     * invalid points. This is the only place where the SoA point arrays are turned into QPointF values.
      *
-     * @param control_points A vector containing the QPointF coordinates of the blob's control points.
-     * @param num_of_points The number of control points in the vector. Should match control_points.size().
-     * @return A QPainterPath representing the smooth outline of the blob. Returns an empty path if control_points are empty.
+     * @param points The blob point state; only the positions are used.
+     * @return A QPainterPath representing the smooth outline of the blob. Returns an empty path if there are no points.
      */
-    static QPainterPath CreateBlobPath(const std::vector<QPointF> &control_points, int num_of_points);
+    static QPainterPath CreateBlobPath(const BlobPoints &points);
 };
 
 #endif // BLOBPATH_H
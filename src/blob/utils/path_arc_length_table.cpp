@@ -0,0 +1,64 @@
+#include "path_arc_length_table.h"
+
+#include <algorithm>
+#include <cmath>
+#include <QLineF>
+#include <QPainterPath>
+
+void PathArcLengthTable::Build(const QPainterPath &path) {
+    vertices_.clear();
+    cumulative_lengths_.clear();
+
+    const int element_count = path.elementCount();
+    if (element_count < 2) {
+        return;
+    }
+
+    vertices_.reserve(element_count);
+    cumulative_lengths_.reserve(element_count);
+
+    double length = 0.0;
+    for (int i = 0; i < element_count; ++i) {
+        const QPointF vertex = path.elementAt(i);
+        if (i > 0) {
+            length += QLineF(vertices_.back(), vertex).length();
+        }
+        vertices_.push_back(vertex);
+        cumulative_lengths_.push_back(length);
+    }
+}
+
+QPointF PathArcLengthTable::PointAtLength(double distance) const {
+    if (Empty()) {
+        return {};
+    }
+
+    const double total_length = TotalLength();
+    if (total_length <= 0.0) {
+        return vertices_.front();
+    }
+
+    // wrapping
+    if (distance < 0.0 || distance > total_length) {
+        distance = std::fmod(distance, total_length);
+        if (distance < 0.0) {
+            distance += total_length;
+        }
+    }
+
+    // first segment whose end reaches the distance
+    const auto segment_end = std::lower_bound(cumulative_lengths_.begin() + 1, cumulative_lengths_.end(), distance);
+    if (segment_end == cumulative_lengths_.end()) {
+        return vertices_.back();
+    }
+
+    const size_t end_index = segment_end - cumulative_lengths_.begin();
+    const double segment_start_length = cumulative_lengths_[end_index - 1];
+    const double segment_length = *segment_end - segment_start_length;
+    if (segment_length <= 0.0) {
+        return vertices_[end_index];
+    }
+
+    const double t = (distance - segment_start_length) / segment_length;
+    return vertices_[end_index - 1] * (1 - t) + vertices_[end_index] * t;
+}
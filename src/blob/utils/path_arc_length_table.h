@@ -0,0 +1,59 @@
+#ifndef PATH_ARC_LENGTH_TABLE_H
+#define PATH_ARC_LENGTH_TABLE_H
+
+#include <QPointF>
+#include <vector>
+
+class QPainterPath;
+
+/**
+ * @brief Arc-length parameterization of a path: the polyline through its elements with a cumulative length table.
+ *
+ * Built once per frame from the blob outline, after which any number of position-at-distance queries cost
+ * a binary search over the table plus a linear interpolation inside the found segment, instead of a walk over
+ * all segments per query. The polyline runs through the path elements in order (for the Bézier outline this
+ * includes the control points), exactly as the marker placement measured the path before.
+ * Build() reuses the table's capacity, so a table kept across frames does not allocate.
+ */
+class PathArcLengthTable {
+public:
+    /**
+     * @brief Rebuilds the table for the given path.
+     * @param path The path to parameterize. Paths with fewer than two elements yield an empty table.
+     */
+    void Build(const QPainterPath &path);
+
+    /**
+     * @brief Gets the total length of the polyline.
+     * @return The length in pixels (0 for an empty table).
+     */
+    [[nodiscard]] double TotalLength() const { return cumulative_lengths_.empty() ? 0.0 : cumulative_lengths_.back(); }
+
+    /**
+     * @brief Checks whether the table is empty.
+     * @return True if the path had fewer than two elements, i.e. there is nothing to place points on.
+     */
+    [[nodiscard]] bool Empty() const { return vertices_.size() < 2; }
+
+    /**
+     * @brief Finds the point at the given distance from the start of the path. O(log n).
+     * @param distance Distance along the path; values outside [0, TotalLength()] wrap around (the path is closed).
+     * @return The interpolated point, or (0, 0) for an empty table.
+     */
+    [[nodiscard]] QPointF PointAtLength(double distance) const;
+
+    /**
+     * @brief Finds the point at the given fraction of the path length.
+     * @param fraction Normalized position (0.0 to 1.0); wraps around like PointAtLength().
+     * @return The interpolated point, or (0, 0) for an empty table.
+     */
+    [[nodiscard]] QPointF PointAtFraction(const double fraction) const { return PointAtLength(fraction * TotalLength()); }
+
+private:
+    /** @brief The path elements, in order. */
+    std::vector<QPointF> vertices_;
+    /** @brief cumulative_lengths_[i] is the polyline length from vertices_[0] to vertices_[i]. */
+    std::vector<double> cumulative_lengths_;
+};
+
+#endif // PATH_ARC_LENGTH_TABLE_H
@@ -2,13 +2,19 @@
 
 #include <QThreadPool>
 
+#include "../../../util/profiling/performance_monitor.h"
+#include "../../../util/profiling/trace_profiler.h"
+
 AttachmentTask::AttachmentTask(const std::function<void()> &taskFunc, QObject *parent): QObject(parent),
     TaskFunc_(taskFunc) {
     setAutoDelete(false);
 }
 
 void AttachmentTask::run() {
-    TaskFunc_();
+    {
+        TRACE_ZONE("AttachmentTask::run");
+        TaskFunc_();
+    }
     emit finished();
 }
 
@@ -27,8 +33,22 @@ void AttachmentQueueManager::AddTask(const std::function<void()> &TaskFunc) {
     ProcessQueue();
 }
 
+int AttachmentQueueManager::GetActiveTaskCount() const {
+    QMutexLocker locker(&mutex_);
+    return active_tasks_.size();
+}
+
+int AttachmentQueueManager::GetPendingTaskCount() const {
+    QMutexLocker locker(&mutex_);
+    return task_queue_.size();
+}
+
 AttachmentQueueManager::AttachmentQueueManager(QObject *parent): QObject(parent) {
     max_active_tasks_ = qMax(1, QThreadPool::globalInstance()->maxThreadCount() / 2);
+
+    PerformanceMonitor *monitor = PerformanceMonitor::GetInstance();
+    monitor->RegisterGauge("Attachment tasks active", this, [this] { return GetActiveTaskCount(); });
+    monitor->RegisterGauge("Attachment tasks pending", this, [this] { return GetPendingTaskCount(); });
 }
 
 void AttachmentQueueManager::ProcessQueue() {
@@ -68,6 +68,18 @@ public:
      */
     void AddTask(const std::function<void()> &TaskFunc);
 
+    /**
+     * @brief Gets the number of tasks currently running on the thread pool. Thread-safe.
+     * @return The number of active tasks.
+     */
+    int GetActiveTaskCount() const;
+
+    /**
+     * @brief Gets the number of tasks waiting for a free slot. Thread-safe.
+     * @return The number of pending tasks.
+     */
+    int GetPendingTaskCount() const;
+
 private:
     /**
      * @brief Private constructor to enforce the singleton pattern.
@@ -89,7 +101,7 @@ private:
     /** @brief List storing tasks currently being executed by the thread pool. Access protected by mutex_. */
     QList<AttachmentTask *> active_tasks_;
     /** @brief Mutex ensuring thread-safe access to task_queue_ and active_tasks_. */
-    QMutex mutex_;
+    mutable QMutex mutex_;
     /** @brief Maximum number of tasks allowed to run concurrently. */
     int max_active_tasks_;
 };
@@ -2,6 +2,9 @@
 
 #include <QAudioOutput>
 
+#include "../../../../util/profiling/performance_monitor.h"
+#include "../../../../util/profiling/trace_profiler.h"
+
 extern "C" {
 #include <libavutil/opt.h>
 }
@@ -38,6 +41,10 @@ AudioDecoder::AudioDecoder(const QByteArray &audio_data, QObject *parent): QThre
         emit error("[AUDIO DECODER] Unable to create I/O context.");
         return;
     }
+
+    PerformanceMonitor::GetInstance()->RegisterGauge("Audio decoder buffered bytes", this, [this] {
+        return static_cast<qint64>(buffered_bytes_.load(std::memory_order_relaxed));
+    });
 }
 
 AudioDecoder::~AudioDecoder() {
@@ -328,6 +335,7 @@ void AudioDecoder::run() {
     double last_emitted_position = 0;
     constexpr int position_update_interval = 250; // ms
 
+    TRACE_THREAD_NAME("Audio Decoder");
     while (!stopped_) {
         QMutexLocker locker(&mutex_);
 
@@ -373,7 +381,10 @@ void AudioDecoder::run() {
         }
 
         if (packet.stream_index == audio_stream_ && audio_codec_context_) {
-            avcodec_send_packet(audio_codec_context_, &packet);
+            {
+                TRACE_ZONE("AudioDecoder::SendPacket");
+                avcodec_send_packet(audio_codec_context_, &packet);
+            }
             while (avcodec_receive_frame(audio_codec_context_, audio_frame_) == 0) {
                 if (audio_frame_->pts != AV_NOPTS_VALUE) {
                     QMutexLocker position_locker(&mutex_);
@@ -398,6 +409,8 @@ void AudioDecoder::run() {
                             msleep(10);
                             mutex_locker.relock();
                         }
+                        buffered_bytes_.store(audio_output_->bufferSize() - audio_output_->bytesFree(),
+                                              std::memory_order_relaxed);
                     }
                 }
             }
@@ -408,6 +421,7 @@ void AudioDecoder::run() {
 }
 
 void AudioDecoder::DecodeAudioFrame(const AVFrame *audio_frame) const {
+    TRACE_ZONE("AudioDecoder::DecodeAudioFrame");
     QByteArray buffer_to_write; {
         QMutexLocker locker(&mutex_);
         if (!audio_device_ || !audio_device_->isOpen() || paused_) {
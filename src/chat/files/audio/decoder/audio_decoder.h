@@ -5,6 +5,7 @@
 #pragma comment(lib, "swresample.lib")
 #endif
 
+#include <atomic>
 #include <QAudioFormat>
 #include <QMutex>
 #include <QObject>
@@ -231,6 +232,9 @@ private:
     /** @brief Qt audio format description (PCM S16LE stereo 44.1kHz). */
     QAudioFormat audio_format_;
 
+    /** @brief Bytes queued in audio_output_ after the last write, shown by the performance overlay. */
+    std::atomic<int> buffered_bytes_{0};
+
     /** @brief Mutex protecting access to shared state variables from different threads. */
     mutable QMutex mutex_;
     /** @brief Condition variable used to pause/resume the decoding thread. */
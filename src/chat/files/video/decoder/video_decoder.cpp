@@ -4,6 +4,7 @@
 #include <QDebug>
 
 #include "../../audio/decoder/audio_decoder.h"
+#include "../../../../util/profiling/trace_profiler.h"
 
 VideoDecoder::VideoDecoder(const QByteArray &video_data, QObject *parent): QThread(parent), video_data_(video_data),
                                                                            paused_(true) {
@@ -311,6 +312,7 @@ void VideoDecoder::run() {
     video_finished_ = false;
     audio_finished_ = !HasAudio();
 
+    TRACE_THREAD_NAME("Video Decoder");
     while (!stopped_) {
         mutex_.lock();
         while (paused_ && !stopped_ && !seeking_) {
@@ -344,9 +346,13 @@ void VideoDecoder::run() {
         }
 
         if (packet.stream_index == video_stream_) {
-            avcodec_send_packet(codec_context_, &packet);
+            int receive_result; {
+                TRACE_ZONE("VideoDecoder::DecodePacket");
+                avcodec_send_packet(codec_context_, &packet);
+                receive_result = avcodec_receive_frame(codec_context_, frame_);
+            }
 
-            if (avcodec_receive_frame(codec_context_, frame_) == 0) {
+            if (receive_result == 0) {
                 double video_pts = -1.0;
                 if (frame_->pts != AV_NOPTS_VALUE) {
                     video_pts = frame_->pts * av_q2d(format_context_->streams[video_stream_]->time_base);
@@ -388,11 +394,13 @@ void VideoDecoder::run() {
                     frame_timer_.restart();
                 }
 
-                QImage frame_image(codec_context_->width, codec_context_->height, QImage::Format_RGB888);
-                uint8_t *dst_data[4] = {frame_image.bits(), nullptr, nullptr, nullptr};
-                const int dst_linesize[4] = {frame_image.bytesPerLine(), 0, 0, 0};
-                sws_scale(sws_context_, frame_->data, frame_->linesize, 0,
-                          codec_context_->height, dst_data, dst_linesize);
+                QImage frame_image(codec_context_->width, codec_context_->height, QImage::Format_RGB888); {
+                    TRACE_ZONE("VideoDecoder::ConvertFrame");
+                    uint8_t *dst_data[4] = {frame_image.bits(), nullptr, nullptr, nullptr};
+                    const int dst_linesize[4] = {frame_image.bytesPerLine(), 0, 0, 0};
+                    sws_scale(sws_context_, frame_->data, frame_->linesize, 0,
+                              codec_context_->height, dst_data, dst_linesize);
+                }
 
                 emit frameReady(frame_image);
                 av_frame_unref(frame_);
@@ -0,0 +1,248 @@
+#include "message_content_parser.h"
+
+namespace {
+    /** @brief Class suffix of the attachment placeholder divs. */
+    const QLatin1String kPlaceholderClassSuffix("-placeholder");
+
+    /**
+     * @brief An entity decoded by the parser, without its terminating ';'.
+     */
+    struct Entity {
+        QLatin1String name;
+        QChar replacement;
+    };
+
+    const Entity kEntities[] = {
+        {QLatin1String("&nbsp"), QLatin1Char(' ')},
+        {QLatin1String("&lt"), QLatin1Char('<')},
+        {QLatin1String("&gt"), QLatin1Char('>')},
+        {QLatin1String("&amp"), QLatin1Char('&')},
+    };
+
+    /**
+     * @brief Replaces an entity at the end of the text, called when its ';' arrives.
+     * @param text The text written so far.
+     * @param decoded_ampersand Position of the last '&' produced by decoding &amp; (it starts no entity);
+     * updated when &amp; is decoded.
+     * @return True if an entity was decoded (the ';' is consumed).
+     */
+    bool DecodeEntity(QString &text, int &decoded_ampersand) {
+        for (const Entity &entity: kEntities) {
+            const int start = text.length() - entity.name.size();
+            if (start >= 0 && start != decoded_ampersand && text.endsWith(entity.name)) {
+                text.truncate(start);
+                text += entity.replacement;
+                if (entity.replacement == '&') {
+                    decoded_ampersand = start;
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Skips whitespace.
+     * @param html The HTML.
+     * @param position The position to advance.
+     * @param end Position to stop at.
+     */
+    void SkipSpaces(const QString &html, int &position, const int end) {
+        while (position < end && html[position].isSpace()) {
+            ++position;
+        }
+    }
+
+    /**
+     * @brief Checks whether a tag is a closing </div>.
+     * @param html The HTML.
+     * @param begin Position of the tag's '<'.
+     * @param end Position of the tag's '>'.
+     * @return True for </div>.
+     */
+    bool IsClosingDiv(const QString &html, const int begin, const int end) {
+        int position = begin + 1;
+        SkipSpaces(html, position, end);
+        if (end - position < 4 || QStringRef(&html, position, 4).compare(QLatin1String("/div"), Qt::CaseInsensitive)) {
+            return false;
+        }
+        position += 4;
+        SkipSpaces(html, position, end);
+        return position == end;
+    }
+
+    /**
+     * @brief Reads the attributes of a tag if it is an attachment placeholder div.
+     * @param html The HTML.
+     * @param begin Position of the tag's '<'.
+     * @param end Position of the tag's '>'.
+     * @param placeholder Receives the attributes (only written for a placeholder).
+     * @return True if the tag opens a placeholder div.
+     */
+    bool ReadPlaceholderTag(const QString &html, const int begin, const int end,
+                            MessageContentParser::Placeholder &placeholder) {
+        int position = begin + 1;
+        if (end - position < 4 || QStringRef(&html, position, 3).compare(QLatin1String("div"), Qt::CaseInsensitive)
+            || !html[position + 3].isSpace()) {
+            return false;
+        }
+        position += 3;
+
+        MessageContentParser::Placeholder attributes;
+        while (position < end) {
+            SkipSpaces(html, position, end);
+            const int name_start = position;
+            while (position < end && !html[position].isSpace() && html[position] != '=' && html[position] != '/') {
+                ++position;
+            }
+            const QStringRef name(&html, name_start, position - name_start);
+            if (name.isEmpty()) {
+                ++position;
+                continue;
+            }
+
+            SkipSpaces(html, position, end);
+            QStringRef value;
+            if (position < end && html[position] == '=') {
+                ++position;
+                SkipSpaces(html, position, end);
+                if (position < end && (html[position] == '\'' || html[position] == '"')) {
+                    const QChar quote = html[position++];
+                    const int value_start = position;
+                    while (position < end && html[position] != quote) {
+                        ++position;
+                    }
+                    value = QStringRef(&html, value_start, position - value_start);
+                    ++position;
+                } else {
+                    const int value_start = position;
+                    while (position < end && !html[position].isSpace()) {
+                        ++position;
+                    }
+                    value = QStringRef(&html, value_start, position - value_start);
+                }
+            }
+
+            if (name == QLatin1String("class")) {
+                for (const QStringRef &class_name: value.split(' ', Qt::SkipEmptyParts)) {
+                    if (class_name.endsWith(kPlaceholderClassSuffix)) {
+                        attributes.type = class_name.left(class_name.size() - kPlaceholderClassSuffix.size())
+                                .toString();
+                        break;
+                    }
+                }
+            } else if (name == QLatin1String("data-attachment-id")) {
+                attributes.attachment_id = value.toString();
+            } else if (name == QLatin1String("data-mime-type")) {
+                attributes.mime_type = value.toString();
+            } else if (name == QLatin1String("data-filename")) {
+                attributes.filename = value.toString();
+            }
+        }
+
+        if (!attributes.IsValid()) {
+            return false;
+        }
+        placeholder = std::move(attributes);
+        return true;
+    }
+}
+
+MessageContentParser::Content MessageContentParser::Parse(const QString &html) {
+    Content content;
+    QString &text = content.text;
+    text.reserve(html.size());
+
+    const int length = html.length();
+    // once a '<' has no '>' after it, no later one has either: the rest is text
+    bool tags_closed = true;
+    bool in_placeholder = false;
+    bool skip_leading_spaces = false;
+    int decoded_ampersand = -1;
+
+    for (int position = 0; position < length; ++position) {
+        const QChar character = html[position];
+
+        if (character == '<' && tags_closed) {
+            const int tag_end = html.indexOf('>', position + 1);
+            if (tag_end < 0) {
+                tags_closed = false;
+            } else {
+                if (in_placeholder) {
+                    if (IsClosingDiv(html, position, tag_end)) {
+                        in_placeholder = false;
+                        text += ' ';
+                        skip_leading_spaces = true;
+                    }
+                } else if (Placeholder placeholder; ReadPlaceholderTag(html, position, tag_end, placeholder)) {
+                    if (!content.placeholder.IsValid()) {
+                        content.placeholder = std::move(placeholder);
+                    }
+                    in_placeholder = true;
+                    while (!text.isEmpty() && text.back().isSpace()) {
+                        text.chop(1);
+                    }
+                }
+                position = tag_end;
+                continue;
+            }
+        }
+
+        if (in_placeholder) continue;
+        if (skip_leading_spaces) {
+            if (character.isSpace()) continue;
+            skip_leading_spaces = false;
+        }
+        if (character == ';' && DecodeEntity(text, decoded_ampersand)) continue;
+
+        text += character;
+    }
+
+    return content;
+}
+
+QString MessageContentParser::FormatForDisplay(const QString &text) {
+    const bool long_text = text.length() > kLongTextLength;
+    const int length = text.length();
+
+    QString result;
+    result.reserve(length);
+
+    // whitespace runs collapse to one separator between words; in long text a "\n\n" inside a run is a paragraph
+    // break, which counts as part of the adjacent words (so it keeps the separators around it)
+    bool pending_separator = false;
+    const auto append_separator = [&result, &pending_separator, long_text] {
+        if (pending_separator && !result.isEmpty()) {
+            const QChar previous = result.back();
+            result += long_text && (previous == '.' || previous == '?' || previous == '!')
+                          ? QLatin1Char('\n')
+                          : QLatin1Char(' ');
+        }
+        pending_separator = false;
+    };
+
+    for (int position = 0; position < length; ++position) {
+        const QChar character = text[position];
+        if (!character.isSpace()) {
+            append_separator();
+            result += character;
+            continue;
+        }
+
+        if (long_text && character == '\n' && position + 1 < length && text[position + 1] == '\n') {
+            append_separator();
+            // a colon stays on the line of the paragraph it introduces
+            if (!result.isEmpty() && result.back() == ':') {
+                result += QLatin1String(" \n");
+            } else {
+                result += QLatin1String("\n\n");
+            }
+            ++position;
+            continue;
+        }
+
+        pending_separator = true;
+    }
+
+    return result;
+}
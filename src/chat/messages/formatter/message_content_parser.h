@@ -0,0 +1,64 @@
+#ifndef MESSAGE_CONTENT_PARSER_H
+#define MESSAGE_CONTENT_PARSER_H
+
+#include <QString>
+
+/**
+ * @brief Extracts the displayable plain text and the attachment placeholder from formatted message HTML.
+ *
+ * Parse() walks the HTML once, without regular expressions or intermediate strings: tags are dropped
+ * (a '<' up to the next '>'), the entities &nbsp; &lt; &gt; and &amp; are decoded as the text is
+ * written, and the attributes of an attachment placeholder (the div generated by MessageFormatter)
+ * are read while its tag is skipped. FormatForDisplay() then normalizes the whitespace of the text
+ * in one more pass.
+ */
+class MessageContentParser {
+public:
+    /**
+     * @brief Attributes of an attachment placeholder div (e.g., <div class='image-placeholder' ...>).
+     */
+    struct Placeholder {
+        QString type; ///< Prefix of the placeholder class ("image", "gif", "audio", "video"), empty if none.
+        QString attachment_id; ///< Value of data-attachment-id.
+        QString mime_type; ///< Value of data-mime-type.
+        QString filename; ///< Value of data-filename.
+
+        /**
+         * @brief Checks whether a placeholder was found.
+         * @return True if the content has a placeholder div.
+         */
+        [[nodiscard]] bool IsValid() const { return !type.isEmpty(); }
+    };
+
+    /**
+     * @brief Result of Parse().
+     */
+    struct Content {
+        QString text; ///< Plain text with decoded entities, not yet normalized for display.
+        Placeholder placeholder; ///< The first attachment placeholder of the content.
+    };
+
+    /**
+     * @brief Parses formatted message HTML in a single pass.
+     * The placeholder div and everything up to its closing </div> are left out of the text; the text before
+     * and after it is joined with a single space.
+     * @param html The message HTML.
+     * @return The plain text and the placeholder attributes.
+     */
+    static Content Parse(const QString &html);
+
+    /**
+     * @brief Normalizes plain text for display in a single pass.
+     * Short text is simplified (trimmed, whitespace runs collapsed to one space). Text longer than
+     * kLongTextLength keeps its paragraph breaks ("\n\n") and gets a line break after every sentence
+     * ending with '.', '?' or '!'.
+     * @param text The plain text from Parse().
+     * @return The text to display.
+     */
+    static QString FormatForDisplay(const QString &text);
+
+    /** @brief Length from which FormatForDisplay() keeps paragraphs and breaks lines after sentences. */
+    static constexpr int kLongTextLength = 300;
+};
+
+#endif // MESSAGE_CONTENT_PARSER_H
@@ -5,8 +5,10 @@
 #include "../../files/attachments/attachment_data_store.h"
 #include "../formatter/message_formatter.h"
 #include "../handler/message_handler.h"
+#include "../../../util/profiling/trace_profiler.h"
 
 void MessageProcessor::ProcessIncomingMessage(const QString &message, const QString &frequency) {
+    TRACE_ZONE("MessageProcessor::ProcessIncomingMessage");
     bool ok = false;
     const QJsonObject message_object = MessageHandler::GetInstance()->ParseMessage(message, &ok);
 
@@ -0,0 +1,186 @@
+#include "frequency_allocator.h"
+
+#include <algorithm>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QTimer>
+#include <QUrlQuery>
+
+#include "../app/wavelength_config.h"
+
+FrequencyAllocator *FrequencyAllocator::GetInstance() {
+    static FrequencyAllocator instance;
+    return &instance;
+}
+
+FrequencyAllocator::FrequencyAllocator(QObject *parent)
+    : QObject(parent),
+      network_manager_(new QNetworkAccessManager(this)),
+      request_timeout_timer_(new QTimer(this)) {
+    request_timeout_timer_->setSingleShot(true);
+    request_timeout_timer_->setInterval(kRequestTimeoutMs);
+    connect(request_timeout_timer_, &QTimer::timeout, this, [this] {
+        qDebug() << "[FREQUENCY ALLOCATOR] Timeout when searching for frequencies - Using fallback.";
+        AnswerWithFallback();
+    });
+
+    connect(WavelengthConfig::GetInstance(), &WavelengthConfig::configChanged, this, [this](const QString &key) {
+        if (key == "relayServerAddress" || key == "relayServerPort" || key == "preferredStartFrequency" ||
+            key == "all") {
+            // candidates from another server or below the new start frequency are useless, but
+            // refetching is left to the next request instead of hitting the network on every settings save
+            ++generation_;
+            candidates_.clear();
+            stale_fallback_.clear();
+        }
+    });
+}
+
+void FrequencyAllocator::RequestFrequency() {
+    DropExpiredCandidates();
+
+    if (!candidates_.isEmpty()) {
+        const QString frequency = candidates_.head().frequency;
+        QTimer::singleShot(0, this, [this, frequency] {
+            emit frequencyReady(frequency, true);
+        });
+        Prefetch();
+        return;
+    }
+
+    request_waiting_ = true;
+    request_timeout_timer_->start();
+    Prefetch();
+}
+
+void FrequencyAllocator::Prefetch() {
+    DropExpiredCandidates();
+
+    if (pending_reply_ || candidates_.size() >= kBatchSize) return;
+
+    // the server returns the lowest free frequency at or above the start, so the batch
+    // is built by asking again just above the highest candidate
+    const QString start_frequency = candidates_.isEmpty()
+                                        ? WavelengthConfig::GetInstance()->GetPreferredStartFrequency()
+                                        : QString::number(candidates_.last().frequency.toDouble() + 0.1, 'f', 1);
+    FetchNext(start_frequency);
+}
+
+void FrequencyAllocator::MarkUsed(const QString &frequency) {
+    for (auto it = candidates_.begin(); it != candidates_.end();) {
+        if (it->frequency == frequency) {
+            it = candidates_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    if (stale_fallback_ == frequency) {
+        stale_fallback_.clear();
+    }
+    Prefetch();
+}
+
+void FrequencyAllocator::Invalidate() {
+    qDebug() << "[FREQUENCY ALLOCATOR] Invalidating" << candidates_.size() << "cached candidates.";
+    ++generation_;
+    candidates_.clear();
+    stale_fallback_.clear();
+
+    if (pending_reply_) {
+        // finishing the aborted reply restarts the prefetch for the new generation
+        pending_reply_->abort();
+    } else {
+        Prefetch();
+    }
+}
+
+void FrequencyAllocator::DropExpiredCandidates() {
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    while (!candidates_.isEmpty() && candidates_.head().fetched_at.msecsTo(now) > kCandidateTtlMs) {
+        stale_fallback_ = candidates_.dequeue().frequency;
+    }
+}
+
+void FrequencyAllocator::FetchNext(const QString &start_frequency) {
+    const WavelengthConfig *config = WavelengthConfig::GetInstance();
+
+    QUrl url(QString("http://%1:%2/api/next-available-frequency")
+        .arg(config->GetRelayServerAddress())
+        .arg(config->GetRelayServerPort()));
+
+    QUrlQuery query;
+    query.addQueryItem("preferredStartFrequency", start_frequency);
+    url.setQuery(query);
+
+    QNetworkReply *reply = network_manager_->get(QNetworkRequest(url));
+    pending_reply_ = reply;
+
+    const int generation = generation_;
+    connect(reply, &QNetworkReply::finished, this, [this, reply, generation] {
+        HandleReply(reply, generation);
+    });
+    QTimer::singleShot(kRequestTimeoutMs, reply, [reply] {
+        if (reply->isRunning()) reply->abort();
+    });
+}
+
+void FrequencyAllocator::HandleReply(QNetworkReply *reply, const int generation) {
+    reply->deleteLater();
+    if (pending_reply_ == reply) {
+        pending_reply_ = nullptr;
+    }
+
+    if (generation != generation_) {
+        Prefetch();
+        return;
+    }
+
+    if (reply->error() != QNetworkReply::NoError) {
+        qDebug() << "[FREQUENCY ALLOCATOR] Error while communicating with the server:" << reply->errorString();
+        AnswerWithFallback();
+        return;
+    }
+
+    const QByteArray response_data = reply->readAll();
+    const QJsonObject response = QJsonDocument::fromJson(response_data).object();
+    if (!response.contains("frequency") || !response["frequency"].isString()) {
+        qDebug() << "[FREQUENCY ALLOCATOR] JSON response parsing error or missing 'frequency' key. Response:"
+                << response_data;
+        AnswerWithFallback();
+        return;
+    }
+
+    const QString frequency = response["frequency"].toString();
+    const bool already_cached = std::any_of(candidates_.cbegin(), candidates_.cend(),
+                                            [&frequency](const Candidate &candidate) {
+                                                return candidate.frequency == frequency;
+                                            });
+    if (!already_cached) {
+        candidates_.enqueue({frequency, QDateTime::currentDateTimeUtc()});
+    }
+
+    if (request_waiting_) {
+        request_waiting_ = false;
+        request_timeout_timer_->stop();
+        emit frequencyReady(frequency, true);
+    }
+
+    // a duplicate means the server has nothing new above our candidates, so the batch stops there
+    if (!already_cached) {
+        Prefetch();
+    }
+}
+
+void FrequencyAllocator::AnswerWithFallback() {
+    if (!request_waiting_) return;
+
+    request_waiting_ = false;
+    request_timeout_timer_->stop();
+
+    const QString frequency = stale_fallback_.isEmpty()
+                                  ? WavelengthConfig::GetInstance()->GetPreferredStartFrequency()
+                                  : stale_fallback_;
+    emit frequencyReady(frequency, false);
+}
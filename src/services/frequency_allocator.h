@@ -0,0 +1,143 @@
+#ifndef FREQUENCY_ALLOCATOR_H
+#define FREQUENCY_ALLOCATOR_H
+
+#include <QDateTime>
+#include <QObject>
+#include <QPointer>
+#include <QQueue>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+class QTimer;
+
+/**
+ * @brief Singleton service handing out free frequencies for new wavelengths without blocking the UI.
+ *
+ * The allocator keeps a small batch of candidate frequencies obtained from the relay server's
+ * /api/next-available-frequency endpoint. The batch is prefetched while the application is idle
+ * (after the first frame and after every consumed or rejected candidate) using a single persistent
+ * QNetworkAccessManager on the GUI thread, so no worker thread or nested event loop is involved.
+ *
+ * Candidates expire after kCandidateTtlMs, because other clients may claim them in the meantime.
+ * RequestFrequency() answers immediately from a fresh candidate. Otherwise it queries the server and,
+ * if that fails or times out, falls back to the newest stale candidate and finally to the preferred
+ * start frequency. A failed registration invalidates the whole batch.
+ */
+class FrequencyAllocator final : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Gets the singleton instance of the FrequencyAllocator.
+     * @return Pointer to the singleton FrequencyAllocator instance.
+     */
+    static FrequencyAllocator *GetInstance();
+
+    /**
+     * @brief Deleted copy constructor to prevent copying.
+     */
+    FrequencyAllocator(const FrequencyAllocator &) = delete;
+
+    /**
+     * @brief Deleted assignment operator to prevent assignment.
+     */
+    FrequencyAllocator &operator=(const FrequencyAllocator &) = delete;
+
+    /**
+     * @brief Requests a free frequency. The answer is always delivered through frequencyReady(),
+     * asynchronously, even when it comes straight from the cache.
+     */
+    void RequestFrequency();
+
+    /**
+     * @brief Starts filling the candidate cache in the background if it is not already full and fresh.
+     */
+    void Prefetch();
+
+    /**
+     * @brief Removes a candidate after it has been successfully registered and refills the cache.
+     * @param frequency The frequency that was registered.
+     */
+    void MarkUsed(const QString &frequency);
+
+    /**
+     * @brief Discards all cached candidates (e.g., after a failed registration) and refetches them.
+     */
+    void Invalidate();
+
+signals:
+    /**
+     * @brief Emitted in response to RequestFrequency().
+     * @param frequency The allocated frequency (e.g., "130.0").
+     * @param verified True if the frequency comes from a fresh server answer, false if it is a fallback.
+     */
+    void frequencyReady(const QString &frequency, bool verified);
+
+private:
+    /**
+     * @brief A cached candidate frequency with the time it was confirmed free by the server.
+     */
+    struct Candidate {
+        QString frequency;
+        QDateTime fetched_at;
+    };
+
+    /**
+     * @brief Private constructor to enforce the singleton pattern.
+     * Invalidates the cache whenever the relay server or preferred start frequency changes.
+     * @param parent Optional parent QObject.
+     */
+    explicit FrequencyAllocator(QObject *parent = nullptr);
+
+    /**
+     * @brief Private default destructor.
+     */
+    ~FrequencyAllocator() override = default;
+
+    /**
+     * @brief Drops candidates older than kCandidateTtlMs, remembering the newest dropped one as a last-resort fallback.
+     */
+    void DropExpiredCandidates();
+
+    /**
+     * @brief Sends a single request for the next free frequency at or above start_frequency.
+     * @param start_frequency Lowest frequency the server should consider.
+     */
+    void FetchNext(const QString &start_frequency);
+
+    /**
+     * @brief Handles a finished request: caches the candidate, answers a waiting request and continues the batch.
+     * @param reply The finished reply.
+     * @param generation Cache generation the request was started in; stale answers are ignored.
+     */
+    void HandleReply(QNetworkReply *reply, int generation);
+
+    /**
+     * @brief Answers a waiting RequestFrequency() call with a fallback frequency.
+     */
+    void AnswerWithFallback();
+
+    /** @brief Number of candidates kept in the cache. */
+    static constexpr int kBatchSize = 3;
+    /** @brief Time after which a candidate is no longer trusted to be free. */
+    static constexpr int kCandidateTtlMs = 30000;
+    /** @brief Time a waiting RequestFrequency() call waits for the server before falling back. */
+    static constexpr int kRequestTimeoutMs = 5000;
+
+    /** @brief Persistent network manager used for all allocation requests. */
+    QNetworkAccessManager *network_manager_;
+    /** @brief Fires when a waiting request has waited too long for the server. */
+    QTimer *request_timeout_timer_;
+    /** @brief Fresh candidates, lowest frequency first. */
+    QQueue<Candidate> candidates_;
+    /** @brief Newest expired candidate, used only if the server cannot be reached. */
+    QString stale_fallback_;
+    /** @brief Reply currently in flight, if any. */
+    QPointer<QNetworkReply> pending_reply_;
+    /** @brief Incremented by Invalidate(); replies from an older generation are discarded. */
+    int generation_ = 0;
+    /** @brief Flag indicating that a RequestFrequency() call is waiting for an answer. */
+    bool request_waiting_ = false;
+};
+
+#endif // FREQUENCY_ALLOCATOR_H
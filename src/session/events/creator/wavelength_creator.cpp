@@ -7,6 +7,7 @@
 #include "../../../auth/authentication_manager.h"
 #include "../../../chat/messages/handler/message_handler.h"
 #include "../../../chat/messages/services/message_processor.h"
+#include "../../../services/frequency_allocator.h"
 #include "../../../storage/wavelength_registry.h"
 
 
@@ -53,6 +54,8 @@ bool WavelengthCreator::CreateWavelength(QString frequency, bool is_password_pro
             registry->RemovePendingRegistration(frequency);
 
             if (success) {
+                FrequencyAllocator::GetInstance()->MarkUsed(frequency);
+
                 WavelengthInfo info = registry->GetWavelengthInfo(frequency);
                 if (info.frequency.isEmpty()) {
                     qWarning() << "[CREATOR] WavelengthInfo not found after successful registration for" << frequency;
@@ -72,6 +75,8 @@ bool WavelengthCreator::CreateWavelength(QString frequency, bool is_password_pro
             } else {
                 const QString error_message = message_object["error"].toString("Unknown error");
                 qDebug() << "[CREATOR] Failed to register wavelength:" << error_message;
+                // the server's view of free frequencies differs from ours, so the prefetched ones are suspect too
+                FrequencyAllocator::GetInstance()->Invalidate();
                 emit connectionError(error_message);
                 keep_alive_timer->stop();
                 socket->close();
@@ -3,6 +3,9 @@
 #include <cstdlib>
 
 DatabaseManager::DatabaseManager(QObject *parent): QObject(parent), is_connected_(false) {
+}
+
+void DatabaseManager::Connect() const {
     try {
         const char *db_user = std::getenv("DB_USER");
         const char *db_name = std::getenv("DB_NAME");
@@ -1,6 +1,7 @@
 #ifndef DATABASE_MANAGER_H
 #define DATABASE_MANAGER_H
 
+#include <mutex>
 #include <QObject>
 #include <pqxx/pqxx>
 
@@ -9,7 +10,8 @@
  *
  * This class establishes and holds the connection to the external PostgreSQL database
  * using the pqxx library. It provides a method to check the connection status.
- * The connection parameters are hardcoded within the constructor.
+ * The connection is opened lazily on first use, so obtaining the instance never blocks startup
+ * on a network round-trip.
  */
 class DatabaseManager final : public QObject {
     Q_OBJECT
@@ -26,22 +28,29 @@ public:
 
     /**
      * @brief Checks if the connection to the database was successfully established.
+     * Opens the connection on the first call.
      * @return True if connected, false otherwise.
      */
     bool IsConnected() const {
+        std::call_once(connect_once_, [this] { Connect(); });
         return is_connected_;
     }
 
 private:
     /**
      * @brief Private constructor to enforce the singleton pattern.
-     * Attempts to establish the connection to the PostgreSQL database using hardcoded credentials.
-     * Sets the is_connected_ flag based on the outcome. Checks for the existence of the
-     * 'active_wavelengths' table upon successful connection.
+     * Does not touch the network; the connection is deferred to the first IsConnected() call.
      * @param parent Optional parent QObject.
      */
     explicit DatabaseManager(QObject *parent = nullptr);
 
+    /**
+     * @brief Attempts to establish the connection to the PostgreSQL database using credentials from the environment.
+     * Sets the is_connected_ flag based on the outcome. Checks for the existence of the
+     * 'active_wavelengths' table upon successful connection.
+     */
+    void Connect() const;
+
     /**
      * @brief Private destructor.
      * The unique_ptr automatically manages the pqxx::connection lifetime.
@@ -59,9 +68,11 @@ private:
     DatabaseManager &operator=(const DatabaseManager &) = delete;
 
     /** @brief Unique pointer managing the pqxx database connection object. */
-    std::unique_ptr<pqxx::connection> connection_;
+    mutable std::unique_ptr<pqxx::connection> connection_;
     /** @brief Flag indicating whether the database connection is currently established. */
-    bool is_connected_;
+    mutable bool is_connected_;
+    /** @brief Guards the one-time lazy connection attempt. */
+    mutable std::once_flag connect_once_;
 };
 
 #endif // DATABASE_MANAGER_H
@@ -1,7 +1,8 @@
 #include "communication_stream.h"
 
-#include <QElapsedTimer>
+#include <qmath.h>
 #include <QKeyEvent>
+#include <QOpenGLFramebufferObject>
 #include <QOpenGLShaderProgram>
 #include <QParallelAnimationGroup>
 #include <QPropertyAnimation>
@@ -11,6 +12,7 @@
 
 #include "../../app/wavelength_config.h"
 #include "../../app/managers/translation_manager.h"
+#include "../../util/frame_scheduler.h"
 
 CommunicationStream::CommunicationStream(QWidget *parent): QOpenGLWidget(parent),
                                                            base_wave_amplitude_(0.05),
@@ -22,6 +24,8 @@ CommunicationStream::CommunicationStream(QWidget *parent): QOpenGLWidget(parent)
                                                            glitch_intensity_(0.0), wave_thickness_(0.008),
                                                            state_(kIdle), current_message_index_(-1),
                                                            initialized_(false), time_offset_(0.0),
+                                                           frame_channel_(PerformanceMonitor::GetInstance()->
+                                                               RegisterChannel("Communication stream frame")),
                                                            shader_program_(nullptr),
                                                            vertex_buffer_(QOpenGLBuffer::VertexBuffer),
                                                            config_(WavelengthConfig::GetInstance()),
@@ -34,7 +38,9 @@ CommunicationStream::CommunicationStream(QWidget *parent): QOpenGLWidget(parent)
     animation_timer_ = new QTimer(this);
     connect(animation_timer_, &QTimer::timeout, this, &CommunicationStream::UpdateAnimation);
     animation_timer_->setTimerType(Qt::PreciseTimer);
-    animation_timer_->start(16); // ~60fps
+    // the stream starts quiet; UpdateFrameRate() switches to ~60fps while something happens
+    FrameScheduler::GetInstance()->RegisterTimer(animation_timer_, kQuietFrameIntervalMs, kQuietIdleFrameIntervalMs);
+    frame_clock_.start();
 
     glitch_timer_ = new QTimer(this);
     connect(glitch_timer_, &QTimer::timeout, this, &CommunicationStream::TriggerRandomGlitch);
@@ -76,10 +82,8 @@ CommunicationStream::CommunicationStream(QWidget *parent): QOpenGLWidget(parent)
     transmitting_user_label_->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
     transmitting_user_label_->hide();
 
+    // a single full-screen quad needs neither depth, stencil nor multisampling
     QSurfaceFormat format;
-    format.setDepthBufferSize(24);
-    format.setStencilBufferSize(8);
-    format.setSamples(4); // MSAA
     format.setSwapInterval(1); // V-Sync
     setFormat(format);
 
@@ -92,59 +96,39 @@ CommunicationStream::~CommunicationStream() {
     vao_.destroy();
     vertex_buffer_.destroy();
     delete shader_program_;
+    delete upscale_program_;
+    delete wave_framebuffer_;
     doneCurrent();
-}
-
-StreamMessage *CommunicationStream::AddMessageWithAttachment(const QString &content, const QString &sender,
-                                                             const StreamMessage::MessageType type,
-                                                             const QString &message_id) {
-    StartReceivingAnimation();
-
-    const auto message = new StreamMessage(content, sender, type, message_id, this);
-    message->hide();
-
-    message->AddAttachment(content);
-
-    messages_.append(message);
-
-    ConnectSignalsForMessage(message);
 
-    if (current_message_index_ == -1) {
-        QTimer::singleShot(1200, this, [this] {
-            if (!messages_.isEmpty()) {
-                ShowMessageAtIndex(messages_.size() - 1);
-            }
-        });
-    } else {
-        UpdateNavigationButtonsForCurrentMessage();
-    }
+    PerformanceMonitor::GetInstance()->ReleaseChannel(frame_channel_);
+}
 
-    return message;
+void CommunicationStream::AddMessageWithAttachment(const QString &content, const QString &sender,
+                                                   const StreamMessage::MessageType type,
+                                                   const QString &message_id) {
+    AppendMessage(MessageRecord{content, sender, type, message_id, true});
 }
 
 void CommunicationStream::SetWaveAmplitude(const qreal amplitude) {
     wave_amplitude_ = amplitude;
-    update();
 }
 
 void CommunicationStream::SetWaveFrequency(const qreal frequency) {
     wave_frequency_ = frequency;
-    update();
 }
 
 void CommunicationStream::SetWaveSpeed(const qreal speed) {
     wave_speed_ = speed;
-    update();
 }
 
 void CommunicationStream::SetGlitchIntensity(const qreal intensity) {
     glitch_intensity_ = intensity;
-    update();
+    // a starting glitch switches the wave to the full frame rate right away
+    UpdateFrameRate();
 }
 
 void CommunicationStream::SetWaveThickness(const qreal thickness) {
     wave_thickness_ = thickness;
-    update();
 }
 
 void CommunicationStream::SetStreamName(const QString &name) const {
@@ -153,48 +137,37 @@ void CommunicationStream::SetStreamName(const QString &name) const {
     stream_name_label_->move((width() - stream_name_label_->width()) / 2, 10);
 }
 
-StreamMessage *CommunicationStream::AddMessage(const QString &content, const QString &sender,
-                                               const StreamMessage::MessageType type, const QString &message_id) {
-    StartReceivingAnimation();
-
-    const auto message = new StreamMessage(content, sender, type, message_id, this);
-    message->hide();
-
-    messages_.append(message);
+void CommunicationStream::AddMessage(const QString &content, const QString &sender,
+                                     const StreamMessage::MessageType type, const QString &message_id) {
+    AppendMessage(MessageRecord{content, sender, type, message_id, false});
+}
 
-    ConnectSignalsForMessage(message);
+bool CommunicationStream::UpdateMessage(const QString &message_id, const QString &content) {
+    if (message_id.isEmpty()) return false;
 
-    if (current_message_index_ == -1) {
-        QTimer::singleShot(1200, this, [this] {
-            if (!messages_.isEmpty()) {
-                ShowMessageAtIndex(messages_.size() - 1);
+    for (MessageRecord &record: messages_) {
+        if (record.message_id == message_id) {
+            record.content = content;
+            if (record.widget) {
+                record.widget->UpdateContent(content);
             }
-        });
-    } else {
-        UpdateNavigationButtonsForCurrentMessage();
+            return true;
+        }
     }
-    return message;
+    return false;
 }
 
 void CommunicationStream::ClearMessages() {
-    if (current_message_index_ >= 0 && current_message_index_ < messages_.size()) {
-        StreamMessage *current_message = messages_[current_message_index_];
-        DisconnectSignalsForMessage(current_message);
-        current_message->hide();
+    while (!messages_.isEmpty()) {
+        RemoveMessageAt(messages_.size() - 1);
     }
 
-    for (StreamMessage *message: qAsConst(messages_)) {
-        DisconnectSignalsForMessage(message);
-        message->deleteLater();
-    }
-
-    messages_.clear();
     current_message_index_ = -1;
     ReturnToIdleAnimation();
     update();
 }
 
-void CommunicationStream::SetTransmittingUser(const QString &user_id) const {
+void CommunicationStream::SetTransmittingUser(const QString &user_id) {
     QString display_text = user_id;
     if (user_id.length() > 15 && user_id.startsWith("client_")) {
         display_text = "CLIENT " + user_id.split('_').last();
@@ -210,15 +183,25 @@ void CommunicationStream::SetTransmittingUser(const QString &user_id) const {
     transmitting_user_label_->adjustSize();
     transmitting_user_label_->move(width() - transmitting_user_label_->width() - 10, 10);
     transmitting_user_label_->show();
+
+    is_transmitting_ = true;
+    UpdateFrameRate();
 }
 
-void CommunicationStream::ClearTransmittingUser() const {
+void CommunicationStream::ClearTransmittingUser() {
     transmitting_user_label_->hide();
     transmitting_user_label_->setText("");
+
+    is_transmitting_ = false;
+    UpdateFrameRate();
 }
 
 void CommunicationStream::SetAudioAmplitude(const qreal amplitude) {
     target_wave_amplitude_ = base_wave_amplitude_ + qBound(0.0, amplitude, 1.0) * amplitude_scale_;
+    if (amplitude > kAudioActivityThreshold) {
+        FrameScheduler::GetInstance()->NotifyActivity();
+    }
+    UpdateFrameRate();
 }
 
 void CommunicationStream::initializeGL() {
@@ -314,6 +297,34 @@ void CommunicationStream::initializeGL() {
     shader_program_->addShaderFromSourceCode(QOpenGLShader::Fragment, fragment_shader_source);
     shader_program_->link();
 
+    // stretches the reduced-resolution wave over the widget; linear filtering smooths the upscaling
+    const auto upscale_vertex_shader_source = R"(
+            #version 330 core
+            layout (location = 0) in vec2 aPos;
+            out vec2 uv;
+
+            void main() {
+                uv = aPos * 0.5 + 0.5;
+                gl_Position = vec4(aPos, 0.0, 1.0);
+            }
+        )";
+
+    const auto upscale_fragment_shader_source = R"(
+            #version 330 core
+            in vec2 uv;
+            out vec4 FragColor;
+            uniform sampler2D waveTexture;
+
+            void main() {
+                FragColor = texture(waveTexture, uv);
+            }
+        )";
+
+    upscale_program_ = new QOpenGLShaderProgram();
+    upscale_program_->addShaderFromSourceCode(QOpenGLShader::Vertex, upscale_vertex_shader_source);
+    upscale_program_->addShaderFromSourceCode(QOpenGLShader::Fragment, upscale_fragment_shader_source);
+    upscale_program_->link();
+
     vao_.create();
     vao_.bind();
 
@@ -338,7 +349,9 @@ void CommunicationStream::initializeGL() {
 }
 
 void CommunicationStream::resizeGL(const int w, const int h) {
-    glViewport(0, 0, w, h);
+    Q_UNUSED(w);
+    Q_UNUSED(h);
+    // the viewports are set per pass in paintGL(), the wave framebuffer follows the size there
     stream_name_label_->move((width() - stream_name_label_->width()) / 2, 10);
 
     transmitting_user_label_->move(width() - transmitting_user_label_->width() - 10, 10);
@@ -348,12 +361,32 @@ void CommunicationStream::resizeGL(const int w, const int h) {
 
 void CommunicationStream::paintGL() {
     if (!initialized_) return;
+    PerformanceMonitor::GetInstance()->RecordFrame(frame_channel_);
+
+    const qreal device_pixel_ratio = devicePixelRatioF();
+    const QSize device_size(qRound(width() * device_pixel_ratio), qRound(height() * device_pixel_ratio));
+    const QSize wave_size(qMax(1, device_size.width() / kWaveDownsample),
+                          qMax(1, device_size.height() / kWaveDownsample));
+
+    if (!wave_framebuffer_ || wave_framebuffer_->size() != wave_size) {
+        delete wave_framebuffer_;
+        wave_framebuffer_ = new QOpenGLFramebufferObject(wave_size);
+        glBindTexture(GL_TEXTURE_2D, wave_framebuffer_->texture());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
 
+    // wave pass, at a fraction of the pixels
+    wave_framebuffer_->bind();
+    glViewport(0, 0, wave_size.width(), wave_size.height());
     glClear(GL_COLOR_BUFFER_BIT);
 
     shader_program_->bind();
 
-    shader_program_->setUniformValue("resolution", QVector2D(width(), height()));
+    shader_program_->setUniformValue("resolution", QVector2D(wave_size.width(), wave_size.height()));
     shader_program_->setUniformValue("time", static_cast<float>(time_offset_));
     shader_program_->setUniformValue("amplitude", static_cast<float>(wave_amplitude_));
     shader_program_->setUniformValue("frequency", static_cast<float>(wave_frequency_));
@@ -365,9 +398,22 @@ void CommunicationStream::paintGL() {
 
     vao_.bind();
     glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-    vao_.release();
 
     shader_program_->release();
+
+    // upscale pass into the widget's framebuffer
+    glBindFramebuffer(GL_FRAMEBUFFER, defaultFramebufferObject());
+    glViewport(0, 0, device_size.width(), device_size.height());
+
+    upscale_program_->bind();
+    upscale_program_->setUniformValue("waveTexture", 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, wave_framebuffer_->texture());
+    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    vao_.release();
+
+    upscale_program_->release();
 }
 
 void CommunicationStream::keyPressEvent(QKeyEvent *event) {
@@ -376,8 +422,9 @@ void CommunicationStream::keyPressEvent(QKeyEvent *event) {
         return;
     }
 
-    if (current_message_index_ >= 0 && current_message_index_ < messages_.size()) {
-        const StreamMessage *current_message = messages_[current_message_index_];
+    if (current_message_index_ >= 0 && current_message_index_ < messages_.size()
+        && messages_[current_message_index_].widget) {
+        const StreamMessage *current_message = messages_[current_message_index_].widget;
 
         switch (event->key()) {
             case Qt::Key_Right:
@@ -407,18 +454,23 @@ void CommunicationStream::keyPressEvent(QKeyEvent *event) {
 }
 
 void CommunicationStream::UpdateAnimation() {
-    time_offset_ += 0.02 * wave_speed_;
-    wave_amplitude_ = wave_amplitude_ * 0.9 + target_wave_amplitude_ * 0.1;
+    // the steps are scaled to the elapsed time, so the wave moves at the same speed at every frame rate
+    const qreal frames = static_cast<qreal>(qMin(frame_clock_.restart(), kMaxFrameStepMs)) / kActiveFrameIntervalMs;
+
+    time_offset_ += 0.02 * wave_speed_ * frames;
+    wave_amplitude_ += (target_wave_amplitude_ - wave_amplitude_) * (1.0 - qPow(0.9, frames));
     if (glitch_intensity_ > 0.0) {
-        glitch_intensity_ = qMax(0.0, glitch_intensity_ - 0.005);
+        glitch_intensity_ = qMax(0.0, glitch_intensity_ - 0.005 * frames);
     }
 
-    const QRegion update_region(0, 0, width(), height());
-    update(update_region);
+    UpdateFrameRate();
+    // the only repaint request of the wave: the property setters just store their values for the next frame
+    update();
 }
 
 void CommunicationStream::TriggerRandomGlitch() {
-    if (state_ == kIdle) {
+    // decorative glitches would wake the full frame rate while nobody uses the application
+    if (state_ == kIdle && !FrameScheduler::GetInstance()->IsIdle()) {
         const float intensity = 0.3 + QRandomGenerator::global()->bounded(40) / 100.0;
 
         StartGlitchAnimation(intensity);
@@ -429,6 +481,7 @@ void CommunicationStream::TriggerRandomGlitch() {
 
 void CommunicationStream::StartReceivingAnimation() {
     state_ = kReceiving;
+    UpdateFrameRate();
 
     const auto amplitude_animation = new QPropertyAnimation(this, "waveAmplitude");
     amplitude_animation->setDuration(1000);
@@ -473,6 +526,7 @@ void CommunicationStream::StartReceivingAnimation() {
     connect(group, &QParallelAnimationGroup::finished, this, [this] {
         target_wave_amplitude_ = 0.15;
         state_ = kDisplaying;
+        UpdateFrameRate();
     });
 }
 
@@ -480,6 +534,7 @@ void CommunicationStream::ReturnToIdleAnimation() {
     state_ = kIdle;
 
     target_wave_amplitude_ = base_wave_amplitude_;
+    UpdateFrameRate();
 
     const auto amplitude_animation = new QPropertyAnimation(this, "waveAmplitude");
     amplitude_animation->setDuration(1500);
@@ -542,22 +597,20 @@ void CommunicationStream::ShowMessageAtIndex(int index) {
         }
     }
 
-    if (index == current_message_index_ && messages_[index]->isVisible()) {
-        messages_[index]->setFocus();
+    if (index == current_message_index_ && messages_[index].widget && messages_[index].widget->isVisible()) {
+        messages_[index].widget->setFocus();
         return;
     }
 
     if (current_message_index_ >= 0 && current_message_index_ < messages_.size()) {
         if (current_message_index_ != index) {
-            StreamMessage *previous_message_ptr = nullptr;
-            previous_message_ptr = messages_[current_message_index_];
-            DisconnectSignalsForMessage(previous_message_ptr);
-            previous_message_ptr->hide();
+            // only the displayed message keeps a widget
+            ReleaseMessage(current_message_index_);
         }
     }
 
     current_message_index_ = index;
-    StreamMessage *message = messages_[current_message_index_];
+    StreamMessage *message = RealizeMessage(current_message_index_);
 
     ConnectSignalsForMessage(message);
 
@@ -601,9 +654,10 @@ void CommunicationStream::OnMessageRead() {
         return;
     }
 
-    is_clearing_all_messages_ = true;
+    StreamMessage *message = messages_[current_message_index_].widget;
+    if (!message) return;
 
-    StreamMessage *message = messages_[current_message_index_];
+    is_clearing_all_messages_ = true;
     message->MarkAsRead();
 }
 
@@ -615,28 +669,19 @@ void CommunicationStream::HandleMessageHidden() {
         return;
     }
 
-    const int hidden_message_index = messages_.indexOf(hidden_message);
+    const int hidden_message_index = IndexOfWidget(hidden_message);
 
     DisconnectSignalsForMessage(hidden_message);
 
     if (is_clearing_all_messages_) {
-        if (hidden_message_index != -1) {
-            messages_.removeAt(hidden_message_index);
-        } else {
+        if (hidden_message_index == -1) {
             qWarning() <<
                     "[COMMUNICATION STREAM]::handleMessageHidden [ClearAll] - Hidden message not found in the list!";
+            RecycleWidget(hidden_message);
         }
-        hidden_message->deleteLater();
 
-        QList<StreamMessage *> messages_to_remove = messages_;
-        messages_.clear();
-
-        for (StreamMessage *message: messages_to_remove) {
-            if (message) {
-                DisconnectSignalsForMessage(message);
-                message->hide();
-                message->deleteLater();
-            }
+        while (!messages_.isEmpty()) {
+            RemoveMessageAt(messages_.size() - 1);
         }
 
         current_message_index_ = -1;
@@ -648,14 +693,15 @@ void CommunicationStream::HandleMessageHidden() {
 
     if (!hidden_message->GetMessageId().isEmpty()) {
         if (hidden_message_index != -1) {
-            messages_.removeAt(hidden_message_index);
+            RemoveMessageAt(hidden_message_index);
             if (hidden_message_index < current_message_index_) {
                 current_message_index_--;
             } else if (hidden_message_index == current_message_index_) {
                 current_message_index_ = -1;
             }
+        } else {
+            RecycleWidget(hidden_message);
         }
-        hidden_message->deleteLater();
 
         if (messages_.isEmpty()) {
             current_message_index_ = -1;
@@ -666,12 +712,12 @@ void CommunicationStream::HandleMessageHidden() {
     } else {
         if (hidden_message_index == current_message_index_) {
             if (hidden_message_index != -1) {
-                messages_.removeAt(hidden_message_index);
+                RemoveMessageAt(hidden_message_index);
             } else {
                 qWarning() <<
                         "[COMMUNICATION STREAM]::handleMessageHidden [SingleClose] - Closed message not found in list!";
+                RecycleWidget(hidden_message);
             }
-            hidden_message->deleteLater();
 
             if (messages_.isEmpty()) {
                 current_message_index_ = -1;
@@ -716,6 +762,84 @@ UserVisuals CommunicationStream::GenerateUserVisuals(const QString &user_id) {
     return visuals;
 }
 
+void CommunicationStream::AppendMessage(const MessageRecord &record) {
+    StartReceivingAnimation();
+
+    messages_.append(record);
+
+    if (current_message_index_ == -1) {
+        QTimer::singleShot(1200, this, [this] {
+            if (!messages_.isEmpty()) {
+                ShowMessageAtIndex(messages_.size() - 1);
+            }
+        });
+    } else {
+        UpdateNavigationButtonsForCurrentMessage();
+    }
+}
+
+StreamMessage *CommunicationStream::RealizeMessage(const int index) {
+    MessageRecord &record = messages_[index];
+    if (record.widget) {
+        return record.widget;
+    }
+
+    StreamMessage *message;
+    if (!message_pool_.isEmpty()) {
+        message = message_pool_.takeLast();
+        message->Rebind(record.content, record.sender, record.type, record.message_id);
+    } else {
+        message = new StreamMessage(record.content, record.sender, record.type, record.message_id, this);
+    }
+    message->hide();
+
+    if (record.has_attachment) {
+        message->AddAttachment(record.content);
+    }
+
+    record.widget = message;
+    return message;
+}
+
+void CommunicationStream::ReleaseMessage(const int index) {
+    if (StreamMessage *message = messages_[index].widget) {
+        messages_[index].widget = nullptr;
+        RecycleWidget(message);
+    }
+}
+
+void CommunicationStream::RecycleWidget(StreamMessage *message) {
+    DisconnectSignalsForMessage(message);
+    message->hide();
+    // off-screen messages must not keep their media (attachment viewers, decoders) alive
+    message->ReleaseContent();
+
+    if (message_pool_.size() < kMaxPooledMessages) {
+        message_pool_.append(message);
+    } else {
+        message->deleteLater();
+    }
+}
+
+void CommunicationStream::RemoveMessageAt(const int index) {
+    ReleaseMessage(index);
+    const QString message_id = messages_[index].message_id;
+    messages_.removeAt(index);
+
+    if (!message_id.isEmpty()) {
+        emit messageRemoved(message_id);
+    }
+}
+
+int CommunicationStream::IndexOfWidget(const StreamMessage *message) const {
+    for (int i = 0; i < messages_.size(); ++i) {
+        if (messages_[i].widget == message) {
+            return i;
+        }
+    }
+    return -1;
+}
+
 void CommunicationStream::ConnectSignalsForMessage(const StreamMessage *message) {
     if (!message) return;
     connect(message->GetNextButton(), &QPushButton::clicked, this, &CommunicationStream::ShowNextMessage,
@@ -733,36 +857,53 @@ void CommunicationStream::DisconnectSignalsForMessage(const StreamMessage *messa
 }
 
 void CommunicationStream::UpdateNavigationButtonsForCurrentMessage() {
-    if (current_message_index_ >= 0 && current_message_index_ < messages_.size()) {
-        const StreamMessage *current_message = messages_[current_message_index_];
+    if (current_message_index_ >= 0 && current_message_index_ < messages_.size()
+        && messages_[current_message_index_].widget) {
+        const StreamMessage *current_message = messages_[current_message_index_].widget;
         const bool has_previous = current_message_index_ > 0;
         const bool has_next = current_message_index_ < messages_.size() - 1;
         current_message->ShowNavigationButtons(has_previous, has_next);
     }
 }
 
-void CommunicationStream::OptimizeForMessageTransition() const {
-    static QElapsedTimer transition_timer;
-    static bool in_transition = false;
+void CommunicationStream::OptimizeForMessageTransition() {
+    if (in_message_transition_) {
+        return;
+    }
 
-    if (!in_transition) {
-        in_transition = true;
-        transition_timer.start();
+    in_message_transition_ = true;
+    ApplyFrameIntervals();
 
-        if (animation_timer_->interval() == 16) {
-            animation_timer_->setInterval(33);
-        }
+    QTimer::singleShot(500, this, [this] {
+        in_message_transition_ = false;
+        ApplyFrameIntervals();
+    });
+}
 
-        QTimer::singleShot(500, this, [this] {
-            animation_timer_->setInterval(16);
-            in_transition = false;
-        });
+void CommunicationStream::UpdateFrameRate() {
+    const bool active = state_ == kReceiving || is_transmitting_ || glitch_intensity_ > kGlitchActivityThreshold
+                        || qAbs(target_wave_amplitude_ - wave_amplitude_) > kAmplitudeSettleThreshold;
+    if (active != is_wave_active_) {
+        is_wave_active_ = active;
+        ApplyFrameIntervals();
+    }
+}
+
+void CommunicationStream::ApplyFrameIntervals() const {
+    FrameScheduler *scheduler = FrameScheduler::GetInstance();
+    if (!is_wave_active_) {
+        scheduler->SetIntervals(animation_timer_, kQuietFrameIntervalMs, kQuietIdleFrameIntervalMs);
+    } else if (in_message_transition_) {
+        scheduler->SetIntervals(animation_timer_, kTransitionFrameIntervalMs, kIdleFrameIntervalMs);
+    } else {
+        scheduler->SetIntervals(animation_timer_, kActiveFrameIntervalMs, kIdleFrameIntervalMs);
     }
 }
 
 void CommunicationStream::UpdateMessagePosition() {
-    if (current_message_index_ >= 0 && current_message_index_ < messages_.size()) {
-        StreamMessage *message = messages_[current_message_index_];
+    if (current_message_index_ >= 0 && current_message_index_ < messages_.size()
+        && messages_[current_message_index_].widget) {
+        StreamMessage *message = messages_[current_message_index_].widget;
         message->move((width() - message->width()) / 2, (height() - message->height()) / 2);
     }
 }
@@ -1,6 +1,7 @@
 #ifndef COMMUNICATION_STREAM_H
 #define COMMUNICATION_STREAM_H
 
+#include <QElapsedTimer>
 #include <QOpenGLBuffer>
 #include <QOpenGLWidget>
 #include <QOpenGLFunctions>
@@ -8,7 +9,9 @@
 
 #include "stream_message.h"
 #include "../labels/user_info_label.h"
+#include "../../util/profiling/performance_monitor.h"
 
+class QOpenGLFramebufferObject;
 class QOpenGLShaderProgram;
 class WavelengthConfig;
 
@@ -26,10 +29,16 @@ struct UserVisuals {
  *
  * This widget renders a dynamic sine wave with cyberpunk aesthetics, including grid lines,
  * glitch effects, and scanlines, using OpenGL shaders. It can display incoming messages
- * (StreamMessage) overlaid on the animation. The wave's amplitude reacts to audio input
+ * (StreamMessage) overlaid on the animation. The message history is kept as lightweight MessageRecord entries;
+ * only the displayed message has a StreamMessage widget, taken from a small pool of recycled widgets. The wave's amplitude reacts to audio input
  * (via SetAudioAmplitude) and changes appearance based on its state (Idle, Receiving, Displaying).
  * It also shows the name of the stream and the ID of the currently transmitting user.
  * Message navigation (next/previous) and closing are handled via keyboard input (arrows, Enter).
+ *
+ * The wave is rendered on demand: only the frame timer requests repaints, the animatable properties just store
+ * their values for the next frame. The timer runs at the full frame rate only while a message is being received,
+ * a user is transmitting, a glitch plays or the amplitude is still settling, and at a low rate otherwise.
+ * The wave shader runs on a framebuffer with 1/kWaveDownsample of the resolution, which is upscaled in a second pass.
  */
 class CommunicationStream final : public QOpenGLWidget, protected QOpenGLFunctions {
     Q_OBJECT
@@ -72,44 +81,43 @@ public:
     /**
      * @brief Adds a new message with attachment content to the stream.
      * Initiates the receiving animation. The message is displayed after the animation completes
-     * if no other message is currently shown. Connects signals for navigation and closing.
+     * if no other message is currently shown.
      * @param content The main content or description of the attachment.
      * @param sender The sender's identifier.
      * @param type The type of the message (e.g., Attachment).
      * @param message_id Optional unique ID, used for progress messages.
-     * @return Pointer to the created StreamMessage widget.
      */
-    StreamMessage *AddMessageWithAttachment(const QString &content, const QString &sender,
-                                            StreamMessage::MessageType type, const QString &message_id = QString());
+    void AddMessageWithAttachment(const QString &content, const QString &sender,
+                                  StreamMessage::MessageType type, const QString &message_id = QString());
 
     /** @brief Gets the current wave amplitude. */
     qreal GetWaveAmplitude() const { return wave_amplitude_; }
 
-    /** @brief Sets the current wave amplitude and triggers an update. */
+    /** @brief Sets the current wave amplitude, rendered with the next frame. */
     void SetWaveAmplitude(qreal amplitude);
 
     /** @brief Gets the current wave frequency. */
     qreal GetWaveFrequency() const { return wave_frequency_; }
 
-    /** @brief Sets the current wave frequency and triggers an update. */
+    /** @brief Sets the current wave frequency, rendered with the next frame. */
     void SetWaveFrequency(qreal frequency);
 
     /** @brief Gets the current wave speed. */
     qreal GetWaveSpeed() const { return wave_speed_; }
 
-    /** @brief Sets the current wave speed and triggers an update. */
+    /** @brief Sets the current wave speed, rendered with the next frame. */
     void SetWaveSpeed(qreal speed);
 
     /** @brief Gets the current glitch effect intensity. */
     qreal GetGlitchIntensity() const { return glitch_intensity_; }
 
-    /** @brief Sets the current glitch effect intensity and triggers an update. */
+    /** @brief Sets the current glitch effect intensity, rendered with the next frame. */
     void SetGlitchIntensity(qreal intensity);
 
     /** @brief Gets the current wave thickness. */
     qreal GetWaveThickness() const { return wave_thickness_; }
 
-    /** @brief Sets the current wave thickness and triggers an update. */
+    /** @brief Sets the current wave thickness, rendered with the next frame. */
     void SetWaveThickness(qreal thickness);
 
     /**
@@ -121,22 +129,37 @@ public:
     /**
      * @brief Adds a new standard message to the stream.
      * Initiates the receiving animation. The message is displayed after the animation completes
-     * if no other message is currently shown. Connects signals for navigation and closing.
+     * if no other message is currently shown.
      * @param content The message content.
      * @param sender The sender's identifier.
      * @param type The type of the message (e.g., Text, System).
      * @param message_id Optional unique ID, used for progress messages.
-     * @return Pointer to the created StreamMessage widget.
      */
-    StreamMessage *AddMessage(const QString &content, const QString &sender, StreamMessage::MessageType type,
-                              const QString &message_id = QString());
+    void AddMessage(const QString &content, const QString &sender, StreamMessage::MessageType type,
+                    const QString &message_id = QString());
+
+    /**
+     * @brief Replaces the content of a message with the given ID (progress updates).
+     * The widget is updated as well if the message is currently realized.
+     * @param message_id The unique ID the message was added with.
+     * @param content The new message content.
+     * @return True if a message with this ID exists.
+     */
+    bool UpdateMessage(const QString &message_id, const QString &content);
 
     /**
      * @brief Removes all messages currently managed by the stream.
-     * Hides and schedules deletion for all message widgets and resets the stream state.
+     * Recycles the realized message widgets and resets the stream state.
      */
     void ClearMessages();
 
+signals:
+    /**
+     * @brief Emitted when a message with a non-empty ID is removed from the stream.
+     * @param message_id The ID of the removed message.
+     */
+    void messageRemoved(const QString &message_id);
+
 public slots:
     /**
      * @brief Displays the identifier of the user currently transmitting audio.
@@ -144,12 +167,12 @@ public slots:
      * in a label at the top right.
      * @param user_id The identifier of the transmitting user.
      */
-    void SetTransmittingUser(const QString &user_id) const;
+    void SetTransmittingUser(const QString &user_id);
 
     /**
      * @brief Hides the transmitting user label.
      */
-    void ClearTransmittingUser() const;
+    void ClearTransmittingUser();
 
     /**
      * @brief Sets the target wave amplitude based on incoming audio level.
@@ -160,7 +183,7 @@ public slots:
 
 protected:
     /**
-     * @brief Initializes OpenGL resources (shaders, VAO, VBO). Called once before the first paintGL.
+     * @brief Initializes OpenGL resources (wave and upscale shaders, VAO, VBO). Called once before the first paintGL.
      */
     void initializeGL() override;
 
@@ -172,7 +195,8 @@ protected:
     void resizeGL(int w, int h) override;
 
     /**
-     * @brief Renders the OpenGL scene (animated wave, grid, glitches). Called on update().
+     * @brief Renders the OpenGL scene (animated wave, grid, glitches) into the reduced-resolution framebuffer
+     * and upscales it into the widget. Called on update().
      */
     void paintGL() override;
 
@@ -185,8 +209,8 @@ protected:
 private slots:
     /**
      * @brief Slot called by animation_timer_ to update animation time and parameters.
-     * Advances time offset, interpolates wave amplitude towards target, fades glitch intensity,
-     * and schedules a repaint.
+     * Advances time offset, interpolates wave amplitude towards target, fades glitch intensity
+     * (all scaled to the time since the last frame), updates the frame rate and schedules a repaint.
      */
     void UpdateAnimation();
 
@@ -216,8 +240,8 @@ private slots:
 
     /**
      * @brief Displays the message at the specified index in the messages_ list.
-     * Hides the previously displayed message, updates the current index, positions and shows
-     * the new message, connects signals, updates navigation buttons, and sets focus.
+     * Releases the widget of the previously displayed message, updates the current index, realizes,
+     * positions and shows the new message, connects signals, updates navigation buttons, and sets focus.
      * @param index The index of the message to display.
      */
     void ShowMessageAtIndex(int index);
@@ -240,7 +264,7 @@ private slots:
 
     /**
      * @brief Slot triggered when a StreamMessage widget finishes its hiding animation (or is hidden).
-     * Handles logic for removing the message from the list, deleting the widget,
+     * Handles logic for removing the message from the list, recycling the widget,
      * showing the next message, or returning to the Idle state. Differentiates between
      * closing a single message, removing a progress message, and clearing all messages.
      */
@@ -254,6 +278,41 @@ private slots:
     void UpdateStreamColor(const QString &key);
 
 private:
+    /** @brief Wave frame interval while the stream is active and the application is too (~60fps). */
+    static constexpr int kActiveFrameIntervalMs = 16;
+    /** @brief Wave frame interval while the stream is active and the application is idle (20fps). */
+    static constexpr int kIdleFrameIntervalMs = 50;
+    /** @brief Wave frame interval while nothing happens in the stream (20fps). */
+    static constexpr int kQuietFrameIntervalMs = 50;
+    /** @brief Wave frame interval while nothing happens in the stream and the application is idle (10fps). */
+    static constexpr int kQuietIdleFrameIntervalMs = 100;
+    /** @brief Longest time step applied by one frame, so a stalled timer does not make the wave jump. */
+    static constexpr qint64 kMaxFrameStepMs = 100;
+    /** @brief Glitch intensity above which the stream counts as active. */
+    static constexpr qreal kGlitchActivityThreshold = 0.01;
+    /** @brief Distance of the wave amplitude from its target above which the stream counts as active. */
+    static constexpr qreal kAmplitudeSettleThreshold = 0.005;
+    /** @brief Downsampling factor of the wave framebuffer relative to the widget, in each direction. */
+    static constexpr int kWaveDownsample = 2;
+    /** @brief Reduced wave frame interval while a message transition runs. */
+    static constexpr int kTransitionFrameIntervalMs = 33;
+    /** @brief Audio amplitude above which the stream counts as active and wakes the frame scheduler. */
+    static constexpr qreal kAudioActivityThreshold = 0.02;
+    /** @brief Number of released message widgets kept for reuse; further ones are deleted. */
+    static constexpr int kMaxPooledMessages = 2;
+
+    /**
+     * @brief A message of the stream history. Only the displayed message has a widget.
+     */
+    struct MessageRecord {
+        QString content; ///< Original message content (may contain HTML).
+        QString sender; ///< Sender identifier.
+        StreamMessage::MessageType type; ///< Message type (Received, Transmitted, System).
+        QString message_id; ///< Unique identifier (progress messages), empty otherwise.
+        bool has_attachment; ///< Whether the content holds an attachment placeholder.
+        StreamMessage *widget = nullptr; ///< The realized widget, or null.
+    };
+
     /**
      * @brief Generates visual properties (currently color) based on a user ID hash.
      * @param user_id The user identifier string.
@@ -261,6 +320,47 @@ private:
      */
     static UserVisuals GenerateUserVisuals(const QString &user_id);
 
+    /**
+     * @brief Appends a message record and schedules its display (or updates the navigation buttons).
+     * Initiates the receiving animation.
+     * @param record The message to append.
+     */
+    void AppendMessage(const MessageRecord &record);
+
+    /**
+     * @brief Gives the message at the specified index a widget, reusing a pooled one if available.
+     * @param index The index in messages_.
+     * @return The (hidden, if newly realized) message widget.
+     */
+    StreamMessage *RealizeMessage(int index);
+
+    /**
+     * @brief Detaches the widget from the message at the specified index and recycles it.
+     * @param index The index in messages_.
+     */
+    void ReleaseMessage(int index);
+
+    /**
+     * @brief Hides a message widget, frees its content (including attachment media) and puts it into the pool,
+     * or deletes it if the pool is full.
+     * @param message The widget to recycle.
+     */
+    void RecycleWidget(StreamMessage *message);
+
+    /**
+     * @brief Releases the message at the specified index and removes it from messages_.
+     * Emits messageRemoved() for messages with an ID.
+     * @param index The index in messages_.
+     */
+    void RemoveMessageAt(int index);
+
+    /**
+     * @brief Finds the message displayed by a widget.
+     * @param message The message widget.
+     * @return The index in messages_, or -1.
+     */
+    [[nodiscard]] int IndexOfWidget(const StreamMessage *message) const;
+
     /**
      * @brief Connects the necessary signals (navigation, read, hidden) from a StreamMessage widget to this CommunicationStream.
      * Uses Qt::UniqueConnection to prevent duplicate connections.
@@ -283,7 +383,18 @@ private:
     /**
      * @brief Temporarily reduces the background animation frame rate during message transitions for smoother UI performance.
      */
-    void OptimizeForMessageTransition() const;
+    void OptimizeForMessageTransition();
+
+    /**
+     * @brief Switches the wave between the full and the low frame rate when the stream becomes active or quiet.
+     * Active means receiving, transmitting, glitching or an amplitude still settling. Cheap when nothing changed.
+     */
+    void UpdateFrameRate();
+
+    /**
+     * @brief Gives animation_timer_ the intervals of the current activity and message transition state.
+     */
+    void ApplyFrameIntervals() const;
 
     /**
      * @brief Updates the position of the currently displayed message to keep it centered.
@@ -302,9 +413,13 @@ private:
 
     // state and message management
     StreamState state_; ///< Current visual state of the stream.
-    QList<StreamMessage *> messages_; ///< List of message widgets managed by the stream.
+    QList<MessageRecord> messages_; ///< History of the messages managed by the stream.
+    QList<StreamMessage *> message_pool_; ///< Released message widgets waiting for reuse (hidden, without content).
     int current_message_index_; ///< Index of the currently displayed message in messages_.
     bool is_clearing_all_messages_ = false; ///< Flag indicating if a full clear operation is in progress.
+    bool is_transmitting_ = false; ///< Whether a user is transmitting audio (the transmitting label is shown).
+    bool is_wave_active_ = false; ///< Whether the wave runs at the full frame rate.
+    bool in_message_transition_ = false; ///< Whether the reduced frame rate of a message transition applies.
 
     // ui elements
     QLabel *stream_name_label_; ///< Label displaying the stream name.
@@ -313,13 +428,17 @@ private:
     // internal state
     bool initialized_; ///< Flag indicating if OpenGL resources are initialized.
     qreal time_offset_; ///< Time variable for shader animations.
+    QElapsedTimer frame_clock_; ///< Time since the last animation frame.
 
     // timers
     QTimer *animation_timer_; ///< Timer driving the main wave animation updates.
     QTimer *glitch_timer_; ///< Timer triggering random glitches in Idle state.
+    PerformanceMonitor::Channel *frame_channel_; ///< Performance overlay channel receiving frame-to-frame times.
 
     // OpenGL resources
     QOpenGLShaderProgram *shader_program_; ///< Compiled shader program for rendering the wave.
+    QOpenGLShaderProgram *upscale_program_ = nullptr; ///< Shader program stretching the wave framebuffer.
+    QOpenGLFramebufferObject *wave_framebuffer_ = nullptr; ///< Reduced-resolution render target of the wave.
     QOpenGLVertexArrayObject vao_; ///< Vertex Array Object.
     QOpenGLBuffer vertex_buffer_; ///< Vertex Buffer Object holding the fullscreen quad vertices.
 
@@ -1,188 +1,278 @@
 #include "electronic_shutdown_effect.h"
 
 #include <qmath.h>
+#include <QDebug>
+#include <QOpenGLShaderProgram>
 #include <QPainter>
 #include <QRandomGenerator>
+#include <QVector2D>
+
+namespace {
+    /** @brief Progress above which nothing is drawn any more. */
+    constexpr qreal kFinishedProgress = 0.99;
+    /** @brief Progress at which the collapsed image becomes the fading line. */
+    constexpr qreal kLinePhaseStart = 0.7;
+
+    const auto kVertexShader = R"(
+        #version 330 core
+        void main() {
+            vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+            gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+        }
+    )";
+
+    // works in logical pixels with y pointing down, like the QPainter effect it replaces; every random value is
+    // a hash of (seed + glitch step, index, salt), so a frame only depends on the uniforms
+    const auto kFragmentShader = R"(
+        #version 330 core
+        out vec4 FragColor;
+        uniform sampler2D sourceTexture;
+        uniform vec2 viewportSize;
+        uniform vec2 sourceSize;
+        uniform float progress;
+        uniform float seed;
+
+        const float kScanlineAlpha = 40.0 / 255.0;
+        const vec4 kFlickerColor = vec4(vec3(80.0 / 255.0), 1.0) * (30.0 / 255.0);
+        const vec3 kGlowColor = vec3(100.0, 200.0, 255.0) / 255.0;
+
+        float Hash(float glitchStep, float index, float salt) {
+            return fract(sin(dot(vec3(glitchStep + seed, index, salt), vec3(12.9898, 78.233, 37.719))) * 43758.5453);
+        }
 
-ElectronicShutdownEffect::ElectronicShutdownEffect(QObject *parent): QGraphicsEffect(parent), progress_(0.0),
-                                                                     last_progress_(-1.0),
-                                                                     result_cache_(5) {
-}
-
-void ElectronicShutdownEffect::SetProgress(const qreal progress) {
-    progress_ = qBound(0.0, progress, 1.0);
-    update();
-}
-
-void ElectronicShutdownEffect::draw(QPainter *painter) {
-    if (progress_ < 0.01) {
-        drawSource(painter);
-        return;
-    }
-
-    if (progress_ > 0.99) {
-        return;
-    }
-
-    QPoint offset;
-    QPixmap pixmap = sourcePixmap(Qt::LogicalCoordinates, &offset, NoPad);
-    if (pixmap.isNull())
-        return;
-
-    QString cache_key = QString("%1").arg(progress_, 0, 'f', 2);
-    QPixmap *cached_result = result_cache_.object(cache_key);
-
-    if (cached_result == nullptr || qAbs(last_progress_ - progress_) > 0.05) {
-        QPixmap result(pixmap.size());
-        result.fill(Qt::transparent);
-
-        QPainter result_painter(&result);
-        try {
-            result_painter.setRenderHint(QPainter::Antialiasing);
-            result_painter.setRenderHint(QPainter::SmoothPixmapTransform);
+        // an integer in [low, high]
+        float RandomRange(float glitchStep, float index, float salt, float low, float high) {
+            return min(high, floor(low + Hash(glitchStep, index, salt) * (high - low + 1.0)));
+        }
 
-            int w = pixmap.width();
-            int h = pixmap.height();
-            int center_y = h / 2;
+        vec4 Source(vec2 position) {
+            if (any(lessThan(position, vec2(0.0))) || any(greaterThanEqual(position, sourceSize))) {
+                return vec4(0.0);
+            }
+            return texture(sourceTexture, position / sourceSize);
+        }
 
-            // phase 1 (0.0-0.7): Narrowing the image to a horizontal line
-            if (progress_ < 0.7) {
-                qreal normalized_progress = progress_ / 0.7; // 0.0-1.0 for first phase
+        vec4 LinePixel(vec2 position, float brightness) {
+            return vec4(min(Source(position).rgb + brightness, vec3(1.0)), 1.0);
+        }
 
-                int new_height = h * (1.0 - qPow(normalized_progress, 1.8));
-                new_height = qMax(2, new_height);
+        void main() {
+            vec2 position = vec2(gl_FragCoord.x, viewportSize.y - gl_FragCoord.y) * sourceSize / viewportSize;
+            if (progress < 0.01) {
+                FragColor = Source(position);
+                return;
+            }
 
-                if (normalized_progress > 0.4) {
-                    int glitch_amplitude = qMax(1, static_cast<int>(normalized_progress * 15));
-                    int glitch_offset = QRandomGenerator::global()->bounded(-glitch_amplitude, glitch_amplitude + 1);
-                    new_height = qMax(2, new_height + glitch_offset);
+            vec2 pixel = floor(position);
+            float width = sourceSize.x;
+            float height = sourceSize.y;
+            float centerY = floor(height * 0.5);
+            // the glitches change every 5% of the progress
+            float glitchStep = floor(progress * 20.0);
+
+            if (progress < 0.7) {
+                float phase = progress / 0.7;
+                float lineHeight = max(2.0, floor(height * (1.0 - pow(phase, 1.8))));
+                if (phase > 0.4) {
+                    float amplitude = max(1.0, floor(phase * 15.0));
+                    lineHeight = max(2.0, lineHeight + RandomRange(glitchStep, 0.0, 1.0, -amplitude, amplitude));
+                }
+                float top = centerY - floor(lineHeight * 0.5);
+                float bottom = top + lineHeight - 1.0;
+                if (pixel.y < top || pixel.y > bottom) {
+                    FragColor = vec4(0.0);
+                    return;
                 }
 
-                QRect source_rect = pixmap.rect();
-                QRect target_rect(0, center_y - new_height / 2, w, new_height);
-
-                result_painter.drawPixmap(target_rect, pixmap, source_rect);
-
-                if (normalized_progress > 0.3) {
-                    int num_of_glitches = qMin(5, qMax(1, static_cast<int>(normalized_progress * 15)));
-
-                    for (int i = 0; i < num_of_glitches; ++i) {
-                        int min_y = target_rect.top();
-                        int max_y = target_rect.bottom();
-
-                        if (min_y >= max_y) continue;
-
-                        int glitch_y = QRandomGenerator::global()->bounded(min_y, max_y + 1);
-
-                        int min_width = qMax(1, w / 4);
-                        int max_width = qMax(min_width + 1, w);
-                        int glitch_width = QRandomGenerator::global()->bounded(min_width, max_width);
-
-                        int glitch_offset = QRandomGenerator::global()->bounded(-10, 11);
-
-                        int glitch_height = qMax(
-                            1, QRandomGenerator::global()->bounded(1, qMax(2, new_height / 20) + 1));
-
-                        if (glitch_y + glitch_height <= max_y) {
-                            QRect glitch_source(0, glitch_y, glitch_width, glitch_height);
-
-                            result_painter.drawPixmap(
-                                QPoint(glitch_offset, glitch_y),
-                                result,
-                                glitch_source
-                            );
+                vec2 sourcePosition = vec2(position.x, (position.y - top) * height / lineHeight);
+                if (phase > 0.3) {
+                    int glitches = clamp(int(phase * 15.0), 1, 5);
+                    for (int i = 0; i < glitches; ++i) {
+                        float index = float(i);
+                        float glitchY = RandomRange(glitchStep, index, 2.0, top, bottom);
+                        float glitchHeight = RandomRange(glitchStep, index, 3.0, 1.0, max(2.0, floor(lineHeight / 20.0)));
+                        float glitchWidth = RandomRange(glitchStep, index, 4.0, max(1.0, floor(width / 4.0)),
+                                                        max(1.0, width - 1.0));
+                        float glitchOffset = RandomRange(glitchStep, index, 5.0, -10.0, 10.0);
+                        if (glitchY + glitchHeight <= bottom && pixel.y >= glitchY
+                            && pixel.y < glitchY + glitchHeight && pixel.x >= glitchOffset
+                            && pixel.x < glitchOffset + glitchWidth) {
+                            sourcePosition.x = position.x - glitchOffset;
                         }
                     }
                 }
 
-                // crt lines (scanlines)
-                QPen scanline_pen(QColor(0, 0, 0, 40));
-                result_painter.setPen(scanline_pen);
-                for (int y = target_rect.top(); y < target_rect.bottom(); y += 2) {
-                    result_painter.drawLine(0, y, w, y);
+                vec4 color = Source(sourcePosition);
+                if (mod(pixel.y - top, 2.0) < 1.0 && pixel.y < bottom) {
+                    color = color * (1.0 - kScanlineAlpha) + vec4(0.0, 0.0, 0.0, kScanlineAlpha);
                 }
+                if (phase > 0.5 && Hash(glitchStep, 0.0, 6.0) < (phase - 0.5) * 0.2) {
+                    color = min(color + kFlickerColor, vec4(1.0));
+                }
+                FragColor = color;
+                return;
+            }
 
-                // pulse blink (twitch)
-                if (normalized_progress > 0.5) {
-                    qreal flicker_chance = (normalized_progress - 0.5) * 2.0; // 0.0 - 1.0
-                    if (QRandomGenerator::global()->generateDouble() < flicker_chance * 0.1) {
-                        result_painter.setCompositionMode(QPainter::CompositionMode_Plus);
-                        result_painter.fillRect(target_rect, QColor(80, 80, 80, 30));
-                    }
+            float phase = (progress - 0.7) / 0.3;
+            float lineWidth = max(1.0, floor(width * (1.0 - phase)));
+            float lineLeft = floor((width - lineWidth) * 0.5);
+            float lineTop = centerY - 1.0;
+            float brightness = (40.0 + min(215.0, floor(phase * 120.0))) / 255.0;
+
+            vec2 lineEnd = vec2(lineLeft + lineWidth - 1.0, centerY);
+            vec2 outside = max(max(vec2(lineLeft, lineTop) - pixel, pixel - lineEnd), vec2(0.0));
+            float ring = max(outside.x, outside.y);
+            vec4 color = vec4(0.0);
+            if (ring == 0.0) {
+                color = LinePixel(position, brightness);
+            } else if (ring <= 5.0) {
+                float glowAlpha = floor(100.0 * (1.0 - phase)) / 255.0 / exp2(ring - 1.0);
+                color = vec4(kGlowColor * glowAlpha, glowAlpha);
+            }
+
+            if (phase > 0.7 && Hash(glitchStep, 0.0, 7.0) < 0.3) {
+                float shiftedLeft = max(0.0, lineLeft + RandomRange(glitchStep, 0.0, 8.0, -15.0, 15.0));
+                if (shiftedLeft + lineWidth <= width && pixel.x >= shiftedLeft && pixel.x < shiftedLeft + lineWidth
+                    && pixel.y >= lineTop && pixel.y <= centerY) {
+                    color = LinePixel(vec2(position.x - shiftedLeft + lineLeft, position.y), brightness);
                 }
-            } else {
-                // phase 2 (0.7-1.0): Fading of the horizontal line
-                qreal normalized_progress = (progress_ - 0.7) / 0.3;
+            }
+            FragColor = color;
+        }
+    )";
+}
 
-                int line_width = qMax(1, static_cast<int>(w * (1.0 - normalized_progress)));
-                int line_offset = (w - line_width) / 2;
+ElectronicShutdownEffect::ElectronicShutdownEffect(QWidget *parent): QOpenGLWidget(parent) {
+    QSurfaceFormat format;
+    format.setVersion(3, 3);
+    format.setProfile(QSurfaceFormat::CoreProfile);
+    setFormat(format);
 
-                int brightness = 40 + qMin(215, static_cast<int>(normalized_progress * 120));
+    // the overlay is translucent around the collapsing image
+    setAttribute(Qt::WA_AlwaysStackOnTop);
+    hide();
+}
 
-                QRect target_rect(line_offset, center_y - 1, line_width, 2);
+ElectronicShutdownEffect::~ElectronicShutdownEffect() {
+    makeCurrent();
+    if (texture_ != 0) {
+        glDeleteTextures(1, &texture_);
+    }
+    vao_.destroy();
+    program_.reset();
+    doneCurrent();
+}
 
-                if (line_width > 0 && target_rect.width() > 0 && target_rect.height() > 0) {
-                    QImage line_image(line_width, 2, QImage::Format_ARGB32_Premultiplied);
-                    line_image.fill(Qt::transparent);
+void ElectronicShutdownEffect::Start(QWidget *source) {
+    snapshot_ = source->grab().toImage().convertToFormat(QImage::Format_RGBA8888_Premultiplied);
+    snapshot_size_ = source->size();
+    seed_ = static_cast<float>(QRandomGenerator::global()->bounded(1000));
+    progress_ = 0.0;
 
-                    QPainter line_painter(&line_image);
-                    line_painter.setCompositionMode(QPainter::CompositionMode_Source);
+    setGeometry(source->geometry());
+    show();
+    raise();
+    update();
+}
 
-                    if (line_offset >= 0 && center_y >= 1 &&
-                        line_offset + line_width <= pixmap.width() &&
-                        center_y + 1 <= pixmap.height()) {
-                        line_painter.drawPixmap(0, 0, pixmap, line_offset, center_y - 1, line_width, 2);
+void ElectronicShutdownEffect::SetProgress(const qreal progress) {
+    progress_ = qBound(0.0, progress, 1.0);
+    update();
+}
 
-                        for (int x = 0; x < line_width; x++) {
-                            for (int y = 0; y < 2; y++) {
-                                auto pixelColor = QColor(line_image.pixel(x, y));
-                                int r = qMin(255, pixelColor.red() + brightness);
-                                int g = qMin(255, pixelColor.green() + brightness);
-                                int b = qMin(255, pixelColor.blue() + brightness);
-                                line_image.setPixel(x, y, qRgba(r, g, b, 255));
-                            }
-                        }
+void ElectronicShutdownEffect::initializeGL() {
+    if (!initializeOpenGLFunctions()) {
+        qWarning() << "[SHUTDOWN EFFECT] OpenGL 3.3 unavailable, using the QPainter fallback.";
+        return;
+    }
 
-                        result_painter.drawImage(target_rect, line_image);
+    program_ = std::make_unique<QOpenGLShaderProgram>();
+    program_->addShaderFromSourceCode(QOpenGLShader::Vertex, kVertexShader);
+    program_->addShaderFromSourceCode(QOpenGLShader::Fragment, kFragmentShader);
+    if (!program_->link()) {
+        qWarning() << "[SHUTDOWN EFFECT] Shader Log:" << program_->log();
+        program_.reset();
+        return;
+    }
 
-                        QColor glow_color(100, 200, 255, qMax(0, 100 - static_cast<int>(normalized_progress * 100)));
-                        for (int i = 1; i <= 5; i++) {
-                            QRect glowRect = target_rect.adjusted(-i, -i, i, i);
-                            result_painter.setPen(QPen(glow_color, 1));
-                            result_painter.drawRect(glowRect);
-                            glow_color.setAlpha(glow_color.alpha() / 2);
-                        }
+    vao_.create();
+    gl_ready_ = true;
+}
 
-                        line_painter.end();
-
-                        if (normalized_progress > 0.7) {
-                            if (!QRandomGenerator::global()->generateDouble() < 0.2) {
-                                if (QRandomGenerator::global()->generateDouble() < 0.3) {
-                                    int shift = QRandomGenerator::global()->bounded(-15, 16);
-                                    target_rect.moveLeft(qMax(0, target_rect.left() + shift));
-                                    if (target_rect.right() < w) {
-                                        result_painter.drawImage(target_rect, line_image);
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
+void ElectronicShutdownEffect::paintGL() {
+    if (!gl_ready_) {
+        PaintFallback();
+        return;
+    }
 
-            result_painter.end();
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    if (progress_ > kFinishedProgress) {
+        return;
+    }
 
-            cached_result = new QPixmap(result);
-            result_cache_.insert(cache_key, cached_result);
-            last_progress_ = progress_;
-        } catch (...) {
-            result_painter.end();
-            throw;
-        }
+    if (!snapshot_.isNull()) {
+        UploadSnapshot();
     }
+    if (texture_ == 0) {
+        return;
+    }
+
+    const qreal device_pixel_ratio = devicePixelRatioF();
+    program_->bind();
+    program_->setUniformValue("sourceTexture", 0);
+    program_->setUniformValue("viewportSize", QVector2D(width() * device_pixel_ratio,
+                                                        height() * device_pixel_ratio));
+    program_->setUniformValue("sourceSize", QVector2D(snapshot_size_.width(), snapshot_size_.height()));
+    program_->setUniformValue("progress", static_cast<float>(progress_));
+    program_->setUniformValue("seed", seed_);
+
+    vao_.bind();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture_);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    vao_.release();
+
+    program_->release();
+}
 
-    painter->save();
-    painter->translate(offset);
-    painter->drawPixmap(0, 0, *cached_result);
-    painter->restore();
+void ElectronicShutdownEffect::UploadSnapshot() {
+    if (texture_ == 0) {
+        glGenTextures(1, &texture_);
+    }
+    glBindTexture(GL_TEXTURE_2D, texture_);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, snapshot_.width(), snapshot_.height(), 0, GL_RGBA,
+                 GL_UNSIGNED_BYTE, snapshot_.constBits());
+    // the collapse scales the image vertically
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    snapshot_ = QImage();
+}
+
+void ElectronicShutdownEffect::PaintFallback() {
+    QPainter painter(this);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.fillRect(rect(), Qt::transparent);
+    if (snapshot_.isNull() || progress_ > kFinishedProgress) {
+        return;
+    }
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+
+    const int w = width();
+    const int center_y = height() / 2;
+    if (progress_ < kLinePhaseStart) {
+        const qreal phase = progress_ / kLinePhaseStart;
+        const int line_height = qMax(2, static_cast<int>(height() * (1.0 - qPow(phase, 1.8))));
+        painter.drawImage(QRect(0, center_y - line_height / 2, w, line_height), snapshot_);
+    } else {
+        const qreal phase = (progress_ - kLinePhaseStart) / (1.0 - kLinePhaseStart);
+        const int line_width = qMax(1, static_cast<int>(w * (1.0 - phase)));
+        painter.fillRect(QRect((w - line_width) / 2, center_y - 1, line_width, 2), QColor(200, 240, 255));
+    }
 }
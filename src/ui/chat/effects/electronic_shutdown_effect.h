@@ -1,11 +1,16 @@
 #ifndef ELECTRONIC_SHUTDOWN_EFFECT_H
 #define ELECTRONIC_SHUTDOWN_EFFECT_H
 
-#include <QCache>
-#include <QGraphicsEffect>
+#include <memory>
+#include <QImage>
+#include <QOpenGLFunctions_3_3_Core>
+#include <QOpenGLVertexArrayObject>
+#include <QOpenGLWidget>
+
+class QOpenGLShaderProgram;
 
 /**
- * @brief A QGraphicsEffect that simulates an old CRT monitor or electronic device shutting down.
+ * @brief An overlay simulating an old CRT monitor or electronic device shutting down, rendered on the GPU.
  *
  * This effect animates in two phases based on the `progress` property (0.0 to 1.0):
  * 1. (0.0-0.7): The source image vertically collapses into a thin horizontal line,
@@ -13,24 +18,38 @@
  * 2. (0.7-1.0): The horizontal line fades out, shrinks horizontally, increases in brightness,
  *    and exhibits flickering and glow effects before disappearing completely.
  *
- * The effect uses caching (QCache) to store intermediate results for performance.
+ * Start() grabs the source widget once and the snapshot is uploaded as a texture; every frame is then a single
+ * full-screen triangle whose fragment shader computes both phases. The glitches come from a hash of the seed
+ * picked in Start(), the row and the progress (re-rolled every 5% of it), so no random numbers or intermediate
+ * pixmaps are generated on the CPU. The overlay covers the source widget as its sibling, so the source can stop
+ * painting while the animation runs. Without OpenGL 3.3, a plain QPainter collapse is drawn instead.
  */
-class ElectronicShutdownEffect final : public QGraphicsEffect {
+class ElectronicShutdownEffect final : public QOpenGLWidget, protected QOpenGLFunctions_3_3_Core {
     Q_OBJECT
     /** @brief Property controlling the progress of the shutdown animation (0.0 to 1.0). Animatable. */
     Q_PROPERTY(qreal progress READ GetProgress WRITE SetProgress)
 
 public:
     /**
-     * @brief Constructs an ElectronicShutdownEffect.
-     * Initializes the effect, sets up the result cache, and seeds the random generator.
-     * @param parent Optional parent QObject.
+     * @brief Constructs an ElectronicShutdownEffect. The overlay stays hidden until Start().
+     * @param parent The parent of the widgets the effect is started on.
+     */
+    explicit ElectronicShutdownEffect(QWidget *parent = nullptr);
+
+    /**
+     * @brief Destructor. Releases the GL resources.
      */
-    explicit ElectronicShutdownEffect(QObject *parent = nullptr);
+    ~ElectronicShutdownEffect() override;
+
+    /**
+     * @brief Captures the source widget, resets the progress to 0.0 and shows the overlay on top of the source.
+     * @param source The widget that shuts down; it must be a child of this overlay's parent.
+     */
+    void Start(QWidget *source);
 
     /**
      * @brief Sets the progress of the shutdown animation.
-     * Clamps the value between 0.0 and 1.0 and triggers an update of the effect.
+     * Clamps the value between 0.0 and 1.0 and schedules a repaint.
      * @param progress The desired progress level (0.0 to 1.0).
      */
     void SetProgress(qreal progress);
@@ -45,24 +64,42 @@ public:
 
 protected:
     /**
-     * @brief Overridden draw method that renders the shutdown effect.
-     * Retrieves the source pixmap. If progress is minimal, draws the source directly.
-     * If progress is maximal, draws nothing. Otherwise, checks a cache for a pre-rendered
-     * result at a similar progress level. If not cached or progress changed significantly,
-     * it generates the effect based on the current phase (collapsing or fading line),
-     * applying glitches, scanlines, brightness changes, and glow effects. The result is
-     * stored in the cache. Finally, the cached (or newly generated) pixmap is drawn.
-     * @param painter The QPainter to use for drawing.
+     * @brief Resolves the OpenGL 3.3 functions and compiles the shutdown shader.
+     */
+    void initializeGL() override;
+
+    /**
+     * @brief Renders the current frame: uploads a new snapshot if needed, then draws one textured triangle.
      */
-    void draw(QPainter *painter) override;
+    void paintGL() override;
 
 private:
+    /**
+     * @brief Uploads snapshot_ into texture_ and drops the CPU copy.
+     */
+    void UploadSnapshot();
+
+    /**
+     * @brief Draws the collapse with QPainter when the shader is unavailable.
+     */
+    void PaintFallback();
+
     /** @brief Current progress level of the shutdown animation (0.0 to 1.0). */
-    qreal progress_;
-    /** @brief Stores the progress value from the last time the cache was updated, used to optimize cache usage. */
-    qreal last_progress_;
-    /** @brief Cache storing pre-rendered effect pixmaps keyed by progress level string for performance. */
-    QCache<QString, QPixmap> result_cache_;
+    qreal progress_ = 0.0;
+    /** @brief Seed of the glitch noise, picked in Start(). */
+    float seed_ = 0.0f;
+    /** @brief Snapshot of the source widget waiting to be uploaded (null once uploaded). */
+    QImage snapshot_;
+    /** @brief Logical size of the last snapshot. */
+    QSize snapshot_size_;
+    /** @brief Texture holding the snapshot (premultiplied, top row first). */
+    GLuint texture_ = 0;
+    /** @brief The shutdown shader. */
+    std::unique_ptr<QOpenGLShaderProgram> program_;
+    /** @brief Empty vertex array object required by the core profile for the attribute-less triangle. */
+    QOpenGLVertexArrayObject vao_;
+    /** @brief Whether the shader is linked and the GL functions are resolved. */
+    bool gl_ready_ = false;
 };
 
 #endif // ELECTRONIC_SHUTDOWN_EFFECT_H
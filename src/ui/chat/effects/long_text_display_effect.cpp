@@ -1,6 +1,14 @@
 #include "long_text_display_effect.h"
 
 #include <QPainter>
+#include <QtConcurrent/QtConcurrentRun>
+
+namespace {
+    /** @brief Length of new text (in characters) from which it is measured on a worker thread. */
+    constexpr int kBackgroundMeasureLength = 20000;
+    /** @brief Approximate length of text measured per chunk handed back to the GUI thread. */
+    constexpr int kMeasureChunkLength = 8000;
+}
 
 LongTextDisplayEffect::LongTextDisplayEffect(QString text, const QColor &text_color, QWidget *parent): QWidget(parent),
     original_text_(std::move(text)), text_color_(text_color),
@@ -10,12 +18,21 @@ LongTextDisplayEffect::LongTextDisplayEffect(QString text, const QColor &text_co
     font_ = QFont("Consolas", 10);
     font_.setStyleHint(QFont::Monospace);
 
+    line_breaker_.SetFont(font_);
+    line_breaker_.SetText(original_text_);
+    StartMeasuring();
     ProcessText();
 }
 
+LongTextDisplayEffect::~LongTextDisplayEffect() {
+    CancelMeasuring();
+}
+
 void LongTextDisplayEffect::SetText(const QString &text) {
     if (original_text_ == text) return;
     original_text_ = text;
+    line_breaker_.SetText(original_text_);
+    StartMeasuring();
     cached_text_valid_ = false;
     ProcessText();
     update();
@@ -96,72 +113,82 @@ void LongTextDisplayEffect::resizeEvent(QResizeEvent *event) {
 void LongTextDisplayEffect::ProcessText() {
     if (cached_text_valid_) return;
 
-    processed_lines_.clear();
-
-    const QFontMetrics fm(font_);
     const int available_width = qMax(1, width() - 30);
     int max_line_width = 0;
+    line_breaker_.Layout(available_width, processed_lines_, max_line_width);
 
-    QStringList paragraphs = original_text_.split("\n", Qt::KeepEmptyParts);
+    const int line_height = QFontMetrics(font_).lineSpacing();
+    const int required_height = processed_lines_.size() * line_height + 20;
+    const int required_width = max_line_width + 30;
 
-    for (const QString &paragraph: paragraphs) {
-        if (paragraph.isEmpty()) {
-            processed_lines_.append("");
-            continue;
-        }
+    const QSize new_size_hint(required_width, required_height);
+    if (size_hint_ != new_size_hint) {
+        size_hint_ = new_size_hint;
+        updateGeometry();
+    }
 
-        QStringList words = paragraph.split(" ", Qt::SkipEmptyParts);
-        QString current_line;
+    cached_text_valid_ = true;
+    emit contentHeightChanged(required_height);
+}
 
-        for (const QString &word: words) {
-            QString test_line = current_line.isEmpty() ? word : current_line + " " + word;
-            const int current_line_width = fm.horizontalAdvance(test_line);
+void LongTextDisplayEffect::StartMeasuring() {
+    CancelMeasuring();
 
-            if (current_line_width <= available_width) {
-                current_line = test_line;
-            } else {
-                if (!current_line.isEmpty()) {
-                    processed_lines_.append(current_line);
-                    max_line_width = qMax(max_line_width, fm.horizontalAdvance(current_line));
-                }
+    const QStringList pending = line_breaker_.PendingParagraphs();
+    int pending_length = 0;
+    for (const QString &paragraph: pending) {
+        pending_length += paragraph.length();
+    }
+    if (pending_length < kBackgroundMeasureLength) {
+        line_breaker_.MeasurePending();
+        return;
+    }
 
-                const int word_width = fm.horizontalAdvance(word);
-                if (word_width > available_width) {
-                    QString part;
-                    for (const QChar &c: word) {
-                        QString test_part = part + c;
-                        const int part_width = fm.horizontalAdvance(test_part);
-                        if (part_width <= available_width) {
-                            part = test_part;
-                        } else {
-                            processed_lines_.append(part);
-                            max_line_width = qMax(max_line_width, fm.horizontalAdvance(part));
-                            part = QString(c);
-                        }
-                    }
-                    current_line = part;
-                } else {
-                    current_line = word;
+    auto cancelled = std::make_shared<std::atomic_bool>(false);
+    measure_cancelled_ = cancelled;
+    measure_future_ = QtConcurrent::run([this, pending, font = font_, cancelled] {
+        const QFontMetrics metrics(font);
+        QHash<QString, int> word_advances;
+        QVector<TextLineBreaker::MeasuredParagraph> chunk;
+        int chunk_length = 0;
+
+        const auto deliver_chunk = [this, &chunk, &chunk_length, &cancelled] {
+            // the widget waits for this worker before it is destroyed, so it is alive here
+            QMetaObject::invokeMethod(this, [this, chunk, cancelled] {
+                if (!cancelled->load()) {
+                    AddMeasuredParagraphs(chunk);
                 }
+            }, Qt::QueuedConnection);
+            chunk.clear();
+            chunk_length = 0;
+        };
+
+        for (const QString &paragraph: pending) {
+            if (cancelled->load()) return;
+
+            chunk.append(TextLineBreaker::MeasureParagraph(paragraph, metrics, word_advances));
+            chunk_length += paragraph.length();
+            if (chunk_length >= kMeasureChunkLength) {
+                deliver_chunk();
             }
         }
-
-        if (!current_line.isEmpty()) {
-            processed_lines_.append(current_line);
-            max_line_width = qMax(max_line_width, fm.horizontalAdvance(current_line));
+        if (!chunk.isEmpty()) {
+            deliver_chunk();
         }
-    }
-
-    const int line_height = fm.lineSpacing();
-    const int required_height = processed_lines_.size() * line_height + 20;
-    const int required_width = max_line_width + 30;
+    });
+}
 
-    const QSize new_size_hint(required_width, required_height);
-    if (size_hint_ != new_size_hint) {
-        size_hint_ = new_size_hint;
-        updateGeometry();
+void LongTextDisplayEffect::CancelMeasuring() {
+    if (measure_cancelled_) {
+        measure_cancelled_->store(true);
+        measure_cancelled_.reset();
     }
+    measure_future_.waitForFinished();
+}
 
-    cached_text_valid_ = true;
-    emit contentHeightChanged(required_height);
+void LongTextDisplayEffect::AddMeasuredParagraphs(const QVector<TextLineBreaker::MeasuredParagraph> &paragraphs) {
+    line_breaker_.AddMeasuredParagraphs(paragraphs);
+    cached_text_valid_ = false;
+    ProcessText();
+    update();
 }
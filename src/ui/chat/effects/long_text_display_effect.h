@@ -1,15 +1,21 @@
 #ifndef CYBER_LONG_TEXT_DISPLAY_H
 #define CYBER_LONG_TEXT_DISPLAY_H
 
+#include <atomic>
+#include <memory>
+#include <QFuture>
 #include <QWidget>
 
+#include "text_line_breaker.h"
+
 /**
  * @brief A custom widget for displaying potentially long text with cyberpunk aesthetics and efficient rendering.
  *
  * This widget takes a long string, processes it by wrapping lines based on the widget's width,
  * and renders only the visible portion of the text. It includes a cyberpunk-style background
- * gradient and scanline effect. Text processing is delayed and cached to avoid excessive
- * recalculations during resizing. It supports vertical scrolling via the SetScrollPosition method
+ * gradient and scanline effect. Line breaking is done by a TextLineBreaker: words are measured once, so
+ * resizing only re-breaks cached measurements, and a text change measures only the new paragraphs.
+ * The new paragraphs of very long texts are measured on a worker thread and their lines are shown as they arrive. It supports vertical scrolling via the SetScrollPosition method
  * and emits a signal indicating the total required height for the content.
  */
 class LongTextDisplayEffect final : public QWidget {
@@ -18,18 +24,22 @@ class LongTextDisplayEffect final : public QWidget {
 public:
     /**
      * @brief Constructs a CyberLongTextDisplay widget.
-     * Initializes the widget with default size policies, font, text color, and sets up
-     * a timer for delayed text processing.
+     * Initializes the widget with default size policies, font and text color, and starts measuring the text.
      * @param text The initial text content to display.
      * @param text_color The color for the displayed text.
      * @param parent Optional parent widget.
      */
     explicit LongTextDisplayEffect(QString text, const QColor &text_color, QWidget *parent = nullptr);
 
+    /**
+     * @brief Destructor. Cancels a running background measurement and waits for it.
+     */
+    ~LongTextDisplayEffect() override;
+
     /**
      * @brief Sets the text content to be displayed.
-     * Updates the internal original text, invalidates the processed text cache,
-     * triggers delayed processing, and schedules a repaint.
+     * Updates the internal original text, measures its new paragraphs (in the background for very long texts),
+     * re-breaks the lines and schedules a repaint.
      * @param text The new text content.
      */
     void SetText(const QString &text);
@@ -70,22 +80,37 @@ protected:
 
     /**
      * @brief Overridden resize event handler.
-     * Invalidates the processed text cache and triggers delayed text processing
-     * when the widget's size changes.
+     * Re-breaks the already measured text for the new width.
      * @param event The resize event.
      */
     void resizeEvent(QResizeEvent *event) override;
 
 private:
     /**
-     * @brief Processes the original_text_ into wrapped lines based on the current widget width.
-     * Splits the text into paragraphs and words, then reconstructs lines ensuring they fit
-     * within the available width. Handles word wrapping and breaking long words.
-     * Updates the processed_lines_ cache, calculates the required dimensions (width and height),
-     * updates the size_hint_, marks the cache as valid, and emits contentHeightChanged.
+     * @brief Breaks the measured text into processed_lines_ for the current widget width.
+     * Calculates the required dimensions (width and height), updates the size_hint_,
+     * marks the cache as valid, and emits contentHeightChanged.
      */
     void ProcessText();
 
+    /**
+     * @brief Measures the paragraphs of original_text_ that line_breaker_ does not know yet.
+     * Short pending text is measured immediately; longer text is measured on a worker thread
+     * in chunks, each handed to AddMeasuredParagraphs() on the GUI thread. A previous measurement is cancelled.
+     */
+    void StartMeasuring();
+
+    /**
+     * @brief Cancels the running background measurement, if any, and waits for the worker to stop.
+     */
+    void CancelMeasuring();
+
+    /**
+     * @brief Takes a chunk of paragraphs measured on the worker thread and re-breaks the lines.
+     * @param paragraphs The measured paragraphs.
+     */
+    void AddMeasuredParagraphs(const QVector<TextLineBreaker::MeasuredParagraph> &paragraphs);
+
 signals:
     /**
      * @brief Emitted after ProcessText() finishes, indicating the total calculated height
@@ -109,8 +134,12 @@ private:
     int scroll_position_;
     /** @brief Flag indicating if the processed_lines_ cache is up to date with the original_text_ and widget width. */
     bool cached_text_valid_;
-    /** @brief Timer used to delay text processing after resize or text change events. */
-    QTimer *update_timer_{};
+    /** @brief Word measurements and per-paragraph lines of the text. */
+    TextLineBreaker line_breaker_;
+    /** @brief The running background measurement. */
+    QFuture<void> measure_future_;
+    /** @brief Cancellation flag of the running background measurement (shared with its worker). */
+    std::shared_ptr<std::atomic_bool> measure_cancelled_;
 };
 
 #endif // CYBER_LONG_TEXT_DISPLAY_H
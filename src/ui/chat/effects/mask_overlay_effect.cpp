@@ -2,15 +2,10 @@
 
 #include <QPainter>
 #include <QRandomGenerator>
-#include <QTimer>
 
 MaskOverlayEffect::MaskOverlayEffect(QWidget *parent): QWidget(parent), reveal_percentage_(0), scanline_y_(0) {
     setAttribute(Qt::WA_TransparentForMouseEvents);
     setAttribute(Qt::WA_NoSystemBackground);
-
-    scan_timer_ = new QTimer(this);
-    connect(scan_timer_, &QTimer::timeout, this, &MaskOverlayEffect::UpdateScanLine);
-    scan_timer_->start(30);
 }
 
 void MaskOverlayEffect::SetRevealProgress(const int percentage) {
@@ -21,15 +16,21 @@ void MaskOverlayEffect::SetRevealProgress(const int percentage) {
 void MaskOverlayEffect::StartScanning() {
     reveal_percentage_ = 0;
     scanline_y_ = 0;
-    if (!scan_timer_->isActive()) {
-        scan_timer_->start();
+    AnimationClock *clock = AnimationClock::GetInstance();
+    if (!clock->IsSubscribed(scan_subscription_)) {
+        // the scanline shows a load in progress, so it keeps moving while the application is idle
+        scan_subscription_ = clock->Subscribe(this, 30, [this] {
+            UpdateScanLine();
+            return true;
+        }, true);
     }
     setVisible(true);
     update();
 }
 
 void MaskOverlayEffect::StopScanning() {
-    scan_timer_->stop();
+    AnimationClock::GetInstance()->Unsubscribe(scan_subscription_);
+    scan_subscription_ = 0;
     setVisible(false);
 }
 
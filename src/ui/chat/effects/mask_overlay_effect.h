@@ -3,6 +3,8 @@
 
 #include <QWidget>
 
+#include "../../../util/animation_clock.h"
+
 /**
  * @brief A custom overlay widget that creates a "reveal" effect using a moving scanline.
  *
@@ -18,8 +20,8 @@ class MaskOverlayEffect final : public QWidget {
 public:
     /**
      * @brief Constructs a MaskOverlay widget.
-     * Initializes the widget attributes (transparent for mouse events, no system background),
-     * sets up and starts the timer for the scanline animation.
+     * Initializes the widget attributes (transparent for mouse events, no system background).
+     * The scanline animation ticks only between StartScanning() and StopScanning().
      * @param parent Optional parent widget.
      */
     explicit MaskOverlayEffect(QWidget *parent = nullptr);
@@ -35,12 +37,12 @@ public slots:
     /**
      * @brief Starts or restarts the scanline animation and reveal effect.
      * Resets the reveal percentage and scanline position, makes the overlay visible,
-     * and ensures the scanline timer is running.
+     * and subscribes the scanline animation to the animation clock.
      */
     void StartScanning();
 
     /**
-     * @brief Stops the scanline animation and hides the overlay.
+     * @brief Stops the scanline animation (unsubscribing it) and hides the overlay.
      */
     void StopScanning();
 
@@ -56,7 +58,7 @@ protected:
 
 private slots:
     /**
-     * @brief Slot called by the scan_timer_ to update the vertical position of the scanline.
+     * @brief Tick of the animation clock updating the vertical position of the scanline.
      * Moves the scanline downwards and wraps it back to the top when it reaches the bottom.
      * Triggers a repaint.
      */
@@ -67,8 +69,8 @@ private:
     int reveal_percentage_;
     /** @brief The current vertical position (y-coordinate) of the scanline. */
     int scanline_y_;
-    /** @brief Timer controlling the animation of the scanline's movement. */
-    QTimer *scan_timer_;
+    /** @brief Animation clock tick of the scanline's movement. */
+    AnimationClock::SubscriptionId scan_subscription_ = 0;
 };
 
 #endif // MASK_OVERLAY_H
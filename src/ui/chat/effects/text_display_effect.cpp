@@ -1,14 +1,34 @@
 #include "text_display_effect.h"
 
+#include <cmath>
 #include <QDateTime>
 #include <QFontDatabase>
+#include <QGlyphRun>
 #include <QMediaPlayer>
 #include <QMediaPlaylist>
 #include <QPainter>
+#include <QPaintEvent>
 #include <QPropertyAnimation>
 #include <QRandomGenerator>
 #include <QTimer>
 
+namespace {
+    /** @brief Left margin of the text. */
+    constexpr int kLeftMargin = 15;
+    /** @brief Top margin of the text. */
+    constexpr int kTopMargin = 10;
+    /** @brief Distance from the cursor (in characters) from which the text color no longer changes. */
+    constexpr int kSettledDistance = 25;
+    /** @brief QColor::lighter factor of the settled text. */
+    constexpr int kSettledBrightness = 180;
+    /** @brief Range of the random characters substituted by the glitch effect. */
+    constexpr int kFirstGlitchChar = 33;
+    constexpr int kLastGlitchChar = 125;
+
+    const QColor kTextColor(0, 255, 200);
+    const QColor kGlitchColor(0, 255, 255);
+}
+
 TextDisplayEffect::TextDisplayEffect(const QString &text, const TypingSoundType sound_type,
                                      QWidget *parent): QWidget(parent), full_text_(text), revealed_chars_(0),
                                                        glitch_intensity_(0.0), is_fully_revealed_(false),
@@ -32,13 +52,6 @@ TextDisplayEffect::TextDisplayEffect(const QString &text, const TypingSoundType
 
     plain_text_ = RemoveHtml(full_text_);
 
-    text_timer_ = new QTimer(this);
-    connect(text_timer_, &QTimer::timeout, this, &TextDisplayEffect::RevealNextChar);
-
-    glitch_timer_ = new QTimer(this);
-    connect(glitch_timer_, &QTimer::timeout, this, &TextDisplayEffect::RandomGlitch);
-    glitch_timer_->start(100);
-
     font_ = QFont(font_family, 10);
     font_.setStyleHint(QFont::Monospace);
 
@@ -71,6 +84,7 @@ TextDisplayEffect::TextDisplayEffect(const QString &text, const TypingSoundType
 
     connect(this, &TextDisplayEffect::fullTextRevealed, this, &TextDisplayEffect::HandleFullTextRevealed);
 
+    SetGlitchEffectEnabled(true);
     RecalculateHeight();
 }
 
@@ -83,7 +97,8 @@ TextDisplayEffect::~TextDisplayEffect() {
 void TextDisplayEffect::StartReveal() {
     if (has_been_fully_revealed_once_) {
         SetRevealedChars(plain_text_.length());
-        text_timer_->stop();
+        AnimationClock::GetInstance()->Unsubscribe(reveal_subscription_);
+        reveal_subscription_ = 0;
         if (media_player_ && media_player_->state() == QMediaPlayer::PlayingState) {
             media_player_->stop();
         }
@@ -92,8 +107,13 @@ void TextDisplayEffect::StartReveal() {
 
     revealed_chars_ = 0;
     is_fully_revealed_ = false;
-    text_timer_->stop();
-    text_timer_->start(30);
+    AnimationClock *clock = AnimationClock::GetInstance();
+    clock->Unsubscribe(reveal_subscription_);
+    // a received message is revealed even if nobody interacts with the application meanwhile
+    reveal_subscription_ = clock->Subscribe(this, 30, [this] {
+        RevealNextChar();
+        return !is_fully_revealed_;
+    }, true);
 
     if (media_player_ && media_player_->mediaStatus() >= QMediaPlayer::LoadedMedia && media_player_->state() !=
         QMediaPlayer::PlayingState) {
@@ -114,10 +134,16 @@ void TextDisplayEffect::SetText(const QString &new_text) {
 }
 
 void TextDisplayEffect::SetRevealedChars(const int chars) {
-    revealed_chars_ = qMin(chars, plain_text_.length());
+    const int previous_chars = revealed_chars_;
+    revealed_chars_ = qBound(0, chars, plain_text_.length());
     const bool just_revealed = revealed_chars_ >= plain_text_.length() && !is_fully_revealed_;
 
-    update();
+    // a reveal step only changes the characters near the cursor
+    if (layout_valid_) {
+        update(RevealDirtyRect(previous_chars, revealed_chars_));
+    } else {
+        update();
+    }
 
     if (just_revealed) {
         is_fully_revealed_ = true;
@@ -134,10 +160,18 @@ void TextDisplayEffect::SetGlitchIntensity(const qreal intensity) {
 }
 
 void TextDisplayEffect::SetGlitchEffectEnabled(const bool enabled) {
-    if (enabled && !glitch_timer_->isActive()) {
-        glitch_timer_->start(100);
-    } else if (!enabled && glitch_timer_->isActive()) {
-        glitch_timer_->stop();
+    AnimationClock *clock = AnimationClock::GetInstance();
+    if (enabled && !clock->IsSubscribed(glitch_subscription_)) {
+        // random glitches are decoration only, they pause while the application is idle
+        glitch_subscription_ = clock->Subscribe(this, 100, [this] {
+            RandomGlitch();
+            return true;
+        });
+    } else if (!enabled) {
+        clock->Unsubscribe(glitch_subscription_);
+        glitch_subscription_ = 0;
+    }
+    if (!enabled && glitch_intensity_ > 0.0) {
         glitch_intensity_ = 0.0;
         update();
     }
@@ -151,79 +185,79 @@ QSize TextDisplayEffect::sizeHint() const {
 }
 
 void TextDisplayEffect::paintEvent(QPaintEvent *event) {
+    if (width() <= 0 || height() <= 0) return;
+
+    EnsureLayout();
+    UpdateCaches();
+
     QPainter painter(this);
     painter.setRenderHint(QPainter::Antialiasing);
+    painter.drawPixmap(0, 0, background_cache_);
+
+    // a glitched character replaces the original glyph, so its cell is cut out of the text layers
+    QVector<int> glitched_chars;
+    if (glitch_intensity_ > 0.01) {
+        const double probability = qMin(1.0, glitch_intensity_);
+        QRandomGenerator *random = QRandomGenerator::global();
+        // geometric skips draw one random number per glitched character instead of one per character
+        const double log_miss = probability < 1.0 ? std::log(1.0 - probability) : 0.0;
+        int index = -1;
+        while (true) {
+            index += log_miss < 0.0 ? 1 + static_cast<int>(std::log(1.0 - random->generateDouble()) / log_miss) : 1;
+            if (index >= revealed_chars_) break;
+            if (plain_text_[index] != '\n' && !plain_text_[index].isLowSurrogate()) {
+                glitched_chars.append(index);
+            }
+        }
+    }
+    if (!glitched_chars.isEmpty()) {
+        QRegion text_region(event->rect());
+        for (const int index: glitched_chars) {
+            text_region -= GlyphRect(index);
+        }
+        painter.setClipRegion(text_region);
+    }
 
-    QLinearGradient background_gradient(0, 0, width(), height());
-    background_gradient.setColorAt(0, QColor(5, 10, 15, 150));
-    background_gradient.setColorAt(1, QColor(10, 20, 30, 150));
-    painter.fillRect(rect(), background_gradient);
+    painter.drawPixmap(0, 0, settled_text_cache_);
+    for (int i = settled_chars_; i < revealed_chars_; ++i) {
+        // the color fades with the distance from the cursor and is constant from kSettledDistance on
+        const int brightness = qMax(kSettledBrightness, 255 - (revealed_chars_ - i) * 3);
+        DrawGlyphs(painter, i, i + 1, kTextColor.lighter(brightness));
+    }
 
-    painter.setFont(font_);
-    QString visible_text = plain_text_.left(revealed_chars_);
-
-    QFontMetrics font_metrics(font_);
-    int line_height = font_metrics.lineSpacing();
-    int top_margin = 10;
-    int left_margin = 15;
-
-    QColor base_text_color(0, 255, 200);
-
-    QStringList lines = visible_text.split('\n');
-    int y = top_margin + font_metrics.ascent();
-
-    for (int line_index = 0; line_index < lines.size(); ++line_index) {
-        QString line = lines[line_index];
-        int x = left_margin;
-
-        for (int i = 0; i < line.length(); ++i) {
-            // calculating color based on position (distance from cursor)
-            int distance_from_cursor = qAbs(i + line_index * 80 - revealed_chars_);
-            int brightness = qMax(180, 255 - distance_from_cursor * 3);
-            QColor char_color = base_text_color.lighter(brightness);
-
-            if (glitch_intensity_ > 0.01 && QRandomGenerator::global()->bounded(100) < glitch_intensity_ * 100) {
-                auto glitched_char = QChar(QRandomGenerator::global()->bounded(33, 126));
-                char_color = QColor(0, 255, 255);
-                painter.setPen(char_color);
-                painter.drawText(x, y, QString(glitched_char));
-            } else {
-                painter.setPen(char_color);
-                painter.drawText(x, y, QString(line[i]));
+    if (!glitched_chars.isEmpty()) {
+        painter.setClipping(false);
+        QRandomGenerator *random = QRandomGenerator::global();
+        QVector<quint32> glyphs;
+        QVector<QPointF> positions;
+        for (const int index: glitched_chars) {
+            positions.append(caret_positions_[index]);
+            glyphs.append(glitch_glyph_indexes_[random->bounded(glitch_glyph_indexes_.size())]);
+        }
+        painter.setPen(kGlitchColor);
+        if (raw_font_.isValid()) {
+            QGlyphRun run;
+            run.setRawFont(raw_font_);
+            run.setGlyphIndexes(glyphs);
+            run.setPositions(positions);
+            painter.drawGlyphRun(QPointF(), run);
+        } else {
+            painter.setFont(font_);
+            for (const QPointF &position: qAsConst(positions)) {
+                painter.drawText(position, QString(QChar(random->bounded(kFirstGlitchChar, kLastGlitchChar + 1))));
             }
-
-            x += font_metrics.horizontalAdvance(line[i]);
         }
-
-        y += line_height;
     }
 
     // blinking cursor
     if (revealed_chars_ < plain_text_.length() ||
         QDateTime::currentMSecsSinceEpoch() % 1000 < 500) {
-        int cursor_line = visible_text.count('\n');
-        int cursor_position = visible_text.length() - visible_text.lastIndexOf('\n') - 1;
-
-        if (visible_text.isEmpty()) {
-            cursor_line = 0;
-            cursor_position = 0;
-        }
-
-        int cursor_x = left_margin + font_metrics.horizontalAdvance(
-                           lines.isEmpty() ? "" : lines.last().left(cursor_position));
-        int cursor_y = top_margin + font_metrics.ascent() + cursor_line * line_height;
-
         painter.setPen(Qt::NoPen);
-        painter.setBrush(QColor(0, 255, 200));
-        painter.drawRect(cursor_x, cursor_y - font_metrics.ascent() + 2, 8, font_metrics.height() - 2);
+        painter.setBrush(kTextColor);
+        painter.drawRect(CursorRect(revealed_chars_));
     }
 
-    painter.setOpacity(0.1);
-    painter.setPen(QPen(QColor(0, 255, 200), 1, Qt::DotLine));
-
-    for (int i = 0; i < height(); i += 4) {
-        painter.drawLine(0, i, width(), i);
-    }
+    painter.drawPixmap(0, 0, scanline_cache_);
 }
 
 void TextDisplayEffect::resizeEvent(QResizeEvent *event) {
@@ -236,14 +270,16 @@ void TextDisplayEffect::hideEvent(QHideEvent *event) {
     if (media_player_ && media_player_->state() == QMediaPlayer::PlayingState) {
         media_player_->stop();
     }
-    text_timer_->stop();
-    glitch_timer_->stop();
+    AnimationClock *clock = AnimationClock::GetInstance();
+    clock->Unsubscribe(reveal_subscription_);
+    clock->Unsubscribe(glitch_subscription_);
+    reveal_subscription_ = 0;
+    glitch_subscription_ = 0;
 }
 
-void TextDisplayEffect::HandleFullTextRevealed() const {
-    if (text_timer_->isActive()) {
-        text_timer_->stop();
-    }
+void TextDisplayEffect::HandleFullTextRevealed() {
+    AnimationClock::GetInstance()->Unsubscribe(reveal_subscription_);
+    reveal_subscription_ = 0;
     if (media_player_ && media_player_->state() == QMediaPlayer::PlayingState) {
         QTimer::singleShot(0, this, [this] {
             if (media_player_ && media_player_->state() == QMediaPlayer::PlayingState) {
@@ -259,9 +295,9 @@ void TextDisplayEffect::RevealNextChar() {
 
         if (revealed_chars_ < plain_text_.length() &&
             (plain_text_[revealed_chars_] == ' ' || plain_text_[revealed_chars_] == '\n')) {
-            text_timer_->setInterval(60);
+            AnimationClock::GetInstance()->SetInterval(reveal_subscription_, 60);
         } else {
-            text_timer_->setInterval(30);
+            AnimationClock::GetInstance()->SetInterval(reveal_subscription_, 30);
         }
 
         if (QRandomGenerator::global()->bounded(100) < 5) {
@@ -304,6 +340,7 @@ QString TextDisplayEffect::RemoveHtml(const QString &html) {
 }
 
 void TextDisplayEffect::RecalculateHeight() {
+    layout_valid_ = false;
     const QFontMetrics font_metrics(font_);
     const int text_width = qMax(300, width() - 30);
 
@@ -339,3 +376,153 @@ void TextDisplayEffect::RecalculateHeight() {
 
     setMinimumHeight(height);
 }
+
+void TextDisplayEffect::EnsureLayout() {
+    if (layout_valid_) return;
+
+    const QFontMetrics font_metrics(font_);
+    raw_font_ = QRawFont::fromFont(font_);
+    font_ascent_ = font_metrics.ascent();
+    font_height_ = font_metrics.height();
+
+    const int length = plain_text_.length();
+    caret_positions_.resize(length + 1);
+    glyph_indexes_.resize(length);
+
+    int x = kLeftMargin;
+    int y = kTopMargin + font_ascent_;
+    for (int i = 0; i < length; ++i) {
+        const QChar character = plain_text_[i];
+        caret_positions_[i] = QPointF(x, y);
+        glyph_indexes_[i] = 0;
+        if (character == '\n') {
+            x = kLeftMargin;
+            y += font_metrics.lineSpacing();
+            continue;
+        }
+        // a surrogate pair (e.g., an emoji) is one character drawn with a fallback font; its low half gets the
+        // caret position after it
+        if (character.isHighSurrogate() && i + 1 < length && plain_text_[i + 1].isLowSurrogate()) {
+            x += font_metrics.horizontalAdvance(plain_text_.mid(i, 2));
+            ++i;
+            caret_positions_[i] = QPointF(x, y);
+            glyph_indexes_[i] = 0;
+            continue;
+        }
+        // glyph 0 means the font lacks the character, e.g. Cyrillic or CJK text; it is drawn with a fallback font
+        if (raw_font_.isValid()) {
+            int glyph_count = 1;
+            raw_font_.glyphIndexesForChars(&character, 1, &glyph_indexes_[i], &glyph_count);
+        }
+        x += font_metrics.horizontalAdvance(character);
+    }
+    caret_positions_[length] = QPointF(x, y);
+    // re-wrapping after a resize may drop characters
+    revealed_chars_ = qMin(revealed_chars_, length);
+
+    glitch_glyph_indexes_.resize(kLastGlitchChar - kFirstGlitchChar + 1);
+    for (int i = 0; i < glitch_glyph_indexes_.size(); ++i) {
+        const QChar character(kFirstGlitchChar + i);
+        int glyph_count = 1;
+        glitch_glyph_indexes_[i] = 0;
+        if (raw_font_.isValid()) {
+            raw_font_.glyphIndexesForChars(&character, 1, &glitch_glyph_indexes_[i], &glyph_count);
+        }
+    }
+
+    // the settled glyphs were drawn at the old positions
+    settled_text_cache_ = QPixmap();
+    settled_chars_ = 0;
+    layout_valid_ = true;
+}
+
+void TextDisplayEffect::UpdateCaches() {
+    const qreal pixel_ratio = devicePixelRatioF();
+    const QSize pixel_size = size() * pixel_ratio;
+    const auto create_layer = [pixel_size, pixel_ratio] {
+        QPixmap layer(pixel_size);
+        layer.setDevicePixelRatio(pixel_ratio);
+        layer.fill(Qt::transparent);
+        return layer;
+    };
+
+    if (background_cache_.size() != pixel_size) {
+        background_cache_ = create_layer();
+        QPainter painter(&background_cache_);
+        QLinearGradient background_gradient(0, 0, width(), height());
+        background_gradient.setColorAt(0, QColor(5, 10, 15, 150));
+        background_gradient.setColorAt(1, QColor(10, 20, 30, 150));
+        painter.fillRect(rect(), background_gradient);
+
+        scanline_cache_ = create_layer();
+        QPainter scanline_painter(&scanline_cache_);
+        scanline_painter.setOpacity(0.1);
+        scanline_painter.setPen(QPen(kTextColor, 1, Qt::DotLine));
+        for (int i = 0; i < height(); i += 4) {
+            scanline_painter.drawLine(0, i, width(), i);
+        }
+    }
+
+    const int settled_target = qMax(0, revealed_chars_ - kSettledDistance);
+    if (settled_text_cache_.size() != pixel_size || settled_target < settled_chars_) {
+        settled_text_cache_ = create_layer();
+        settled_chars_ = 0;
+    }
+    if (settled_target > settled_chars_) {
+        QPainter painter(&settled_text_cache_);
+        painter.setRenderHint(QPainter::Antialiasing);
+        DrawGlyphs(painter, settled_chars_, settled_target, kTextColor.lighter(kSettledBrightness));
+        settled_chars_ = settled_target;
+    }
+}
+
+void TextDisplayEffect::DrawGlyphs(QPainter &painter, const int from, const int to, const QColor &color) const {
+    painter.setPen(color);
+    painter.setFont(font_);
+
+    QVector<quint32> glyphs;
+    QVector<QPointF> positions;
+    glyphs.reserve(to - from);
+    positions.reserve(to - from);
+    for (int i = from; i < to; ++i) {
+        const QChar character = plain_text_[i];
+        if (character == '\n' || character.isLowSurrogate()) continue;
+
+        if (glyph_indexes_[i] != 0) {
+            glyphs.append(glyph_indexes_[i]);
+            positions.append(caret_positions_[i]);
+            continue;
+        }
+        // drawText() resolves a font that has the character
+        const int length = character.isHighSurrogate() && i + 1 < plain_text_.length() ? 2 : 1;
+        painter.drawText(caret_positions_[i], plain_text_.mid(i, length));
+    }
+    if (glyphs.isEmpty()) return;
+
+    QGlyphRun run;
+    run.setRawFont(raw_font_);
+    run.setGlyphIndexes(glyphs);
+    run.setPositions(positions);
+    painter.drawGlyphRun(QPointF(), run);
+}
+
+QRect TextDisplayEffect::GlyphRect(const int index) const {
+    const QPointF &position = caret_positions_[index];
+    const qreal advance = plain_text_[index] == '\n' ? 0.0 : caret_positions_[index + 1].x() - position.x();
+    return QRectF(position.x(), position.y() - font_ascent_, advance, font_height_)
+            .toAlignedRect().adjusted(-1, -1, 1, 1);
+}
+
+QRect TextDisplayEffect::CursorRect(const int chars) const {
+    const QPointF &position = caret_positions_[chars];
+    return QRect(qRound(position.x()), qRound(position.y()) - font_ascent_ + 2, 8, font_height_ - 2);
+}
+
+QRect TextDisplayEffect::RevealDirtyRect(const int from_chars, const int to_chars) const {
+    QRect dirty = CursorRect(from_chars).adjusted(-1, -1, 1, 1) | CursorRect(to_chars).adjusted(-1, -1, 1, 1);
+    for (int i = qMax(0, qMin(from_chars, to_chars) - kSettledDistance), end = qMax(from_chars, to_chars);
+         i < end; ++i) {
+        dirty |= GlyphRect(i);
+    }
+    return dirty;
+}
@@ -1,9 +1,15 @@
 #ifndef CYBER_TEXT_DISPLAY_H
 #define CYBER_TEXT_DISPLAY_H
 
+#include <QPixmap>
+#include <QRawFont>
+#include <QVector>
 #include <QWidget>
 
+#include "../../../util/animation_clock.h"
+
 class QMediaPlaylist;
+class QPainter;
 class QAudioOutput;
 class QMediaPlayer;
 
@@ -14,6 +20,11 @@ class QMediaPlayer;
  * It also features random visual "glitch" effects and a pulsing cursor. The text is rendered with a monospace font
  * and neon colors against a gradient background with scanlines. It handles HTML removal from the input text and
  * recalculates its required height based on content and width.
+ *
+ * The text is laid out once per content or size change into one glyph and pen position per character.
+ * Characters far enough behind the cursor no longer change their color, so they are drawn once into a cached
+ * pixmap; a frame only draws the few characters near the cursor and the glitched ones, and a reveal step
+ * repaints only the area around the cursor.
  */
 class TextDisplayEffect final : public QWidget {
     Q_OBJECT
@@ -35,7 +46,7 @@ public:
 
     /**
      * @brief Constructs a CyberTextDisplay widget.
-     * Initializes the widget with text, sets up timers for text reveal and glitch effects,
+     * Initializes the widget with text, subscribes the glitch effect to the animation clock,
      * loads the monospace font, initializes the media player for typing sounds, and calculates initial height.
      * @param text The initial text content (can include basic HTML for formatting, which will be stripped for display).
      * @param sound_type The type of typing sounds to use (defaults to kUserSound).
@@ -51,7 +62,7 @@ public:
     /**
      * @brief Starts or restarts the text revealing animation from the beginning.
      * If the text has been fully revealed once, it instantly shows the full text.
-     * Otherwise, resets the revealed character count and starts the text reveal timer and typing sound.
+     * Otherwise, resets the revealed character count and starts the text reveal ticks and typing sound.
      */
     void StartReveal();
 
@@ -90,9 +101,9 @@ public:
     void SetGlitchIntensity(qreal intensity);
 
     /**
-     * @brief Enables or disables the random glitch effect timer.
+     * @brief Enables or disables the random glitch effect ticks.
      * When disabled, it also resets the glitch intensity to 0.
-     * @param enabled True to enable the glitch timer, false to disable it.
+     * @param enabled True to enable the glitch ticks, false to disable it.
      */
     void SetGlitchEffectEnabled(bool enabled);
 
@@ -112,8 +123,8 @@ signals:
 protected:
     /**
      * @brief Overridden paint event handler. Draws the widget's appearance.
-     * Renders the background gradient, the revealed portion of the text with character-by-character coloring,
-     * the pulsing cursor, and the scanline effect. Applies glitch effects if intensity > 0.
+     * Composites the cached background, the cached settled text and the scanline overlay, and draws the characters
+     * near the cursor (whose color still fades), the glitched characters and the pulsing cursor.
      * @param event The paint event.
      */
     void paintEvent(QPaintEvent *event) override;
@@ -125,25 +136,25 @@ protected:
     void resizeEvent(QResizeEvent *event) override;
 
     /**
-     * @brief Overridden hide event handler. Stops the typing sound and timers when the widget is hidden.
+     * @brief Overridden hide event handler. Stops the typing sound and animation ticks when the widget is hidden.
      * @param event The hide event.
      */
     void hideEvent(QHideEvent *event) override;
 
 private slots:
     /**
-     * @brief Slot connected to the fullTextRevealed signal. Stops the text reveal timer and typing sound.
+     * @brief Slot connected to the fullTextRevealed signal. Stops the text reveal ticks and typing sound.
      */
-    void HandleFullTextRevealed() const;
+    void HandleFullTextRevealed();
 
     /**
-     * @brief Slot called by the text_timer_. Reveals the next character in the sequence.
-     * Adjusts the timer interval for pauses after spaces/newlines. Randomly triggers glitches.
+     * @brief Reveal tick of the animation clock. Reveals the next character in the sequence.
+     * Adjusts the tick interval for pauses after spaces/newlines. Randomly triggers glitches.
      */
     void RevealNextChar();
 
     /**
-     * @brief Slot called by the glitch_timer_. Randomly triggers a glitch effect or fades the current intensity.
+     * @brief Glitch tick of the animation clock. Randomly triggers a glitch effect or fades the current intensity.
      */
     void RandomGlitch();
 
@@ -166,6 +177,50 @@ private:
      */
     void RecalculateHeight();
 
+    /**
+     * @brief Lays out plain_text_ (glyph and pen position of every character) if it changed since the last call.
+     */
+    void EnsureLayout();
+
+    /**
+     * @brief Recreates the background and scanline pixmaps after a size change and draws the characters that
+     * have settled since the last frame into settled_text_cache_ (rebuilding it if the reveal went backwards).
+     */
+    void UpdateCaches();
+
+    /**
+     * @brief Draws a range of laid out characters in one color as a single glyph run (line breaks are skipped).
+     * Characters raw_font_ has no glyph for are drawn with QPainter::drawText(), which falls back to other fonts.
+     * @param painter The painter to draw with.
+     * @param from Index of the first character.
+     * @param to Index past the last character.
+     * @param color The text color.
+     */
+    void DrawGlyphs(QPainter &painter, int from, int to, const QColor &color) const;
+
+    /**
+     * @brief Returns the area covered by a laid out character (with a margin for antialiasing).
+     * @param index Index of the character.
+     * @return The character's cell in widget coordinates.
+     */
+    QRect GlyphRect(int index) const;
+
+    /**
+     * @brief Returns the area of the cursor placed after the given number of revealed characters.
+     * @param chars Number of revealed characters.
+     * @return The cursor rectangle in widget coordinates.
+     */
+    QRect CursorRect(int chars) const;
+
+    /**
+     * @brief Returns the area that changes when the reveal moves between two character counts:
+     * both cursors, the newly (un)revealed characters, and the characters whose distance to the cursor changed.
+     * @param from_chars The previous number of revealed characters.
+     * @param to_chars The new number of revealed characters.
+     * @return The area to repaint.
+     */
+    QRect RevealDirtyRect(int from_chars, int to_chars) const;
+
     /** @brief The original text content, potentially including HTML. */
     QString full_text_;
     /** @brief The processed text content with HTML removed and potentially word-wrapped by RecalculateHeight. */
@@ -178,10 +233,36 @@ private:
     bool is_fully_revealed_;
     /** @brief The monospace font used for rendering. */
     QFont font_;
-    /** @brief Timer controlling the character-by-character reveal animation. */
-    QTimer *text_timer_;
-    /** @brief Timer controlling the random triggering and fading of glitch effects. */
-    QTimer *glitch_timer_;
+    /** @brief font_ as a raw font, used to draw the cached glyphs without shaping. */
+    QRawFont raw_font_;
+    /** @brief Whether the layout below matches plain_text_, font_ and the widget size. */
+    bool layout_valid_ = false;
+    /** @brief Pen position (on the baseline) before every character of plain_text_, plus one for the end. */
+    QVector<QPointF> caret_positions_;
+    /**
+     * @brief Glyph of every character of plain_text_ in raw_font_. 0 for line breaks, for characters raw_font_
+     * cannot draw (drawn with a fallback font instead) and for the low half of a surrogate pair (drawn with its
+     * high half).
+     */
+    QVector<quint32> glyph_indexes_;
+    /** @brief Glyphs of the random characters substituted by the glitch effect. */
+    QVector<quint32> glitch_glyph_indexes_;
+    /** @brief Ascent of font_. */
+    int font_ascent_ = 0;
+    /** @brief Height of font_. */
+    int font_height_ = 0;
+    /** @brief Background gradient of the current widget size. */
+    QPixmap background_cache_;
+    /** @brief Scanline overlay of the current widget size. */
+    QPixmap scanline_cache_;
+    /** @brief The revealed characters whose color no longer changes, i.e., the first settled_chars_ characters. */
+    QPixmap settled_text_cache_;
+    /** @brief Number of characters drawn into settled_text_cache_. */
+    int settled_chars_ = 0;
+    /** @brief Animation clock tick of the character-by-character reveal animation. */
+    AnimationClock::SubscriptionId reveal_subscription_ = 0;
+    /** @brief Animation clock tick of the random triggering and fading of glitch effects. */
+    AnimationClock::SubscriptionId glitch_subscription_ = 0;
     /** @brief Flag indicating if the text has completed its reveal animation at least once since the last SetText(). */
     bool has_been_fully_revealed_once_;
     /** @brief Media player responsible for playing the typing sound effect. */
@@ -0,0 +1,174 @@
+#include "text_line_breaker.h"
+
+#include <QFontMetrics>
+#include <QSet>
+
+namespace {
+    /** @brief Number of cached word advances after which the cache is started anew. */
+    constexpr int kMaxCachedWords = 65536;
+}
+
+void TextLineBreaker::SetFont(const QFont &font) {
+    font_ = font;
+    space_advance_ = QFontMetrics(font_).horizontalAdvance(' ');
+    measured_.clear();
+    word_advances_.clear();
+    character_advances_.clear();
+}
+
+void TextLineBreaker::SetText(const QString &text) {
+    paragraphs_ = text.split('\n', Qt::KeepEmptyParts);
+
+    QHash<QString, MeasuredParagraph> previous;
+    previous.swap(measured_);
+    for (const QString &paragraph: qAsConst(paragraphs_)) {
+        if (const auto it = previous.find(paragraph); it != previous.end()) {
+            measured_.insert(paragraph, std::move(it.value()));
+            previous.erase(it);
+        }
+    }
+}
+
+QStringList TextLineBreaker::PendingParagraphs() const {
+    QStringList pending;
+    QSet<QString> seen;
+    for (const QString &paragraph: paragraphs_) {
+        if (!measured_.contains(paragraph) && !seen.contains(paragraph)) {
+            seen.insert(paragraph);
+            pending.append(paragraph);
+        }
+    }
+    return pending;
+}
+
+void TextLineBreaker::MeasurePending() {
+    if (word_advances_.size() > kMaxCachedWords) {
+        word_advances_.clear();
+    }
+
+    const QFontMetrics metrics(font_);
+    for (const QString &paragraph: PendingParagraphs()) {
+        measured_.insert(paragraph, MeasureParagraph(paragraph, metrics, word_advances_));
+    }
+}
+
+void TextLineBreaker::AddMeasuredParagraphs(const QVector<MeasuredParagraph> &paragraphs) {
+    for (const MeasuredParagraph &paragraph: paragraphs) {
+        measured_.insert(paragraph.text, paragraph);
+    }
+}
+
+TextLineBreaker::MeasuredParagraph TextLineBreaker::MeasureParagraph(const QString &text,
+                                                                     const QFontMetrics &metrics,
+                                                                     QHash<QString, int> &word_advances) {
+    MeasuredParagraph paragraph;
+    paragraph.text = text;
+
+    const int length = text.length();
+    int index = 0;
+    while (index < length) {
+        while (index < length && text[index] == ' ') {
+            ++index;
+        }
+        const int start = index;
+        while (index < length && text[index] != ' ') {
+            ++index;
+        }
+        if (index == start) {
+            break;
+        }
+
+        const QString word = text.mid(start, index - start);
+        auto advance = word_advances.find(word);
+        if (advance == word_advances.end()) {
+            advance = word_advances.insert(word, metrics.horizontalAdvance(word));
+        }
+        paragraph.words.append(Word{start, index - start, advance.value()});
+    }
+    return paragraph;
+}
+
+bool TextLineBreaker::Layout(const int available_width, QStringList &lines, int &max_line_width) {
+    lines.clear();
+    max_line_width = 0;
+
+    for (const QString &text: qAsConst(paragraphs_)) {
+        const auto paragraph = measured_.find(text);
+        if (paragraph == measured_.end()) {
+            return false;
+        }
+        if (paragraph->wrap_width != available_width) {
+            BreakParagraph(*paragraph, available_width);
+        }
+        lines.append(paragraph->lines);
+        max_line_width = qMax(max_line_width, paragraph->max_line_width);
+    }
+    return true;
+}
+
+void TextLineBreaker::BreakParagraph(MeasuredParagraph &paragraph, const int available_width) {
+    paragraph.wrap_width = available_width;
+    paragraph.lines.clear();
+    paragraph.max_line_width = 0;
+
+    if (paragraph.text.isEmpty()) {
+        paragraph.lines.append(QString());
+        return;
+    }
+
+    QString line;
+    int line_width = 0;
+    const auto flush_line = [&paragraph, &line, &line_width] {
+        paragraph.lines.append(line);
+        paragraph.max_line_width = qMax(paragraph.max_line_width, line_width);
+        line.clear();
+        line_width = 0;
+    };
+
+    for (const Word &word: qAsConst(paragraph.words)) {
+        const QStringRef word_text = paragraph.text.midRef(word.start, word.length);
+        if (line.isEmpty() && word.advance <= available_width) {
+            line = word_text.toString();
+            line_width = word.advance;
+            continue;
+        }
+        if (!line.isEmpty() && line_width + space_advance_ + word.advance <= available_width) {
+            line += ' ';
+            line += word_text;
+            line_width += space_advance_ + word.advance;
+            continue;
+        }
+
+        if (!line.isEmpty()) {
+            flush_line();
+        }
+        if (word.advance <= available_width) {
+            line = word_text.toString();
+            line_width = word.advance;
+            continue;
+        }
+
+        // an over-long word is broken between characters, its last part starts the next line
+        for (const QChar character: word_text) {
+            const int advance = CharacterAdvance(character);
+            // a character wider than the whole line still gets a line of its own, never an empty one before it
+            if (!line.isEmpty() && line_width + advance > available_width) {
+                flush_line();
+            }
+            line += character;
+            line_width += advance;
+        }
+    }
+
+    if (!line.isEmpty()) {
+        flush_line();
+    }
+}
+
+int TextLineBreaker::CharacterAdvance(const QChar character) {
+    auto advance = character_advances_.find(character);
+    if (advance == character_advances_.end()) {
+        advance = character_advances_.insert(character, QFontMetrics(font_).horizontalAdvance(character));
+    }
+    return advance.value();
+}
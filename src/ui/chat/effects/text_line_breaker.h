@@ -0,0 +1,126 @@
+#ifndef TEXT_LINE_BREAKER_H
+#define TEXT_LINE_BREAKER_H
+
+#include <QFont>
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+
+class QFontMetrics;
+
+/**
+ * @brief Greedy line breaking of plain text into lines fitting a width, in time linear in the text length.
+ *
+ * Text is split into paragraphs (at '\n') and paragraphs into words (at ' '). Every word is measured once;
+ * a line's width is the sum of its word advances plus one space advance between words, so breaking never
+ * measures a growing line again. Words wider than the available width are broken between characters using
+ * cached per-character advances.
+ *
+ * Measured paragraphs are cached by their text together with their lines for the last width:
+ * - a width change re-breaks all paragraphs without measuring anything,
+ * - a text change measures and breaks only the paragraphs that were not in the previous text.
+ *
+ * Measuring may run on a worker thread through the static MeasureParagraph(); its results are handed over
+ * with AddMeasuredParagraphs(). Until every paragraph is measured, Layout() returns the lines of the measured
+ * prefix of the text. An instance itself is not thread-safe.
+ */
+class TextLineBreaker {
+public:
+    /**
+     * @brief A word of a paragraph.
+     */
+    struct Word {
+        int start = 0; ///< Index of the first character in the paragraph.
+        int length = 0; ///< Number of characters.
+        int advance = 0; ///< Horizontal advance in pixels.
+    };
+
+    /**
+     * @brief A measured paragraph and its lines for the last width it was broken at.
+     */
+    struct MeasuredParagraph {
+        QString text; ///< The paragraph text (without the line break).
+        QVector<Word> words; ///< The words, in order.
+        int wrap_width = -1; ///< Width the lines were broken at, -1 if not broken yet.
+        QStringList lines; ///< The lines for wrap_width.
+        int max_line_width = 0; ///< Advance of the widest line.
+    };
+
+    /**
+     * @brief Sets the font used for measuring. Drops all measurements made with a different font.
+     * @param font The font.
+     */
+    void SetFont(const QFont &font);
+
+    /**
+     * @brief Sets the text. Measurements of paragraphs that also occur in the new text are kept.
+     * @param text The text; paragraphs are separated by '\n', words by ' ' (repeated spaces collapse).
+     */
+    void SetText(const QString &text);
+
+    /**
+     * @brief Returns the distinct paragraphs of the text that are not measured yet, in text order.
+     * @return The paragraph texts.
+     */
+    [[nodiscard]] QStringList PendingParagraphs() const;
+
+    /**
+     * @brief Measures all pending paragraphs on the calling (GUI) thread.
+     */
+    void MeasurePending();
+
+    /**
+     * @brief Adds paragraphs measured elsewhere (e.g., on a worker thread with the same font).
+     * @param paragraphs The measured paragraphs.
+     */
+    void AddMeasuredParagraphs(const QVector<MeasuredParagraph> &paragraphs);
+
+    /**
+     * @brief Measures the words of a paragraph. Thread-safe as long as every thread uses its own metrics and cache.
+     * @param text The paragraph text.
+     * @param metrics Metrics of the font.
+     * @param word_advances Cache of word advances, shared by the paragraphs measured with the same metrics.
+     * @return The measured paragraph (not broken yet).
+     */
+    static MeasuredParagraph MeasureParagraph(const QString &text, const QFontMetrics &metrics,
+                                              QHash<QString, int> &word_advances);
+
+    /**
+     * @brief Breaks the measured paragraphs into lines. Paragraphs already broken at this width are reused.
+     * @param available_width The maximum line advance in pixels.
+     * @param lines Receives the lines of all paragraphs up to the first one not measured yet.
+     * @param max_line_width Receives the advance of the widest of these lines.
+     * @return True if the lines cover the whole text.
+     */
+    bool Layout(int available_width, QStringList &lines, int &max_line_width);
+
+private:
+    /**
+     * @brief Breaks one paragraph at a width and stores the lines in it.
+     * @param paragraph The paragraph.
+     * @param available_width The maximum line advance in pixels.
+     */
+    void BreakParagraph(MeasuredParagraph &paragraph, int available_width);
+
+    /**
+     * @brief Returns the cached advance of a character, measuring it on first use.
+     * @param character The character.
+     * @return The horizontal advance in pixels.
+     */
+    int CharacterAdvance(QChar character);
+
+    /** @brief The font of all measurements. */
+    QFont font_;
+    /** @brief Advance of the space between two words. */
+    int space_advance_ = 0;
+    /** @brief The paragraphs of the current text, in order. */
+    QStringList paragraphs_;
+    /** @brief Measured paragraphs of the current text, by paragraph text. */
+    QHash<QString, MeasuredParagraph> measured_;
+    /** @brief Advances of the words measured on the GUI thread. */
+    QHash<QString, int> word_advances_;
+    /** @brief Advances of the characters of over-long words. */
+    QHash<QChar, int> character_advances_;
+};
+
+#endif // TEXT_LINE_BREAKER_H
@@ -7,6 +7,7 @@
 #include <QVBoxLayout>
 
 #include "communication_stream.h"
+#include "../../util/profiling/performance_monitor.h"
 
 StreamDisplay::StreamDisplay(QWidget *parent): QWidget(parent) {
     const auto main_layout = new QVBoxLayout(this);
@@ -17,11 +18,17 @@ StreamDisplay::StreamDisplay(QWidget *parent): QWidget(parent) {
     main_layout->addWidget(communication_stream_, 1);
 
     message_queue_ = QQueue<MessageData>();
-    displayed_progress_messages_ = QMap<QString, StreamMessage *>();
+    displayed_progress_messages_ = QSet<QString>();
+    connect(communication_stream_, &CommunicationStream::messageRemoved, this,
+            &StreamDisplay::OnStreamMessageRemoved);
 
     message_timer_ = new QTimer(this);
     message_timer_->setSingleShot(true);
     connect(message_timer_, &QTimer::timeout, this, &StreamDisplay::ProcessNextQueuedMessage);
+
+    PerformanceMonitor::GetInstance()->RegisterGauge("Stream message queue", this, [this] {
+        return static_cast<qint64>(message_queue_.size());
+    });
 }
 
 void StreamDisplay::SetFrequency(const QString &frequency, const QString &name) {
@@ -36,8 +43,7 @@ void StreamDisplay::SetFrequency(const QString &frequency, const QString &name)
 void StreamDisplay::AddMessage(const QString &message, const QString &message_id,
                                const StreamMessage::MessageType type) {
     if (!message_id.isEmpty() && displayed_progress_messages_.contains(message_id)) {
-        if (StreamMessage *existing_message = displayed_progress_messages_.value(message_id)) {
-            existing_message->UpdateContent(message);
+        if (communication_stream_->UpdateMessage(message_id, message)) {
             return;
         }
         qWarning() << "[STREAM DISPLAY] Removing an invalid indicator from the map for ID:" << message_id;
@@ -102,41 +108,25 @@ void StreamDisplay::ProcessNextQueuedMessage() {
         return;
     }
     const auto [content, sender, id, type, has_attachment] = message_queue_.dequeue();
-    StreamMessage *displayed_message = nullptr;
+    bool updated = false;
 
     if (!id.isEmpty() && displayed_progress_messages_.contains(id)) {
         qWarning() << "[STREAM DISPLAY] Trying to add a message with an ID that already exists in the map:" << id;
-        displayed_message = displayed_progress_messages_.value(id);
-        if (displayed_message) {
-            displayed_message->UpdateContent(content);
-        } else {
+        updated = communication_stream_->UpdateMessage(id, content);
+        if (!updated) {
             displayed_progress_messages_.remove(id);
-            displayed_message = nullptr;
         }
     }
 
-    if (!displayed_message) {
+    if (!updated) {
         if (has_attachment) {
-            displayed_message = communication_stream_->AddMessageWithAttachment(
-                content, sender, type, id);
+            communication_stream_->AddMessageWithAttachment(content, sender, type, id);
         } else {
-            displayed_message = communication_stream_->AddMessage(
-                content, sender, type, id);
+            communication_stream_->AddMessage(content, sender, type, id);
         }
-    }
-
-    if (displayed_message) {
         if (!id.isEmpty()) {
-            if (!displayed_progress_messages_.contains(id)) {
-                displayed_progress_messages_.insert(id, displayed_message);
-                connect(displayed_message, &QObject::destroyed, this,
-                        &StreamDisplay::OnStreamMessageDestroyed);
-            } else {
-                qWarning() << "[STREAM DISPLAY] Progress message with ID " << id << "already exists in the map!";
-            }
+            displayed_progress_messages_.insert(id);
         }
-    } else {
-        qWarning() << "[STREAM DISPLAY] CommunicationStream failed to create/return message widget for ID:" << id;
     }
 
     if (!message_queue_.isEmpty()) {
@@ -145,15 +135,6 @@ void StreamDisplay::ProcessNextQueuedMessage() {
     }
 }
 
-void StreamDisplay::OnStreamMessageDestroyed(const QObject *object) {
-    auto it = displayed_progress_messages_.begin();
-    while (it != displayed_progress_messages_.end()) {
-        if (it.value() == object) {
-            displayed_progress_messages_.erase(it);
-            return;
-        }
-        ++it;
-    }
-    qWarning() <<
-            "[STREAM DISPLAY] Destroyed signal has been received for an object that is not in the progress message map.";
+void StreamDisplay::OnStreamMessageRemoved(const QString &message_id) {
+    displayed_progress_messages_.remove(message_id);
 }
@@ -1,8 +1,8 @@
 #ifndef WAVELENGTH_STREAM_DISPLAY_H
 #define WAVELENGTH_STREAM_DISPLAY_H
 
-#include <QMap>
 #include <QQueue>
+#include <QSet>
 
 #include "stream_message.h"
 
@@ -103,19 +103,17 @@ private slots:
      * @brief Processes the next message from the message_queue_.
      * Dequeues a message, checks if it's an update to an existing progress message.
      * If not, calls the appropriate AddMessage method on CommunicationStream.
-     * If it's a progress message, adds the returned StreamMessage pointer to the
-     * displayed_progress_messages_ map and connects its destroyed() signal.
+     * If it's a progress message, adds its ID to displayed_progress_messages_.
      * Restarts the timer with a random delay if the queue is not empty.
      */
     void ProcessNextQueuedMessage();
 
     /**
-     * @brief Slot called when a StreamMessage associated with a progress ID is destroyed.
-     * Removes the corresponding entry from the displayed_progress_messages_ map to prevent
-     * dangling pointers and incorrect update attempts.
-     * @param object Pointer to the QObject that was destroyed (the StreamMessage).
+     * @brief Slot called when CommunicationStream removes a message with a progress ID.
+     * Removes the ID from displayed_progress_messages_, so later messages with it are added anew.
+     * @param message_id The ID of the removed message.
      */
-    void OnStreamMessageDestroyed(const QObject *object);
+    void OnStreamMessageRemoved(const QString &message_id);
 
 private:
     /** @brief The underlying widget that handles the visual rendering of the stream and messages. */
@@ -124,8 +122,8 @@ private:
     QQueue<MessageData> message_queue_;
     /** @brief Timer controlling the delay between displaying queued messages. */
     QTimer *message_timer_;
-    /** @brief Map tracking currently displayed progress messages by their unique ID to allow updates. */
-    QMap<QString, StreamMessage *> displayed_progress_messages_;
+    /** @brief IDs of the progress messages currently in the stream, whose content is updated in place. */
+    QSet<QString> displayed_progress_messages_;
 };
 
 #endif // WAVELENGTH_STREAM_DISPLAY_H
@@ -7,6 +7,7 @@
 #include <QSequentialAnimationGroup>
 #include <QBitmap>
 #include <QDateTime>
+#include <QGraphicsOpacityEffect>
 #include <QKeyEvent>
 #include <QLabel>
 #include <QPainter>
@@ -22,6 +23,7 @@
 
 #include "../../chat/files/attachments/attachment_placeholder.h"
 #include "../../chat/files/attachments/auto_scaling_attachment.h"
+#include "../../chat/messages/formatter/message_content_parser.h"
 #include "../files/attachment_viewer.h"
 #include "effects/electronic_shutdown_effect.h"
 #include "effects/long_text_display_effect.h"
@@ -43,9 +45,134 @@ StreamMessage::StreamMessage(QString content, QString sender, MessageType type,
     main_layout_->setContentsMargins(45, 35, 45, 30);
     main_layout_->setSpacing(10);
 
+    auto opacity = new QGraphicsOpacityEffect(this);
+    opacity->setOpacity(0.0);
+    setGraphicsEffect(opacity);
+
+    next_button_ = new QPushButton(">", this);
+    next_button_->setFixedSize(25, 25);
+    next_button_->setStyleSheet(
+        "QPushButton {"
+        "  background-color: rgba(0, 200, 255, 0.3);"
+        "  color: #00ffff;"
+        "  border: 1px solid #00ccff;"
+        "  border-radius: 3px;"
+        "  font-weight: bold;"
+        "  font-size: 12pt;"
+        "  padding: 0px 0px 1px 0px;"
+        "}"
+        "QPushButton:hover { background-color: rgba(0, 200, 255, 0.5); }"
+        "QPushButton:pressed { background-color: rgba(0, 200, 255, 0.7); }");
+    next_button_->hide();
+
+    prev_button_ = new QPushButton("<", this);
+    prev_button_->setFixedSize(25, 25);
+    prev_button_->setStyleSheet(next_button_->styleSheet());
+    prev_button_->hide();
+
+    mark_read_button = new QPushButton(this);
+    mark_read_button->setFixedSize(25, 25);
+
+    auto icon_color = QColor("#00ffcc");
+    QSize icon_size(20, 20);
+
+    QIcon check_icon = CreateColoredSvgIcon(":/resources/icons/checkmark.svg", icon_color, icon_size);
+
+    if (!check_icon.isNull()) {
+        mark_read_button->setIcon(check_icon);
+    } else {
+        qWarning() << "[STREAM MESSAGE] Cannot create a colored checkmark.svg icon!";
+        mark_read_button->setText("✓");
+    }
+
+    mark_read_button->setStyleSheet(
+        "QPushButton {"
+        "  background-color: rgba(0, 255, 150, 0.3);"
+        "  border: 1px solid #00ffcc;"
+        "  border-radius: 3px;"
+        "}"
+        "QPushButton:hover { background-color: rgba(0, 255, 150, 0.5); }"
+        "QPushButton:pressed { background-color: rgba(0, 255, 150, 0.7); }");
+    mark_read_button->hide();
+
+    connect(mark_read_button, &QPushButton::clicked, this, &StreamMessage::MarkAsRead);
+
+    StartGlowPulse();
+
+
+    BuildContent();
+}
+
+StreamMessage::~StreamMessage() {
+    delete shutdown_effect_;
+}
+
+void StreamMessage::Rebind(QString content, QString sender, const MessageType type, QString message_id) {
+    ReleaseContent();
+
+    message_id_ = std::move(message_id);
+    content_ = std::move(content);
+    sender_ = std::move(sender);
+    type_ = type;
+    opacity_ = 0.0;
+    glow_intensity_ = 0.8;
+    shutdown_progress_ = 0.0;
+    is_read_ = false;
+
+    const auto opacity = new QGraphicsOpacityEffect(this);
+    opacity->setOpacity(0.0);
+    setGraphicsEffect(opacity);
+
+    setMinimumSize(400, 120);
+    setMaximumSize(600, QWIDGETSIZE_MAX);
+    next_button_->hide();
+    prev_button_->hide();
+    mark_read_button->hide();
+
+    BuildContent();
+    StartGlowPulse();
+}
+
+void StreamMessage::StartGlowPulse() {
+    AnimationClock *clock = AnimationClock::GetInstance();
+    clock->Unsubscribe(animation_subscription_);
+    // the glow pulse is decoration only, it pauses while the application is idle
+    animation_subscription_ = clock->Subscribe(this, 50, [this] {
+        UpdateAnimation();
+        return true;
+    });
+}
+
+void StreamMessage::ReleaseContent() {
+    for (QAbstractAnimation *animation: findChildren<QAbstractAnimation *>(QString(), Qt::FindDirectChildrenOnly)) {
+        animation->stop();
+    }
+    AnimationClock::GetInstance()->Unsubscribe(animation_subscription_);
+    animation_subscription_ = 0;
+    if (shutdown_effect_) {
+        shutdown_effect_->hide();
+    }
+
+    for (QWidget *content_widget: {
+             static_cast<QWidget *>(text_display_), static_cast<QWidget *>(scroll_area_),
+             static_cast<QWidget *>(content_label_), attachment_widget_
+         }) {
+        if (content_widget) {
+            main_layout_->removeWidget(content_widget);
+            delete content_widget;
+        }
+    }
+    text_display_ = nullptr;
+    scroll_area_ = nullptr;
+    long_text_display_ = nullptr;
+    content_label_ = nullptr;
+    attachment_widget_ = nullptr;
+}
+
+void StreamMessage::BuildContent() {
     CleanupContent();
 
-    bool has_attachment = content_.contains("placeholder");
+    bool has_attachment = placeholder_.IsValid();
     bool is_long_message = clean_content_.length() > 500;
 
     if (!has_attachment) {
@@ -109,63 +236,6 @@ StreamMessage::StreamMessage(QString content, QString sender, MessageType type,
         main_layout_->addWidget(content_label_);
     }
 
-    auto opacity = new QGraphicsOpacityEffect(this);
-    opacity->setOpacity(0.0);
-    setGraphicsEffect(opacity);
-
-    next_button_ = new QPushButton(">", this);
-    next_button_->setFixedSize(25, 25);
-    next_button_->setStyleSheet(
-        "QPushButton {"
-        "  background-color: rgba(0, 200, 255, 0.3);"
-        "  color: #00ffff;"
-        "  border: 1px solid #00ccff;"
-        "  border-radius: 3px;"
-        "  font-weight: bold;"
-        "  font-size: 12pt;"
-        "  padding: 0px 0px 1px 0px;"
-        "}"
-        "QPushButton:hover { background-color: rgba(0, 200, 255, 0.5); }"
-        "QPushButton:pressed { background-color: rgba(0, 200, 255, 0.7); }");
-    next_button_->hide();
-
-    prev_button_ = new QPushButton("<", this);
-    prev_button_->setFixedSize(25, 25);
-    prev_button_->setStyleSheet(next_button_->styleSheet());
-    prev_button_->hide();
-
-    mark_read_button = new QPushButton(this);
-    mark_read_button->setFixedSize(25, 25);
-
-    auto icon_color = QColor("#00ffcc");
-    QSize icon_size(20, 20);
-
-    QIcon check_icon = CreateColoredSvgIcon(":/resources/icons/checkmark.svg", icon_color, icon_size);
-
-    if (!check_icon.isNull()) {
-        mark_read_button->setIcon(check_icon);
-    } else {
-        qWarning() << "[STREAM MESSAGE] Cannot create a colored checkmark.svg icon!";
-        mark_read_button->setText("✓");
-    }
-
-    mark_read_button->setStyleSheet(
-        "QPushButton {"
-        "  background-color: rgba(0, 255, 150, 0.3);"
-        "  border: 1px solid #00ffcc;"
-        "  border-radius: 3px;"
-        "}"
-        "QPushButton:hover { background-color: rgba(0, 255, 150, 0.5); }"
-        "QPushButton:pressed { background-color: rgba(0, 255, 150, 0.7); }");
-    mark_read_button->hide();
-
-    connect(mark_read_button, &QPushButton::clicked, this, &StreamMessage::MarkAsRead);
-
-    animation_timer_ = new QTimer(this);
-    connect(animation_timer_, &QTimer::timeout, this, &StreamMessage::UpdateAnimation);
-    animation_timer_->start(50);
-
-
     if (scroll_area_) {
         AdjustScrollAreaStyle();
         QTimer::singleShot(100, this, &StreamMessage::UpdateScrollAreaMaxHeight);
@@ -208,29 +278,11 @@ void StreamMessage::SetShutdownProgress(const qreal progress) {
 }
 
 void StreamMessage::AddAttachment(const QString &html) {
-    QString type, attachment_id, mime_type, filename;
-
-    if (html.contains("video-placeholder")) {
-        type = "video";
-        attachment_id = ExtractAttribute(html, "data-attachment-id");
-        mime_type = ExtractAttribute(html, "data-mime-type");
-        filename = ExtractAttribute(html, "data-filename");
-    } else if (html.contains("audio-placeholder")) {
-        type = "audio";
-        attachment_id = ExtractAttribute(html, "data-attachment-id");
-        mime_type = ExtractAttribute(html, "data-mime-type");
-        filename = ExtractAttribute(html, "data-filename");
-    } else if (html.contains("gif-placeholder")) {
-        type = "gif";
-        attachment_id = ExtractAttribute(html, "data-attachment-id");
-        mime_type = ExtractAttribute(html, "data-mime-type");
-        filename = ExtractAttribute(html, "data-filename");
-    } else if (html.contains("image-placeholder")) {
-        type = "image";
-        attachment_id = ExtractAttribute(html, "data-attachment-id");
-        mime_type = ExtractAttribute(html, "data-mime-type");
-        filename = ExtractAttribute(html, "data-filename");
-    } else {
+    // the content was parsed when the message was built, so only a different html is parsed again
+    const MessageContentParser::Placeholder placeholder =
+            html == content_ ? placeholder_ : MessageContentParser::Parse(html).placeholder;
+    const QString &type = placeholder.type;
+    if (type != "video" && type != "audio" && type != "gif" && type != "image") {
         return;
     }
 
@@ -245,15 +297,14 @@ void StreamMessage::AddAttachment(const QString &html) {
     setMaximumWidth(QWIDGETSIZE_MAX);
 
     const auto attachment_widget = new AttachmentPlaceholder(
-        filename, type, this);
-    attachment_widget->SetAttachmentReference(attachment_id, mime_type);
+        placeholder.filename, type, this);
+    attachment_widget->SetAttachmentReference(placeholder.attachment_id, placeholder.mime_type);
 
     attachment_widget_ = attachment_widget;
     main_layout_->addWidget(attachment_widget_);
 
     attachment_widget->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Preferred);
 
-    CleanupContent();
     if (content_label_) {
         content_label_->setText(clean_content_);
     }
@@ -463,13 +514,20 @@ void StreamMessage::UpdateScrollAreaMaxHeight() const {
 }
 
 void StreamMessage::StartShutdownAnimation() {
-    if (graphicsEffect() && graphicsEffect() != shutdown_effect_) {
-        delete graphicsEffect();
+    if (!parentWidget()) {
+        hide();
+        emit hidden();
+        return;
     }
 
-    shutdown_effect_ = new ElectronicShutdownEffect(this);
-    shutdown_effect_->SetProgress(0.0);
-    setGraphicsEffect(shutdown_effect_);
+    if (!shutdown_effect_) {
+        shutdown_effect_ = new ElectronicShutdownEffect(parentWidget());
+    }
+    // the overlay plays the animation on a snapshot, the message stops painting until it is hidden
+    shutdown_effect_->Start(this);
+    SetOpacity(0.0);
+    AnimationClock::GetInstance()->Unsubscribe(animation_subscription_);
+    animation_subscription_ = 0;
 
     const auto shutdown_animation = new QPropertyAnimation(this, "shutdownProgress");
     shutdown_animation->setDuration(1200);
@@ -478,6 +536,9 @@ void StreamMessage::StartShutdownAnimation() {
     shutdown_animation->setEasingCurve(QEasingCurve::InQuad);
 
     connect(shutdown_animation, &QPropertyAnimation::finished, this, [this] {
+        if (shutdown_effect_) {
+            shutdown_effect_->hide();
+        }
         hide();
         emit hidden();
     });
@@ -730,18 +791,6 @@ void StreamMessage::AdjustScrollAreaStyle() const {
     }
 }
 
-QString StreamMessage::ExtractAttribute(const QString &html, const QString &attribute) {
-    int attribute_position = html.indexOf(attribute + "='");
-    if (attribute_position >= 0) {
-        attribute_position += attribute.length() + 2;
-        const int endPos = html.indexOf("'", attribute_position);
-        if (endPos >= 0) {
-            return html.mid(attribute_position, endPos - attribute_position);
-        }
-    }
-    return QString();
-}
-
 void StreamMessage::StartLongMessageClosingAnimation() {
     const auto animation_group = new QSequentialAnimationGroup(this);
 
@@ -774,17 +823,15 @@ void StreamMessage::StartLongMessageClosingAnimation() {
 }
 
 void StreamMessage::ProcessImageAttachment(const QString &html) {
-    const QString attachment_id = ExtractAttribute(html, "data-attachment-id");
-    const QString mime_type = ExtractAttribute(html, "data-mime-type");
-    const QString filename = ExtractAttribute(html, "data-filename");
+    const MessageContentParser::Placeholder placeholder = MessageContentParser::Parse(html).placeholder;
 
     const auto container = new QWidget(this);
     const auto container_layout = new QVBoxLayout(container);
     container_layout->setContentsMargins(5, 5, 5, 5);
 
     const auto placeholder_widget = new AttachmentPlaceholder(
-        filename, "image", container);
-    placeholder_widget->SetAttachmentReference(attachment_id, mime_type);
+        placeholder.filename, "image", container);
+    placeholder_widget->SetAttachmentReference(placeholder.attachment_id, placeholder.mime_type);
 
     container_layout->addWidget(placeholder_widget);
 
@@ -795,17 +842,15 @@ void StreamMessage::ProcessImageAttachment(const QString &html) {
 }
 
 void StreamMessage::ProcessGifAttachment(const QString &html) {
-    const QString attachment_id = ExtractAttribute(html, "data-attachment-id");
-    const QString mime_type = ExtractAttribute(html, "data-mime-type");
-    const QString filename = ExtractAttribute(html, "data-filename");
+    const MessageContentParser::Placeholder placeholder = MessageContentParser::Parse(html).placeholder;
 
     const auto container = new QWidget(this);
     const auto container_layout = new QVBoxLayout(container);
     container_layout->setContentsMargins(5, 5, 5, 5);
 
     const auto placeholder_widget = new AttachmentPlaceholder(
-        filename, "gif", container);
-    placeholder_widget->SetAttachmentReference(attachment_id, mime_type);
+        placeholder.filename, "gif", container);
+    placeholder_widget->SetAttachmentReference(placeholder.attachment_id, placeholder.mime_type);
 
     container_layout->addWidget(placeholder_widget);
 
@@ -816,17 +861,15 @@ void StreamMessage::ProcessGifAttachment(const QString &html) {
 }
 
 void StreamMessage::ProcessAudioAttachment(const QString &html) {
-    const QString attachment_id = ExtractAttribute(html, "data-attachment-id");
-    const QString mime_type = ExtractAttribute(html, "data-mime-type");
-    const QString filename = ExtractAttribute(html, "data-filename");
+    const MessageContentParser::Placeholder placeholder = MessageContentParser::Parse(html).placeholder;
 
     const auto container = new QWidget(this);
     const auto container_layout = new QVBoxLayout(container);
     container_layout->setContentsMargins(5, 5, 5, 5);
 
     const auto placeholder_widget = new AttachmentPlaceholder(
-        filename, "audio", container);
-    placeholder_widget->SetAttachmentReference(attachment_id, mime_type);
+        placeholder.filename, "audio", container);
+    placeholder_widget->SetAttachmentReference(placeholder.attachment_id, placeholder.mime_type);
 
     container_layout->addWidget(placeholder_widget);
 
@@ -837,17 +880,15 @@ void StreamMessage::ProcessAudioAttachment(const QString &html) {
 }
 
 void StreamMessage::ProcessVideoAttachment(const QString &html) {
-    const QString attachment_id = ExtractAttribute(html, "data-attachment-id");
-    const QString mime_type = ExtractAttribute(html, "data-mime-type");
-    const QString filename = ExtractAttribute(html, "data-filename");
+    const MessageContentParser::Placeholder placeholder = MessageContentParser::Parse(html).placeholder;
 
     const auto container = new QWidget(this);
     const auto container_layout = new QVBoxLayout(container);
     container_layout->setContentsMargins(5, 5, 5, 5);
 
     const auto placeholder_widget = new AttachmentPlaceholder(
-        filename, "video", container);
-    placeholder_widget->SetAttachmentReference(attachment_id, mime_type);
+        placeholder.filename, "video", container);
+    placeholder_widget->SetAttachmentReference(placeholder.attachment_id, placeholder.mime_type);
 
     container_layout->addWidget(placeholder_widget);
 
@@ -858,39 +899,9 @@ void StreamMessage::ProcessVideoAttachment(const QString &html) {
 }
 
 void StreamMessage::CleanupContent() {
-    clean_content_ = content_;
-
-    clean_content_.remove(QRegExp("<[^>]*>"));
-
-    if (content_.contains("placeholder")) {
-        const int placeholder_start = content_.indexOf("<div class='");
-        if (placeholder_start >= 0) {
-            const int placeholder_end = content_.indexOf("</div>", placeholder_start);
-            if (placeholder_end > 0) {
-                const QString before = clean_content_.left(placeholder_start);
-                const QString after = clean_content_.mid(placeholder_end + 6);
-                clean_content_ = before.trimmed() + " " + after.trimmed();
-            }
-        }
-    }
-
-    clean_content_.replace("&nbsp;", " ");
-    clean_content_.replace("&lt;", "<");
-    clean_content_.replace("&gt;", ">");
-    clean_content_.replace("&amp;", "&");
-
-    if (clean_content_.length() > 300) {
-        clean_content_.replace("\n\n", "||PARAGRAPH||");
-        clean_content_ = clean_content_.simplified();
-        clean_content_.replace("||PARAGRAPH||", "\n\n");
-
-        clean_content_.replace(". ", ".\n");
-        clean_content_.replace("? ", "?\n");
-        clean_content_.replace("! ", "!\n");
-        clean_content_.replace(":\n", ": ");
-    } else {
-        clean_content_ = clean_content_.simplified();
-    }
+    MessageContentParser::Content content = MessageContentParser::Parse(content_);
+    clean_content_ = MessageContentParser::FormatForDisplay(content.text);
+    placeholder_ = std::move(content.placeholder);
 }
 
 void StreamMessage::UpdateLayout() const {
@@ -1,8 +1,12 @@
 #ifndef STREAM_MESSAGE_H
 #define STREAM_MESSAGE_H
 
+#include <QPointer>
 #include <QWidget>
 
+#include "../../chat/messages/formatter/message_content_parser.h"
+#include "../../util/animation_clock.h"
+
 class ElectronicShutdownEffect;
 class LongTextDisplayEffect;
 class QScrollArea;
@@ -22,6 +26,8 @@ class AttachmentViewer;
  * For short messages, it uses CyberTextDisplay for a typing reveal effect.
  * For long messages, it uses CyberLongTextDisplay within a QScrollArea.
  * It also manages navigation buttons (Next/Previous) and a "Mark as Read" button.
+ * CommunicationStream realizes widgets only for displayed messages and recycles them: Rebind() gives
+ * the widget (its chrome, buttons and timer) a new message, ReleaseContent() frees the content widgets.
  */
 class StreamMessage final : public QWidget {
     Q_OBJECT
@@ -69,6 +75,28 @@ public:
     explicit StreamMessage(QString content, QString sender, MessageType type, QString message_id = QString(),
                            QWidget *parent = nullptr);
 
+    /**
+     * @brief Destructor. Deletes the shutdown overlay, which is owned by the parent widget.
+     */
+    ~StreamMessage() override;
+
+    /**
+     * @brief Turns a recycled widget into the widget of another message.
+     * Releases the previous content, resets the animation state and the size constraints,
+     * and builds the content widgets for the new message.
+     * @param content The message content (can be plain text or HTML with attachment placeholders).
+     * @param sender The identifier of the message sender ("SYSTEM" for system messages).
+     * @param type The type of the message (Received, Transmitted, System).
+     * @param message_id Optional unique identifier, used for progress updates.
+     */
+    void Rebind(QString content, QString sender, MessageType type, QString message_id = QString());
+
+    /**
+     * @brief Stops running animations and the glow pulse and deletes the content widgets (text effects,
+     * scroll area, attachment with its media), so a widget waiting for reuse holds no content.
+     */
+    void ReleaseContent();
+
     /**
      * @brief Updates the content of an existing message, typically used for progress updates.
      * Cleans the new content, updates the appropriate display widget (CyberTextDisplay, CyberLongTextDisplay, or QLabel),
@@ -148,7 +176,8 @@ public:
 
     /**
      * @brief Starts the electronic shutdown closing animation.
-     * Applies the ElectronicShutdownEffect and animates its progress.
+     * Covers the message with an ElectronicShutdownEffect overlay started on a snapshot of it, makes the message
+     * itself transparent and animates the overlay's progress.
      * Hides the widget and emits hidden() upon completion.
      */
     void StartShutdownAnimation();
@@ -216,7 +245,7 @@ protected:
 
 private slots:
     /**
-     * @brief Slot called by animation_timer_ to update subtle background animations (e.g., glow pulsing).
+     * @brief Tick of the animation clock updating subtle background animations (e.g., glow pulsing).
      */
     void UpdateAnimation();
 
@@ -226,14 +255,6 @@ private slots:
     void AdjustScrollAreaStyle() const;
 
 private:
-    /**
-     * @brief Static utility function to extract the value of an HTML attribute from a string.
-     * @param html The HTML string.
-     * @param attribute The name of the attribute to extract (e.g., "data-attachment-id").
-     * @return The attribute's value, or an empty string if not found.
-     */
-    static QString ExtractAttribute(const QString &html, const QString &attribute);
-
     /**
      * @brief Starts a simpler closing animation (glitch/fade) used specifically for long messages displayed in a scroll area.
      */
@@ -252,8 +273,20 @@ private:
     void ProcessVideoAttachment(const QString &html);
 
     /**
-     * @brief Cleans the message content by removing HTML tags and placeholders, and decoding HTML entities.
-     * Updates the clean_content_ member variable. Applies specific formatting for long text.
+     * @brief Creates the content widgets for content_: a text reveal effect for short messages, a scroll area
+     * with a long text effect for long ones, or a rich text label for messages with attachments.
+     */
+    void BuildContent();
+
+    /**
+     * @brief Subscribes the glow pulse (UpdateAnimation) to the animation clock, replacing a previous subscription.
+     */
+    void StartGlowPulse();
+
+    /**
+     * @brief Cleans the message content by removing HTML tags and placeholders, and decoding HTML entities,
+     * in one pass of MessageContentParser. Updates clean_content_ (with the formatting for long text)
+     * and placeholder_.
      */
     void CleanupContent();
 
@@ -265,6 +298,7 @@ private:
     QString message_id_; ///< Unique identifier for the message (optional).
     QString content_; ///< Original message content (may contain HTML).
     QString clean_content_; ///< Processed message content (plain text).
+    MessageContentParser::Placeholder placeholder_; ///< Attachment placeholder of content_ (if any).
     QString sender_; ///< Sender identifier.
     MessageType type_; ///< Message type (Received, Transmitted, System).
     qreal opacity_; ///< Current opacity level (for animation).
@@ -275,13 +309,14 @@ private:
     QVBoxLayout *main_layout_; ///< Main vertical layout.
     QPushButton *next_button_; ///< Button to navigate to the next message.
     QPushButton *prev_button_; ///< Button to navigate to the previous message.
-    QTimer *animation_timer_; ///< Timer for subtle background animations.
+    AnimationClock::SubscriptionId animation_subscription_ = 0; ///< Animation clock tick of the glow pulse.
     QWidget *attachment_widget_ = nullptr; ///< Widget holding the attachment placeholder/viewer.
     QLabel *content_label_ = nullptr; ///< Label for displaying short text content (if no CyberTextDisplay).
     TextDisplayEffect *text_display_ = nullptr; ///< Widget for animated text reveal (short messages).
     QScrollArea *scroll_area_ = nullptr; ///< Scroll area for long messages.
     LongTextDisplayEffect *long_text_display_ = nullptr; ///< Widget for displaying long text within scroll area.
-    ElectronicShutdownEffect *shutdown_effect_ = nullptr; ///< Graphics effect for electronic shutdown animation.
+    /** @brief Overlay playing the electronic shutdown animation (a sibling of the message, reused by Rebind()). */
+    QPointer<ElectronicShutdownEffect> shutdown_effect_;
 };
 
 #endif // STREAM_MESSAGE_H
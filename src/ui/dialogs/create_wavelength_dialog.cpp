@@ -1,23 +1,18 @@
 #include "create_wavelength_dialog.h"
 
-#include <qeventloop.h>
 #include <QFormLayout>
 #include <QLabel>
-#include <QFutureWatcher>
 #include <QGraphicsOpacityEffect>
-#include <QJsonDocument>
-#include <QUrlQuery>
-#include <QNetworkReply>
 #include <QPainter>
 #include <QPainterPath>
 #include <QParallelAnimationGroup>
 #include <QPropertyAnimation>
 #include <QRandomGenerator>
-#include <qtconcurrentrun.h>
 #include <QVBoxLayout>
 
 #include "../../app/wavelength_config.h"
 #include "../../app/managers/translation_manager.h"
+#include "../../services/frequency_allocator.h"
 #include "../../session/session_coordinator.h"
 #include "../../ui/dialogs/animated_dialog.h"
 #include "../../ui/buttons/cyber_button.h"
@@ -175,9 +170,6 @@ CreateWavelengthDialog::CreateWavelengthDialog(QWidget *parent): AnimatedDialog(
     connect(generate_button_, &QPushButton::clicked, this, &CreateWavelengthDialog::TryGenerate);
     connect(cancel_button_, &QPushButton::clicked, this, &QDialog::reject);
 
-    frequency_watcher_ = new QFutureWatcher<QString>(this);
-    connect(frequency_watcher_, &QFutureWatcher<double>::finished, this, &CreateWavelengthDialog::OnFrequencyFound);
-
     frequency_label_->setText("...");
 
     connect(this, &AnimatedDialog::showAnimationFinished,
@@ -358,23 +350,11 @@ void CreateWavelengthDialog::StartFrequencySearch() {
         translator_->Translate("CreateWavelengthDialog.LoadingIndicator",
                                "SEARCHING FOR AVAILABLE FREQUENCY..."));
 
-    const auto timeout_timer = new QTimer(this);
-    timeout_timer->setSingleShot(true);
-    timeout_timer->setInterval(5000); // 5-second searching limit
-    connect(timeout_timer, &QTimer::timeout, [this] {
-        if (frequency_watcher_ && frequency_watcher_->isRunning()) {
-            loading_indicator_->setText(
-                translator_->Translate("CreateWavelengthDialog.DefaultIndicator", "USING DEFAULT FREQUENCY..."));
-            frequency_ = "130.0";
-            frequency_found_ = true;
-            OnFrequencyFound();
-            qDebug() << "[WVLGTH-DIALOG] Timeout when searching for frequencies - Fallback to the default value.";
-        }
-    });
-    timeout_timer->start();
-
-    const QFuture<QString> future = QtConcurrent::run(&CreateWavelengthDialog::FindLowestAvailableFrequency);
-    frequency_watcher_->setFuture(future);
+    // usually answered straight from the prefetched candidates; the allocator handles timeouts and fallbacks
+    FrequencyAllocator *allocator = FrequencyAllocator::GetInstance();
+    connect(allocator, &FrequencyAllocator::frequencyReady,
+            this, &CreateWavelengthDialog::OnFrequencyFound, Qt::UniqueConnection);
+    allocator->RequestFrequency();
 }
 
 void CreateWavelengthDialog::TryGenerate() {
@@ -398,18 +378,18 @@ void CreateWavelengthDialog::TryGenerate() {
     is_generating = false;
 }
 
-void CreateWavelengthDialog::OnFrequencyFound() {
-    const auto timeout_timer = findChild<QTimer *>();
-    if (timeout_timer && timeout_timer->isActive()) {
-        timeout_timer->stop();
-    }
+void CreateWavelengthDialog::OnFrequencyFound(const QString &frequency, const bool verified) {
+    disconnect(FrequencyAllocator::GetInstance(), &FrequencyAllocator::frequencyReady,
+               this, &CreateWavelengthDialog::OnFrequencyFound);
+    if (frequency_found_) return;
 
-    if (frequency_watcher_ && frequency_watcher_->isFinished()) {
-        frequency_ = frequency_watcher_->result();
-    } else {
-        frequency_ = 130.0;
+    if (!verified) {
+        loading_indicator_->setText(
+            translator_->Translate("CreateWavelengthDialog.DefaultIndicator", "USING DEFAULT FREQUENCY..."));
+        qDebug() << "[WVLGTH-DIALOG] Frequency search failed - Using fallback frequency" << frequency;
     }
 
+    frequency_ = frequency;
     frequency_found_ = true;
 
     QString frequency_text = frequency_;
@@ -480,55 +460,6 @@ QString CreateWavelengthDialog::FormatFrequencyText(const double frequency) {
     return QString::number(display_value, 'f', 1) + unit_text;
 }
 
-// ReSharper disable once CppDFAConstantFunctionResult
-QString CreateWavelengthDialog::FindLowestAvailableFrequency() {
-    const WavelengthConfig *config = WavelengthConfig::GetInstance();
-    const QString preferred_frequency = config->GetPreferredStartFrequency();
-
-    QNetworkAccessManager manager;
-    QEventLoop loop;
-
-    const QString server_address = config->GetRelayServerAddress();
-    const int server_port = config->GetRelayServerPort();
-
-    const QString base_url_string = QString("http://%1:%2/api/next-available-frequency").arg(server_address).
-            arg(server_port);
-    QUrl url(base_url_string);
-
-    QUrlQuery query;
-    query.addQueryItem("preferredStartFrequency", preferred_frequency);
-    url.setQuery(query);
-
-    const QNetworkRequest request(url);
-
-    QNetworkReply *reply = manager.get(request);
-
-    connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-
-    loop.exec();
-
-    QString result_frequency = "130.0";
-
-    if (reply->error() == QNetworkReply::NoError) {
-        const QByteArray response_data = reply->readAll();
-        const QJsonDocument document = QJsonDocument::fromJson(response_data);
-        QJsonObject obj = document.object();
-
-        if (obj.contains("frequency") && obj["frequency"].isString()) {
-            result_frequency = obj["frequency"].toString();
-        } else {
-            qDebug() << "[WVLGTH-DIALOG] JSON response parsing error or missing 'frequency' key. Response:" <<
-                    response_data;
-        }
-    } else {
-        qDebug() << "[WVLGTH-DIALOG] Error while communicating with the server:" << reply->errorString();
-    }
-
-    reply->deleteLater();
-
-    return result_frequency;
-}
-
 void CreateWavelengthDialog::InitRenderBuffers() {
     if (!buffers_initialized_ || height() != previous_height_) {
         scanline_buffer_ = QPixmap(width(), 20);
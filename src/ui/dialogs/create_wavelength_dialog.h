@@ -1,7 +1,6 @@
 #ifndef WAVELENGTH_DIALOG_H
 #define WAVELENGTH_DIALOG_H
 
-#include <QFuture>
 #include <QTimer>
 
 #include "animated_dialog.h"
@@ -126,8 +125,9 @@ private slots:
     void ValidateInputs() const;
 
     /**
-     * @brief Starts the asynchronous process of finding the lowest available frequency via the relay server.
-     * Called automatically after the show animation finishes. Sets up a timeout for the search.
+     * @brief Requests a free frequency from the FrequencyAllocator.
+     * Called automatically after the show animation finishes. The allocator answers from its
+     * prefetched cache when possible and handles timeouts and fallbacks itself.
      */
     void StartFrequencySearch();
 
@@ -139,11 +139,13 @@ private slots:
     void TryGenerate();
 
     /**
-     * @brief Slot triggered when the frequency search (FindLowestAvailableFrequency) completes.
-     * Updates the frequency label with the found frequency (or default), hides the loading indicator,
+     * @brief Slot triggered when the FrequencyAllocator answers the frequency request.
+     * Updates the frequency label with the found frequency (or fallback), hides the loading indicator,
      * enables the generate button (if inputs are valid), and triggers animations.
+     * @param frequency The allocated frequency.
+     * @param verified False if the frequency is a fallback used because the server could not be reached.
      */
-    void OnFrequencyFound();
+    void OnFrequencyFound(const QString &frequency, bool verified);
 
     /**
      * @brief Static utility function to format a frequency value (double) into a display string with units (Hz, kHz, MHz).
@@ -153,14 +155,6 @@ private slots:
     static QString FormatFrequencyText(double frequency);
 
 private:
-    /**
-     * @brief Static function executed concurrently to query the relay server for the next available frequency.
-     * Sends an HTTP GET request to the server's API endpoint, optionally providing a preferred starting frequency.
-     * Parses the JSON response to extract the frequency. Returns a default value on error or timeout.
-     * @return The available frequency as a string (e.g., "130.0"), or a default value.
-     */
-    static QString FindLowestAvailableFrequency();
-
     /**
      * @brief Initializes or reinitializes the QPixmap buffer used for rendering the vertical scanline effect.
      * Called when needed by paintEvent, typically on the first paint or after a resize.
@@ -184,8 +178,6 @@ private:
     CyberButton *generate_button_;
     /** @brief Button to cancel the dialog. */
     CyberButton *cancel_button_;
-    /** @brief Watches the QFuture returned by the concurrent frequency search. */
-    QFutureWatcher<QString> *frequency_watcher_;
     /** @brief Timer used to trigger repaints for the vertical scanline animation. */
     QTimer *refresh_timer_;
     /** @brief Stores the frequency found by the server or the default value. */
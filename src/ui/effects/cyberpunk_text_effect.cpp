@@ -2,22 +2,28 @@
 
 #include <QLabel>
 #include <QRandomGenerator>
-#include <QTimer>
 
 CyberpunkTextEffect::CyberpunkTextEffect(QLabel *label, QWidget *parent): QObject(parent), label_(label),
                                                                           original_text_(label->text()) {
     label_->setText("");
     label_->show();
+}
 
-    timer_ = new QTimer(this);
-    connect(timer_, &QTimer::timeout, this, &CyberpunkTextEffect::NextAnimationStep);
+CyberpunkTextEffect::~CyberpunkTextEffect() {
+    AnimationClock::GetInstance()->Unsubscribe(subscription_);
 }
 
 void CyberpunkTextEffect::StartAnimation() {
     phase_ = 0;
     char_index_ = 0;
     glitch_count_ = 0;
-    timer_->start(50);
+
+    AnimationClock *clock = AnimationClock::GetInstance();
+    clock->Unsubscribe(subscription_);
+    subscription_ = clock->Subscribe(label_, 50, [this] {
+        NextAnimationStep();
+        return true;
+    }, true);
 }
 
 void CyberpunkTextEffect::AnimateScanning() {
@@ -94,7 +100,8 @@ void CyberpunkTextEffect::NextAnimationStep() {
             AnimateGlitching();
             break;
         case 3: // end of animation
-            timer_->stop();
+            AnimationClock::GetInstance()->Unsubscribe(subscription_);
+            subscription_ = 0;
             label_->setText(original_text_);
             break;
         default:
@@ -2,7 +2,8 @@
 #define CYBERPUNK_TEXT_EFFECT_H
 
 #include <QObject>
-#include <QTimer>
+
+#include "../../util/animation_clock.h"
 
 class QLabel;
 
@@ -16,7 +17,7 @@ class QLabel;
  * 3. Glitching: A brief final phase where random characters are rapidly inserted and removed from the full text.
  * 4. Final: The animation stops, displaying the original text cleanly.
  *
- * The animation is driven by a QTimer.
+ * The animation is driven by the AnimationClock, ticking only while the label is visible.
  */
 class CyberpunkTextEffect final : public QObject {
     Q_OBJECT
@@ -24,23 +25,28 @@ class CyberpunkTextEffect final : public QObject {
 public:
     /**
      * @brief Constructs a CyberpunkTextEffect.
-     * Stores the target QLabel, hides it initially, and sets up the animation timer.
+     * Stores the target QLabel, hides it initially.
      * @param label Pointer to the QLabel widget to animate.
      * @param parent Optional parent QObject.
      */
     explicit CyberpunkTextEffect(QLabel *label, QWidget *parent = nullptr);
 
+    /**
+     * @brief Destructor. Unsubscribes a running animation from the animation clock.
+     */
+    ~CyberpunkTextEffect() override;
+
     /**
      * @brief Starts the text reveal an animation sequence from the beginning.
-     * Resets the animation phase and character index, then starts the internal timer.
+     * Resets the animation phase and character index, then subscribes the animation steps to the animation clock.
      */
     void StartAnimation();
 
 private slots:
     /**
-     * @brief Slot called periodically by the timer to advance the animation.
+     * @brief Tick of the animation clock advancing the animation.
      * Executes the logic for the current animation phase (scanning, typing, glitching)
-     * by calling the corresponding private Animate* method. Stops the timer when
+     * by calling the corresponding private Animate* method. Unsubscribes when
      * the animation completes.
      */
     void NextAnimationStep();
@@ -71,8 +77,8 @@ private:
     QLabel *label_;
     /** @brief The original text content of the label. */
     QString original_text_;
-    /** @brief Timer driving the animation steps. */
-    QTimer *timer_;
+    /** @brief Animation clock tick driving the animation steps. */
+    AnimationClock::SubscriptionId subscription_ = 0;
     /** @brief Current phase of the animation (0: Scan, 1: Type, 2: Glitch, 3: Done). */
     int phase_ = 0;
     /** @brief Index used during scanning and typing phases to track progress. */
@@ -183,7 +183,8 @@ FloatingEnergySphereWidget::FloatingEnergySphereWidget(const bool is_first_time,
       hint_timer_(new QTimer(this)),
       is_destroying_(false),
       destruction_progress_(0.0f),
-      click_simulation_timer_(new QTimer(this)) {
+      click_simulation_timer_(new QTimer(this)),
+      frame_channel_(PerformanceMonitor::GetInstance()->RegisterChannel("Energy sphere frame")) {
     if constexpr (MAX_IMPACTS > 0) {
         impacts_.resize(MAX_IMPACTS);
     } else {
@@ -238,6 +239,8 @@ FloatingEnergySphereWidget::~FloatingEnergySphereWidget() {
     vao_.destroy();
     delete shader_program_;
     doneCurrent();
+
+    PerformanceMonitor::GetInstance()->ReleaseChannel(frame_channel_);
 }
 
 void FloatingEnergySphereWidget::SetClosable(const bool closable) {
@@ -424,6 +427,7 @@ void FloatingEnergySphereWidget::resizeGL(const int w, int h) {
 }
 
 void FloatingEnergySphereWidget::paintGL() {
+    PerformanceMonitor::GetInstance()->RecordFrame(frame_channel_);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     if (!shader_program_ || !shader_program_->isLinked()) {
@@ -15,6 +15,8 @@
 #include <QtMultimedia/QAudioDecoder>
 #include <QtMultimedia/QAudioBuffer>
 
+#include "../../../../../util/profiling/performance_monitor.h"
+
 /** @brief Maximum number of concurrent impact effects supported by the shader. */
 #define MAX_IMPACTS 5
 
@@ -319,6 +321,8 @@ private:
 
     /** @brief Timer triggering simulated random clicks/impacts on the sphere. */
     QTimer *click_simulation_timer_;
+    /** @brief Performance overlay channel receiving frame-to-frame times. */
+    PerformanceMonitor::Channel *frame_channel_;
 };
 
 #endif // FLOATING_ENERGY_SPHERE_WIDGET_H
@@ -54,6 +54,8 @@ void ShortcutsSettingsWidget::SetupUi() {
 
     for (auto it = default_shortcuts.constBegin(); it != default_shortcuts.constEnd(); ++it) {
         const QString &action_id = it.key();
+        if (action_id.startsWith("Debug.")) continue;
+
         QString description = GetActionDescription(action_id);
         if (description.isEmpty()) {
             qWarning() << "[SHORTCUTS TAB] No description for shortcut action:" << action_id;
@@ -19,6 +19,8 @@
 #include "../chat/style/chat_style.h"
 #include "../../ui/chat/stream_display.h"
 #include "../../storage/wavelength_registry.h"
+#include "../../util/audio_utilities.h"
+#include "../../util/profiling/trace_profiler.h"
 
 ChatView::ChatView(QWidget *parent): QWidget(parent), scanline_opacity_(0.15) {
     setObjectName("chatViewContainer");
@@ -420,12 +422,9 @@ void ChatView::OnPttStopReceiving(const QString &frequency) {
 }
 
 void ChatView::OnAudioDataReceived(const QString &frequency, const QByteArray &audio_data) const {
+    TRACE_ZONE("ChatView::OnAudioDataReceived");
     if (frequency == current_frequency_ && ptt_state_ == Receiving) {
-        if (audio_output_) {
-            qDebug() << "[CHAT VIEW][CLIENT] onAudioDataReceived: Current Audio Output State before write:" <<
-                    audio_output_->
-                    state();
-        } else {
+        if (!audio_output_) {
             qWarning() << "[CHAT VIEW][CLIENT] onAudioDataReceived: m_audioOutput is null!";
             return;
         }
@@ -701,24 +700,7 @@ void ChatView::StopAudioOutput() {
 }
 
 qreal ChatView::CalculateAmplitude(const QByteArray &buffer) const {
-    if (buffer.isEmpty() || audio_format_.sampleSize() != 16 || audio_format_.sampleType() != QAudioFormat::SignedInt) {
-        return 0.0;
-    }
-
-    const auto data = reinterpret_cast<const qint16 *>(buffer.constData());
-    const int sample_count = buffer.size() / (audio_format_.sampleSize() / 8);
-    if (sample_count == 0) return 0.0;
-
-    double sum_of_squares = 0.0;
-    for (int i = 0; i < sample_count; ++i) {
-        const double normalized_sample = static_cast<double>(data[i]) / 32767.0;
-        sum_of_squares += normalized_sample * normalized_sample;
-    }
-
-    const double mean_square = sum_of_squares / sample_count;
-    const double rms = std::sqrt(mean_square);
-
-    return rms;
+    return AudioUtilities::CalculateRmsAmplitude(buffer, audio_format_);
 }
 
 void ChatView::UpdatePttButtonState() const {
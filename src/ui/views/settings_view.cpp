@@ -74,6 +74,12 @@ SettingsView::SettingsView(QWidget *parent)
         if (time_label_) time_label_->setText(QString("TS: %1").arg(timestamp));
     });
     refresh_timer_->start();
+}
+
+SystemOverrideManager *SettingsView::EnsureSystemOverrideManager() {
+    if (system_override_manager_) {
+        return system_override_manager_;
+    }
 
     system_override_manager_ = new SystemOverrideManager(this);
 
@@ -85,6 +91,7 @@ SettingsView::SettingsView(QWidget *parent)
                     setText(translator_->Translate("SettingsView.SystemOverride", "CAUTION: SYSTEM OVERRIDE"));
         }
     });
+    return system_override_manager_;
 }
 
 void SettingsView::SetDebugMode(const bool enabled) {
@@ -158,19 +165,11 @@ void SettingsView::SetupUi() {
         "QWidget { background-color: rgba(10, 25, 40, 180); border: 1px solid #005577; border-radius: 5px; }"
     );
 
-    wavelength_tab_widget_ = new WavelengthSettingsWidget(tab_content_);
-    tab_content_->addWidget(wavelength_tab_widget_); // index 0
-
-    appearance_tab_widget_ = new AppearanceSettingsWidget(tab_content_);
-    tab_content_->addWidget(appearance_tab_widget_); // index 1
-
-    advanced_tab_widget_ = new NetworkSettingsWidget(tab_content_);
-    tab_content_->addWidget(advanced_tab_widget_); // index 2
-
-    shortcuts_tab_widget_ = new ShortcutsSettingsWidget(tab_content_);
-    tab_content_->addWidget(shortcuts_tab_widget_); // index 3
-
-    SetupClassifiedTab(); // index 4
+    // only the first tab is built up front, the rest are placeholders replaced on first visit
+    for (int i = 0; i < tab_names.size(); ++i) {
+        tab_content_->addWidget(new QWidget(tab_content_));
+    }
+    EnsureTabCreated(0);
 
     main_layout->addWidget(tab_content_, 1);
 
@@ -209,7 +208,54 @@ void SettingsView::SetupUi() {
     tab_content_->setCurrentIndex(0);
 }
 
-void SettingsView::SetupClassifiedTab() {
+void SettingsView::EnsureTabCreated(const int tab_index) {
+    if (tab_index < 0 || tab_index >= tab_content_->count()) return;
+
+    QWidget *tab = nullptr;
+    switch (tab_index) {
+        case 0:
+            if (wavelength_tab_widget_) return;
+            wavelength_tab_widget_ = new WavelengthSettingsWidget(tab_content_);
+            wavelength_tab_widget_->LoadSettings();
+            tab = wavelength_tab_widget_;
+            break;
+        case 1:
+            if (appearance_tab_widget_) return;
+            appearance_tab_widget_ = new AppearanceSettingsWidget(tab_content_);
+            appearance_tab_widget_->LoadSettings();
+            tab = appearance_tab_widget_;
+            break;
+        case 2:
+            if (advanced_tab_widget_) return;
+            advanced_tab_widget_ = new NetworkSettingsWidget(tab_content_);
+            advanced_tab_widget_->LoadSettings();
+            tab = advanced_tab_widget_;
+            break;
+        case 3:
+            if (shortcuts_tab_widget_) return;
+            shortcuts_tab_widget_ = new ShortcutsSettingsWidget(tab_content_);
+            shortcuts_tab_widget_->LoadSettings();
+            tab = shortcuts_tab_widget_;
+            break;
+        case 4:
+            if (security_layers_stack_) return;
+            tab = SetupClassifiedTab();
+            break;
+        default:
+            return;
+    }
+
+    const bool was_current = tab_content_->currentIndex() == tab_index;
+    QWidget *placeholder = tab_content_->widget(tab_index);
+    tab_content_->removeWidget(placeholder);
+    placeholder->deleteLater();
+    tab_content_->insertWidget(tab_index, tab);
+    if (was_current) {
+        tab_content_->setCurrentIndex(tab_index);
+    }
+}
+
+QWidget *SettingsView::SetupClassifiedTab() {
     const auto tab = new QWidget(tab_content_);
     const auto layout = new QVBoxLayout(tab);
     layout->setContentsMargins(20, 20, 20, 20);
@@ -301,6 +347,7 @@ void SettingsView::SetupClassifiedTab() {
     override_button_->setEnabled(true);
     connect(override_button_, &QPushButton::clicked, this, [this] {
         qDebug() << "[SETTINGS VIEW] Override button clicked.";
+        EnsureSystemOverrideManager();
 #ifdef Q_OS_WIN
         if (SystemOverrideManager::IsRunningAsAdmin()) {
             qDebug() << "[SETTINGS VIEW] Already running as admin. Initiating sequence directly.";
@@ -393,9 +440,9 @@ void SettingsView::SetupClassifiedTab() {
     });
 
     layout->addStretch();
-    tab_content_->addWidget(tab);
 
     ResetSecurityLayers();
+    return tab;
 }
 
 void SettingsView::SetupNextSecurityLayer() {
@@ -530,6 +577,7 @@ void SettingsView::SwitchToTab(const int tab_index) {
         tab_buttons_[i]->SetActive(i == tab_index);
         tab_buttons_[i]->setChecked(i == tab_index);
     }
+    EnsureTabCreated(tab_index);
     tab_content_->setCurrentIndex(tab_index);
 
     constexpr int classified_tab_index = 4;
@@ -545,7 +593,12 @@ void SettingsView::HandleBackButton() {
 
 
 void SettingsView::ResetSecurityLayers() {
-    if (!security_layers_stack_ || !fingerprint_layer_ || !handprint_layer_ ||
+    if (!security_layers_stack_) {
+        // classified tab has not been opened yet, its layers are reset when they get created
+        return;
+    }
+
+    if (!fingerprint_layer_ || !handprint_layer_ ||
         !security_code_layer_ || !security_question_layer_ || !retina_scan_layer_ ||
         !voice_recognition_layer_ || !typing_test_layer_ || !snake_game_layer_ ||
         !classified_features_widget_) {
@@ -39,8 +39,8 @@ class SettingsView final : public QWidget {
 public:
     /**
      * @brief Constructs the SettingsView.
-     * Initializes the UI, sets up all tabs including the security layers for the CLASSIFIED tab,
-     * connects signals and slots for UI interaction, and starts a timer for updating the displayed time.
+     * Initializes the UI and the first tab, connects signals and slots for UI interaction, and starts
+     * a timer for updating the displayed time. Remaining tabs are built lazily by EnsureTabCreated().
      * @param parent Optional parent widget.
      */
     explicit SettingsView(QWidget *parent = nullptr);
@@ -121,13 +121,28 @@ private:
      */
     void SetupUi();
 
+    /**
+     * @brief Builds the content widget of the given tab if it has not been created yet.
+     * Only the first tab is created with the view; the others (including the CLASSIFIED tab with
+     * its security layers) replace their placeholders on first visit, keeping them off the startup path.
+     * @param tab_index The index of the tab to create.
+     */
+    void EnsureTabCreated(int tab_index);
+
     /**
      * @brief Creates and configures the "CLASSIFIED" tab.
      * Sets up the stacked widget containing all the security layers (Fingerprint, Handprint, etc.)
      * and the final "Access Granted" widget with the system override button. Connects signals
      * for layer completion to advance through the sequence.
+     * @return The tab content widget.
+     */
+    QWidget *SetupClassifiedTab();
+
+    /**
+     * @brief Creates the SystemOverrideManager on first use and connects its signals.
+     * @return Pointer to the SystemOverrideManager owned by this view.
      */
-    void SetupClassifiedTab();
+    SystemOverrideManager *EnsureSystemOverrideManager();
 
     /**
      * @brief Advances to the next security layer in the CLASSIFIED tab sequence.
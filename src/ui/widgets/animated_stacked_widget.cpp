@@ -6,6 +6,7 @@
 #include <QSoundEffect>
 
 #include "gl_transition_widget.h"
+#include "../../util/frame_scheduler.h"
 
 AnimatedStackedWidget::AnimatedStackedWidget(QWidget *parent)
     : QStackedWidget(parent),
@@ -33,6 +34,9 @@ AnimatedStackedWidget::AnimatedStackedWidget(QWidget *parent)
     gl_transition_widget_->hide();
     connect(gl_transition_widget_, &GLTransitionWidget::transitionFinished,
             this, &AnimatedStackedWidget::OnGLTransitionFinished);
+
+    connect(FrameScheduler::GetInstance(), &FrameScheduler::idleChanged,
+            this, &AnimatedStackedWidget::PrefetchLikelyNextSnapshot);
 }
 
 AnimatedStackedWidget::~AnimatedStackedWidget() {
@@ -58,6 +62,7 @@ void AnimatedStackedWidget::SlideToIndex(const int index) {
 
     animation_running_ = true;
     target_index_ = index;
+    likely_next_widget_ = currentWidget();
 
     PrepareAnimation(index);
 }
@@ -78,31 +83,47 @@ void AnimatedStackedWidget::SlideToNextIndex() {
 }
 
 void AnimatedStackedWidget::PrepareAnimation(const int next_index) const {
+    if (gl_transition_widget_->IsAvailable()) {
+        QWidget *current_widget = widget(currentIndex());
+        QWidget *next_widget = widget(next_index);
+
+        current_widget->resize(size());
+        next_widget->resize(size());
+
+        gl_transition_widget_->resize(size());
+        gl_transition_widget_->SetWidgets(current_widget, next_widget);
+
+        gl_transition_widget_->show();
+        gl_transition_widget_->raise();
+
+        current_widget->hide();
+        next_widget->hide();
+
+        GLTransitionWidget::TransitionType type = GLTransitionWidget::kSlide;
+        switch (animation_type_) {
+            case Fade:
+                type = GLTransitionWidget::kFade;
+                break;
+            case Slide:
+                type = GLTransitionWidget::kSlide;
+                break;
+            case SlideAndFade:
+                type = GLTransitionWidget::kSlideAndFade;
+                break;
+            case Push:
+                type = GLTransitionWidget::kPush;
+                break;
+        }
+        gl_transition_widget_->StartTransition(duration_, type);
+        return;
+    }
+
+    // fallback to standard animations
     switch (animation_type_) {
         case Fade:
             AnimateFade(next_index);
             break;
         case Slide:
-            if (gl_transition_widget_) {
-                QWidget *current_widget = widget(currentIndex());
-                QWidget *next_widget = widget(next_index);
-
-                current_widget->resize(size());
-                next_widget->resize(size());
-
-                gl_transition_widget_->resize(size());
-                gl_transition_widget_->SetWidgets(current_widget, next_widget);
-
-                gl_transition_widget_->show();
-                gl_transition_widget_->raise();
-
-                current_widget->hide();
-                next_widget->hide();
-
-                gl_transition_widget_->StartTransition(duration_);
-                return;
-            }
-            // fallback to standard animation
             AnimateSlide(next_index);
             break;
         case SlideAndFade:
@@ -281,3 +302,17 @@ void AnimatedStackedWidget::OnGLTransitionFinished() {
 
     emit currentChanged(currentIndex());
 }
+
+void AnimatedStackedWidget::InvalidateSnapshot(const QWidget *widget) const {
+    gl_transition_widget_->InvalidateSnapshot(widget);
+}
+
+void AnimatedStackedWidget::PrefetchLikelyNextSnapshot(const bool idle) const {
+    if (!idle || animation_running_ || !likely_next_widget_ || likely_next_widget_ == currentWidget()
+        || indexOf(likely_next_widget_) < 0 || !gl_transition_widget_->IsAvailable()) {
+        return;
+    }
+
+    likely_next_widget_->resize(size());
+    gl_transition_widget_->PrefetchSnapshot(likely_next_widget_);
+}
@@ -1,6 +1,7 @@
 #ifndef ANIMATED_STACKED_WIDGET_H
 #define ANIMATED_STACKED_WIDGET_H
 
+#include <QPointer>
 #include <QStackedWidget>
 
 class GLTransitionWidget;
@@ -12,9 +13,10 @@ class QParallelAnimationGroup;
  *
  * This widget enhances the standard QStackedWidget by adding visual animations
  * (like fade, slide, push) when switching between child widgets. It supports
- * different animation types and durations, and can optionally use OpenGL for
- * smoother slide transitions via GLTransitionWidget. It also plays a sound effect
- * during transitions.
+ * different animation types and durations. All of them are rendered by GLTransitionWidget as a shader
+ * blend of two widget snapshots; the widget-moving Animate* methods are the fallback when OpenGL is
+ * unavailable. While the application is idle, the widget shown before the current one (the likely target
+ * of the next transition) is rendered ahead of time. It also plays a sound effect during transitions.
  */
 class AnimatedStackedWidget final : public QStackedWidget {
     Q_OBJECT
@@ -76,6 +78,14 @@ public:
      */
     bool IsAnimating() const { return animation_running_; }
 
+    /**
+     * @brief Drops the snapshot rendered ahead of time for a widget.
+     * Changes that relayout the widget or add or remove children drop it on their own; this is needed for the
+     * rest, such as a line edit's text changing right before a transition to it.
+     * @param widget The widget whose content changed.
+     */
+    void InvalidateSnapshot(const QWidget *widget) const;
+
 public slots:
     /**
      * @brief Initiates an animated transition to the widget at the specified index.
@@ -131,6 +141,13 @@ private slots:
      */
     void OnGLTransitionFinished();
 
+    /**
+     * @brief Slot called when the application enters or leaves the idle state.
+     * On entering it, renders the snapshot of likely_next_widget_ for the next transition.
+     * @param idle True if the application became idle.
+     */
+    void PrefetchLikelyNextSnapshot(bool idle) const;
+
 private:
     /**
      * @brief Prepares the appropriate animation based on animation_type_.
@@ -156,8 +173,10 @@ private:
     bool animation_running_;
     /** @brief Stores the index of the target widget during an animation. */
     int target_index_;
-    /** @brief Optional widget for handling OpenGL-accelerated slide transitions. */
+    /** @brief Widget rendering the transitions with OpenGL. */
     GLTransitionWidget *gl_transition_widget_ = nullptr;
+    /** @brief The widget shown before the current one, the likely target of the next transition. */
+    QPointer<QWidget> likely_next_widget_;
     /** @brief Sound effect played during transitions. */
     QSoundEffect *swoosh_sound_;
 };
@@ -1,14 +1,78 @@
 #include "gl_transition_widget.h"
 
-#include <QApplication>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QEasingCurve>
+#include <QEvent>
+#include <QOpenGLShaderProgram>
 #include <QPainter>
 #include <QPropertyAnimation>
-#include <QScreen>
+#include <QVector2D>
+#include <QVector4D>
+
+namespace {
+    const auto kVertexShader = R"(
+        #version 330 core
+        void main() {
+            vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+            gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+        }
+    )";
+
+    // both snapshots are premultiplied and uploaded top row first; a page is (shift in widths, opacity)
+    const auto kBlendFragmentShader = R"(
+        #version 330 core
+        out vec4 FragColor;
+        uniform sampler2D currentTexture;
+        uniform sampler2D nextTexture;
+        uniform vec2 viewportSize;
+        uniform vec4 backgroundColor;
+        uniform vec2 currentPage;
+        uniform vec2 nextPage;
+        uniform bool nextOnTop;
+
+        vec4 Page(sampler2D page, vec2 uv, vec2 state) {
+            uv.x -= state.x;
+            if (uv.x < 0.0 || uv.x >= 1.0) {
+                return vec4(0.0);
+            }
+            return texture(page, uv) * state.y;
+        }
+
+        void main() {
+            vec2 uv = gl_FragCoord.xy / viewportSize;
+            uv.y = 1.0 - uv.y;
+            vec4 current = Page(currentTexture, uv, currentPage);
+            vec4 next = Page(nextTexture, uv, nextPage);
+            vec4 bottom = nextOnTop ? current : next;
+            vec4 top = nextOnTop ? next : current;
+            bottom += backgroundColor * (1.0 - bottom.a);
+            FragColor = top + bottom * (1.0 - top.a);
+        }
+    )";
+
+    /**
+     * @brief Converts a color into the premultiplied RGBA vector the shader blends with.
+     */
+    QVector4D PremultipliedColor(const QColor &color) {
+        const auto alpha = static_cast<float>(color.alphaF());
+        return {
+            static_cast<float>(color.redF()) * alpha, static_cast<float>(color.greenF()) * alpha,
+            static_cast<float>(color.blueF()) * alpha, alpha
+        };
+    }
+}
 
 GLTransitionWidget::GLTransitionWidget(QWidget *parent)
     : QOpenGLWidget(parent) {
-    animation_ = new QPropertyAnimation(this, "offset");
-    animation_->setEasingCurve(QEasingCurve::OutCubic);
+    QSurfaceFormat format;
+    format.setVersion(3, 3);
+    format.setProfile(QSurfaceFormat::CoreProfile);
+    setFormat(format);
+
+    // the easing depends on the transition type and is applied per page
+    animation_ = new QPropertyAnimation(this, "progress");
+    animation_->setEasingCurve(QEasingCurve::Linear);
 
     connect(animation_, &QPropertyAnimation::finished, this, &GLTransitionWidget::transitionFinished);
 
@@ -18,55 +82,237 @@ GLTransitionWidget::GLTransitionWidget(QWidget *parent)
 
 GLTransitionWidget::~GLTransitionWidget() {
     delete animation_;
+
+    makeCurrent();
+    if (textures_[0] != 0) {
+        glDeleteTextures(2, textures_);
+    }
+    vao_.destroy();
+    program_.reset();
+    doneCurrent();
 }
 
 void GLTransitionWidget::SetWidgets(QWidget *current_widget, QWidget *next_widget) {
     if (!current_widget || !next_widget)
         return;
 
-    const qreal device_pixel_ratio = QApplication::primaryScreen()->devicePixelRatio();
+    RenderSnapshot(current_widget, current_snapshot_);
 
-    current_pixmap_ = current_widget->grab();
-    current_pixmap_.setDevicePixelRatio(device_pixel_ratio);
+    if (prefetched_widget_ == next_widget && prefetched_snapshot_.size() == current_snapshot_.size()) {
+        // the old next snapshot becomes the buffer of the next prefetch
+        next_snapshot_.swap(prefetched_snapshot_);
+    } else {
+        RenderSnapshot(next_widget, next_snapshot_);
+    }
+    DropPrefetchedSnapshot();
+    snapshots_dirty_ = true;
+}
+
+void GLTransitionWidget::PrefetchSnapshot(QWidget *widget) {
+    if (!widget)
+        return;
 
-    next_pixmap_ = next_widget->grab();
-    next_pixmap_.setDevicePixelRatio(device_pixel_ratio);
+    DropPrefetchedSnapshot();
+    // layouts invalidated before or while rendering must not count as changes after it
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::LayoutRequest);
+    RenderSnapshot(widget, prefetched_snapshot_);
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::LayoutRequest);
+
+    prefetched_widget_ = widget;
+    QCoreApplication::instance()->installEventFilter(this);
+}
+
+void GLTransitionWidget::InvalidateSnapshot(const QWidget *widget) {
+    if (prefetched_widget_ == widget) {
+        DropPrefetchedSnapshot();
+    }
+}
+
+bool GLTransitionWidget::eventFilter(QObject *watched, QEvent *event) {
+    switch (event->type()) {
+        case QEvent::Paint:
+        case QEvent::UpdateRequest:
+        case QEvent::LayoutRequest:
+        case QEvent::ChildAdded:
+        case QEvent::ChildRemoved:
+        case QEvent::Show:
+        case QEvent::Hide:
+        case QEvent::FontChange:
+        case QEvent::PaletteChange:
+        case QEvent::StyleChange:
+        case QEvent::EnabledChange:
+            if (prefetched_widget_ && watched->isWidgetType()) {
+                const auto *widget = static_cast<QWidget *>(watched);
+                if (widget == prefetched_widget_ || prefetched_widget_->isAncestorOf(widget)) {
+                    DropPrefetchedSnapshot();
+                }
+            }
+            break;
+        default:
+            break;
+    }
+    return QOpenGLWidget::eventFilter(watched, event);
 }
 
-void GLTransitionWidget::StartTransition(const int duration) {
-    offset_ = 0.0f;
+void GLTransitionWidget::DropPrefetchedSnapshot() {
+    prefetched_widget_ = nullptr;
+    QCoreApplication::instance()->removeEventFilter(this);
+}
+
+void GLTransitionWidget::StartTransition(const int duration, const TransitionType type) {
+    type_ = type;
+    progress_ = 0.0f;
     animation_->setDuration(duration);
     animation_->setStartValue(0.0f);
     animation_->setEndValue(1.0f);
     animation_->start();
 }
 
-void GLTransitionWidget::SetOffset(const float offset) {
-    if (offset_ != offset) {
-        offset_ = offset;
+void GLTransitionWidget::SetProgress(const float progress) {
+    if (progress_ != progress) {
+        progress_ = progress;
         update();
     }
 }
 
-void GLTransitionWidget::paintEvent(QPaintEvent *event) {
-    Q_UNUSED(event);
+void GLTransitionWidget::initializeGL() {
+    if (!initializeOpenGLFunctions()) {
+        qWarning() << "[GL TRANSITION] OpenGL 3.3 unavailable, using the QPainter fallback.";
+        available_ = false;
+        return;
+    }
 
-    if (current_pixmap_.isNull() || next_pixmap_.isNull())
+    program_ = std::make_unique<QOpenGLShaderProgram>();
+    program_->addShaderFromSourceCode(QOpenGLShader::Vertex, kVertexShader);
+    program_->addShaderFromSourceCode(QOpenGLShader::Fragment, kBlendFragmentShader);
+    if (!program_->link()) {
+        qWarning() << "[GL TRANSITION] Blend Shader Log:" << program_->log();
+        program_.reset();
+        available_ = false;
         return;
+    }
 
-    QPainter painter(this);
+    vao_.create();
+    gl_ready_ = true;
+}
+
+void GLTransitionWidget::paintGL() {
+    if (current_snapshot_.isNull() || next_snapshot_.isNull())
+        return;
+
+    PageState current, next;
+    ComputePageStates(current, next);
+
+    if (!gl_ready_) {
+        PaintFallback(current, next);
+        return;
+    }
+
+    if (snapshots_dirty_) {
+        UploadSnapshots();
+    }
+
+    const qreal device_pixel_ratio = devicePixelRatioF();
+    program_->bind();
+    program_->setUniformValue("currentTexture", 0);
+    program_->setUniformValue("nextTexture", 1);
+    program_->setUniformValue("viewportSize", QVector2D(width() * device_pixel_ratio,
+                                                        height() * device_pixel_ratio));
+    program_->setUniformValue("backgroundColor", PremultipliedColor(palette().color(QPalette::Window)));
+    program_->setUniformValue("currentPage", QVector2D(current.shift, current.opacity));
+    program_->setUniformValue("nextPage", QVector2D(next.shift, next.opacity));
+    program_->setUniformValue("nextOnTop", type_ != kFade ? 1 : 0);
+
+    vao_.bind();
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, textures_[1]);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, textures_[0]);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    vao_.release();
+
+    program_->release();
+}
 
-    painter.setRenderHints(QPainter::Antialiasing |
-                           QPainter::TextAntialiasing |
-                           QPainter::SmoothPixmapTransform |
-                           QPainter::Antialiasing);
+void GLTransitionWidget::ComputePageStates(PageState &current, PageState &next) const {
+    const auto eased_out = static_cast<float>(QEasingCurve(QEasingCurve::OutCubic).valueForProgress(progress_));
+    const auto eased_in = static_cast<float>(QEasingCurve(QEasingCurve::InCubic).valueForProgress(progress_));
 
-    const int w = width();
-    const int h = height();
+    switch (type_) {
+        case kSlide:
+            current = {-eased_out, 1.0f};
+            next = {1.0f - eased_out, 1.0f};
+            break;
+        case kSlideAndFade:
+            current = {-eased_out, 1.0f - eased_out};
+            next = {1.0f - eased_out, 0.3f + 0.7f * eased_in};
+            break;
+        case kFade:
+            current = {0.0f, 1.0f - eased_out};
+            next = {0.0f, eased_in};
+            break;
+        case kPush:
+            current = {-eased_out / 2.0f, 1.0f - eased_out};
+            next = {1.0f - eased_out, 1.0f};
+            break;
+    }
+}
 
-    const int current_x = -w * offset_;
-    painter.drawPixmap(current_x, 0, w, h, current_pixmap_);
+void GLTransitionWidget::RenderSnapshot(QWidget *widget, QImage &image) const {
+    const qreal device_pixel_ratio = devicePixelRatioF();
+    const QSize image_size = widget->size() * device_pixel_ratio;
+    if (image.size() != image_size) {
+        image = QImage(image_size, QImage::Format_RGBA8888_Premultiplied);
+    }
+    image.setDevicePixelRatio(device_pixel_ratio);
+    image.fill(Qt::transparent);
+    widget->render(&image);
+}
 
-    const int next_x = w * (1.0 - offset_);
-    painter.drawPixmap(next_x, 0, w, h, next_pixmap_);
+void GLTransitionWidget::UploadSnapshots() {
+    const QImage *snapshots[2] = {&current_snapshot_, &next_snapshot_};
+    const bool reallocate = texture_size_ != current_snapshot_.size();
+
+    if (textures_[0] == 0) {
+        glGenTextures(2, textures_);
+    }
+    for (int i = 0; i < 2; ++i) {
+        const QImage &snapshot = *snapshots[i];
+        glBindTexture(GL_TEXTURE_2D, textures_[i]);
+        if (!reallocate && snapshot.size() == texture_size_) {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, snapshot.width(), snapshot.height(), GL_RGBA, GL_UNSIGNED_BYTE,
+                            snapshot.constBits());
+            continue;
+        }
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, snapshot.width(), snapshot.height(), 0, GL_RGBA,
+                     GL_UNSIGNED_BYTE, snapshot.constBits());
+        // the pages move by fractions of a pixel
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    texture_size_ = current_snapshot_.size();
+    snapshots_dirty_ = false;
+}
+
+void GLTransitionWidget::PaintFallback(const PageState &current, const PageState &next) {
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    painter.fillRect(rect(), palette().color(QPalette::Window));
+
+    const auto draw_page = [this, &painter](const QImage &snapshot, const PageState &state) {
+        painter.setOpacity(state.opacity);
+        painter.drawImage(QPointF(state.shift * width(), 0.0), snapshot);
+    };
+    if (type_ == kFade) {
+        draw_page(next_snapshot_, next);
+        draw_page(current_snapshot_, current);
+    } else {
+        draw_page(current_snapshot_, current);
+        draw_page(next_snapshot_, next);
+    }
 }
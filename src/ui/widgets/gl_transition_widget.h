@@ -1,67 +1,112 @@
 #ifndef GL_TRANSITION_WIDGET_H
 #define GL_TRANSITION_WIDGET_H
 
+#include <memory>
+#include <QImage>
+#include <QOpenGLFunctions_3_3_Core>
+#include <QOpenGLVertexArrayObject>
 #include <QOpenGLWidget>
+#include <QPointer>
 
+class QOpenGLShaderProgram;
 class QPropertyAnimation;
 
 /**
- * @brief An OpenGL widget designed to render smooth, animated slide transitions between two other widgets.
+ * @brief An OpenGL widget rendering the animated transitions between two other widgets as a shader blend.
  *
- * This widget captures the visual representation (pixmap) of the current and next widgets
- * and then uses QPainter (within the OpenGL context) to draw them sliding horizontally.
- * The transition progress is controlled by a QPropertyAnimation animating the 'offset' property.
- * It's intended to be used by AnimatedStackedWidget for hardware-accelerated slide transitions.
+ * The widgets are rendered into snapshot images, which are uploaded into two persistent textures sized to this
+ * widget: they are only reallocated when the size changes, otherwise the upload reuses them (glTexSubImage2D).
+ * Every frame is a single full-screen triangle blending both textures with the shift and opacity the transition
+ * type gives each page at the current progress.
+ *
+ * Rendering a whole widget tree is the expensive part of a transition, so the widget likely to be shown next can
+ * be rendered ahead of time with PrefetchSnapshot() (e.g., while the application is idle); SetWidgets() then only
+ * renders the outgoing widget. The prefetched snapshot is dropped as soon as anything in the widget's tree asks
+ * for a repaint or a new layout, gains or loses a child, or is shown or hidden. The snapshot images are reused
+ * as well.
+ * The transition progress is controlled by a QPropertyAnimation animating the 'progress' property.
+ * It's intended to be used by AnimatedStackedWidget. Without OpenGL 3.3, frames are drawn with QPainter.
  */
-class GLTransitionWidget final : public QOpenGLWidget {
+class GLTransitionWidget final : public QOpenGLWidget, protected QOpenGLFunctions_3_3_Core {
     Q_OBJECT
-    /** @brief Property controlling the horizontal offset during the transition (0.0 to 1.0). Animatable. */
-    Q_PROPERTY(float offset READ GetOffset WRITE SetOffset)
+    /** @brief Property controlling the progress of the transition (0.0 to 1.0, linear). Animatable. */
+    Q_PROPERTY(float progress READ GetProgress WRITE SetProgress)
 
 public:
+    /**
+     * @brief How the two widgets move and blend during a transition.
+     */
+    enum TransitionType {
+        kSlide, ///< The current widget slides out to the left while the next one slides in from the right.
+        kSlideAndFade, ///< Slide, with the current widget fading out and the next one fading in from 30%.
+        kFade, ///< Cross-fade in place.
+        kPush ///< The current widget moves half its width left and fades out; the next one slides in over it.
+    };
+
     /**
      * @brief Constructs a GLTransitionWidget.
-     * Initializes the QPropertyAnimation for the offset and sets widget attributes for optimal painting.
+     * Initializes the QPropertyAnimation for the progress and sets widget attributes for optimal painting.
      * @param parent Optional parent widget.
      */
     explicit GLTransitionWidget(QWidget *parent = nullptr);
 
     /**
      * @brief Destructor.
-     * Cleans up the QPropertyAnimation.
+     * Releases the textures and the shader, and cleans up the QPropertyAnimation.
      */
     ~GLTransitionWidget() override;
 
     /**
      * @brief Sets the widgets involved in the transition.
-     * Captures the current visual state of the provided widgets into pixmaps (current_pixmap_, next_pixmap_)
-     * which will be used for rendering the animation. Takes a device's pixel ratio into account.
-     * @param current_widget The widget currently visible, which will slide out.
-     * @param next_widget The widget that will slide in.
+     * Renders the current widget into its snapshot. The next widget is rendered too, unless its prefetched
+     * snapshot still fits this widget's size. Both widgets must already have the size of this widget.
+     * @param current_widget The widget currently visible, which will leave.
+     * @param next_widget The widget that will be shown.
      */
     void SetWidgets(QWidget *current_widget, QWidget *next_widget);
 
     /**
-     * @brief Starts the slide transition animation.
-     * Configures and starts the QPropertyAnimation to animate the 'offset' property from 0.0 to 1.0
+     * @brief Renders a widget ahead of a transition to it, replacing the previously prefetched snapshot.
+     * Watches the widget's tree until the snapshot is used or dropped (see eventFilter()).
+     * @param widget The widget likely to be shown next (sized like this widget, may be hidden).
+     */
+    void PrefetchSnapshot(QWidget *widget);
+
+    /**
+     * @brief Drops the prefetched snapshot if it shows the given widget (e.g., because its content changed).
+     * Needed for changes a hidden widget does not signal through events, such as a line edit's text.
+     * @param widget The widget.
+     */
+    void InvalidateSnapshot(const QWidget *widget);
+
+    /**
+     * @brief Starts the transition animation.
+     * Configures and starts the QPropertyAnimation to animate the 'progress' property from 0.0 to 1.0
      * over the specified duration.
      * @param duration The duration of the transition in milliseconds.
+     * @param type How the widgets move and blend.
      */
-    void StartTransition(int duration);
+    void StartTransition(int duration, TransitionType type = kSlide);
 
     /**
-     * @brief Gets the current transition offset.
-     * @return The current offset value (0.0 to 1.0).
+     * @brief Checks whether the transitions can be rendered with OpenGL.
+     * @return False once the OpenGL initialization failed (transitions then fall back to QPainter).
      */
-    float GetOffset() const { return offset_; }
+    [[nodiscard]] bool IsAvailable() const { return available_; }
 
     /**
-     * @brief Sets the transition offset.
-     * This is typically called by the QPropertyAnimation. Updates the internal offset_ value
+     * @brief Gets the current transition progress.
+     * @return The current progress value (0.0 to 1.0).
+     */
+    float GetProgress() const { return progress_; }
+
+    /**
+     * @brief Sets the transition progress.
+     * This is typically called by the QPropertyAnimation. Updates the internal progress_ value
      * and schedules a repaint of the widget.
-     * @param offset The new offset value (0.0 to 1.0).
+     * @param progress The new progress value (0.0 to 1.0).
      */
-    void SetOffset(float offset);
+    void SetProgress(float progress);
 
 signals:
     /**
@@ -71,21 +116,92 @@ signals:
 
 protected:
     /**
-     * @brief Overridden paint event handler. Renders the transition frame.
-     * Draws the current_pixmap_ sliding out to the left and the next_pixmap_ sliding in
-     * from the right, based on the current value of offset_. Uses QPainter with high-quality settings.
-     * @param event The paint event.
+     * @brief Drops the prefetched snapshot when its widget or one of its children changes.
+     * Installed on the application only while a prefetched snapshot is held. Hidden widgets get no paint events,
+     * so layout requests, added or removed children and visibility or style changes stand for content changes.
+     * @param watched The object receiving the event.
+     * @param event The event.
+     * @return Always false; the event is passed on.
+     */
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+    /**
+     * @brief Resolves the OpenGL 3.3 functions and compiles the blend shader.
+     */
+    void initializeGL() override;
+
+    /**
+     * @brief Renders the transition frame: uploads new snapshots if needed, then blends both textures.
      */
-    void paintEvent(QPaintEvent *event) override;
+    void paintGL() override;
 
 private:
-    /** @brief Pixmap captured from the widget sliding out. */
-    QPixmap current_pixmap_;
-    /** @brief Pixmap captured from the widget sliding in. */
-    QPixmap next_pixmap_;
+    /**
+     * @brief Placement of one widget in a transition frame.
+     */
+    struct PageState {
+        float shift = 0.0f; ///< Horizontal offset in widths of this widget (negative is left).
+        float opacity = 1.0f; ///< Opacity of the widget.
+    };
+
+    /**
+     * @brief Computes where both widgets are at the current progress, with the easing curves of the type.
+     * @param current Receives the state of the widget leaving.
+     * @param next Receives the state of the widget being shown.
+     */
+    void ComputePageStates(PageState &current, PageState &next) const;
+
+    /**
+     * @brief Renders a widget into an image in device pixels, reusing the image's memory if the size fits.
+     * @param widget The widget.
+     * @param image The image to render into.
+     */
+    void RenderSnapshot(QWidget *widget, QImage &image) const;
+
+    /**
+     * @brief Uploads both snapshots, (re)allocating the textures only when their size changed.
+     */
+    void UploadSnapshots();
+
+    /**
+     * @brief Draws the transition frame with QPainter when the shader is unavailable.
+     * @param current State of the widget leaving.
+     * @param next State of the widget being shown.
+     */
+    void PaintFallback(const PageState &current, const PageState &next);
+
+    /**
+     * @brief Forgets the prefetched snapshot and stops watching its widget. The image memory is kept for reuse.
+     */
+    void DropPrefetchedSnapshot();
+
+    /** @brief Snapshot of the widget leaving. */
+    QImage current_snapshot_;
+    /** @brief Snapshot of the widget being shown. */
+    QImage next_snapshot_;
+    /** @brief Snapshot rendered ahead of time by PrefetchSnapshot(). */
+    QImage prefetched_snapshot_;
+    /** @brief The widget shown in prefetched_snapshot_ (null if there is none). */
+    QPointer<QWidget> prefetched_widget_;
+    /** @brief Whether the snapshots changed since they were uploaded. */
+    bool snapshots_dirty_ = false;
+    /** @brief Textures of the current and the next widget. */
+    GLuint textures_[2] = {0, 0};
+    /** @brief Size the textures are allocated with, in device pixels. */
+    QSize texture_size_;
+    /** @brief The blend shader. */
+    std::unique_ptr<QOpenGLShaderProgram> program_;
+    /** @brief Empty vertex array object required by the core profile for the attribute-less triangle. */
+    QOpenGLVertexArrayObject vao_;
+    /** @brief Whether the shader is linked and the GL functions are resolved. */
+    bool gl_ready_ = false;
+    /** @brief False once initializeGL() failed. */
+    bool available_ = true;
+    /** @brief Type of the running transition. */
+    TransitionType type_ = kSlide;
     /** @brief Current progress of the transition animation (0.0 = start, 1.0 = end). */
-    float offset_ = 0.0f;
-    /** @brief Animation object controlling the 'offset' property over time. */
+    float progress_ = 0.0f;
+    /** @brief Animation object controlling the 'progress' property over time. */
     QPropertyAnimation *animation_ = nullptr;
 };
 
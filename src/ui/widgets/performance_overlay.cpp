@@ -0,0 +1,151 @@
+#include "performance_overlay.h"
+
+#include <algorithm>
+#include <QPainter>
+#include <QPainterPath>
+#include <QResizeEvent>
+#include <QTimer>
+
+#include "../../util/profiling/performance_monitor.h"
+
+PerformanceOverlay::PerformanceOverlay(QWidget *parent)
+    : QWidget(parent), refresh_timer_(new QTimer(this)) {
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setAttribute(Qt::WA_TranslucentBackground);
+    setAttribute(Qt::WA_NoSystemBackground);
+    setObjectName("performanceOverlay");
+
+    refresh_timer_->setInterval(kRefreshIntervalMs);
+    connect(refresh_timer_, &QTimer::timeout, this, qOverload<>(&QWidget::update));
+
+    if (parent) {
+        parent->installEventFilter(this);
+        setGeometry(parent->rect());
+    }
+    hide();
+}
+
+void PerformanceOverlay::Toggle(QWidget *window) {
+    if (!window) return;
+
+    auto overlay = window->findChild<PerformanceOverlay *>("performanceOverlay", Qt::FindDirectChildrenOnly);
+    if (!overlay) {
+        overlay = new PerformanceOverlay(window);
+    }
+
+    overlay->setVisible(!overlay->isVisible());
+    if (overlay->isVisible()) {
+        overlay->raise();
+    }
+}
+
+bool PerformanceOverlay::eventFilter(QObject *watched, QEvent *event) {
+    if (watched == parent() && event->type() == QEvent::Resize) {
+        const auto resize_event = static_cast<QResizeEvent *>(event);
+        setGeometry(QRect(QPoint(0, 0), resize_event->size()));
+    } else if (watched == parent() && event->type() == QEvent::ChildAdded && isVisible()) {
+        // views added to the window later would otherwise cover the overlay
+        QTimer::singleShot(0, this, &QWidget::raise);
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
+void PerformanceOverlay::showEvent(QShowEvent *event) {
+    PerformanceMonitor::GetInstance()->SetEnabled(true);
+    refresh_timer_->start();
+    QWidget::showEvent(event);
+}
+
+void PerformanceOverlay::hideEvent(QHideEvent *event) {
+    refresh_timer_->stop();
+    PerformanceMonitor::GetInstance()->SetEnabled(false);
+    QWidget::hideEvent(event);
+}
+
+void PerformanceOverlay::paintEvent(QPaintEvent *event) {
+    Q_UNUSED(event);
+    const PerformanceMonitor *monitor = PerformanceMonitor::GetInstance();
+    const QVector<const PerformanceMonitor::Channel *> channels = monitor->GetChannels();
+    const QVector<PerformanceMonitor::Gauge> &gauges = monitor->GetGauges();
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.setFont(QFont("Consolas", 8));
+
+    const QFontMetrics metrics = painter.fontMetrics();
+    const int line_height = metrics.height();
+    constexpr int margin = 8;
+
+    const int panel_height = margin * 2
+                             + channels.size() * (line_height + kGraphHeight + 6)
+                             + (gauges.size() + 1) * line_height;
+    const QRect panel(width() - kPanelWidth - margin, margin, kPanelWidth, panel_height);
+
+    painter.setPen(QColor(0, 170, 255, 160));
+    painter.setBrush(QColor(5, 10, 20, 210));
+    painter.drawRect(panel);
+
+    int y = panel.top() + margin;
+    const int left = panel.left() + margin;
+    const int graph_width = panel.width() - margin * 2;
+
+    for (const PerformanceMonitor::Channel *channel: channels) {
+        const QVector<float> samples = channel->samples.Samples();
+
+        float average = 0.0f;
+        float worst = 0.0f;
+        for (const float sample: samples) {
+            average += sample;
+            worst = std::max(worst, sample);
+        }
+        if (!samples.isEmpty()) average /= static_cast<float>(samples.size());
+
+        painter.setPen(QColor(153, 204, 255));
+        painter.drawText(left, y + metrics.ascent(),
+                         QString("%1  avg %2 ms  max %3 ms  missed %4")
+                         .arg(channel->name)
+                         .arg(average, 0, 'f', 2)
+                         .arg(worst, 0, 'f', 2)
+                         .arg(channel->missed.load(std::memory_order_relaxed)));
+        y += line_height;
+
+        const QRect graph(left, y, graph_width, kGraphHeight);
+        painter.setPen(QColor(0, 85, 119));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawRect(graph);
+
+        // the graph spans twice the budget, so the budget line sits in the middle
+        const double budget_ms = channel->budget_ms.load(std::memory_order_relaxed);
+        const double scale_ms = budget_ms * 2.0;
+        const int budget_y = graph.bottom() - qRound(budget_ms / scale_ms * graph.height());
+        painter.setPen(QPen(QColor(255, 200, 0, 140), 1, Qt::DashLine));
+        painter.drawLine(graph.left(), budget_y, graph.right(), budget_y);
+
+        if (samples.size() > 1) {
+            QPainterPath path;
+            const double step = static_cast<double>(graph.width()) / (SampleRing::kCapacity - 1);
+            const double start_x = graph.right() - step * (samples.size() - 1);
+            for (int i = 0; i < samples.size(); ++i) {
+                const double clamped = std::min<double>(samples[i], scale_ms);
+                const QPointF point(start_x + step * i, graph.bottom() - clamped / scale_ms * graph.height());
+                if (i == 0) path.moveTo(point);
+                else path.lineTo(point);
+            }
+            painter.setPen(QPen(QColor(0, 255, 170), 1));
+            painter.drawPath(path);
+        }
+        y += kGraphHeight + 6;
+    }
+
+    painter.setPen(QColor(221, 238, 255));
+    for (const PerformanceMonitor::Gauge &gauge: gauges) {
+        painter.drawText(left, y + metrics.ascent(), QString("%1: %2").arg(gauge.name).arg(gauge.Read()));
+        y += line_height;
+    }
+
+    const qint64 rss = PerformanceMonitor::GetResidentMemoryBytes();
+    painter.drawText(left, y + metrics.ascent(),
+                     rss < 0
+                         ? QString("RSS: n/a")
+                         : QString("RSS: %1 MB").arg(static_cast<double>(rss) / (1024.0 * 1024.0), 0, 'f', 1));
+}
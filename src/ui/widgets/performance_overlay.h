@@ -0,0 +1,72 @@
+#ifndef PERFORMANCE_OVERLAY_H
+#define PERFORMANCE_OVERLAY_H
+
+#include <QWidget>
+
+class QTimer;
+
+/**
+ * @brief Debug overlay showing live frame pacing, step durations, queue depths and memory usage.
+ *
+ * The overlay covers its parent, ignores mouse input and draws a compact panel in the top-right corner
+ * with a frame-time graph for every PerformanceMonitor channel, followed by the registered gauges and the
+ * process resident memory. Sample collection in PerformanceMonitor is enabled only while the overlay is
+ * visible, and the panel is refreshed at a low fixed rate so the overlay barely affects what it measures.
+ * Toggled with the hidden "Debug.TogglePerformanceOverlay" shortcut.
+ */
+class PerformanceOverlay final : public QWidget {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructs a hidden PerformanceOverlay covering the parent widget.
+     * @param parent The widget to draw over (usually the main window).
+     */
+    explicit PerformanceOverlay(QWidget *parent);
+
+    /**
+     * @brief Shows or hides the overlay on the given window, creating it on first use.
+     * @param window The window hosting the overlay.
+     */
+    static void Toggle(QWidget *window);
+
+protected:
+    /**
+     * @brief Tracks parent resizes to keep the overlay covering the parent.
+     * @param watched The object that generated the event.
+     * @param event The event being processed.
+     * @return False; events are never consumed.
+     */
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+    /**
+     * @brief Enables sampling and starts the refresh timer.
+     * @param event The show event.
+     */
+    void showEvent(QShowEvent *event) override;
+
+    /**
+     * @brief Disables sampling and stops the refresh timer.
+     * @param event The hide event.
+     */
+    void hideEvent(QHideEvent *event) override;
+
+    /**
+     * @brief Draws the statistics panel.
+     * @param event The paint event.
+     */
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    /** @brief Width of the statistics panel in pixels. */
+    static constexpr int kPanelWidth = 340;
+    /** @brief Height of a single frame-time graph in pixels. */
+    static constexpr int kGraphHeight = 42;
+    /** @brief Refresh interval of the panel in milliseconds. */
+    static constexpr int kRefreshIntervalMs = 100;
+
+    /** @brief Timer repainting the panel while the overlay is visible. */
+    QTimer *refresh_timer_;
+};
+
+#endif // PERFORMANCE_OVERLAY_H
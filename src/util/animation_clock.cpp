@@ -0,0 +1,129 @@
+#include "animation_clock.h"
+
+#include <algorithm>
+#include <QEvent>
+#include <QGuiApplication>
+#include <QScreen>
+#include <QWidget>
+
+#include "frame_scheduler.h"
+
+AnimationClock *AnimationClock::GetInstance() {
+    static AnimationClock instance;
+    return &instance;
+}
+
+AnimationClock::AnimationClock(QObject *parent) : QObject(parent) {
+    if (const QScreen *screen = QGuiApplication::primaryScreen(); screen && screen->refreshRate() > 1.0) {
+        frame_interval_ms_ = qMax(1, qRound(1000.0 / screen->refreshRate()));
+    }
+
+    frame_timer_.setTimerType(Qt::PreciseTimer);
+    connect(&frame_timer_, &QTimer::timeout, this, &AnimationClock::Tick);
+
+    FrameScheduler *scheduler = FrameScheduler::GetInstance();
+    scheduler->RegisterTimer(&frame_timer_, frame_interval_ms_, kIdleFrameIntervalMs);
+    scheduler->SetTimerEnabled(&frame_timer_, false);
+    connect(scheduler, &FrameScheduler::idleChanged, this, &AnimationClock::UpdateTimerState);
+
+    clock_.start();
+}
+
+AnimationClock::SubscriptionId AnimationClock::Subscribe(QWidget *owner, const int interval_ms, TickCallback tick,
+                                                         const bool runs_while_idle) {
+    Subscription subscription;
+    subscription.owner = owner;
+    subscription.interval_ms = qMax(1, interval_ms);
+    subscription.next_tick_ms = clock_.elapsed() + subscription.interval_ms;
+    subscription.tick = std::move(tick);
+    subscription.runs_while_idle = runs_while_idle;
+
+    if (owner) {
+        owner->installEventFilter(this);
+    }
+
+    const SubscriptionId id = next_id_++;
+    subscriptions_.insert(id, std::move(subscription));
+    UpdateTimerState();
+    return id;
+}
+
+void AnimationClock::Unsubscribe(const SubscriptionId id) {
+    if (subscriptions_.remove(id) > 0) {
+        UpdateTimerState();
+    }
+}
+
+void AnimationClock::SetInterval(const SubscriptionId id, const int interval_ms) {
+    const auto it = subscriptions_.find(id);
+    if (it == subscriptions_.end()) {
+        return;
+    }
+
+    const int interval = qMax(1, interval_ms);
+    it->next_tick_ms += interval - it->interval_ms;
+    it->interval_ms = interval;
+}
+
+void AnimationClock::Tick() {
+    const qint64 now = clock_.elapsed();
+    // a tick is due on the frame closest to its deadline, so intervals below one frame still tick every frame
+    const qint64 due_limit = now + frame_interval_ms_ / 2;
+    const bool idle = FrameScheduler::GetInstance()->IsIdle();
+
+    due_.clear();
+    for (auto it = subscriptions_.begin(); it != subscriptions_.end();) {
+        if (!it->owner) {
+            it = subscriptions_.erase(it);
+            continue;
+        }
+        if (it->next_tick_ms <= due_limit && (!idle || it->runs_while_idle) && it->owner->isVisible()) {
+            due_.append(it.key());
+        }
+        ++it;
+    }
+
+    // callbacks may subscribe or unsubscribe (also themselves), so every due one is looked up again
+    for (const SubscriptionId id: qAsConst(due_)) {
+        auto it = subscriptions_.find(id);
+        if (it == subscriptions_.end()) {
+            continue;
+        }
+
+        it->next_tick_ms = qMax(it->next_tick_ms + it->interval_ms, now + 1);
+        const TickCallback tick = it->tick;
+        if (!tick()) {
+            subscriptions_.remove(id);
+        }
+    }
+
+    UpdateTimerState();
+}
+
+void AnimationClock::UpdateTimerState() {
+    const bool idle = FrameScheduler::GetInstance()->IsIdle();
+
+    bool needed = false;
+    for (const Subscription &subscription: qAsConst(subscriptions_)) {
+        if (subscription.owner && subscription.owner->isVisible() && (!idle || subscription.runs_while_idle)) {
+            needed = true;
+            break;
+        }
+    }
+    FrameScheduler::GetInstance()->SetTimerEnabled(&frame_timer_, needed);
+}
+
+bool AnimationClock::eventFilter(QObject *watched, QEvent *event) {
+    if (event->type() == QEvent::Show || event->type() == QEvent::Hide) {
+        const bool owns_subscription = std::any_of(subscriptions_.cbegin(), subscriptions_.cend(),
+                                                   [watched](const Subscription &subscription) {
+                                                       return subscription.owner == watched;
+                                                   });
+        if (owns_subscription) {
+            UpdateTimerState();
+        } else {
+            watched->removeEventFilter(this);
+        }
+    }
+    return QObject::eventFilter(watched, event);
+}
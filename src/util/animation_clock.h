@@ -0,0 +1,143 @@
+#ifndef ANIMATION_CLOCK_H
+#define ANIMATION_CLOCK_H
+
+#include <functional>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QVector>
+
+class QWidget;
+
+/**
+ * @brief One frame-synchronized driver for the small widget animations (glow pulses, text reveals, glitches,
+ * scanlines), so their timer wakeups no longer grow with the number of widgets.
+ *
+ * Widgets subscribe a tick callback with the interval it wants. A single timer, running at the display's
+ * refresh interval and paced by FrameScheduler, calls every due callback in one pass. The update() calls
+ * the callbacks make therefore land in the same event loop iteration and are painted in one pass.
+ * A subscription:
+ * - is skipped while its owner widget is hidden, and resumes when the owner is shown again,
+ * - is removed when its callback returns false (the animation finished) or its owner is destroyed,
+ * - pauses while the application is idle, unless it was subscribed with runs_while_idle.
+ * The clock timer only runs while there are subscriptions that may tick: owners are watched through an event
+ * filter, so hiding the last visible one stops the timer and showing one starts it again. GUI thread only.
+ */
+class AnimationClock final : public QObject {
+    Q_OBJECT
+
+public:
+    /** @brief Identifier of a subscription; 0 is never used and means "not subscribed". */
+    using SubscriptionId = quint64;
+    /** @brief Tick callback; returns false when the animation finished and should be unsubscribed. */
+    using TickCallback = std::function<bool()>;
+
+    /** @brief Frame interval used when the refresh rate of the screen is unknown (~60 Hz). */
+    static constexpr int kDefaultFrameIntervalMs = 16;
+    /** @brief Frame interval while the application is idle (only runs_while_idle subscriptions tick). */
+    static constexpr int kIdleFrameIntervalMs = 50;
+
+    /**
+     * @brief Gets the singleton instance of the AnimationClock.
+     * @return Pointer to the singleton AnimationClock instance.
+     */
+    static AnimationClock *GetInstance();
+
+    /**
+     * @brief Subscribes a tick callback. The first tick comes one interval later.
+     * @param owner The widget the animation belongs to (its visibility and lifetime control the subscription).
+     * @param interval_ms Time between two ticks; a tick runs on the frame closest to its deadline.
+     * @param tick The callback.
+     * @param runs_while_idle True for animations that must go on while nobody interacts (e.g., revealing a
+     * received message); decorative ones pause.
+     * @return The subscription identifier.
+     */
+    SubscriptionId Subscribe(QWidget *owner, int interval_ms, TickCallback tick, bool runs_while_idle = false);
+
+    /**
+     * @brief Removes a subscription. Unknown identifiers (including 0) are ignored.
+     * @param id The subscription identifier.
+     */
+    void Unsubscribe(SubscriptionId id);
+
+    /**
+     * @brief Changes the interval of a subscription, effective from its next tick.
+     * @param id The subscription identifier.
+     * @param interval_ms Minimal time between two ticks.
+     */
+    void SetInterval(SubscriptionId id, int interval_ms);
+
+    /**
+     * @brief Checks whether a subscription is still active.
+     * @param id The subscription identifier.
+     * @return True if the subscription exists.
+     */
+    [[nodiscard]] bool IsSubscribed(const SubscriptionId id) const { return subscriptions_.contains(id); }
+
+protected:
+    /**
+     * @brief Re-evaluates the frame timer when an owner widget is shown or hidden.
+     * Removes itself from widgets that no longer own a subscription.
+     * @param watched The object receiving the event.
+     * @param event The event.
+     * @return Always false; the event is passed on.
+     */
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    /**
+     * @brief State of one subscription.
+     */
+    struct Subscription {
+        /** @brief The owner widget; the subscription is dropped when it is destroyed. */
+        QPointer<QWidget> owner;
+        /** @brief Minimal time between two ticks. */
+        int interval_ms = kDefaultFrameIntervalMs;
+        /** @brief Clock time of the next tick. */
+        qint64 next_tick_ms = 0;
+        /** @brief The tick callback. */
+        TickCallback tick;
+        /** @brief Whether the subscription ticks while the application is idle. */
+        bool runs_while_idle = false;
+    };
+
+    /**
+     * @brief Private constructor to enforce the singleton pattern.
+     * Registers the frame timer with FrameScheduler using the refresh interval of the primary screen.
+     * @param parent Optional parent QObject.
+     */
+    explicit AnimationClock(QObject *parent = nullptr);
+
+    /**
+     * @brief Private default destructor.
+     */
+    ~AnimationClock() override = default;
+
+    /**
+     * @brief Slot for frame_timer_. Calls every due subscription once and drops the finished ones.
+     */
+    void Tick();
+
+    /**
+     * @brief Enables the frame timer if any subscription of a visible owner may tick in the current idle state,
+     * disables it otherwise.
+     */
+    void UpdateTimerState();
+
+    /** @brief Active subscriptions by identifier. */
+    QHash<SubscriptionId, Subscription> subscriptions_;
+    /** @brief Identifier given to the next subscription. */
+    SubscriptionId next_id_ = 1;
+    /** @brief The single timer driving all subscriptions. */
+    QTimer frame_timer_;
+    /** @brief Refresh interval of the primary screen. */
+    int frame_interval_ms_ = kDefaultFrameIntervalMs;
+    /** @brief Time base of the subscription deadlines. */
+    QElapsedTimer clock_;
+    /** @brief Identifiers due in the current tick (kept to reuse its capacity). */
+    QVector<SubscriptionId> due_;
+};
+
+#endif // ANIMATION_CLOCK_H
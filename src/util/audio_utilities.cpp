@@ -0,0 +1,24 @@
+#include "audio_utilities.h"
+
+#include <cmath>
+#include <QAudioFormat>
+#include <QByteArray>
+
+qreal AudioUtilities::CalculateRmsAmplitude(const QByteArray &buffer, const QAudioFormat &format) {
+    if (buffer.isEmpty() || format.sampleSize() != 16 || format.sampleType() != QAudioFormat::SignedInt) {
+        return 0.0;
+    }
+
+    const auto data = reinterpret_cast<const qint16 *>(buffer.constData());
+    const int sample_count = buffer.size() / (format.sampleSize() / 8);
+    if (sample_count == 0) return 0.0;
+
+    double sum_of_squares = 0.0;
+    for (int i = 0; i < sample_count; ++i) {
+        const double normalized_sample = static_cast<double>(data[i]) / 32767.0;
+        sum_of_squares += normalized_sample * normalized_sample;
+    }
+
+    const double mean_square = sum_of_squares / sample_count;
+    return std::sqrt(mean_square);
+}
@@ -0,0 +1,27 @@
+#ifndef AUDIO_UTILITIES_H
+#define AUDIO_UTILITIES_H
+
+#include <QtGlobal>
+
+class QAudioFormat;
+class QByteArray;
+
+/**
+ * @brief A collection of static helpers for raw PCM audio buffers.
+ *
+ * Kept free of any widget state, so the push-to-talk path in ChatView and the
+ * microbenchmarks share the exact same implementation.
+ */
+class AudioUtilities {
+public:
+    /**
+     * @brief Calculates the Root Mean Square (RMS) amplitude of a raw audio buffer.
+     * Only 16-bit signed integer PCM is supported; other formats yield 0.
+     * @param buffer The raw audio data.
+     * @param format The format of the data in buffer.
+     * @return The calculated RMS amplitude, normalized to approximately [0.0, 1.0].
+     */
+    static qreal CalculateRmsAmplitude(const QByteArray &buffer, const QAudioFormat &format);
+};
+
+#endif // AUDIO_UTILITIES_H
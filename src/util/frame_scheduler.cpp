@@ -0,0 +1,140 @@
+#include "frame_scheduler.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QEvent>
+#include <QWidget>
+
+FrameScheduler *FrameScheduler::GetInstance() {
+    static FrameScheduler instance;
+    return &instance;
+}
+
+FrameScheduler::FrameScheduler(QObject *parent) : QObject(parent) {
+    idle_timer_.setSingleShot(true);
+    connect(&idle_timer_, &QTimer::timeout, this, &FrameScheduler::CheckIdle);
+
+    if (QCoreApplication *application = QCoreApplication::instance()) {
+        application->installEventFilter(this);
+    } else {
+        qWarning() << "[FRAME SCHEDULER] Created before the application object, user input will not wake animations.";
+    }
+
+    last_activity_.start();
+    idle_timer_.start(kIdleTimeoutMs);
+}
+
+void FrameScheduler::RegisterTimer(QTimer *timer, const int active_interval_ms, const int idle_interval_ms) {
+    if (!timer || timers_.contains(timer)) {
+        return;
+    }
+
+    TimerEntry entry;
+    entry.active_interval_ms = active_interval_ms;
+    entry.idle_interval_ms = idle_interval_ms;
+    timers_.insert(timer, entry);
+    connect(timer, &QObject::destroyed, this, [this, timer] {
+        timers_.remove(timer);
+    });
+
+    ApplyTimerState(timer, entry);
+}
+
+void FrameScheduler::SetIntervals(QTimer *timer, const int active_interval_ms, const int idle_interval_ms) {
+    const auto it = timers_.find(timer);
+    if (it == timers_.end()) {
+        return;
+    }
+
+    it->active_interval_ms = active_interval_ms;
+    it->idle_interval_ms = idle_interval_ms;
+    ApplyTimerState(timer, *it);
+}
+
+void FrameScheduler::SetTimerEnabled(QTimer *timer, const bool enabled) {
+    const auto it = timers_.find(timer);
+    if (it == timers_.end() || it->enabled == enabled) {
+        return;
+    }
+
+    it->enabled = enabled;
+    ApplyTimerState(timer, *it);
+}
+
+void FrameScheduler::SetSettled(QTimer *timer, const bool settled) {
+    const auto it = timers_.find(timer);
+    if (it == timers_.end() || it->settled == settled) {
+        return;
+    }
+
+    it->settled = settled;
+    ApplyTimerState(timer, *it);
+}
+
+void FrameScheduler::NotifyActivity() {
+    last_activity_.restart();
+    if (IsIdle()) {
+        SetIdle(false);
+        idle_timer_.start(kIdleTimeoutMs);
+    }
+}
+
+bool FrameScheduler::eventFilter(QObject *watched, QEvent *event) {
+    switch (event->type()) {
+        case QEvent::MouseButtonPress:
+        case QEvent::MouseButtonRelease:
+        case QEvent::MouseMove:
+        case QEvent::Wheel:
+        case QEvent::KeyPress:
+        case QEvent::KeyRelease:
+        case QEvent::TouchBegin:
+        case QEvent::TouchUpdate:
+        case QEvent::ApplicationActivate:
+            NotifyActivity();
+            break;
+        case QEvent::Move:
+        case QEvent::Resize:
+        case QEvent::WindowStateChange:
+            // child widgets are moved and resized by animations all the time, only window changes are activity
+            if (watched->isWidgetType() && static_cast<QWidget *>(watched)->isWindow()) {
+                NotifyActivity();
+            }
+            break;
+        default:
+            break;
+    }
+    return false;
+}
+
+void FrameScheduler::ApplyTimerState(QTimer *timer, const TimerEntry &entry) const {
+    const int interval = IsIdle() ? entry.idle_interval_ms : entry.active_interval_ms;
+    if (!entry.enabled || entry.settled || interval <= 0) {
+        timer->stop();
+        return;
+    }
+
+    if (!timer->isActive()) {
+        timer->start(interval);
+    } else if (timer->interval() != interval) {
+        timer->setInterval(interval);
+    }
+}
+
+void FrameScheduler::CheckIdle() {
+    if (const qint64 elapsed = last_activity_.elapsed(); elapsed < kIdleTimeoutMs) {
+        idle_timer_.start(static_cast<int>(kIdleTimeoutMs - elapsed));
+        return;
+    }
+    SetIdle(true);
+}
+
+void FrameScheduler::SetIdle(const bool idle) {
+    if (idle_.exchange(idle, std::memory_order_relaxed) == idle) {
+        return;
+    }
+
+    for (auto it = timers_.begin(); it != timers_.end(); ++it) {
+        ApplyTimerState(it.key(), it.value());
+    }
+    emit idleChanged(idle);
+}
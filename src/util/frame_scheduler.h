@@ -0,0 +1,152 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <atomic>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QTimer>
+
+/**
+ * @brief Central pacing of the animation timers, so animations stop costing CPU while nothing changes.
+ *
+ * Widgets register their animation timers together with an active and an idle interval and, instead of
+ * starting or stopping them directly, tell the scheduler whether the timer is wanted (SetTimerEnabled())
+ * and whether its animation is visually settled (SetSettled()). The scheduler then decides:
+ * - a disabled or settled timer is stopped,
+ * - while the application is active, a timer runs at its active interval,
+ * - once nothing happened for kIdleTimeoutMs, it runs at its idle interval (or stops, if that is 0).
+ *
+ * User input anywhere in the application (seen through an application-wide event filter) and explicit
+ * NotifyActivity() calls (network traffic, audio) switch back to the active state instantly.
+ * All methods except IsIdle() must be called on the GUI thread.
+ */
+class FrameScheduler final : public QObject {
+    Q_OBJECT
+
+public:
+    /** @brief Time without any activity after which the application is considered idle. */
+    static constexpr int kIdleTimeoutMs = 2000;
+
+    /**
+     * @brief Gets the singleton instance of the FrameScheduler.
+     * @return Pointer to the singleton FrameScheduler instance.
+     */
+    static FrameScheduler *GetInstance();
+
+    /**
+     * @brief Puts a timer under the scheduler's control. The timer starts enabled and not settled.
+     * The registration is dropped automatically when the timer is destroyed.
+     * @param timer The timer to pace.
+     * @param active_interval_ms Interval while the application is active.
+     * @param idle_interval_ms Interval while the application is idle; 0 stops the timer when idle.
+     */
+    void RegisterTimer(QTimer *timer, int active_interval_ms, int idle_interval_ms);
+
+    /**
+     * @brief Changes the intervals of a registered timer (e.g., a temporarily reduced rate during transitions).
+     * @param timer The registered timer.
+     * @param active_interval_ms Interval while the application is active.
+     * @param idle_interval_ms Interval while the application is idle; 0 stops the timer when idle.
+     */
+    void SetIntervals(QTimer *timer, int active_interval_ms, int idle_interval_ms);
+
+    /**
+     * @brief Replaces start() / stop() of a registered timer.
+     * @param timer The registered timer.
+     * @param enabled False keeps the timer stopped regardless of activity.
+     */
+    void SetTimerEnabled(QTimer *timer, bool enabled);
+
+    /**
+     * @brief Marks the animation driven by a registered timer as visually settled (or not).
+     * A settled timer is stopped until its owner reports a change.
+     * @param timer The registered timer.
+     * @param settled True if another tick would not change anything on screen.
+     */
+    void SetSettled(QTimer *timer, bool settled);
+
+    /**
+     * @brief Reports activity that should wake all animations (network message, audio, programmatic changes).
+     * Restarts the idle countdown. Must be called on the GUI thread.
+     */
+    void NotifyActivity();
+
+    /**
+     * @brief Checks whether the application is idle. Thread-safe (used by the blob physics thread).
+     * @return True if nothing happened for kIdleTimeoutMs.
+     */
+    [[nodiscard]] bool IsIdle() const { return idle_.load(std::memory_order_relaxed); }
+
+signals:
+    /**
+     * @brief Emitted when the application enters or leaves the idle state.
+     * @param idle True when entering the idle state.
+     */
+    void idleChanged(bool idle);
+
+protected:
+    /**
+     * @brief Application-wide event filter treating user input and window changes as activity.
+     * @param watched The object receiving the event.
+     * @param event The event being processed.
+     * @return Always false; events are only observed.
+     */
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    /**
+     * @brief Scheduling state of one registered timer.
+     */
+    struct TimerEntry {
+        /** @brief Interval while the application is active. */
+        int active_interval_ms = 16;
+        /** @brief Interval while the application is idle; 0 stops the timer. */
+        int idle_interval_ms = 0;
+        /** @brief Whether the owner wants the timer running at all. */
+        bool enabled = true;
+        /** @brief Whether the animation is visually settled. */
+        bool settled = false;
+    };
+
+    /**
+     * @brief Private constructor to enforce the singleton pattern.
+     * Installs the event filter on the application and starts the idle countdown.
+     * @param parent Optional parent QObject.
+     */
+    explicit FrameScheduler(QObject *parent = nullptr);
+
+    /**
+     * @brief Private default destructor.
+     */
+    ~FrameScheduler() override = default;
+
+    /**
+     * @brief Starts, stops or re-paces a timer according to its entry and the global idle state.
+     * @param timer The timer to apply the state to.
+     * @param entry Its scheduling state.
+     */
+    void ApplyTimerState(QTimer *timer, const TimerEntry &entry) const;
+
+    /**
+     * @brief Slot for idle_timer_. Enters the idle state, or re-arms the countdown if there was activity since.
+     */
+    void CheckIdle();
+
+    /**
+     * @brief Switches the global idle state and re-applies all timers if it changed.
+     * @param idle The new idle state.
+     */
+    void SetIdle(bool idle);
+
+    /** @brief Registered timers. GUI thread only. */
+    QHash<QTimer *, TimerEntry> timers_;
+    /** @brief Time since the last activity. Restarting it is cheaper than restarting idle_timer_ on every event. */
+    QElapsedTimer last_activity_;
+    /** @brief Single-shot countdown to the idle state; re-armed for the remaining time if activity happened meanwhile. */
+    QTimer idle_timer_;
+    /** @brief Global idle state; read by other threads. */
+    std::atomic<bool> idle_{false};
+};
+
+#endif // FRAME_SCHEDULER_H
@@ -0,0 +1,138 @@
+#ifndef PARALLEL_FOR_POOL_H
+#define PARALLEL_FOR_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Persistent worker pool specialised for short, frequent data-parallel loops.
+ *
+ * Unlike QtConcurrent, no task objects or futures are allocated per call: the workers are started once,
+ * pinned to their own cores (best effort) and wait for the next job on a spin-then-park barrier, so a job
+ * submitted shortly after the previous one is picked up without a kernel round trip.
+ *
+ * A job splits [0, count) into fixed-size chunks which are distributed evenly over the per-participant
+ * queues. Each participant (the workers and the calling thread) drains its own queue first and then steals
+ * the remaining chunks from the other queues, so a descheduled worker cannot stall the whole job.
+ *
+ * Only one job runs at a time. A call made while another job is in progress (from another thread, or
+ * nested in a loop body) runs serially on the calling thread instead of blocking.
+ */
+class ParallelForPool {
+public:
+    /**
+     * @brief Signature of the type-erased loop body: processes the elements [begin, end).
+     */
+    using RangeFunction = void (*)(void *context, size_t begin, size_t end);
+
+    /**
+     * @brief Gets the process-wide pool. The workers are started on the first call.
+     * @return Pointer to the singleton instance.
+     */
+    static ParallelForPool *GetInstance();
+
+    /**
+     * @brief Gets the participant count the process-wide pool has (or will have), without starting it.
+     * @return The participant count, at least 1.
+     */
+    static int GetDefaultParticipantCount();
+
+    /**
+     * @brief Stops and joins the workers.
+     */
+    ~ParallelForPool();
+
+    ParallelForPool(const ParallelForPool &) = delete;
+
+    ParallelForPool &operator=(const ParallelForPool &) = delete;
+
+    /**
+     * @brief Gets the number of threads taking part in a job (the workers plus the calling thread).
+     * @return The participant count, at least 1.
+     */
+    [[nodiscard]] int GetParticipantCount() const { return static_cast<int>(workers_.size()) + 1; }
+
+    /**
+     * @brief Runs body(begin, end) over [0, count) in chunks of chunk_size elements and waits for completion.
+     * Chunk boundaries are multiples of chunk_size, so aligned chunk sizes keep SIMD loads aligned.
+     * @tparam Body Callable with the signature void(size_t begin, size_t end).
+     * @param count Number of elements.
+     * @param chunk_size Number of elements per chunk (0 is treated as 1).
+     * @param body The loop body. Must be safe to call concurrently for disjoint ranges.
+     */
+    template<typename Body>
+    void ParallelFor(const size_t count, const size_t chunk_size, Body &&body) {
+        using BodyType = std::remove_reference_t<Body>;
+        Run(count, chunk_size, [](void *context, const size_t begin, const size_t end) {
+            (*static_cast<BodyType *>(context))(begin, end);
+        }, const_cast<std::remove_const_t<BodyType> *>(&body));
+    }
+
+    /**
+     * @brief Type-erased version of ParallelFor().
+     * @param count Number of elements.
+     * @param chunk_size Number of elements per chunk (0 is treated as 1).
+     * @param function The loop body.
+     * @param context Opaque pointer passed to every function call.
+     */
+    void Run(size_t count, size_t chunk_size, RangeFunction function, void *context);
+
+private:
+    /**
+     * @brief Chunk queue of a single participant. Owners and thieves claim chunks with the same fetch_add.
+     */
+    struct alignas(64) ChunkQueue {
+        /** @brief Index of the next unclaimed chunk. May run past end once the queue is drained. */
+        std::atomic<size_t> next{0};
+        /** @brief One past the last chunk index of this queue. Written only between jobs. */
+        size_t end = 0;
+    };
+
+    /**
+     * @brief Private constructor (singleton). Starts worker_count workers.
+     * @param worker_count Number of worker threads (the caller is an extra participant).
+     */
+    explicit ParallelForPool(int worker_count);
+
+    /**
+     * @brief Main loop of a worker: waits for a new job generation, executes chunks, reports completion.
+     * @param participant Index of the worker's chunk queue (1-based; 0 belongs to the caller).
+     */
+    void WorkerLoop(int participant);
+
+    /**
+     * @brief Processes the participant's own chunks, then steals from the other queues until all are empty.
+     * @param participant Index of the participant's chunk queue.
+     */
+    void ExecuteChunks(int participant);
+
+    /** @brief Worker threads. */
+    std::vector<std::thread> workers_;
+    /** @brief One chunk queue per participant; index 0 belongs to the calling thread. */
+    std::unique_ptr<ChunkQueue[]> queues_;
+    /** @brief Serializes jobs; a busy pool makes Run() fall back to serial execution. */
+    std::mutex run_mutex_;
+
+    /** @brief Incremented to publish a new job (or the shutdown request) to the workers. */
+    alignas(64) std::atomic<unsigned> generation_{0};
+    /** @brief Number of workers that have not yet finished the current job. */
+    alignas(64) std::atomic<int> pending_workers_{0};
+    /** @brief Set when the pool is being destroyed. */
+    std::atomic<bool> stopping_{false};
+
+    /** @brief Body of the current job. Published by the release increment of generation_. */
+    RangeFunction function_ = nullptr;
+    /** @brief Context of the current job. */
+    void *context_ = nullptr;
+    /** @brief Element count of the current job. */
+    size_t count_ = 0;
+    /** @brief Chunk size of the current job. */
+    size_t chunk_size_ = 1;
+};
+
+#endif // PARALLEL_FOR_POOL_H
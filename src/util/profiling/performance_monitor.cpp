@@ -0,0 +1,156 @@
+#include "performance_monitor.h"
+
+#include <algorithm>
+#include <QDebug>
+#include <QFile>
+
+#include "trace_profiler.h"
+
+#ifdef Q_OS_WINDOWS
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#elif defined(Q_OS_MACOS)
+#include <mach/mach.h>
+#else
+#include <unistd.h>
+#endif
+
+QVector<float> SampleRing::Samples() const {
+    const quint32 count = count_.load(std::memory_order_acquire);
+    const quint32 retained = qMin<quint32>(count, kCapacity);
+
+    QVector<float> result;
+    result.reserve(static_cast<int>(retained));
+    for (quint32 i = count - retained; i < count; ++i) {
+        result.append(samples_[i % kCapacity].load(std::memory_order_relaxed));
+    }
+    return result;
+}
+
+PerformanceMonitor *PerformanceMonitor::GetInstance() {
+    static PerformanceMonitor instance;
+    return &instance;
+}
+
+PerformanceMonitor::PerformanceMonitor(QObject *parent) : QObject(parent) {
+}
+
+void PerformanceMonitor::SetEnabled(const bool enabled) {
+    if (enabled_.exchange(enabled) == enabled) return;
+
+    if (enabled) {
+        // the gap since the last frame recorded before the monitor was disabled is not a real frame
+        std::lock_guard lock(channels_mutex_);
+        for (const auto &channel: channels_) {
+            channel->last_frame_ns.store(0, std::memory_order_relaxed);
+        }
+    }
+    qDebug() << "[PERFORMANCE MONITOR] Sampling" << (enabled ? "enabled" : "disabled");
+}
+
+PerformanceMonitor::Channel *PerformanceMonitor::RegisterChannel(const QString &name, const double budget_ms) {
+    std::lock_guard lock(channels_mutex_);
+    int held = 0;
+    for (const auto &existing: channels_) {
+        if (existing->key != name) continue;
+        if (existing->in_use) {
+            ++held;
+            continue;
+        }
+
+        existing->in_use = true;
+        existing->budget_ms.store(budget_ms, std::memory_order_relaxed);
+        existing->last_frame_ns.store(0, std::memory_order_relaxed);
+        return existing.get();
+    }
+
+    auto channel = std::make_unique<Channel>();
+    channel->key = name;
+    channel->name = held == 0 ? name : QString("%1 #%2").arg(name).arg(held + 1);
+    channel->budget_ms.store(budget_ms, std::memory_order_relaxed);
+    channels_.push_back(std::move(channel));
+    return channels_.back().get();
+}
+
+void PerformanceMonitor::ReleaseChannel(Channel *channel) {
+    if (!channel) return;
+
+    std::lock_guard lock(channels_mutex_);
+    channel->in_use = false;
+}
+
+void PerformanceMonitor::RecordFrame(Channel *channel) const {
+    if (!IsEnabled() || !channel) return;
+
+    const qint64 now = TraceProfiler::Now();
+    const qint64 previous = channel->last_frame_ns.exchange(now, std::memory_order_relaxed);
+    if (previous > 0) {
+        Push(channel, static_cast<double>(now - previous) / 1e6);
+    }
+}
+
+void PerformanceMonitor::RecordDuration(Channel *channel, const qint64 duration_ns) const {
+    if (!IsEnabled() || !channel) return;
+
+    Push(channel, static_cast<double>(duration_ns) / 1e6);
+}
+
+void PerformanceMonitor::Push(Channel *channel, const double value_ms) {
+    channel->samples.Push(static_cast<float>(value_ms));
+    if (value_ms > channel->budget_ms.load(std::memory_order_relaxed) * 1.5) {
+        channel->missed.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void PerformanceMonitor::RegisterGauge(const QString &name, const QObject *owner, std::function<qint64()> Read) {
+    if (!owner || !Read) return;
+
+    gauges_.append({name, owner, std::move(Read)});
+    connect(owner, &QObject::destroyed, this, [this, owner] {
+        gauges_.erase(std::remove_if(gauges_.begin(), gauges_.end(),
+                                     [owner](const Gauge &gauge) { return gauge.owner == owner; }),
+                      gauges_.end());
+    });
+}
+
+QVector<const PerformanceMonitor::Channel *> PerformanceMonitor::GetChannels() const {
+    std::lock_guard lock(channels_mutex_);
+    QVector<const Channel *> result;
+    result.reserve(static_cast<int>(channels_.size()));
+    for (const auto &channel: channels_) {
+        if (channel->in_use) {
+            result.append(channel.get());
+        }
+    }
+    return result;
+}
+
+qint64 PerformanceMonitor::GetResidentMemoryBytes() {
+#ifdef Q_OS_WINDOWS
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<qint64>(counters.WorkingSetSize);
+    }
+    return -1;
+#elif defined(Q_OS_MACOS)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) ==
+        KERN_SUCCESS) {
+        return static_cast<qint64>(info.resident_size);
+    }
+    return -1;
+#else
+    // second field of statm is the number of resident pages
+    QFile statm("/proc/self/statm");
+    if (!statm.open(QIODevice::ReadOnly)) return -1;
+
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 2) return -1;
+
+    bool ok = false;
+    const qint64 pages = fields.at(1).toLongLong(&ok);
+    return ok ? pages * sysconf(_SC_PAGESIZE) : -1;
+#endif
+}
@@ -0,0 +1,202 @@
+#ifndef PERFORMANCE_MONITOR_H
+#define PERFORMANCE_MONITOR_H
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <QObject>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief Fixed-size ring of float samples with a single producer and lock-free readers.
+ * Readers may observe a sample being overwritten, which is harmless for display purposes.
+ */
+class SampleRing {
+public:
+    /** @brief Number of samples kept. */
+    static constexpr int kCapacity = 240;
+
+    /**
+     * @brief Appends a sample, overwriting the oldest one once the ring is full.
+     * @param value The sample value.
+     */
+    void Push(const float value) {
+        const quint32 count = count_.load(std::memory_order_relaxed);
+        samples_[count % kCapacity].store(value, std::memory_order_relaxed);
+        count_.store(count + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copies the retained samples, oldest first.
+     * @return The retained samples (at most kCapacity).
+     */
+    [[nodiscard]] QVector<float> Samples() const;
+
+    /**
+     * @brief Gets the total number of samples ever pushed.
+     * @return The sample count.
+     */
+    [[nodiscard]] quint32 TotalCount() const { return count_.load(std::memory_order_acquire); }
+
+private:
+    /** @brief Sample storage. */
+    std::array<std::atomic<float>, kCapacity> samples_{};
+    /** @brief Total number of pushed samples; the write position is count_ % kCapacity. */
+    std::atomic<quint32> count_{0};
+};
+
+/**
+ * @brief Collects live frame pacing, step durations and queue depths for the performance overlay.
+ *
+ * Producers (GL widgets, the physics thread, decoders) register a channel once and then push samples
+ * into its fixed-size ring. While the overlay is hidden the monitor is disabled and every record call
+ * returns after a single relaxed atomic load. Gauges are polled by the overlay on the GUI thread.
+ */
+class PerformanceMonitor final : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief A named series of timings (in milliseconds) produced by a single thread.
+     */
+    struct Channel {
+        /** @brief Name passed to RegisterChannel(). */
+        QString key;
+        /** @brief Display name: the key, numbered when several producers use it at once. */
+        QString name;
+        /** @brief Whether a producer holds the channel. Guarded by channels_mutex_. */
+        bool in_use = true;
+        /**
+         * @brief Budget in milliseconds; frames or steps above 1.5x the budget count as missed.
+         * Read by producers while RegisterChannel() may reassign a released channel on the GUI thread.
+         */
+        std::atomic<double> budget_ms{0.0};
+        /** @brief Recent samples in milliseconds. */
+        SampleRing samples;
+        /** @brief Timestamp of the previous frame, used by RecordFrame(). */
+        std::atomic<qint64> last_frame_ns{0};
+        /** @brief Number of samples that exceeded 1.5x the budget. */
+        std::atomic<quint64> missed{0};
+    };
+
+    /**
+     * @brief A named integer value polled on the GUI thread (queue depths, buffer fill).
+     */
+    struct Gauge {
+        /** @brief Display name. */
+        QString name;
+        /** @brief Object the gauge belongs to; the gauge is removed when it is destroyed. */
+        const QObject *owner;
+        /** @brief Callback returning the current value. */
+        std::function<qint64()> Read;
+    };
+
+    /**
+     * @brief Gets the singleton instance of the PerformanceMonitor.
+     * @return Pointer to the singleton PerformanceMonitor instance.
+     */
+    static PerformanceMonitor *GetInstance();
+
+    /**
+     * @brief Checks whether samples are currently being collected.
+     * @return True if the overlay (or anything else) enabled the monitor.
+     */
+    [[nodiscard]] bool IsEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Starts or stops sample collection.
+     * @param enabled True to collect samples.
+     */
+    void SetEnabled(bool enabled);
+
+    /**
+     * @brief Gives the caller its own channel with the given name.
+     * Every channel has a single producer, so a name already held by another producer gets a new, numbered
+     * channel. Channels live as long as the application: one released by ReleaseChannel() is handed to the
+     * next registration with the same name, so widgets recreated later keep writing into the same series.
+     * @param name Display name of the channel.
+     * @param budget_ms Frame or step budget in milliseconds.
+     * @return Pointer to the channel, to be kept by the producer until it calls ReleaseChannel().
+     */
+    Channel *RegisterChannel(const QString &name, double budget_ms = 1000.0 / 60.0);
+
+    /**
+     * @brief Returns a channel once its producer stopped recording into it.
+     * Released channels are hidden from GetChannels() until they are registered again.
+     * @param channel The channel returned by RegisterChannel() (may be null).
+     */
+    void ReleaseChannel(Channel *channel);
+
+    /**
+     * @brief Records a presented frame; the sample is the time since the previous frame on the channel.
+     * @param channel The channel returned by RegisterChannel().
+     */
+    void RecordFrame(Channel *channel) const;
+
+    /**
+     * @brief Records the duration of a single step (e.g., a physics update).
+     * @param channel The channel returned by RegisterChannel().
+     * @param duration_ns The step duration in nanoseconds.
+     */
+    void RecordDuration(Channel *channel, qint64 duration_ns) const;
+
+    /**
+     * @brief Registers a gauge polled by the overlay. Must be called on the GUI thread.
+     * @param name Display name.
+     * @param owner Object owning the data; the gauge is removed when the owner is destroyed.
+     * @param Read Callback returning the current value. Called on the GUI thread.
+     */
+    void RegisterGauge(const QString &name, const QObject *owner, std::function<qint64()> Read);
+
+    /**
+     * @brief Gets a snapshot of all channels.
+     * @return Pointers to the channels held by a producer, in registration order.
+     */
+    [[nodiscard]] QVector<const Channel *> GetChannels() const;
+
+    /**
+     * @brief Gets all registered gauges.
+     * @return The gauges, in registration order.
+     */
+    [[nodiscard]] const QVector<Gauge> &GetGauges() const { return gauges_; }
+
+    /**
+     * @brief Reads the resident set size of the current process.
+     * @return The RSS in bytes, or -1 if it could not be determined on this platform.
+     */
+    static qint64 GetResidentMemoryBytes();
+
+private:
+    /**
+     * @brief Private constructor to enforce the singleton pattern.
+     * @param parent Optional parent QObject.
+     */
+    explicit PerformanceMonitor(QObject *parent = nullptr);
+
+    /**
+     * @brief Private default destructor.
+     */
+    ~PerformanceMonitor() override = default;
+
+    /**
+     * @brief Pushes a sample and updates the missed counter of a channel.
+     * @param channel Target channel.
+     * @param value_ms Sample in milliseconds.
+     */
+    static void Push(Channel *channel, double value_ms);
+
+    /** @brief Collection on/off switch. */
+    std::atomic<bool> enabled_{false};
+    /** @brief Guards channels_ (registration and snapshotting only, never the record path). */
+    mutable std::mutex channels_mutex_;
+    /** @brief Registered channels; a deque keeps channel addresses stable. */
+    std::deque<std::unique_ptr<Channel>> channels_;
+    /** @brief Registered gauges. GUI thread only. */
+    QVector<Gauge> gauges_;
+};
+
+#endif // PERFORMANCE_MONITOR_H
@@ -0,0 +1,124 @@
+#include "startup_profiler.h"
+
+#include <QDebug>
+#include <QEvent>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
+#include <QWidget>
+
+StartupProfiler *StartupProfiler::GetInstance() {
+    static StartupProfiler instance;
+    return &instance;
+}
+
+StartupProfiler::StartupProfiler(QObject *parent) : QObject(parent) {
+    export_path_ = qEnvironmentVariable("WAVELENGTH_STARTUP_TRACE");
+    timer_.start();
+}
+
+void StartupProfiler::Start() {
+    phases_.clear();
+    phases_.reserve(32);
+    finished_ = false;
+    first_frame_ns_ = -1;
+    timer_.restart();
+    phase_start_ns_ = 0;
+}
+
+void StartupProfiler::Mark(const QString &phase) {
+    if (finished_) return;
+
+    const qint64 now = timer_.nsecsElapsed();
+    phases_.append({phase, phase_start_ns_, now});
+    phase_start_ns_ = now;
+}
+
+void StartupProfiler::WatchFirstFrame(QWidget *widget) {
+    if (!widget || finished_) return;
+
+    if (watched_widget_) {
+        watched_widget_->removeEventFilter(this);
+    }
+    watched_widget_ = widget;
+    watched_widget_->installEventFilter(this);
+}
+
+void StartupProfiler::SetExportPath(const QString &path) {
+    export_path_ = path;
+}
+
+bool StartupProfiler::eventFilter(QObject *watched, QEvent *event) {
+    if (watched == watched_widget_ && event->type() == QEvent::Paint) {
+        watched_widget_->removeEventFilter(this);
+        watched_widget_ = nullptr;
+
+        // the paint event is delivered right after this filter returns, so the frame
+        // is considered presented once control gets back to the event loop
+        QTimer::singleShot(0, this, [this] {
+            Mark("first frame");
+            Finish();
+        });
+    }
+    return false;
+}
+
+void StartupProfiler::Finish() {
+    if (finished_) return;
+
+    if (first_frame_ns_ < 0) {
+        first_frame_ns_ = timer_.nsecsElapsed();
+    }
+    finished_ = true;
+
+    PrintBreakdown();
+
+    if (!export_path_.isEmpty()) {
+        QFile file(export_path_);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            file.write(ToJson());
+            qInfo() << "[STARTUP PROFILER] Startup breakdown exported to:" << export_path_;
+        } else {
+            qWarning() << "[STARTUP PROFILER] Could not write startup breakdown to:" << export_path_
+                    << file.errorString();
+        }
+    }
+
+    emit firstFramePresented();
+}
+
+double StartupProfiler::GetTimeToFirstFrameMs() const {
+    return first_frame_ns_ < 0 ? -1.0 : first_frame_ns_ / 1e6;
+}
+
+QByteArray StartupProfiler::ToJson() const {
+    QJsonArray phases;
+    for (const Phase &phase: phases_) {
+        QJsonObject entry;
+        entry["name"] = phase.name;
+        entry["start_ms"] = phase.start_ns / 1e6;
+        entry["duration_ms"] = (phase.end_ns - phase.start_ns) / 1e6;
+        phases.append(entry);
+    }
+
+    QJsonObject root;
+    root["time_to_first_frame_ms"] = GetTimeToFirstFrameMs();
+    root["phases"] = phases;
+    return QJsonDocument(root).toJson(QJsonDocument::Indented);
+}
+
+void StartupProfiler::PrintBreakdown() const {
+    const double total_ms = GetTimeToFirstFrameMs();
+    qInfo().noquote() << QString("[STARTUP PROFILER] Time to first frame: %1 ms").arg(total_ms, 0, 'f', 1);
+
+    for (const Phase &phase: phases_) {
+        const double duration_ms = (phase.end_ns - phase.start_ns) / 1e6;
+        const double share = total_ms > 0.0 ? duration_ms / total_ms * 100.0 : 0.0;
+        qInfo().noquote() << QString("[STARTUP PROFILER]   %1 %2 ms (%3%)")
+                .arg(phase.name, -28)
+                .arg(duration_ms, 8, 'f', 1)
+                .arg(share, 5, 'f', 1);
+    }
+}
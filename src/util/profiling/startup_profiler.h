@@ -0,0 +1,136 @@
+#ifndef STARTUP_PROFILER_H
+#define STARTUP_PROFILER_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QVector>
+
+class QWidget;
+
+/**
+ * @brief Records named startup phases and reports the time it takes to reach the first interactive frame.
+ *
+ * The profiler is a singleton started at the very top of main(). Each call to Mark() closes the phase
+ * that began at the previous mark, so the breakdown adds up to the total startup time. Once the watched
+ * widget paints for the first time, the final "first frame" phase is recorded, a breakdown is printed
+ * to the log and, if an export path was configured, the phases are written out as JSON.
+ */
+class StartupProfiler final : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief A single startup phase, expressed in nanoseconds relative to Start().
+     */
+    struct Phase {
+        QString name; ///< Human-readable phase name.
+        qint64 start_ns; ///< Time at which the phase started.
+        qint64 end_ns; ///< Time at which the phase ended.
+    };
+
+    /**
+     * @brief Gets the singleton instance of the StartupProfiler.
+     * @return Pointer to the singleton StartupProfiler instance.
+     */
+    static StartupProfiler *GetInstance();
+
+    /**
+     * @brief Starts (or restarts) the startup clock and clears previously recorded phases.
+     */
+    void Start();
+
+    /**
+     * @brief Closes the current phase under the given name and opens the next one.
+     * Ignored once the profiler has finished.
+     * @param phase The name of the phase that just completed.
+     */
+    void Mark(const QString &phase);
+
+    /**
+     * @brief Installs a one-shot watcher that finishes profiling once the widget has painted its first frame.
+     * @param widget The widget whose first paint marks the application as interactive.
+     */
+    void WatchFirstFrame(QWidget *widget);
+
+    /**
+     * @brief Sets the path of the JSON file the breakdown is written to when profiling finishes.
+     * An empty path disables the export. The WAVELENGTH_STARTUP_TRACE environment variable is used by default.
+     * @param path The destination file path.
+     */
+    void SetExportPath(const QString &path);
+
+    /**
+     * @brief Ends profiling, prints the breakdown and exports it if an export path is set.
+     * Emits firstFramePresented(). Subsequent calls do nothing.
+     */
+    void Finish();
+
+    /**
+     * @brief Gets the time elapsed between Start() and the first presented frame.
+     * @return The time in milliseconds, or -1 if the first frame has not been presented yet.
+     */
+    [[nodiscard]] double GetTimeToFirstFrameMs() const;
+
+    /**
+     * @brief Gets the phases recorded so far.
+     * @return A copy of the recorded phases.
+     */
+    [[nodiscard]] QVector<Phase> GetPhases() const { return phases_; }
+
+    /**
+     * @brief Serializes the recorded phases to an indented JSON document, readable in the exported file.
+     * @return UTF-8 encoded JSON.
+     */
+    [[nodiscard]] QByteArray ToJson() const;
+
+signals:
+    /**
+     * @brief Emitted once, right after the first frame has been presented.
+     * Used to kick off deferred initialization of subsystems not needed for the first frame.
+     */
+    void firstFramePresented();
+
+protected:
+    /**
+     * @brief Watches for the first paint event of the widget passed to WatchFirstFrame().
+     * @param watched The watched object.
+     * @param event The event being delivered.
+     * @return Always false; the event is never consumed.
+     */
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    /**
+     * @brief Private constructor to enforce the singleton pattern.
+     * Reads the default export path from the environment.
+     * @param parent Optional parent QObject.
+     */
+    explicit StartupProfiler(QObject *parent = nullptr);
+
+    /**
+     * @brief Private default destructor.
+     */
+    ~StartupProfiler() override = default;
+
+    /**
+     * @brief Prints the recorded phases with their durations and share of the total startup time.
+     */
+    void PrintBreakdown() const;
+
+    /** @brief Monotonic clock started by Start(). */
+    QElapsedTimer timer_;
+    /** @brief Phases recorded so far, in order. */
+    QVector<Phase> phases_;
+    /** @brief Timestamp (ns) at which the currently open phase began. */
+    qint64 phase_start_ns_ = 0;
+    /** @brief Timestamp (ns) of the first presented frame, or -1 if not presented yet. */
+    qint64 first_frame_ns_ = -1;
+    /** @brief Destination of the JSON export; empty if disabled. */
+    QString export_path_;
+    /** @brief Widget watched for the first paint. */
+    QWidget *watched_widget_ = nullptr;
+    /** @brief Flag indicating whether Finish() has already run. */
+    bool finished_ = false;
+};
+
+#endif // STARTUP_PROFILER_H
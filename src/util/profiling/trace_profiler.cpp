@@ -0,0 +1,229 @@
+#include "trace_profiler.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+
+std::atomic<bool> TraceProfiler::enabled_{false};
+QString TraceProfiler::export_path_;
+const std::chrono::steady_clock::time_point TraceProfiler::kEpoch = std::chrono::steady_clock::now();
+
+namespace {
+    /** @brief Maximum number of buffers of already finished threads kept for export. */
+    constexpr int kMaxRetiredBuffers = 32;
+
+    /**
+     * @brief Process-wide list of per-thread ring buffers.
+     * Buffers are shared with their threads so events survive thread exit until exported.
+     */
+    struct TraceRegistry {
+        std::mutex mutex;
+        std::vector<std::shared_ptr<TraceRingBuffer>> buffers;
+        int next_thread_index = 1;
+    };
+
+    TraceRegistry &Registry() {
+        static TraceRegistry registry;
+        return registry;
+    }
+
+    /**
+     * @brief Thread-local owner of the calling thread's buffer.
+     * On thread exit the buffer stays in the registry, but is pruned once too many finished threads pile up
+     * (decoder threads are created per playback).
+     */
+    struct ThreadBufferHandle {
+        std::shared_ptr<TraceRingBuffer> buffer;
+
+        ~ThreadBufferHandle() {
+            if (!buffer) return;
+
+            TraceRegistry &registry = Registry();
+            std::lock_guard lock(registry.mutex);
+            buffer.reset();
+
+            int retired = 0;
+            for (const auto &retained: registry.buffers) {
+                if (retained.use_count() == 1) ++retired;
+            }
+            for (auto it = registry.buffers.begin(); it != registry.buffers.end() && retired > kMaxRetiredBuffers;) {
+                if (it->use_count() == 1) {
+                    it = registry.buffers.erase(it);
+                    --retired;
+                } else {
+                    ++it;
+                }
+            }
+        }
+    };
+
+    thread_local ThreadBufferHandle current_thread_buffer;
+
+    void AppendEscaped(QByteArray &json, const QByteArray &text) {
+        for (const char c: text) {
+            if (c == '"' || c == '\\') {
+                json.append('\\');
+                json.append(c);
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                json.append(' ');
+            } else {
+                json.append(c);
+            }
+        }
+    }
+}
+
+void TraceRingBuffer::Snapshot(std::vector<TraceEvent> &output) const {
+    const quint64 head = head_.load(std::memory_order_acquire);
+    const quint64 first = head > kCapacity ? head - kCapacity : 0;
+
+    for (quint64 i = first; i < head; ++i) {
+        const Slot &slot = slots_[i & (kCapacity - 1)];
+        const quint64 sequence = slot.sequence.load(std::memory_order_acquire);
+        // the producer already moved on to a newer event in this slot
+        if (sequence != 2 * i + 2) continue;
+
+        const TraceEvent event{
+            slot.name.load(std::memory_order_relaxed),
+            slot.start_ns.load(std::memory_order_relaxed),
+            slot.duration_ns.load(std::memory_order_relaxed)
+        };
+
+        // the copied fields must be read before the sequence is checked again
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence) continue;
+
+        output.push_back(event);
+    }
+}
+
+void TraceProfiler::SetEnabled(const bool enabled) {
+    if (enabled_.exchange(enabled) != enabled) {
+        qDebug() << "[TRACE PROFILER] Tracing" << (enabled ? "enabled" : "disabled");
+    }
+}
+
+void TraceProfiler::SetExportPath(const QString &path) {
+    export_path_ = path;
+}
+
+bool TraceProfiler::ToggleRecording() {
+    if (!IsEnabled()) {
+        // a recording only covers the time since it was started
+        Clear();
+        SetEnabled(true);
+        return true;
+    }
+
+    SetEnabled(false);
+    const QString path = !export_path_.isEmpty()
+                             ? export_path_
+                             : QDir::temp().filePath(QString("wavelength_trace_%1.json")
+                                 .arg(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss")));
+    ExportChromeTrace(path);
+    return false;
+}
+
+TraceRingBuffer &TraceProfiler::CurrentThreadBuffer() {
+    if (!current_thread_buffer.buffer) {
+        auto buffer = std::make_shared<TraceRingBuffer>();
+
+        TraceRegistry &registry = Registry();
+        std::lock_guard lock(registry.mutex);
+        buffer->thread_index = registry.next_thread_index++;
+        buffer->thread_name = QString("Thread %1").arg(buffer->thread_index);
+        registry.buffers.push_back(buffer);
+        current_thread_buffer.buffer = std::move(buffer);
+    }
+    return *current_thread_buffer.buffer;
+}
+
+void TraceProfiler::Record(const char *name, const qint64 start_ns, const qint64 end_ns) {
+    CurrentThreadBuffer().Push({name, start_ns, end_ns - start_ns});
+}
+
+void TraceProfiler::SetCurrentThreadName(const QString &name) {
+    TraceRingBuffer &buffer = CurrentThreadBuffer();
+
+    std::lock_guard lock(Registry().mutex);
+    buffer.thread_name = name;
+}
+
+void TraceProfiler::Clear() {
+    TraceRegistry &registry = Registry();
+    std::lock_guard lock(registry.mutex);
+
+    // buffers of finished threads are dropped; buffers of live threads cannot be reset from here
+    // without racing their producer, so their older events are hidden from the export instead
+    registry.buffers.erase(
+        std::remove_if(registry.buffers.begin(), registry.buffers.end(),
+                       [](const std::shared_ptr<TraceRingBuffer> &buffer) { return buffer.use_count() == 1; }),
+        registry.buffers.end());
+
+    for (const auto &buffer: registry.buffers) {
+        buffer->clear_before_ns = Now();
+    }
+}
+
+QByteArray TraceProfiler::ToChromeTraceJson() {
+    QByteArray json;
+    std::vector<TraceEvent> events;
+
+    json.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool first_entry = true;
+
+    auto begin_entry = [&json, &first_entry] {
+        if (!first_entry) json.append(",\n");
+        first_entry = false;
+    };
+
+    TraceRegistry &registry = Registry();
+    std::lock_guard lock(registry.mutex);
+
+    for (const auto &buffer: registry.buffers) {
+        begin_entry();
+        json.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":");
+        json.append(QByteArray::number(buffer->thread_index));
+        json.append(",\"args\":{\"name\":\"");
+        AppendEscaped(json, buffer->thread_name.toUtf8());
+        json.append("\"}}");
+
+        events.clear();
+        buffer->Snapshot(events);
+
+        for (const TraceEvent &event: events) {
+            if (event.start_ns < buffer->clear_before_ns) continue;
+
+            // chrome trace timestamps are microseconds
+            begin_entry();
+            json.append("{\"name\":\"");
+            AppendEscaped(json, QByteArray(event.name));
+            json.append("\",\"ph\":\"X\",\"pid\":1,\"tid\":");
+            json.append(QByteArray::number(buffer->thread_index));
+            json.append(",\"ts\":");
+            json.append(QByteArray::number(static_cast<double>(event.start_ns) / 1000.0, 'f', 3));
+            json.append(",\"dur\":");
+            json.append(QByteArray::number(static_cast<double>(event.duration_ns) / 1000.0, 'f', 3));
+            json.append('}');
+        }
+    }
+
+    json.append("]}\n");
+    return json;
+}
+
+bool TraceProfiler::ExportChromeTrace(const QString &path) {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "[TRACE PROFILER] Could not write trace to:" << path << file.errorString();
+        return false;
+    }
+
+    file.write(ToChromeTraceJson());
+    qInfo() << "[TRACE PROFILER] Chrome trace exported to:" << path;
+    return true;
+}
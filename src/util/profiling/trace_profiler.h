@@ -0,0 +1,239 @@
+#ifndef TRACE_PROFILER_H
+#define TRACE_PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <QByteArray>
+#include <QString>
+
+/**
+ * @brief Compile-time switch for the tracing subsystem.
+ * Set to 0 (CMake option WAVELENGTH_ENABLE_TRACING=OFF) to compile every TRACE_* macro away.
+ */
+#ifndef WAVELENGTH_TRACING_ENABLED
+#define WAVELENGTH_TRACING_ENABLED 1
+#endif
+
+/**
+ * @brief A single completed trace zone as stored in the per-thread ring buffers.
+ */
+struct TraceEvent {
+    /** @brief Zone name. Must point to a string with static storage duration (a literal). */
+    const char *name;
+    /** @brief Start of the zone in nanoseconds since the profiler epoch. */
+    qint64 start_ns;
+    /** @brief Duration of the zone in nanoseconds. */
+    qint64 duration_ns;
+};
+
+/**
+ * @brief Fixed-size, single-producer ring buffer of trace events owned by one thread.
+ *
+ * Only the owning thread writes. Every slot is a small seqlock: its sequence is odd while the owner
+ * writes the (atomic) fields and ends up even and unique to the event stored, so readers (the exporter)
+ * copy the slots without locking and drop the ones being overwritten while copying. The oldest events
+ * are silently dropped when full.
+ */
+class TraceRingBuffer {
+public:
+    /** @brief Number of events kept per thread. Must be a power of two. */
+    static constexpr quint64 kCapacity = 1 << 13;
+
+    /**
+     * @brief Appends an event, overwriting the oldest one if the buffer is full.
+     * Must only be called from the owning thread.
+     * @param event The completed event.
+     */
+    void Push(const TraceEvent &event) {
+        const quint64 head = head_.load(std::memory_order_relaxed);
+        Slot &slot = slots_[head & (kCapacity - 1)];
+
+        slot.sequence.store(2 * head + 1, std::memory_order_relaxed);
+        // the odd sequence must be visible before any of the new fields
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(event.name, std::memory_order_relaxed);
+        slot.start_ns.store(event.start_ns, std::memory_order_relaxed);
+        slot.duration_ns.store(event.duration_ns, std::memory_order_relaxed);
+        slot.sequence.store(2 * head + 2, std::memory_order_release);
+
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copies the currently retained events into the output vector, oldest first.
+     * Safe to call from any thread while the owner keeps pushing.
+     * @param output Destination vector (appended to).
+     */
+    void Snapshot(std::vector<TraceEvent> &output) const;
+
+    /** @brief Sequential id of the owning thread, used as "tid" in the exported trace. */
+    int thread_index = 0;
+    /** @brief Display name of the owning thread. Written under the registry lock. */
+    QString thread_name;
+    /** @brief Events starting before this timestamp are skipped on export. Written under the registry lock. */
+    qint64 clear_before_ns = 0;
+
+private:
+    /**
+     * @brief Storage of one event.
+     */
+    struct Slot {
+        /** @brief 2 * index + 2 of the stored event, odd while the owner writes the event with that index. */
+        std::atomic<quint64> sequence{0};
+        std::atomic<const char *> name{nullptr};
+        std::atomic<qint64> start_ns{0};
+        std::atomic<qint64> duration_ns{0};
+    };
+
+    /** @brief Storage for the events. */
+    std::array<Slot, kCapacity> slots_{};
+    /** @brief Total number of events ever pushed. */
+    std::atomic<quint64> head_{0};
+};
+
+/**
+ * @brief Low-overhead, always-compiled-in tracing of hot code paths with Chrome trace export.
+ *
+ * Zones are recorded with the TRACE_ZONE macro. When tracing is disabled at runtime the cost of a
+ * zone is a single relaxed atomic load; when enabled it is two clock reads and a store into the
+ * calling thread's ring buffer, with no locks or allocations after the first event on a thread.
+ * ExportChromeTrace() writes the collected events in the Chrome trace event format, which can be
+ * opened in chrome://tracing or ui.perfetto.dev. Recording starts at launch with --trace <file> (or the
+ * WAVELENGTH_TRACE environment variable), or at runtime through ToggleRecording().
+ */
+class TraceProfiler {
+public:
+    /**
+     * @brief Checks whether zones are currently being recorded.
+     * @return True if tracing is enabled at runtime.
+     */
+    static bool IsEnabled() {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Enables or disables recording at runtime. Already recorded events are kept.
+     * @param enabled True to start recording, false to stop.
+     */
+    static void SetEnabled(bool enabled);
+
+    /**
+     * @brief Sets the file ToggleRecording() writes the trace to when recording stops.
+     * Without one, each recording goes to a timestamped file in the temporary directory.
+     * @param path Destination file path.
+     */
+    static void SetExportPath(const QString &path);
+
+    /**
+     * @brief Starts a fresh recording, or stops the running one and exports it as a Chrome trace.
+     * Backs the hidden "Debug.ToggleTracing" shortcut. Main thread only.
+     * @return True if recording is running after the call.
+     */
+    static bool ToggleRecording();
+
+    /**
+     * @brief Gets the current time on the profiler clock.
+     * @return Nanoseconds since the profiler epoch (process start).
+     */
+    static qint64 Now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - kEpoch).count();
+    }
+
+    /**
+     * @brief Records a completed zone in the calling thread's ring buffer.
+     * @param name Zone name with static storage duration.
+     * @param start_ns Zone start as returned by Now().
+     * @param end_ns Zone end as returned by Now().
+     */
+    static void Record(const char *name, qint64 start_ns, qint64 end_ns);
+
+    /**
+     * @brief Names the calling thread in exported traces.
+     * @param name The thread's display name.
+     */
+    static void SetCurrentThreadName(const QString &name);
+
+    /**
+     * @brief Discards all recorded events on every thread.
+     */
+    static void Clear();
+
+    /**
+     * @brief Writes all retained events to a Chrome trace event JSON file.
+     * @param path Destination file path.
+     * @return True if the file was written successfully, false otherwise.
+     */
+    static bool ExportChromeTrace(const QString &path);
+
+    /**
+     * @brief Serializes all retained events into Chrome trace event JSON.
+     * @return UTF-8 encoded JSON.
+     */
+    static QByteArray ToChromeTraceJson();
+
+private:
+    /**
+     * @brief Returns the calling thread's ring buffer, registering it on first use.
+     * @return Reference to the thread's buffer.
+     */
+    static TraceRingBuffer &CurrentThreadBuffer();
+
+    /** @brief Runtime on/off switch. */
+    static std::atomic<bool> enabled_;
+    /** @brief Destination of ToggleRecording() exports (empty for the temporary directory). */
+    static QString export_path_;
+    /** @brief Reference point of the profiler clock. */
+    static const std::chrono::steady_clock::time_point kEpoch;
+};
+
+/**
+ * @brief RAII helper recording the lifetime of a scope as a trace zone.
+ * Use through the TRACE_ZONE macro rather than directly.
+ */
+class TraceZone {
+public:
+    /**
+     * @brief Opens the zone if tracing is enabled.
+     * @param name Zone name with static storage duration.
+     */
+    explicit TraceZone(const char *name)
+        : name_(TraceProfiler::IsEnabled() ? name : nullptr),
+          start_ns_(name_ ? TraceProfiler::Now() : 0) {
+    }
+
+    /**
+     * @brief Closes the zone and records it.
+     */
+    ~TraceZone() {
+        if (name_) {
+            TraceProfiler::Record(name_, start_ns_, TraceProfiler::Now());
+        }
+    }
+
+    TraceZone(const TraceZone &) = delete;
+
+    TraceZone &operator=(const TraceZone &) = delete;
+
+private:
+    /** @brief Zone name, or nullptr if tracing was disabled when the zone opened. */
+    const char *name_;
+    /** @brief Zone start timestamp. */
+    qint64 start_ns_;
+};
+
+#if WAVELENGTH_TRACING_ENABLED
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+/** @brief Records the enclosing scope as a zone with the given string literal name. */
+#define TRACE_ZONE(name) const TraceZone TRACE_CONCAT(trace_zone_, __LINE__)(name)
+/** @brief Names the calling thread in exported traces. */
+#define TRACE_THREAD_NAME(name) TraceProfiler::SetCurrentThreadName(name)
+#else
+#define TRACE_ZONE(name) static_cast<void>(0)
+#define TRACE_THREAD_NAME(name) static_cast<void>(0)
+#endif
+
+#endif // TRACE_PROFILER_H
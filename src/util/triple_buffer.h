@@ -0,0 +1,79 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Wait-free single-producer / single-consumer exchange of the latest value.
+ *
+ * Three instances of T are kept: the writer fills the back buffer, the reader owns the front buffer and
+ * the middle one holds the most recently published value. Publishing and picking up a value are a single
+ * atomic exchange each, so neither side ever blocks or waits for the other. Values the reader did not pick
+ * up in time are overwritten (only the latest one matters).
+ *
+ * The buffers are reused, so large members (vectors) keep their capacity and the steady state does not allocate.
+ * @tparam T The exchanged type. Must be default-constructible.
+ */
+template<typename T>
+class TripleBuffer {
+public:
+    /**
+     * @brief Gets the buffer the writer may fill. Only valid for the writer thread, until Publish().
+     * @return Reference to the back buffer (holds an older value, to be overwritten).
+     */
+    T &GetWriteBuffer() { return buffers_[back_]; }
+
+    /**
+     * @brief Gets the value published last, e.g. to derive the next value from it. Called by the writer thread.
+     * The buffer is never the write buffer and the reader only reads it, so it stays valid until the next Publish().
+     * @return Reference to the last published value (default-constructed before the first Publish()).
+     */
+    [[nodiscard]] const T &GetLastPublished() const { return buffers_[last_published_]; }
+
+    /**
+     * @brief Makes the contents of the write buffer the latest value. Called by the writer thread.
+     */
+    void Publish() {
+        last_published_ = back_;
+        back_ = middle_.exchange(static_cast<uint8_t>(back_ | kFreshBit), std::memory_order_acq_rel) & kIndexMask;
+    }
+
+    /**
+     * @brief Takes the latest published value, if there is a newer one. Called by the reader thread.
+     * @return True if the read buffer changed.
+     */
+    bool Update() {
+        if ((middle_.load(std::memory_order_relaxed) & kFreshBit) == 0) {
+            return false;
+        }
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndexMask;
+        return true;
+    }
+
+    /**
+     * @brief Gets the value the reader owns. Only valid for the reader thread, until the next Update().
+     * @return Reference to the front buffer (default-constructed until the first Update() succeeds).
+     */
+    [[nodiscard]] const T &GetReadBuffer() const { return buffers_[front_]; }
+
+private:
+    /** @brief Set in middle_ when it holds a value the reader has not taken yet. */
+    static constexpr uint8_t kFreshBit = 0x4;
+    /** @brief Mask extracting the buffer index from middle_. */
+    static constexpr uint8_t kIndexMask = 0x3;
+
+    /** @brief The three value instances. */
+    std::array<T, 3> buffers_{};
+    /** @brief Index of the buffer owned by the writer. */
+    uint8_t back_ = 0;
+    /** @brief Index of the buffer published last (writer side). */
+    uint8_t last_published_ = 1;
+    /** @brief Index of the buffer owned by the reader. */
+    uint8_t front_ = 2;
+    /** @brief Index of the shared buffer plus kFreshBit; on its own cache line to avoid false sharing. */
+    alignas(64) std::atomic<uint8_t> middle_{1};
+};
+
+#endif // TRIPLE_BUFFER_H
@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <QDebug>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/blob/blob_config.h"
+#include "../src/blob/physics/blob_physics_kernels.h"
+
+namespace {
+    /** @brief Steps run per comparison, alternating between two target sets so the points keep moving. */
+    constexpr int kSteps = 32;
+
+    /**
+     * @brief SoA point data scattered around the center, partly inside the radius threshold, with velocities
+     * ranging from resting to above the speed limit, so every masked branch of the kernels is exercised.
+     */
+    struct KernelFixture {
+        explicit KernelFixture(const size_t count)
+            : position_x(count), position_y(count), velocity_x(count), velocity_y(count) {
+            std::mt19937 generator(static_cast<std::mt19937::result_type>(count));
+            const auto random = [&generator](const float min, const float max) {
+                return std::uniform_real_distribution(min, max)(generator);
+            };
+
+            for (auto &targets: target_x) targets.resize(count);
+            for (auto &targets: target_y) targets.resize(count);
+
+            for (size_t i = 0; i < count; ++i) {
+                position_x[i] = random(340.0f, 940.0f);
+                position_y[i] = random(60.0f, 660.0f);
+                velocity_x[i] = i % 4 == 0 ? 0.0f : random(-20.0f, 20.0f);
+                velocity_y[i] = i % 4 == 0 ? 0.0f : random(-20.0f, 20.0f);
+                for (int set = 0; set < 2; ++set) {
+                    target_x[set][i] = random(340.0f, 940.0f);
+                    target_y[set][i] = random(60.0f, 660.0f);
+                }
+            }
+
+            // same constants UpdatePhysicsOptimized derives from the default parameters
+            const BlobConfig::BlobParameters blob_params{};
+            const BlobConfig::PhysicsParameters physics_params{};
+            const auto radius_threshold = static_cast<float>(blob_params.blob_radius * 1.1);
+            const auto velocity_threshold = static_cast<float>(physics_params.velocity_threshold);
+            const auto max_speed = static_cast<float>(blob_params.blob_radius * physics_params.max_speed);
+            params.center_x = 640.0f;
+            params.center_y = 360.0f;
+            params.radius_threshold_squared = radius_threshold * radius_threshold;
+            params.viscosity = static_cast<float>(physics_params.viscosity);
+            params.damping = static_cast<float>(physics_params.damping);
+            params.velocity_threshold_squared = velocity_threshold * velocity_threshold;
+            params.max_speed = max_speed;
+            params.max_speed_squared = max_speed * max_speed;
+        }
+
+        BlobPhysicsKernels::PointArrays Arrays(const int target_set) {
+            return {
+                position_x.data(), position_y.data(), velocity_x.data(), velocity_y.data(),
+                target_x[target_set].data(), target_y[target_set].data(), position_x.size()
+            };
+        }
+
+        std::vector<float> position_x;
+        std::vector<float> position_y;
+        std::vector<float> velocity_x;
+        std::vector<float> velocity_y;
+        std::vector<float> target_x[2];
+        std::vector<float> target_y[2];
+        BlobPhysicsKernels::StepParameters params{};
+    };
+
+    /**
+     * @brief Runs the steps with the given kernel and with the scalar kernel and compares the results.
+     * The kernels avoid fused multiply-adds, so the results are expected to be identical; the tolerance
+     * only absorbs compilers that contract floating-point expressions regardless.
+     * @return An empty string if the results match, a description of the first mismatch otherwise.
+     */
+    std::string CompareWithScalar(const BlobPhysicsKernels::InstructionSet instruction_set, const size_t count) {
+        KernelFixture expected(count);
+        KernelFixture actual(count);
+
+        for (int step = 0; step < kSteps; ++step) {
+            const bool expected_motion = BlobPhysicsKernels::Step(BlobPhysicsKernels::InstructionSet::kScalar,
+                                                                  expected.Arrays(step % 2), expected.params);
+            const bool actual_motion = BlobPhysicsKernels::Step(instruction_set, actual.Arrays(step % 2),
+                                                                actual.params);
+            if (expected_motion != actual_motion) {
+                return "motion flag differs at step " + std::to_string(step);
+            }
+        }
+
+        const std::pair<const std::vector<float> *, const std::vector<float> *> compared[] = {
+            {&expected.position_x, &actual.position_x}, {&expected.position_y, &actual.position_y},
+            {&expected.velocity_x, &actual.velocity_x}, {&expected.velocity_y, &actual.velocity_y}
+        };
+        for (const auto &[expected_values, actual_values]: compared) {
+            for (size_t i = 0; i < count; ++i) {
+                const float tolerance = 1e-5f * std::max(1.0f, std::abs((*expected_values)[i]));
+                if (!(std::abs((*expected_values)[i] - (*actual_values)[i]) <= tolerance)) {
+                    return "value differs at point " + std::to_string(i) + ": " +
+                           std::to_string((*expected_values)[i]) + " vs " + std::to_string((*actual_values)[i]);
+                }
+            }
+        }
+        return {};
+    }
+}
+
+/**
+ * @brief Checks every SIMD blob kernel supported by this CPU against the scalar kernel.
+ * The point counts cover the tails of every vector width as well as whole vectors.
+ * @return EXIT_SUCCESS if every supported variant reproduces the scalar results.
+ */
+int main() {
+    std::vector<size_t> counts;
+    for (size_t count = 1; count <= 40; ++count) {
+        counts.push_back(count);
+    }
+    counts.insert(counts.end(), {64, 1024, 1031, 65536 + 7});
+
+    int failures = 0;
+    for (const auto instruction_set: {
+             BlobPhysicsKernels::InstructionSet::kSse2, BlobPhysicsKernels::InstructionSet::kAvx2,
+             BlobPhysicsKernels::InstructionSet::kAvx512
+         }) {
+        const char *name = BlobPhysicsKernels::GetInstructionSetName(instruction_set);
+        if (!BlobPhysicsKernels::IsSupported(instruction_set)) {
+            qInfo() << "[KERNEL TEST]" << name << "not supported by this CPU, skipped.";
+            continue;
+        }
+
+        for (const size_t count: counts) {
+            if (const std::string mismatch = CompareWithScalar(instruction_set, count); !mismatch.empty()) {
+                qWarning() << "[KERNEL TEST]" << name << "differs from the scalar kernel with" << count
+                        << "points:" << mismatch.c_str();
+                ++failures;
+            }
+        }
+        qInfo() << "[KERNEL TEST]" << name << "checked against the scalar kernel.";
+    }
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,316 @@
+#include <algorithm>
+#include <cstdlib>
+#include <QDebug>
+#include <QRegExp>
+#include <QStringList>
+#include <random>
+
+#include "../src/chat/messages/formatter/message_content_parser.h"
+
+namespace {
+    /** @brief Random inputs checked per case kind. */
+    constexpr int kCasesPerKind = 20000;
+
+    using Generator = std::mt19937;
+
+    /**
+     * @brief Picks a random element of a fixed-size array.
+     */
+    template<typename T, size_t N>
+    const T &Pick(Generator &generator, const T (&items)[N]) {
+        return items[std::uniform_int_distribution<size_t>(0, N - 1)(generator)];
+    }
+
+    /**
+     * @brief Draws an integer in [low, high].
+     */
+    int Random(Generator &generator, const int low, const int high) {
+        return std::uniform_int_distribution(low, high)(generator);
+    }
+
+    /**
+     * @brief Tags removed and entities decoded with the regex and the sequential replaces of the former
+     * StreamMessage::CleanupContent.
+     */
+    QString DecodeReference(QString html) {
+        html.remove(QRegExp("<[^>]*>"));
+        html.replace("&nbsp;", " ");
+        html.replace("&lt;", "<");
+        html.replace("&gt;", ">");
+        html.replace("&amp;", "&");
+        return html;
+    }
+
+    /**
+     * @brief The former StreamMessage::CleanupContent for content without placeholders.
+     */
+    QString CleanupContentReference(const QString &content) {
+        QString clean_content = DecodeReference(content);
+        if (clean_content.length() > MessageContentParser::kLongTextLength) {
+            clean_content.replace("\n\n", "||PARAGRAPH||");
+            clean_content = clean_content.simplified();
+            clean_content.replace("||PARAGRAPH||", "\n\n");
+
+            clean_content.replace(". ", ".\n");
+            clean_content.replace("? ", "?\n");
+            clean_content.replace("! ", "!\n");
+            clean_content.replace(":\n", ": ");
+        } else {
+            clean_content = clean_content.simplified();
+        }
+        return clean_content;
+    }
+
+    /** @brief Fragments stressing the text path: tags, (split) entities, unterminated tags and whitespace. */
+    const char *const kTextFragments[] = {
+        "<b>", "</b>", "<br>", "<span style=\"color:#ffffff;\">", "</span>", "&nbsp;", "&lt;", "&gt;", "&amp;",
+        "&amp;lt;", "&am", "p;", "&", "&lt", "lt;", ";", "<", ">", " ", "  ", "\n", "\n\n", "\t", ".", ". ",
+        "? ", "! ", ":", ":\n\n", "signal", "x", "band 7"
+    };
+
+    /**
+     * @brief The text fragments without a lone '<', which would swallow the placeholder tags that follow it.
+     * "<div>" is no placeholder and does not nest inside one.
+     */
+    const char *const kBalancedFragments[] = {
+        "<b>", "</b>", "<br>", "<div>", "<span style=\"color:#ffffff;\">", "</span>", "&nbsp;", "&lt;", "&gt;",
+        "&amp;", "&amp;lt;", "&am", "p;", "&", "&lt", "lt;", ";", ">", " ", "  ", "\n", "\n\n", "\t", ". ", "? ",
+        ":\n\n", "signal", "x"
+    };
+
+    /**
+     * @brief Concatenates random fragments.
+     */
+    template<size_t N>
+    QString MakeFuzzHtml(Generator &generator, const char *const (&fragments)[N], const int fragment_count) {
+        QString html;
+        for (int i = 0; i < fragment_count; ++i) {
+            html += Pick(generator, fragments);
+        }
+        return html;
+    }
+
+    /**
+     * @brief A random attribute value: quoted values may contain spaces and the other quote.
+     */
+    QString MakeValue(Generator &generator, const QChar quote) {
+        static const char kCharacters[] = "abcXYZ019-_./&;:";
+        QString value;
+        for (int i = Random(generator, quote.isNull() ? 1 : 0, 12); i > 0; --i) {
+            const int kind = Random(generator, 0, 9);
+            if (kind == 0 && !quote.isNull()) {
+                value += ' ';
+            } else if (kind == 1 && !quote.isNull()) {
+                value += quote == '\'' ? '"' : '\'';
+            } else {
+                value += QLatin1Char(kCharacters[Random(generator, 0, sizeof(kCharacters) - 2)]);
+            }
+        }
+        return value;
+    }
+
+    /**
+     * @brief Whitespace between attributes or around '=' (at least one character if required).
+     */
+    QString MakeSpaces(Generator &generator, const bool required) {
+        static const char *const kSpaces[] = {" ", "  ", "\n", "\t", " \n "};
+        return !required && Random(generator, 0, 2) == 0 ? QString() : QString(Pick(generator, kSpaces));
+    }
+
+    /**
+     * @brief Writes name=value with random quoting and whitespace.
+     */
+    QString MakeAttribute(Generator &generator, const QString &name, QString &value, const bool allow_unquoted) {
+        static const QChar kQuotes[] = {QLatin1Char('\''), QLatin1Char('"'), QChar()};
+        const QChar quote = Pick(generator, kQuotes);
+        if (quote.isNull() && !allow_unquoted) {
+            return MakeAttribute(generator, name, value, false);
+        }
+        if (value.isNull()) {
+            value = MakeValue(generator, quote);
+        }
+
+        QString attribute = name + MakeSpaces(generator, false) + '=' + MakeSpaces(generator, false);
+        if (quote.isNull()) {
+            // an unquoted value ends at the first space, so the parser reads it up to there
+            return attribute + value;
+        }
+        return attribute + quote + value + quote;
+    }
+
+    /**
+     * @brief Builds an opening div tag like the ones MessageFormatter generates, with the attributes in random
+     * order, random quoting and whitespace, extra classes and unknown attributes.
+     * @param expected Receives the attributes the parser has to read (type stays empty for a plain div).
+     */
+    QString MakePlaceholderTag(Generator &generator, MessageContentParser::Placeholder &expected) {
+        static const char *const kTypes[] = {"image", "gif", "audio", "video"};
+        static const char *const kOtherClasses[] = {"note", "attachment", "placeholder", "video-holder"};
+        static const char *const kDivNames[] = {"div", "DIV", "Div"};
+
+        expected = {};
+        const bool is_placeholder = Random(generator, 0, 7) != 0;
+        const bool single_class = Random(generator, 0, 2) == 0;
+
+        QStringList classes;
+        if (is_placeholder) {
+            expected.type = Pick(generator, kTypes);
+            classes << expected.type + "-placeholder";
+        } else {
+            classes << Pick(generator, kOtherClasses);
+        }
+        if (!single_class) {
+            for (int i = Random(generator, 0, 2); i > 0; --i) {
+                classes.insert(Random(generator, 0, classes.size()), Pick(generator, kOtherClasses));
+            }
+        }
+
+        QString class_value = classes.join(' ');
+        QStringList attributes;
+        attributes << MakeAttribute(generator, "class", class_value, single_class);
+        QString unknown_value;
+        attributes << MakeAttribute(generator, "data-video-id", unknown_value, true);
+        if (Random(generator, 0, 1) == 0) {
+            attributes << "hidden";
+        }
+
+        const struct {
+            const char *name;
+            QString *value;
+        } known[] = {
+            {"data-attachment-id", &expected.attachment_id}, {"data-mime-type", &expected.mime_type},
+            {"data-filename", &expected.filename}
+        };
+        for (const auto &[name, value]: known) {
+            if (Random(generator, 0, 5) == 0) continue;
+            attributes << MakeAttribute(generator, name, *value, true);
+            if (!is_placeholder) {
+                *value = QString();
+            }
+        }
+        std::shuffle(attributes.begin(), attributes.end(), generator);
+
+        QString tag = QString("<") + Pick(generator, kDivNames);
+        for (const QString &attribute: qAsConst(attributes)) {
+            tag += MakeSpaces(generator, true) + attribute;
+        }
+        return tag + MakeSpaces(generator, false) + '>';
+    }
+
+    /**
+     * @brief The text of the HTML between two placeholders as the parser writes it.
+     * @param html The HTML.
+     * @param after_placeholder Whether a placeholder precedes it: the raw whitespace at its start is skipped
+     * then, before any entity is decoded.
+     */
+    QString DecodeSegmentReference(QString html, const bool after_placeholder) {
+        html.remove(QRegExp("<[^>]*>"));
+        if (after_placeholder) {
+            int skipped = 0;
+            while (skipped < html.length() && html[skipped].isSpace()) {
+                ++skipped;
+            }
+            html.remove(0, skipped);
+        }
+        return DecodeReference(html);
+    }
+
+    /**
+     * @brief Checks text without placeholders against the former regex and replace passes.
+     * @return True if the displayed text matches.
+     */
+    bool CheckTextCase(Generator &generator, const int index) {
+        const QString html = MakeFuzzHtml(generator, kTextFragments, Random(generator, 0, index % 4 == 0 ? 300 : 40));
+        const QString expected = CleanupContentReference(html);
+        const MessageContentParser::Content content = MessageContentParser::Parse(html);
+        if (const QString actual = MessageContentParser::FormatForDisplay(content.text); actual != expected) {
+            qWarning() << "[PARSER FUZZ] Text differs from the reference for:" << html << "\nexpected:" << expected
+                    << "\nactual:" << actual;
+            return false;
+        }
+        if (content.placeholder.IsValid()) {
+            qWarning() << "[PARSER FUZZ] Placeholder found in:" << html;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Checks text around one or two divs, placeholders or not. The attributes of the first placeholder have
+     * to be read; every placeholder is cut out of the text, which is joined around it with a single space.
+     * @return True if the text and the attributes match.
+     */
+    bool CheckPlaceholderCase(Generator &generator) {
+        static const char *const kClosingDivs[] = {"</div>", "</DIV>", "</div >", "< /div>"};
+
+        QString html = MakeFuzzHtml(generator, kBalancedFragments, Random(generator, 0, 20));
+        QString expected_text;
+        MessageContentParser::Placeholder expected;
+        // the HTML since the last placeholder; a plain div is just tags around text and stays in it
+        QString segment = html;
+        bool after_placeholder = false;
+
+        for (int i = Random(generator, 1, 2); i > 0; --i) {
+            MessageContentParser::Placeholder attributes;
+            const QString tag = MakePlaceholderTag(generator, attributes);
+            const QString inner = MakeFuzzHtml(generator, kBalancedFragments, Random(generator, 0, 8));
+            const QString closing = Pick(generator, kClosingDivs);
+            const QString after = MakeFuzzHtml(generator, kBalancedFragments, Random(generator, 0, 20));
+            html += tag + inner + closing + after;
+
+            if (!attributes.IsValid()) {
+                segment += tag + inner + closing + after;
+                continue;
+            }
+            if (!expected.IsValid()) {
+                expected = attributes;
+            }
+
+            expected_text += DecodeSegmentReference(segment, after_placeholder);
+            while (!expected_text.isEmpty() && expected_text.back().isSpace()) {
+                expected_text.chop(1);
+            }
+            expected_text += ' ';
+            segment = after;
+            after_placeholder = true;
+        }
+        expected_text += DecodeSegmentReference(segment, after_placeholder);
+
+        const MessageContentParser::Content content = MessageContentParser::Parse(html);
+        const MessageContentParser::Placeholder &actual = content.placeholder;
+        if (content.text != expected_text) {
+            qWarning() << "[PARSER FUZZ] Text around the placeholder differs for:" << html << "\nexpected:"
+                    << expected_text << "\nactual:" << content.text;
+            return false;
+        }
+        if (actual.type != expected.type || actual.attachment_id != expected.attachment_id
+            || actual.mime_type != expected.mime_type || actual.filename != expected.filename) {
+            qWarning() << "[PARSER FUZZ] Placeholder attributes differ for:" << html << "\nexpected:" << expected.type
+                    << expected.attachment_id << expected.mime_type << expected.filename << "\nactual:" << actual.type
+                    << actual.attachment_id << actual.mime_type << actual.filename;
+            return false;
+        }
+        return true;
+    }
+}
+
+/**
+ * @brief Fuzzes MessageContentParser against the former regex and replace passes, and checks the placeholder
+ * attributes and the text around placeholders.
+ * @param argc Argument count.
+ * @param argv An optional seed (the default seed keeps CTest runs reproducible).
+ * @return EXIT_SUCCESS if every case matches.
+ */
+int main(const int argc, char *argv[]) {
+    const auto seed = argc > 1 ? static_cast<Generator::result_type>(std::strtoul(argv[1], nullptr, 10)) : 1234;
+    Generator generator(seed);
+
+    int failures = 0;
+    for (int i = 0; i < kCasesPerKind && failures < 10; ++i) {
+        if (!CheckTextCase(generator, i)) ++failures;
+        if (!CheckPlaceholderCase(generator)) ++failures;
+    }
+
+    qInfo() << "[PARSER FUZZ]" << 2 * kCasesPerKind << "cases with seed" << seed << "," << failures << "failures";
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}